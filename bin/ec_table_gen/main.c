@@ -0,0 +1,57 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/private/ec_native.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+/*
+ * Writes the native engine's generator tables as C source, so the library can link them in as read only data
+ * instead of building them the first time a curve is used. Run by the build; the output depends only on the curve
+ * constants in ec_native.c.
+ */
+
+static void s_write_table(FILE *out, enum aws_ecc_curve_name curve_name, const char *symbol) {
+    size_t length = aws_ec_native_generator_table_length(curve_name);
+    AWS_FATAL_ASSERT(length && "curve not implemented by the native engine");
+
+    struct aws_allocator *allocator = aws_default_allocator();
+    uint64_t *points = aws_mem_calloc(allocator, length, sizeof(uint64_t));
+    AWS_FATAL_ASSERT(points && "allocation of table failed");
+    AWS_FATAL_ASSERT(!aws_ec_native_build_generator_table(curve_name, points) && "building table failed");
+
+    fprintf(out, "\nconst uint64_t %s[%zu] = {\n", symbol, length);
+    for (size_t i = 0; i < length; ++i) {
+        fprintf(out, "%s0x%016" PRIx64 "ULL,%s", i % 4 ? " " : "    ", points[i], i % 4 == 3 ? "\n" : "");
+    }
+    fprintf(out, "%s};\n", length % 4 ? "\n" : "");
+
+    aws_mem_release(allocator, points);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <output.c>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if (!out) {
+        fprintf(stderr, "unable to open %s for writing\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "/* Generated by ec_table_gen. Do not edit. */\n\n#include <stdint.h>\n");
+    s_write_table(out, AWS_CAL_ECDSA_P256, "aws_ec_native_p256_generator_points");
+    s_write_table(out, AWS_CAL_ECDSA_P384, "aws_ec_native_p384_generator_points");
+
+    if (fclose(out)) {
+        fprintf(stderr, "unable to write %s\n", argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
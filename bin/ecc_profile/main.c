@@ -0,0 +1,930 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/cal.h>
+#include <aws/cal/ecc.h>
+#include <aws/cal/ed25519.h>
+#include <aws/cal/hash.h>
+
+#include <aws/common/clock.h>
+#include <aws/common/device_random.h>
+#include <aws/common/math.h>
+#include <aws/common/system_info.h>
+#include <aws/common/thread.h>
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+#    include <aws/cal/private/opensslcrypto_ecc.h>
+#endif
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#define ITERATIONS 2000
+#define BATCH_KEYS 16
+#define BATCH_SIZE 1024
+#define LATENCY_SAMPLES 500
+#define STREAM_PAYLOAD_SIZE (16 * 1024)
+#define SCALING_MAX_THREADS 16
+#define SCALING_SIGNATURES_PER_THREAD 500
+
+static const char *s_curve_names[] = {
+    [AWS_CAL_ECDSA_P256] = "P-256",
+    [AWS_CAL_ECDSA_P384] = "P-384",
+};
+
+static void s_report(const char *curve, const char *backend, const char *operation, uint64_t start, uint64_t end) {
+    uint64_t per_op = (end - start) / ITERATIONS;
+    fprintf(
+        stdout,
+        "%-6s %-24s %-7s %8" PRIu64 "ns per op %8" PRIu64 " ops/s\n",
+        curve,
+        backend,
+        operation,
+        per_op,
+        per_op ? (uint64_t)1000000000 / per_op : 0);
+}
+
+static void s_profile_sign_verify(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *backend_name,
+    bool deterministic) {
+
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    if (deterministic) {
+        AWS_FATAL_ASSERT(
+            !aws_ecc_key_pair_set_deterministic_signing(key_pair, true) && "enabling deterministic signing failed");
+    }
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&hash_buf) && "reading random data failed");
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_buf);
+
+    struct aws_byte_buf signature;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&signature, allocator, aws_ecc_key_pair_signature_length(key_pair)) &&
+        "allocation of signature failed");
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        signature.len = 0;
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature) && "sign failed");
+    }
+
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], backend_name, "sign", start, end);
+
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature);
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_verify_signature(key_pair, &hash_cur, &signature_cur) && "verify failed");
+    }
+
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], backend_name, "verify", start, end);
+
+    aws_byte_buf_clean_up(&signature);
+    aws_ecc_key_pair_release(key_pair);
+}
+
+static void s_profile_sign_batch(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *backend_name) {
+
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&hash_buf) && "reading random data failed");
+
+    size_t signature_length = aws_ecc_key_pair_signature_length(key_pair);
+    struct aws_byte_buf signature_storage;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&signature_storage, allocator, ITERATIONS * signature_length) &&
+        "allocation of signatures failed");
+
+    static struct aws_byte_cursor messages[ITERATIONS];
+    static struct aws_byte_buf signatures[ITERATIONS];
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        messages[i] = aws_byte_cursor_from_buf(&hash_buf);
+        signatures[i] =
+            aws_byte_buf_from_empty_array(signature_storage.buffer + i * signature_length, signature_length);
+    }
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+    AWS_FATAL_ASSERT(
+        !aws_ecc_key_pair_sign_message_batch(key_pair, messages, ITERATIONS, signatures) && "batch sign failed");
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], backend_name, "sign", start, end);
+
+    aws_byte_buf_clean_up(&signature_storage);
+    aws_ecc_key_pair_release(key_pair);
+}
+
+#define ECDH_PEERS 64
+
+/*
+ * ECDH against one static key, as a handshake-heavy server does: ITERATIONS agreements with a rotating set of peers,
+ * one at a time or as one batch. Prepared peers stand in for static-static agreements with known parties.
+ */
+static void s_profile_ecdh(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *backend_name,
+    bool batch,
+    bool prepared) {
+
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    struct aws_ecc_key_pair *peers[ECDH_PEERS];
+    for (size_t i = 0; i < ECDH_PEERS; ++i) {
+        peers[i] = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+        AWS_FATAL_ASSERT(peers[i] && "key generation failed");
+
+        /* the peers' public keys arrive as coordinates, so don't time converting them */
+        struct aws_byte_cursor pub_x;
+        struct aws_byte_cursor pub_y;
+        aws_ecc_key_pair_get_public_key(peers[i], &pub_x, &pub_y);
+        if (prepared) {
+            AWS_FATAL_ASSERT(!aws_ecc_key_pair_prepare_for_verification(peers[i]) && "preparing peer failed");
+        }
+    }
+
+    size_t secret_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+    struct aws_byte_buf secret_storage;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&secret_storage, allocator, ITERATIONS * secret_size) && "allocation of secrets failed");
+
+    static const struct aws_ecc_key_pair *batch_peers[ITERATIONS];
+    static struct aws_byte_buf secrets[ITERATIONS];
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        batch_peers[i] = peers[i % ECDH_PEERS];
+        secrets[i] = aws_byte_buf_from_empty_array(secret_storage.buffer + i * secret_size, secret_size);
+    }
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    if (batch) {
+        AWS_FATAL_ASSERT(
+            !aws_ecc_key_pair_derive_shared_secret_batch(key_pair, batch_peers, ITERATIONS, secrets) &&
+            "batch ECDH failed");
+    } else {
+        for (size_t i = 0; i < ITERATIONS; ++i) {
+            AWS_FATAL_ASSERT(
+                !aws_ecc_key_pair_derive_shared_secret(key_pair, batch_peers[i], &secrets[i]) && "ECDH failed");
+        }
+    }
+
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], backend_name, "ecdh", start, end);
+
+    aws_byte_buf_clean_up_secure(&secret_storage);
+    for (size_t i = 0; i < ECDH_PEERS; ++i) {
+        aws_ecc_key_pair_release(peers[i]);
+    }
+    aws_ecc_key_pair_release(key_pair);
+}
+
+static int s_compare_ticks(const void *a, const void *b) {
+    uint64_t ticks_a = *(const uint64_t *)a;
+    uint64_t ticks_b = *(const uint64_t *)b;
+    return ticks_a < ticks_b ? -1 : ticks_a > ticks_b;
+}
+
+/*
+ * Latency of single signatures made 1ms apart, like a request path would, which leaves a nonce pool's worker the
+ * time to keep up.
+ */
+static void s_profile_sign_latency(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *backend_name,
+    bool nonce_pool) {
+
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    if (nonce_pool) {
+        struct aws_ecc_nonce_pool_options options = {
+            .depth = 64,
+            .refill_threshold = 32,
+        };
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_enable_nonce_pool(key_pair, &options) && "enabling nonce pool failed");
+    }
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&hash_buf) && "reading random data failed");
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_buf);
+
+    struct aws_byte_buf signature;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&signature, allocator, aws_ecc_key_pair_signature_length(key_pair)) &&
+        "allocation of signature failed");
+
+    static uint64_t latencies[LATENCY_SAMPLES];
+    for (size_t i = 0; i < LATENCY_SAMPLES; ++i) {
+        aws_thread_current_sleep(1000000);
+
+        uint64_t start = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+        signature.len = 0;
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature) && "sign failed");
+        uint64_t end = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+
+        latencies[i] = end - start;
+    }
+
+    qsort(latencies, LATENCY_SAMPLES, sizeof(uint64_t), s_compare_ticks);
+    fprintf(
+        stdout,
+        "%-6s %-24s %-7s %8" PRIu64 "ns p50   %8" PRIu64 "ns p99\n",
+        s_curve_names[curve_name],
+        backend_name,
+        "sign",
+        latencies[LATENCY_SAMPLES / 2],
+        latencies[LATENCY_SAMPLES * 99 / 100]);
+
+    aws_byte_buf_clean_up(&signature);
+    aws_ecc_key_pair_release(key_pair);
+}
+
+/*
+ * Request path key generation for an ECDH style exchange, a fresh key pair and its public coordinates, either made on
+ * the spot or taken from a pool that a worker keeps filled in between requests.
+ */
+static void s_profile_key_latency(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *backend_name,
+    bool key_pool) {
+
+    struct aws_ecc_key_pool *pool = NULL;
+    if (key_pool) {
+        struct aws_ecc_key_pool_options options = {
+            .depth = 64,
+            .refill_threshold = 32,
+        };
+        pool = aws_ecc_key_pool_new(allocator, curve_name, &options);
+        AWS_FATAL_ASSERT(pool && "key pool creation failed");
+    }
+
+    static uint64_t latencies[LATENCY_SAMPLES];
+    for (size_t i = 0; i < LATENCY_SAMPLES; ++i) {
+        aws_thread_current_sleep(1000000);
+
+        uint64_t start = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+        struct aws_ecc_key_pair *key_pair =
+            pool ? aws_ecc_key_pool_take(pool) : aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+        AWS_FATAL_ASSERT(key_pair && "key generation failed");
+        struct aws_byte_cursor pub_x;
+        struct aws_byte_cursor pub_y;
+        aws_ecc_key_pair_get_public_key(key_pair, &pub_x, &pub_y);
+        uint64_t end = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+
+        latencies[i] = end - start;
+        aws_ecc_key_pair_release(key_pair);
+    }
+
+    qsort(latencies, LATENCY_SAMPLES, sizeof(uint64_t), s_compare_ticks);
+    fprintf(
+        stdout,
+        "%-6s %-24s %-7s %8" PRIu64 "ns p50   %8" PRIu64 "ns p99\n",
+        s_curve_names[curve_name],
+        backend_name,
+        "keygen",
+        latencies[LATENCY_SAMPLES / 2],
+        latencies[LATENCY_SAMPLES * 99 / 100]);
+
+    aws_ecc_key_pool_destroy(pool);
+}
+
+struct scaling_thread_data {
+    struct aws_allocator *allocator;
+    struct aws_ecc_key_pair *key_pair;
+    struct aws_byte_cursor hash;
+    bool replica;
+};
+
+/* What a request handler does with the process' signing key: take a reference, sign, drop it. */
+static void s_scaling_thread_fn(void *arg) {
+    struct scaling_thread_data *data = arg;
+
+    struct aws_ecc_key_pair *replica = NULL;
+    if (data->replica) {
+        replica = aws_ecc_key_pair_new_replica(data->allocator, data->key_pair);
+        AWS_FATAL_ASSERT(replica && "replica creation failed");
+    }
+
+    uint8_t signature[256];
+    for (size_t i = 0; i < SCALING_SIGNATURES_PER_THREAD; ++i) {
+        struct aws_ecc_key_pair *key_pair = replica ? replica : data->key_pair;
+        aws_ecc_key_pair_acquire(key_pair);
+        struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_sign_message(key_pair, &data->hash, &signature_buf) && "sign failed");
+        aws_ecc_key_pair_release(key_pair);
+    }
+
+    aws_ecc_key_pair_release(replica);
+}
+
+/* Aggregate signing throughput of one logical key shared by 1, 2, 4, ... threads, up to one per processor. */
+static void s_profile_sign_scaling(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *backend_name,
+    bool replica) {
+
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&hash_buf) && "reading random data failed");
+
+    struct scaling_thread_data data = {
+        .allocator = allocator,
+        .key_pair = key_pair,
+        .hash = aws_byte_cursor_from_buf(&hash_buf),
+        .replica = replica,
+    };
+
+    size_t max_threads = aws_min_size(aws_system_info_processor_count(), SCALING_MAX_THREADS);
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+        struct aws_thread threads[SCALING_MAX_THREADS];
+
+        uint64_t start = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+        for (size_t i = 0; i < thread_count; ++i) {
+            AWS_FATAL_ASSERT(!aws_thread_init(&threads[i], allocator) && "thread init failed");
+            AWS_FATAL_ASSERT(
+                !aws_thread_launch(&threads[i], s_scaling_thread_fn, &data, NULL) && "thread launch failed");
+        }
+
+        for (size_t i = 0; i < thread_count; ++i) {
+            aws_thread_join(&threads[i]);
+            aws_thread_clean_up(&threads[i]);
+        }
+
+        uint64_t end = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+
+        uint64_t elapsed = end - start;
+        uint64_t signatures = (uint64_t)thread_count * SCALING_SIGNATURES_PER_THREAD;
+        fprintf(
+            stdout,
+            "%-6s %-24s %-7s %2zu threads %8" PRIu64 " ops/s\n",
+            s_curve_names[curve_name],
+            backend_name,
+            "sign",
+            thread_count,
+            elapsed ? signatures * 1000000000 / elapsed : 0);
+    }
+
+    aws_ecc_key_pair_release(key_pair);
+}
+
+#define ROTATION_KEYS 8
+
+struct rotation_thread_data {
+    struct aws_ecc_key_slot *slot;
+    struct aws_ecc_key_pair *key_pairs[ROTATION_KEYS];
+    struct aws_atomic_var done;
+};
+
+/* Publishes the next key pair every millisecond, far more often than any real rotation. */
+static void s_rotation_thread_fn(void *arg) {
+    struct rotation_thread_data *data = arg;
+
+    for (size_t i = 0; !aws_atomic_load_int(&data->done); ++i) {
+        AWS_FATAL_ASSERT(!aws_ecc_key_slot_publish(data->slot, data->key_pairs[i % ROTATION_KEYS]) && "publish failed");
+        aws_thread_current_sleep(1000000);
+    }
+}
+
+/* Sign latency through a key slot, with and without the key being rotated underneath. */
+static void s_profile_key_slot(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name, bool rotate) {
+    struct rotation_thread_data data;
+    AWS_ZERO_STRUCT(data);
+    for (size_t i = 0; i < ROTATION_KEYS; ++i) {
+        data.key_pairs[i] = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+        AWS_FATAL_ASSERT(data.key_pairs[i] && "key generation failed");
+    }
+
+    data.slot = aws_ecc_key_slot_new(allocator, data.key_pairs[0]);
+    AWS_FATAL_ASSERT(data.slot && "key slot creation failed");
+    struct aws_ecc_key_slot_reader *reader = aws_ecc_key_slot_reader_new(data.slot);
+    AWS_FATAL_ASSERT(reader && "key slot reader creation failed");
+    aws_atomic_init_int(&data.done, 0);
+
+    struct aws_thread rotator;
+    if (rotate) {
+        AWS_FATAL_ASSERT(!aws_thread_init(&rotator, allocator) && "thread init failed");
+        AWS_FATAL_ASSERT(!aws_thread_launch(&rotator, s_rotation_thread_fn, &data, NULL) && "thread launch failed");
+    }
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&hash_buf) && "reading random data failed");
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_buf);
+
+    static uint64_t latencies[LATENCY_SAMPLES];
+    uint8_t signature[256];
+    for (size_t i = 0; i < LATENCY_SAMPLES; ++i) {
+        uint64_t start = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+        struct aws_ecc_key_pair *key_pair = aws_ecc_key_slot_read_begin(reader);
+        struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature_buf) && "sign failed");
+        aws_ecc_key_slot_read_end(reader);
+        uint64_t end = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+
+        latencies[i] = end - start;
+    }
+
+    if (rotate) {
+        aws_atomic_store_int(&data.done, 1);
+        aws_thread_join(&rotator);
+        aws_thread_clean_up(&rotator);
+    }
+
+    qsort(latencies, LATENCY_SAMPLES, sizeof(uint64_t), s_compare_ticks);
+    fprintf(
+        stdout,
+        "%-6s %-24s %-7s %8" PRIu64 "ns p50   %8" PRIu64 "ns p99\n",
+        s_curve_names[curve_name],
+        rotate ? "key slot, rotating" : "key slot",
+        "sign",
+        latencies[LATENCY_SAMPLES / 2],
+        latencies[LATENCY_SAMPLES * 99 / 100]);
+
+    aws_ecc_key_slot_reader_destroy(reader);
+    aws_ecc_key_slot_destroy(data.slot);
+    for (size_t i = 0; i < ROTATION_KEYS; ++i) {
+        aws_ecc_key_pair_release(data.key_pairs[i]);
+    }
+}
+
+static void s_profile_prepared_verify(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&hash_buf) && "reading random data failed");
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_buf);
+
+    struct aws_byte_buf signature;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&signature, allocator, aws_ecc_key_pair_signature_length(key_pair)) &&
+        "allocation of signature failed");
+    AWS_FATAL_ASSERT(!aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature) && "sign failed");
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature);
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+    AWS_FATAL_ASSERT(!aws_ecc_key_pair_prepare_for_verification(key_pair) && "prepare failed");
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    fprintf(
+        stdout,
+        "%-6s %-24s %-7s %8" PRIu64 "ns once\n",
+        s_curve_names[curve_name],
+        "prepared",
+        "prepare",
+        end - start);
+
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_verify_signature(key_pair, &hash_cur, &signature_cur) && "verify failed");
+    }
+
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], "prepared", "verify", start, end);
+
+    aws_byte_buf_clean_up(&signature);
+    aws_ecc_key_pair_release(key_pair);
+}
+
+static void s_profile_import(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *backend_name) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(key_pair, &pub_x, &pub_y);
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        struct aws_ecc_key_pair *imported = aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &pub_x, &pub_y);
+        AWS_FATAL_ASSERT(imported && "public key import failed");
+        aws_ecc_key_pair_release(imported);
+    }
+
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], backend_name, "import", start, end);
+
+    aws_ecc_key_pair_release(key_pair);
+}
+
+/* aws_ecc_verify_batch() over BATCH_KEYS keys, from one thread up to one per processor. */
+static void s_profile_verify_batch(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *key_pairs[BATCH_KEYS];
+    for (size_t i = 0; i < BATCH_KEYS; ++i) {
+        key_pairs[i] = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+        AWS_FATAL_ASSERT(key_pairs[i] && "key generation failed");
+    }
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&hash_buf) && "reading random data failed");
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_buf);
+
+    size_t signature_length = aws_ecc_key_pair_signature_length(key_pairs[0]);
+    struct aws_byte_buf signature_storage;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&signature_storage, allocator, BATCH_SIZE * signature_length) &&
+        "allocation of signatures failed");
+
+    static struct aws_ecc_key_pair *keys[BATCH_SIZE];
+    static struct aws_byte_cursor messages[BATCH_SIZE];
+    static struct aws_byte_cursor signatures[BATCH_SIZE];
+    static int results[BATCH_SIZE];
+
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        keys[i] = key_pairs[i % BATCH_KEYS];
+        messages[i] = hash_cur;
+
+        struct aws_byte_buf signature =
+            aws_byte_buf_from_empty_array(signature_storage.buffer + i * signature_length, signature_length);
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_sign_message(keys[i], &hash_cur, &signature) && "sign failed");
+        signatures[i] = aws_byte_cursor_from_buf(&signature);
+    }
+
+    size_t processors = aws_system_info_processor_count();
+    for (size_t threads = 1;; threads *= 2) {
+        threads = threads < processors ? threads : processors;
+
+        /* started once, outside the timing, the way a service would */
+        struct aws_ecc_verify_workers *workers = aws_ecc_verify_workers_new(allocator, threads);
+        AWS_FATAL_ASSERT(workers && "starting the batch workers failed");
+
+        uint64_t start = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+        AWS_FATAL_ASSERT(
+            !aws_ecc_verify_batch(allocator, keys, messages, signatures, BATCH_SIZE, workers, results) &&
+            "batch verify failed");
+        uint64_t end = 0;
+        AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+
+        aws_ecc_verify_workers_destroy(workers);
+
+        char backend_name[32];
+        snprintf(backend_name, sizeof(backend_name), "batch, %zu thread(s)", threads);
+
+        uint64_t per_op = (end - start) / BATCH_SIZE;
+        fprintf(
+            stdout,
+            "%-6s %-24s %-7s %8" PRIu64 "ns per op %8" PRIu64 " ops/s\n",
+            s_curve_names[curve_name],
+            backend_name,
+            "verify",
+            per_op,
+            per_op ? (uint64_t)1000000000 / per_op : 0);
+
+        if (threads >= processors) {
+            break;
+        }
+    }
+
+    aws_byte_buf_clean_up(&signature_storage);
+    for (size_t i = 0; i < BATCH_KEYS; ++i) {
+        aws_ecc_key_pair_release(key_pairs[i]);
+    }
+}
+
+/* DER <-> raw conversion of ITERATIONS signatures in one batch, per signature */
+static void s_profile_signature_conversion(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&hash_buf) && "reading random data failed");
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_buf);
+
+    struct aws_byte_buf signature;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&signature, allocator, aws_ecc_key_pair_signature_length(key_pair)) &&
+        "allocation of signature failed");
+    AWS_FATAL_ASSERT(!aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature) && "sign failed");
+
+    static struct aws_byte_cursor der_signatures[ITERATIONS];
+    static struct aws_byte_cursor raw_signatures[ITERATIONS];
+    static struct aws_byte_buf raw_outputs[ITERATIONS];
+    static struct aws_byte_buf der_outputs[ITERATIONS];
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        der_signatures[i] = aws_byte_cursor_from_buf(&signature);
+        AWS_FATAL_ASSERT(
+            !aws_byte_buf_init(&raw_outputs[i], allocator, aws_ecc_raw_signature_length(curve_name)) &&
+            !aws_byte_buf_init(&der_outputs[i], allocator, aws_ecc_key_pair_signature_length(key_pair)) &&
+            "allocation of signatures failed");
+    }
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+    AWS_FATAL_ASSERT(
+        !aws_ecc_signatures_der_to_raw(curve_name, der_signatures, ITERATIONS, raw_outputs) && "conversion failed");
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], "DER to raw", "convert", start, end);
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        raw_signatures[i] = aws_byte_cursor_from_buf(&raw_outputs[i]);
+    }
+
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+    AWS_FATAL_ASSERT(
+        !aws_ecc_signatures_raw_to_der(curve_name, raw_signatures, ITERATIONS, der_outputs) && "conversion failed");
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], "raw to DER", "convert", start, end);
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        aws_byte_buf_clean_up(&raw_outputs[i]);
+        aws_byte_buf_clean_up(&der_outputs[i]);
+    }
+
+    aws_byte_buf_clean_up(&signature);
+    aws_ecc_key_pair_release(key_pair);
+}
+
+/* signing a STREAM_PAYLOAD_SIZE message: hashing it with aws_hash first, then through a streaming signer */
+static void s_profile_stream_sign(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    static uint8_t payload[STREAM_PAYLOAD_SIZE];
+    struct aws_byte_buf payload_buf = aws_byte_buf_from_empty_array(payload, sizeof(payload));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&payload_buf) && "reading random data failed");
+    struct aws_byte_cursor payload_cur = aws_byte_cursor_from_buf(&payload_buf);
+
+    struct aws_byte_buf signature;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&signature, allocator, aws_ecc_key_pair_signature_length(key_pair)) &&
+        "allocation of signature failed");
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        uint8_t hash[AWS_SHA256_LEN];
+        struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+        AWS_FATAL_ASSERT(!aws_sha256_compute(allocator, &payload_cur, &hash_buf, 0) && "hash failed");
+        struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_buf);
+        signature.len = 0;
+        AWS_FATAL_ASSERT(!aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature) && "sign failed");
+    }
+
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], "hash then sign 16KiB", "sign", start, end);
+
+    struct aws_ecc_signer *signer = aws_ecc_signer_new(allocator, key_pair);
+    AWS_FATAL_ASSERT(signer && "signer creation failed");
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        signature.len = 0;
+        AWS_FATAL_ASSERT(!aws_ecc_signer_update(signer, &payload_cur) && "update failed");
+        AWS_FATAL_ASSERT(!aws_ecc_signer_finalize(signer, &signature) && "sign failed");
+    }
+
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], "streaming 16KiB", "sign", start, end);
+
+    aws_ecc_signer_destroy(signer);
+    aws_byte_buf_clean_up(&signature);
+    aws_ecc_key_pair_release(key_pair);
+}
+
+/* s_profile_import() from the SEC1 encoding, where compressed points pay for a square root on every load */
+static void s_profile_sec1_import(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *backend_name,
+    bool compressed) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    AWS_FATAL_ASSERT(key_pair && "key generation failed");
+
+    struct aws_byte_buf encoded;
+    aws_byte_buf_init(&encoded, allocator, aws_ecc_sec1_public_key_length(curve_name, compressed));
+    AWS_FATAL_ASSERT(!aws_ecc_key_pair_write_sec1_public_key(key_pair, compressed, &encoded) && "encoding failed");
+    struct aws_byte_cursor encoded_cur = aws_byte_cursor_from_buf(&encoded);
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        struct aws_ecc_key_pair *imported =
+            aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur);
+        AWS_FATAL_ASSERT(imported && "public key import failed");
+        aws_ecc_key_pair_release(imported);
+    }
+
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report(s_curve_names[curve_name], backend_name, "import", start, end);
+
+    aws_byte_buf_clean_up(&encoded);
+    aws_ecc_key_pair_release(key_pair);
+}
+
+/*
+ * Ed25519 sign, verify and batch verify of a 32 byte message, the size of the P-256 rows' digest, so the rows line up
+ * with P-256's. The batch row is per signature, on one thread.
+ */
+static void s_profile_ed25519(struct aws_allocator *allocator, const char *backend_name) {
+    struct aws_ed25519_key_pair *key_pairs[BATCH_KEYS];
+    for (size_t i = 0; i < BATCH_KEYS; ++i) {
+        key_pairs[i] = aws_ed25519_key_pair_new_generate_random(allocator);
+        AWS_FATAL_ASSERT(key_pairs[i] && "key generation failed");
+    }
+
+    uint8_t message[32];
+    struct aws_byte_buf message_buf = aws_byte_buf_from_empty_array(message, sizeof(message));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&message_buf) && "reading random data failed");
+    struct aws_byte_cursor message_cur = aws_byte_cursor_from_buf(&message_buf);
+
+    struct aws_byte_buf signature_storage;
+    AWS_FATAL_ASSERT(
+        !aws_byte_buf_init(&signature_storage, allocator, BATCH_SIZE * AWS_ED25519_SIGNATURE_LEN) &&
+        "allocation of signatures failed");
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        signature_storage.len = 0;
+        AWS_FATAL_ASSERT(
+            !aws_ed25519_key_pair_sign_message(key_pairs[0], &message_cur, &signature_storage) && "sign failed");
+    }
+
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report("Ed25519", backend_name, "sign", start, end);
+
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_storage);
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        AWS_FATAL_ASSERT(
+            !aws_ed25519_key_pair_verify_signature(key_pairs[0], &message_cur, &signature_cur) && "verify failed");
+    }
+
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    s_report("Ed25519", backend_name, "verify", start, end);
+
+    static struct aws_ed25519_key_pair *keys[BATCH_SIZE];
+    static struct aws_byte_cursor messages[BATCH_SIZE];
+    static struct aws_byte_cursor signatures[BATCH_SIZE];
+    static int results[BATCH_SIZE];
+
+    signature_storage.len = 0;
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        keys[i] = key_pairs[i % BATCH_KEYS];
+        messages[i] = message_cur;
+
+        struct aws_byte_buf signature = aws_byte_buf_from_empty_array(
+            signature_storage.buffer + i * AWS_ED25519_SIGNATURE_LEN, AWS_ED25519_SIGNATURE_LEN);
+        AWS_FATAL_ASSERT(!aws_ed25519_key_pair_sign_message(keys[i], &message_cur, &signature) && "sign failed");
+        signatures[i] = aws_byte_cursor_from_buf(&signature);
+    }
+
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+    AWS_FATAL_ASSERT(
+        !aws_ed25519_verify_batch(allocator, keys, messages, signatures, BATCH_SIZE, results) && "batch verify failed");
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+
+    char batch_name[32];
+    snprintf(batch_name, sizeof(batch_name), "%s batch", backend_name);
+
+    uint64_t per_op = (end - start) / BATCH_SIZE;
+    fprintf(
+        stdout,
+        "%-6s %-24s %-7s %8" PRIu64 "ns per op %8" PRIu64 " ops/s\n",
+        "Ed25519",
+        batch_name,
+        "verify",
+        per_op,
+        per_op ? (uint64_t)1000000000 / per_op : 0);
+
+    aws_byte_buf_clean_up(&signature_storage);
+    for (size_t i = 0; i < BATCH_KEYS; ++i) {
+        aws_ed25519_key_pair_release(key_pairs[i]);
+    }
+}
+
+static void s_run_profiles(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    fprintf(stdout, "********************* ECDSA %s *************************\n\n", s_curve_names[curve_name]);
+
+    s_profile_import(allocator, curve_name, "default");
+    s_profile_sec1_import(allocator, curve_name, "default SEC1 uncompressed", false);
+    s_profile_sec1_import(allocator, curve_name, "default SEC1 compressed", true);
+
+    s_profile_sign_verify(allocator, curve_name, "default", false);
+    s_profile_sign_batch(allocator, curve_name, "default batch");
+#if !defined(_WIN32) && !defined(__APPLE__)
+    enum aws_libcrypto_ecc_backend default_backend = aws_libcrypto_ecc_get_backend();
+
+    aws_libcrypto_ecc_set_backend(AWS_LIBCRYPTO_ECC_BACKEND_EC_KEY);
+    s_profile_sign_verify(allocator, curve_name, "libcrypto EC_KEY", false);
+
+    aws_libcrypto_ecc_set_backend(AWS_LIBCRYPTO_ECC_BACKEND_EVP_PKEY);
+    s_profile_sign_verify(allocator, curve_name, "libcrypto EVP_PKEY", false);
+
+    aws_libcrypto_ecc_set_backend(default_backend);
+#endif
+
+    s_profile_prepared_verify(allocator, curve_name);
+    s_profile_verify_batch(allocator, curve_name);
+    s_profile_signature_conversion(allocator, curve_name);
+    s_profile_stream_sign(allocator, curve_name);
+    s_profile_key_latency(allocator, curve_name, "default", false);
+    s_profile_key_latency(allocator, curve_name, "default key pool", true);
+    s_profile_sign_scaling(allocator, curve_name, "default shared", false);
+    s_profile_sign_scaling(allocator, curve_name, "default replicas", true);
+    s_profile_key_slot(allocator, curve_name, false);
+    s_profile_key_slot(allocator, curve_name, true);
+    s_profile_ecdh(allocator, curve_name, "default", false, false);
+    s_profile_ecdh(allocator, curve_name, "default batch", true, false);
+
+    /* the native provider doesn't cover every curve */
+    enum aws_ecc_provider default_provider = aws_ecc_get_provider(curve_name);
+    if (!aws_ecc_set_provider(curve_name, AWS_ECC_PROVIDER_NATIVE)) {
+        s_profile_import(allocator, curve_name, "native");
+        s_profile_sec1_import(allocator, curve_name, "native SEC1 uncompressed", false);
+        s_profile_sec1_import(allocator, curve_name, "native SEC1 compressed", true);
+        s_profile_sign_verify(allocator, curve_name, "native", false);
+        s_profile_sign_verify(allocator, curve_name, "native RFC 6979", true);
+        s_profile_sign_batch(allocator, curve_name, "native batch");
+        s_profile_sign_latency(allocator, curve_name, "native", false);
+        s_profile_sign_latency(allocator, curve_name, "native nonce pool", true);
+        s_profile_key_latency(allocator, curve_name, "native", false);
+        s_profile_key_latency(allocator, curve_name, "native key pool", true);
+        s_profile_sign_scaling(allocator, curve_name, "native shared", false);
+        s_profile_sign_scaling(allocator, curve_name, "native replicas", true);
+        s_profile_ecdh(allocator, curve_name, "native", false, false);
+        s_profile_ecdh(allocator, curve_name, "native batch", true, false);
+        s_profile_ecdh(allocator, curve_name, "native prepared peers", false, true);
+        aws_ecc_set_provider(curve_name, default_provider);
+    }
+
+    fprintf(stdout, "\n");
+}
+
+int main(void) {
+    struct aws_allocator *allocator = aws_default_allocator();
+    aws_cal_library_init(allocator);
+
+    s_run_profiles(allocator, AWS_CAL_ECDSA_P256);
+    s_run_profiles(allocator, AWS_CAL_ECDSA_P384);
+
+    fprintf(stdout, "********************* Ed25519 *************************\n\n");
+    enum aws_ecc_provider default_provider = aws_ed25519_get_provider();
+    s_profile_ed25519(allocator, "default");
+    aws_ed25519_set_provider(AWS_ECC_PROVIDER_NATIVE);
+    s_profile_ed25519(allocator, "native");
+    aws_ed25519_set_provider(default_provider);
+
+    aws_cal_library_clean_up();
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/cal.h>
+#include <aws/cal/hmac.h>
+
+#include <aws/common/clock.h>
+#include <aws/common/device_random.h>
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+#    include <aws/cal/private/opensslcrypto_hmac.h>
+#endif
+
+#include <inttypes.h>
+
+#define ITERATIONS 100000
+
+static void s_profile_provider(
+    struct aws_allocator *allocator,
+    const char *name,
+    aws_hmac_new_fn *new_fn,
+    struct aws_byte_cursor secret,
+    struct aws_byte_cursor to_hmac) {
+
+    uint8_t output[AWS_SHA256_HMAC_LEN];
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+
+    for (size_t i = 0; i < ITERATIONS; ++i) {
+        struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output, sizeof(output));
+        struct aws_hmac *hmac = new_fn(allocator, &secret);
+        AWS_FATAL_ASSERT(hmac && "hmac creation failed");
+        AWS_FATAL_ASSERT(!aws_hmac_update(hmac, &to_hmac) && "hmac update failed");
+        AWS_FATAL_ASSERT(!aws_hmac_finalize(hmac, &output_buf, 0) && "hmac finalize failed");
+        aws_hmac_destroy(hmac);
+    }
+
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    fprintf(stdout, "%-24s %" PRIu64 "ns per hmac\n", name, (end - start) / ITERATIONS);
+}
+
+static void s_run_profiles(struct aws_allocator *allocator, size_t message_size) {
+    fprintf(stdout, "********************* HMAC-SHA256 %zu byte messages *************************\n\n", message_size);
+
+    struct aws_byte_buf message;
+    AWS_FATAL_ASSERT(!aws_byte_buf_init(&message, allocator, message_size) && "allocation of message failed");
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&message) && "reading random data failed");
+
+    struct aws_byte_cursor secret = aws_byte_cursor_from_c_str("hmac profile secret key");
+    struct aws_byte_cursor to_hmac = aws_byte_cursor_from_buf(&message);
+
+    s_profile_provider(allocator, "default", aws_sha256_hmac_new, secret, to_hmac);
+#if !defined(_WIN32) && !defined(__APPLE__)
+    s_profile_provider(allocator, "libcrypto HMAC_CTX", aws_sha256_hmac_libcrypto_legacy_new, secret, to_hmac);
+
+    struct aws_hmac *probe = aws_sha256_hmac_libcrypto_evp_mac_new(allocator, &secret);
+    if (probe) {
+        aws_hmac_destroy(probe);
+        s_profile_provider(allocator, "libcrypto EVP_MAC", aws_sha256_hmac_libcrypto_evp_mac_new, secret, to_hmac);
+    }
+#endif
+    s_profile_provider(allocator, "native", aws_sha256_hmac_native_new, secret, to_hmac);
+
+    fprintf(stdout, "\n");
+    aws_byte_buf_clean_up(&message);
+}
+
+int main(void) {
+    struct aws_allocator *allocator = aws_default_allocator();
+    aws_cal_library_init(allocator);
+
+    s_run_profiles(allocator, 32);
+    s_run_profiles(allocator, 256);
+    s_run_profiles(allocator, 4096);
+
+    aws_cal_library_clean_up();
+    return 0;
+}
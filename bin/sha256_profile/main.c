@@ -3,7 +3,9 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <aws/cal/cal.h>
 #include <aws/cal/hash.h>
+#include <aws/cal/hmac.h>
 
 #include <aws/common/clock.h>
 #include <aws/common/device_random.h>
@@ -106,8 +108,57 @@ static void s_run_profiles(struct aws_allocator *allocator, size_t to_hash_size,
     fprintf(stdout, "\n\n");
 }
 
+static void s_profile_hmac_batch(struct aws_allocator *allocator, size_t message_count, size_t message_size) {
+    fprintf(
+        stdout,
+        "********************* HMAC-SHA256 %zu messages of %zu bytes *******************\n\n",
+        message_count,
+        message_size);
+
+    struct aws_byte_buf message_data;
+    AWS_FATAL_ASSERT(!aws_byte_buf_init(&message_data, allocator, message_count * message_size));
+    AWS_FATAL_ASSERT(!aws_device_random_buffer(&message_data) && "reading random data failed");
+
+    struct aws_byte_cursor *messages = aws_mem_calloc(allocator, message_count, sizeof(struct aws_byte_cursor));
+    struct aws_byte_buf *outputs = aws_mem_calloc(allocator, message_count, sizeof(struct aws_byte_buf));
+    uint8_t *output_data = aws_mem_calloc(allocator, message_count, AWS_SHA256_HMAC_LEN);
+    AWS_FATAL_ASSERT(messages && outputs && output_data);
+
+    for (size_t i = 0; i < message_count; ++i) {
+        messages[i] = aws_byte_cursor_from_array(message_data.buffer + i * message_size, message_size);
+        outputs[i] = aws_byte_buf_from_empty_array(output_data + i * AWS_SHA256_HMAC_LEN, AWS_SHA256_HMAC_LEN);
+    }
+
+    struct aws_byte_cursor secret = aws_byte_cursor_from_c_str("sha256 profile hmac secret");
+
+    uint64_t start = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+    for (size_t i = 0; i < message_count; ++i) {
+        outputs[i].len = 0;
+        AWS_FATAL_ASSERT(!aws_sha256_hmac_compute(allocator, &secret, &messages[i], &outputs[i], 0));
+    }
+    uint64_t end = 0;
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    fprintf(stdout, "one at a time took %" PRIu64 "ns\n", end - start);
+
+    for (size_t i = 0; i < message_count; ++i) {
+        outputs[i].len = 0;
+    }
+
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&start) && "clock get ticks failed.");
+    AWS_FATAL_ASSERT(!aws_sha256_hmac_compute_batch(&secret, 1, messages, outputs, message_count, 0));
+    AWS_FATAL_ASSERT(!aws_high_res_clock_get_ticks(&end) && "clock get ticks failed");
+    fprintf(stdout, "batched took %" PRIu64 "ns\n\n", end - start);
+
+    aws_mem_release(allocator, output_data);
+    aws_mem_release(allocator, outputs);
+    aws_mem_release(allocator, messages);
+    aws_byte_buf_clean_up(&message_data);
+}
+
 int main(void) {
     struct aws_allocator *allocator = aws_default_allocator();
+    aws_cal_library_init(allocator);
 
     struct aws_hash *hash_impl = aws_sha256_new(allocator);
     fprintf(stdout, "Starting profile run for Sha256 using implementation %s\n\n", hash_impl->vtable->provider);
@@ -116,6 +167,10 @@ int main(void) {
     s_run_profiles(allocator, 1024 * 128, "128 KB");
     s_run_profiles(allocator, 1024 * 512, "512 KB");
 
+    s_profile_hmac_batch(allocator, 10000, 64);
+    s_profile_hmac_batch(allocator, 10000, 256);
+
     aws_hash_destroy(hash_impl);
+    aws_cal_library_clean_up();
     return 0;
 }
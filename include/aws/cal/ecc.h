@@ -15,7 +15,42 @@ enum aws_ecc_curve_name {
     AWS_CAL_ECDSA_P384,
 };
 
+/**
+ * Where key pairs get their curve arithmetic from. PLATFORM is the operating system's crypto library (libcrypto,
+ * Security.framework or BCrypt), NATIVE is aws-c-cal's own implementation of P-256 and P-384.
+ */
+enum aws_ecc_provider {
+    AWS_ECC_PROVIDER_PLATFORM,
+    AWS_ECC_PROVIDER_NATIVE,
+};
+
 struct aws_ecc_key_pair;
+struct aws_ecc_key_pool;
+struct aws_ecc_key_slot;
+struct aws_ecc_key_slot_reader;
+struct aws_ecc_signer;
+struct aws_ecc_verifier;
+struct aws_ecc_verify_workers;
+
+/**
+ * Sizing of a key's nonce pool, see aws_ecc_key_pair_enable_nonce_pool().
+ */
+struct aws_ecc_nonce_pool_options {
+    /* nonces kept ready */
+    size_t depth;
+    /* the worker tops the pool back up once no more than this many are left; less than depth */
+    size_t refill_threshold;
+};
+
+/**
+ * Sizing of a key pool, see aws_ecc_key_pool_new().
+ */
+struct aws_ecc_key_pool_options {
+    /* key pairs kept ready */
+    size_t depth;
+    /* the worker tops the pool back up once no more than this many are left; less than depth */
+    size_t refill_threshold;
+};
 
 typedef void aws_ecc_key_pair_destroy_fn(struct aws_ecc_key_pair *key_pair);
 typedef int aws_ecc_key_pair_sign_message_fn(
@@ -28,6 +63,28 @@ typedef int aws_ecc_key_pair_verify_signature_fn(
     const struct aws_byte_cursor *message,
     const struct aws_byte_cursor *signature);
 typedef size_t aws_ecc_key_pair_signature_length_fn(const struct aws_ecc_key_pair *signer);
+typedef int aws_ecc_key_pair_sign_message_batch_fn(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *messages,
+    size_t count,
+    struct aws_byte_buf *signatures);
+typedef int aws_ecc_key_pair_enable_nonce_pool_fn(
+    struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_nonce_pool_options *options);
+typedef int aws_ecc_key_pair_set_deterministic_signing_fn(struct aws_ecc_key_pair *key_pair, bool deterministic);
+typedef int aws_ecc_key_pair_materialize_public_key_fn(struct aws_ecc_key_pair *key_pair);
+typedef struct aws_ecc_key_pair *aws_ecc_key_pair_replicate_fn(
+    const struct aws_ecc_key_pair *key_pair,
+    struct aws_allocator *allocator);
+typedef int aws_ecc_key_pair_derive_shared_secret_fn(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *peer,
+    struct aws_byte_buf *shared_secret);
+typedef int aws_ecc_key_pair_derive_shared_secret_batch_fn(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *const *peers,
+    size_t count,
+    struct aws_byte_buf *shared_secrets);
 
 struct aws_ecc_key_pair_vtable {
     aws_ecc_key_pair_destroy_fn *destroy;
@@ -35,6 +92,23 @@ struct aws_ecc_key_pair_vtable {
     aws_ecc_key_pair_sign_message_fn *sign_message;
     aws_ecc_key_pair_verify_signature_fn *verify_signature;
     aws_ecc_key_pair_signature_length_fn *signature_length;
+    /* optional, providers without it sign batches one message at a time */
+    aws_ecc_key_pair_sign_message_batch_fn *sign_message_batch;
+    /* optional, providers without it don't support nonce pools */
+    aws_ecc_key_pair_enable_nonce_pool_fn *enable_nonce_pool;
+    /* optional, providers without it only sign with random nonces */
+    aws_ecc_key_pair_set_deterministic_signing_fn *set_deterministic_signing;
+    /* optional, providers without them go through DER */
+    aws_ecc_key_pair_sign_message_fn *sign_message_raw;
+    aws_ecc_key_pair_verify_signature_fn *verify_signature_raw;
+    /* optional, writes pub_x and pub_y of a key pair created with them deferred, does nothing for other key pairs */
+    aws_ecc_key_pair_materialize_public_key_fn *materialize_public_key;
+    /* optional, copies the key into new provider state; providers without it hand out the key pair itself */
+    aws_ecc_key_pair_replicate_fn *replicate;
+    /* optional, providers without it don't support ECDH */
+    aws_ecc_key_pair_derive_shared_secret_fn *derive_shared_secret;
+    /* optional, providers without it derive batches one peer at a time */
+    aws_ecc_key_pair_derive_shared_secret_batch_fn *derive_shared_secret_batch;
 };
 
 struct aws_ecc_key_pair {
@@ -47,10 +121,29 @@ struct aws_ecc_key_pair {
     struct aws_byte_buf priv_d;
     struct aws_ecc_key_pair_vtable *vtable;
     void *impl;
+    /*
+     * Everything from here on belongs to aws-c-cal, not to the provider: aws_ecc_key_pair_init() sets it up, so every
+     * provider, AWS_BYO_CRYPTO ones included, must build its key pairs with it.
+     */
+    /* struct aws_ec_native_table *, set by aws_ecc_key_pair_prepare_for_verification() */
+    struct aws_atomic_var verification_table;
 };
 
 AWS_EXTERN_C_BEGIN
 
+/**
+ * For providers: zeroes key_pair, the struct aws_ecc_key_pair embedded in the provider's key struct, sets its
+ * allocator, curve_name, vtable and impl, gives it a ref count of one and initializes the fields aws-c-cal keeps in
+ * it. Every key pair must go through this before it is handed out, including those of AWS_BYO_CRYPTO providers; the
+ * provider fills in key_buf, pub_x, pub_y and priv_d afterwards.
+ */
+AWS_CAL_API void aws_ecc_key_pair_init(
+    struct aws_ecc_key_pair *key_pair,
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_ecc_key_pair_vtable *vtable,
+    void *impl);
+
 /**
  * Adds one to an ecc key pair's ref count.
  */
@@ -61,6 +154,19 @@ AWS_CAL_API void aws_ecc_key_pair_acquire(struct aws_ecc_key_pair *key_pair);
  */
 AWS_CAL_API void aws_ecc_key_pair_release(struct aws_ecc_key_pair *key_pair);
 
+/**
+ * Creates a replica of key_pair for one thread to sign and verify with: the same key, with its own reference count
+ * and its own copy of the provider's key state, so threads sharing a hot key don't all contend on one ref count and
+ * on the platform library's per key locks. Signatures from a replica are the same as the key pair's, including
+ * deterministic ones. A verification table key_pair already has is shared, not rebuilt; a nonce pool is not. The
+ * replica is independent of key_pair afterwards and is released like any other key pair.
+ *
+ * Providers that keep no per key state worth copying hand out key_pair itself, with a reference acquired. Thread safe.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_replica(
+    struct aws_allocator *allocator,
+    struct aws_ecc_key_pair *key_pair);
+
 /**
  * Creates a Eliptic Curve private key that can be used for signing.
  * Returns a new instance of aws_ecc_key_pair if the key was successfully built.
@@ -81,6 +187,18 @@ AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key(
 AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random(
     struct aws_allocator *allocator,
     enum aws_ecc_curve_name curve_name);
+
+/**
+ * aws_ecc_key_pair_new_generate_random() for ephemeral key pairs that may only ever sign: the public key is left for
+ * aws_ecc_key_pair_materialize_public_key() to write, so a key pair nobody reads it from skips the native provider's
+ * public point multiplication, or libcrypto's conversion of the point to coordinates. Until then the key pair has
+ * empty pub_x and pub_y and signs as usual, but verifying, exporting the public key, preparing for verification and
+ * ECDH with it as the peer may fail with AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT. Providers with nothing to
+ * defer return a complete key pair.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_deferred(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name);
 #endif /* !AWS_OS_IOS */
 
 /**
@@ -95,6 +213,19 @@ AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key(
     const struct aws_byte_cursor *public_key_x,
     const struct aws_byte_cursor *public_key_y);
 
+/**
+ * Creates a public key from its SEC1 encoding: 0x04 || x || y uncompressed, or 0x02 or 0x03 (for an even or odd y)
+ * followed by x compressed, with each coordinate exactly aws_ecc_key_coordinate_byte_size_from_curve_name() bytes.
+ * Compressed points get their y from a constant time square root specialized for each curve, cheap enough next to
+ * parsing the key to decompress on every load. The key pair comes from curve_name's provider, as with
+ * aws_ecc_key_pair_new_from_public_key(). Raises AWS_ERROR_INVALID_ARGUMENT for any other length or prefix, or for a
+ * point that is not on the curve.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_sec1_public_key(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *encoded);
+
 /**
  * Creates a Eliptic Curve public/private key pair from a DER encoded key pair.
  * Returns a new instance of aws_ecc_key_pair if the key was successfully built.
@@ -119,6 +250,7 @@ AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_new_from_hex_coordinates(
 /**
  * Derives a public key from the private key if supported by this operating system (not supported on OSX).
  * key_pair::pub_x and key_pair::pub_y will be set with the raw key buffers.
+ * This changes the key pair, so call it before sharing the key pair with other threads.
  */
 AWS_CAL_API int aws_ecc_key_pair_derive_public_key(struct aws_ecc_key_pair *key_pair);
 
@@ -146,6 +278,48 @@ AWS_CAL_API int aws_ecc_key_pair_sign_message(
     const struct aws_byte_cursor *message,
     struct aws_byte_buf *signature);
 
+/**
+ * aws_ecc_key_pair_sign_message() of messages[i] into signatures[i] for each of the count messages. Native provider
+ * keys share the nonce inversions across the batch, which makes bulk signing cheaper per signature; other keys sign
+ * one message at a time. Raises AWS_ERROR_SHORT_BUFFER before signing anything if a buffer is too small for
+ * aws_ecc_key_pair_signature_length(); if signing fails part way, the signatures before the failing one have already
+ * been appended.
+ */
+AWS_CAL_API int aws_ecc_key_pair_sign_message_batch(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *messages,
+    size_t count,
+    struct aws_byte_buf *signatures);
+
+/**
+ * Starts a worker thread that computes signing nonces for key_pair ahead of time, the scalar multiplication and
+ * inversions that make up most of signing, so that aws_ecc_key_pair_sign_message() only has to do the message
+ * dependent multiply-add. The worker keeps up to options->depth nonces ready and tops the pool up once no more than
+ * options->refill_threshold are left; a signer that finds the pool empty makes its own nonce as usual. Each nonce is
+ * used for exactly one signature. The worker stops when the key pair is destroyed.
+ *
+ * Only the native provider supports nonce pools; others raise AWS_ERROR_UNSUPPORTED_OPERATION. Raises
+ * AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT for key pairs without a private key, AWS_ERROR_INVALID_ARGUMENT unless
+ * 0 <= refill_threshold < depth and AWS_ERROR_INVALID_STATE if the key pair already has a pool. Call it before
+ * sharing the key pair with other threads.
+ */
+AWS_CAL_API int aws_ecc_key_pair_enable_nonce_pool(
+    struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_nonce_pool_options *options);
+
+/**
+ * Switches key_pair between random signing nonces, the default, and RFC 6979 deterministic nonces derived from the
+ * private key and the message with HMAC-SHA256. A deterministic key pair never touches the system RNG to sign and
+ * always produces the same signature for the same message, which also makes signatures reproducible in tests. The
+ * HMAC state that only depends on the private key is computed here, once. While deterministic signing is on, a nonce
+ * pool is not used.
+ *
+ * Only the native provider supports deterministic signing; others raise AWS_ERROR_UNSUPPORTED_OPERATION. Raises
+ * AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT for key pairs without a private key. Call it before sharing the key
+ * pair with other threads.
+ */
+AWS_CAL_API int aws_ecc_key_pair_set_deterministic_signing(struct aws_ecc_key_pair *key_pair, bool deterministic);
+
 /**
  * Uses the key_pair's public key to verify signature of message. Signature should be DER
  * encoded.
@@ -161,6 +335,207 @@ AWS_CAL_API int aws_ecc_key_pair_verify_signature(
     const struct aws_byte_cursor *signature);
 AWS_CAL_API size_t aws_ecc_key_pair_signature_length(const struct aws_ecc_key_pair *key_pair);
 
+/**
+ * Length of a raw signature on curve_name: r || s, each big endian and exactly the curve's coordinate size, as JWS
+ * and SigV4a put them on the wire. 64 bytes for P-256 and 96 for P-384.
+ */
+AWS_CAL_API size_t aws_ecc_raw_signature_length(enum aws_ecc_curve_name curve_name);
+
+/**
+ * aws_ecc_key_pair_sign_message(), but appends the signature in the raw r || s form, always
+ * aws_ecc_raw_signature_length() bytes. The native provider writes it directly; others sign to DER on the stack and
+ * convert it. Nothing is allocated. Raises AWS_ERROR_SHORT_BUFFER if signature has no room for it.
+ */
+AWS_CAL_API int aws_ecc_key_pair_sign_message_raw(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *message,
+    struct aws_byte_buf *signature);
+
+/**
+ * aws_ecc_key_pair_verify_signature() of a raw r || s signature. Raises AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED if
+ * it is not exactly aws_ecc_raw_signature_length() bytes. Nothing is allocated.
+ */
+AWS_CAL_API int aws_ecc_key_pair_verify_signature_raw(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *message,
+    const struct aws_byte_cursor *signature);
+
+/**
+ * Converts count DER signatures on curve_name to raw r || s, appending der_signatures[i]'s to raw_signatures[i].
+ * Raises AWS_ERROR_SHORT_BUFFER before converting anything if an output has no room for
+ * aws_ecc_raw_signature_length() bytes, and AWS_ERROR_CAL_MALFORMED_ASN1_ENCOUNTERED for a signature that isn't strict
+ * DER or whose values don't fit the curve, in which case the ones before it have already been converted. Nothing is
+ * allocated.
+ */
+AWS_CAL_API int aws_ecc_signatures_der_to_raw(
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *der_signatures,
+    size_t count,
+    struct aws_byte_buf *raw_signatures);
+
+/**
+ * Converts count raw r || s signatures on curve_name to DER, appending raw_signatures[i]'s to der_signatures[i].
+ * Raises AWS_ERROR_INVALID_ARGUMENT if an input isn't exactly aws_ecc_raw_signature_length() bytes and
+ * AWS_ERROR_SHORT_BUFFER if an output has less room than the longest DER signature on the curve, both before
+ * converting anything. Nothing is allocated.
+ */
+AWS_CAL_API int aws_ecc_signatures_raw_to_der(
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *raw_signatures,
+    size_t count,
+    struct aws_byte_buf *der_signatures);
+
+/**
+ * Precomputes multiples of key_pair's public key so that every later aws_ecc_key_pair_verify_signature() call on it
+ * skips the doublings of a full scalar multiplication. Worth it for keys that verify many signatures, e.g. a
+ * service's trusted signers; the table costs 52KiB for P-256 and 116KiB for P-384 and lives as long as the key pair.
+ *
+ * Thread safe and idempotent. Fails with AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT if the key pair has no public
+ * key (derive it first).
+ */
+AWS_CAL_API int aws_ecc_key_pair_prepare_for_verification(struct aws_ecc_key_pair *key_pair);
+
+/**
+ * Starts the threads aws_ecc_verify_batch() spreads its work over: thread_count threads in all, counting the thread
+ * that calls aws_ecc_verify_batch(), so thread_count - 1 are started here; 0 means one per processor. They sleep
+ * between batches, so batches don't pay for creating and joining threads. Keep one set for the life of the service.
+ * Returns NULL if a thread cannot be started.
+ */
+AWS_CAL_API struct aws_ecc_verify_workers *aws_ecc_verify_workers_new(
+    struct aws_allocator *allocator,
+    size_t thread_count);
+
+/**
+ * Stops and joins the threads. No batch may be running on workers.
+ */
+AWS_CAL_API void aws_ecc_verify_workers_destroy(struct aws_ecc_verify_workers *workers);
+
+/**
+ * Verifies count signatures, signatures[i] over messages[i] with keys[i], spread over workers' threads and the calling
+ * thread; with NULL workers the calling thread does it all. Signatures are grouped by key so each key's verification
+ * state is reused by one thread: a key prepared with aws_ecc_key_pair_prepare_for_verification() uses its table, and
+ * keys with enough signatures in the batch get a table built just for the batch. Batches on the same workers from
+ * different threads run one after the other.
+ *
+ * results[i] is set to AWS_ERROR_SUCCESS if signatures[i] is valid, else to the error its verification raised. Returns
+ * AWS_OP_SUCCESS if every signature is valid, raises AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED if any is not, and
+ * fails without touching results if the batch's bookkeeping cannot be allocated. keys may repeat and must stay alive
+ * for the duration of the call.
+ */
+AWS_CAL_API int aws_ecc_verify_batch(
+    struct aws_allocator *allocator,
+    struct aws_ecc_key_pair *const *keys,
+    const struct aws_byte_cursor *messages,
+    const struct aws_byte_cursor *signatures,
+    size_t count,
+    struct aws_ecc_verify_workers *workers,
+    int *results);
+
+/**
+ * ECDH key agreement: appends the shared secret of key_pair's private key and peer's public key to shared_secret, the
+ * x coordinate of the shared point, big endian and exactly aws_ecc_key_coordinate_byte_size_from_curve_name() bytes.
+ * Feed it to a KDF rather than using it as a key directly. peer may come from any provider, or be a public key only
+ * key pair; a peer prepared with aws_ecc_key_pair_prepare_for_verification() lets the native provider use its table.
+ * The native provider computes the secret in constant time.
+ *
+ * Raises AWS_ERROR_INVALID_ARGUMENT if the key pairs are on different curves, AWS_ERROR_SHORT_BUFFER if shared_secret
+ * has no room for the secret, AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT if key_pair has no private key or peer no
+ * public key, and AWS_ERROR_UNSUPPORTED_OPERATION for providers without ECDH. Thread safe.
+ */
+AWS_CAL_API int aws_ecc_key_pair_derive_shared_secret(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *peer,
+    struct aws_byte_buf *shared_secret);
+
+/**
+ * aws_ecc_key_pair_derive_shared_secret() with each of the count peers into shared_secrets[i], for services that
+ * agree on many secrets with one static key. The native provider recodes the private key once and has the shared
+ * points of each block of peers share a single inversion; other providers derive one peer at a time. Everything is
+ * checked before anything is derived; if deriving fails part way, the secrets before the failing one have already been
+ * appended.
+ */
+AWS_CAL_API int aws_ecc_key_pair_derive_shared_secret_batch(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *const *peers,
+    size_t count,
+    struct aws_byte_buf *shared_secrets);
+
+/**
+ * Creates a signer that hashes a message with SHA-256 as it is fed in with aws_ecc_signer_update() and signs the
+ * digest with key_pair on aws_ecc_signer_finalize(). The hash state lives inside the signer, so large payloads are
+ * signed in one pass without an intermediate digest buffer or a hash object per message. The signer holds a reference
+ * to key_pair and can be reused: finalizing starts the next message.
+ */
+AWS_CAL_API struct aws_ecc_signer *aws_ecc_signer_new(
+    struct aws_allocator *allocator,
+    struct aws_ecc_key_pair *key_pair);
+
+/**
+ * Cleans up and deallocates signer.
+ */
+AWS_CAL_API void aws_ecc_signer_destroy(struct aws_ecc_signer *signer);
+
+/**
+ * Hashes the next part of the message. This can be called multiple times.
+ */
+AWS_CAL_API int aws_ecc_signer_update(struct aws_ecc_signer *signer, const struct aws_byte_cursor *data);
+
+/**
+ * Appends the DER signature of the message fed in since the signer was created or last finalized to signature, as
+ * aws_ecc_key_pair_sign_message() of its SHA-256 digest would, then starts over for the next message, whether
+ * signing succeeded or not.
+ */
+AWS_CAL_API int aws_ecc_signer_finalize(struct aws_ecc_signer *signer, struct aws_byte_buf *signature);
+
+/**
+ * aws_ecc_signer_finalize(), but appends the raw r || s signature, as aws_ecc_key_pair_sign_message_raw() would.
+ */
+AWS_CAL_API int aws_ecc_signer_finalize_raw(struct aws_ecc_signer *signer, struct aws_byte_buf *signature);
+
+/**
+ * Creates a verifier that hashes a message with SHA-256 as it is fed in with aws_ecc_verifier_update() and checks a
+ * signature of the digest against key_pair on aws_ecc_verifier_finalize(). Like aws_ecc_signer_new(), the verifier
+ * holds a reference to key_pair and can be reused.
+ */
+AWS_CAL_API struct aws_ecc_verifier *aws_ecc_verifier_new(
+    struct aws_allocator *allocator,
+    struct aws_ecc_key_pair *key_pair);
+
+/**
+ * Cleans up and deallocates verifier.
+ */
+AWS_CAL_API void aws_ecc_verifier_destroy(struct aws_ecc_verifier *verifier);
+
+/**
+ * Hashes the next part of the message. This can be called multiple times.
+ */
+AWS_CAL_API int aws_ecc_verifier_update(struct aws_ecc_verifier *verifier, const struct aws_byte_cursor *data);
+
+/**
+ * Verifies the DER signature against the message fed in since the verifier was created or last finalized, as
+ * aws_ecc_key_pair_verify_signature() of its SHA-256 digest would, then starts over for the next message, whether the
+ * signature was valid or not. Returns AWS_OP_SUCCESS if the signature is valid.
+ */
+AWS_CAL_API int aws_ecc_verifier_finalize(struct aws_ecc_verifier *verifier, const struct aws_byte_cursor *signature);
+
+/**
+ * aws_ecc_verifier_finalize() of a raw r || s signature, as aws_ecc_key_pair_verify_signature_raw() would.
+ */
+AWS_CAL_API int aws_ecc_verifier_finalize_raw(
+    struct aws_ecc_verifier *verifier,
+    const struct aws_byte_cursor *signature);
+
+/**
+ * Writes the public coordinates of a key pair from aws_ecc_key_pair_new_generate_random_deferred(); does nothing for
+ * other key pairs, or if they are already written. This changes the key pair, so call it before sharing the key pair
+ * with other threads.
+ */
+AWS_CAL_API int aws_ecc_key_pair_materialize_public_key(struct aws_ecc_key_pair *key_pair);
+
+/**
+ * Points pub_x and pub_y at key_pair's public coordinates. Both cursors are empty if the key pair has no public key,
+ * or has it deferred (see aws_ecc_key_pair_materialize_public_key()).
+ */
 AWS_CAL_API void aws_ecc_key_pair_get_public_key(
     const struct aws_ecc_key_pair *key_pair,
     struct aws_byte_cursor *pub_x,
@@ -172,6 +547,126 @@ AWS_CAL_API void aws_ecc_key_pair_get_private_key(
 
 AWS_CAL_API size_t aws_ecc_key_coordinate_byte_size_from_curve_name(enum aws_ecc_curve_name curve_name);
 
+/**
+ * Length of a SEC1 encoded public key on curve_name: 33 or 49 bytes compressed, 65 or 97 uncompressed.
+ */
+AWS_CAL_API size_t aws_ecc_sec1_public_key_length(enum aws_ecc_curve_name curve_name, bool compressed);
+
+/**
+ * Appends key_pair's public key to out in SEC1 form, compressed (the x coordinate and y's parity, half the size) or
+ * uncompressed. Raises AWS_ERROR_SHORT_BUFFER if out has no room for aws_ecc_sec1_public_key_length() bytes, and
+ * AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT if the key pair has no public key.
+ */
+AWS_CAL_API int aws_ecc_key_pair_write_sec1_public_key(
+    const struct aws_ecc_key_pair *key_pair,
+    bool compressed,
+    struct aws_byte_buf *out);
+
+/**
+ * Selects the provider key pairs on curve_name are created with from now on; existing key pairs keep theirs, and key
+ * pairs from different providers interoperate through their encodings as usual. The native provider signs in constant
+ * time with fixed-base tables for the generator and verifies with a width 5 NAF of the public key, without going
+ * through the platform's generic big number code.
+ *
+ * The platform provider is the default for every curve; the native one is opt-in. In AWS_BYO_CRYPTO builds the
+ * platform provider is the application's, and so are aws_ecc_key_pair_new_from_private_key(),
+ * aws_ecc_key_pair_new_generate_random(), aws_ecc_key_pair_new_from_public_key() and aws_ecc_key_pair_new_from_asn1():
+ * aws-c-cal doesn't define them there. Selecting the native provider then only takes effect in the application's
+ * constructors if they check aws_ecc_get_provider() and call the native ones in aws/cal/private/ecc.h, and in the
+ * key pools, which call the native provider themselves.
+ *
+ * Raises AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM if the provider does not implement curve_name. Meant to be called at
+ * startup: not thread safe with respect to concurrent key creation.
+ */
+AWS_CAL_API int aws_ecc_set_provider(enum aws_ecc_curve_name curve_name, enum aws_ecc_provider provider);
+
+/**
+ * Returns the provider new key pairs on curve_name will be created with.
+ */
+AWS_CAL_API enum aws_ecc_provider aws_ecc_get_provider(enum aws_ecc_curve_name curve_name);
+
+/**
+ * Creates a slot that publishes the current key pair, e.g. a service's signing key, to any number of threads and lets
+ * it be replaced at any time without readers taking a lock or touching the key pair's reference count. A replaced key
+ * pair is released once every reader that could still be using it has finished its read. key_pair may be NULL; the
+ * slot takes a reference to it otherwise.
+ */
+AWS_CAL_API struct aws_ecc_key_slot *aws_ecc_key_slot_new(
+    struct aws_allocator *allocator,
+    struct aws_ecc_key_pair *key_pair);
+
+/**
+ * Releases the current key pair and any replaced ones still held back. All readers must have been destroyed.
+ */
+AWS_CAL_API void aws_ecc_key_slot_destroy(struct aws_ecc_key_slot *slot);
+
+/**
+ * Makes key_pair, which may be NULL, the slot's current key pair; the slot takes a reference to it. Readers that begin
+ * a read afterwards get key_pair, readers already inside a read keep the one they have. The replaced key pair is
+ * released as soon as no reader can still be using it, here or on a later publish, reclaim or reader destruction.
+ * Thread safe; publishers serialize on a lock readers never take.
+ */
+AWS_CAL_API int aws_ecc_key_slot_publish(struct aws_ecc_key_slot *slot, struct aws_ecc_key_pair *key_pair);
+
+/**
+ * Releases the replaced key pairs that no reader can still be using. Publishing does this too; call it to let go of
+ * an old key pair sooner when there is no next key to publish.
+ */
+AWS_CAL_API void aws_ecc_key_slot_reclaim(struct aws_ecc_key_slot *slot);
+
+/**
+ * Registers a reader of slot. Readers are meant to be per thread, created once and used for every read; a reader is
+ * not thread safe. Registering and destroying readers takes the slot's lock.
+ */
+AWS_CAL_API struct aws_ecc_key_slot_reader *aws_ecc_key_slot_reader_new(struct aws_ecc_key_slot *slot);
+
+/**
+ * Unregisters and frees reader, which must be outside a read.
+ */
+AWS_CAL_API void aws_ecc_key_slot_reader_destroy(struct aws_ecc_key_slot_reader *reader);
+
+/**
+ * Begins a read and returns the slot's current key pair, which stays valid until aws_ecc_key_slot_read_end() without
+ * a reference being taken: wait free, two stores and two loads. Sign, verify or read the key pair's components as
+ * usual, but don't release it; acquire a reference to keep it past the end of the read. Reads don't nest, and keeping
+ * a read open holds back the release of every key pair replaced in the meantime.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_slot_read_begin(struct aws_ecc_key_slot_reader *reader);
+
+/**
+ * Ends the read aws_ecc_key_slot_read_begin() started.
+ */
+AWS_CAL_API void aws_ecc_key_slot_read_end(struct aws_ecc_key_slot_reader *reader);
+
+#if !defined(AWS_OS_IOS)
+/**
+ * Starts a worker thread that generates key pairs on curve_name ahead of time, for flows such as ECDH handshakes that
+ * need a fresh single use key pair on the request path. The worker keeps up to options->depth key pairs ready and
+ * tops the pool up once no more than options->refill_threshold are left. Key pairs come from the curve's provider at
+ * the time the pool is created; the native provider generates them in batches that share the conversion of their
+ * public points to coordinates. Pooled key pairs have their public coordinates written.
+ *
+ * Raises AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM for curves the provider does not implement, and
+ * AWS_ERROR_INVALID_ARGUMENT unless 0 <= refill_threshold < depth.
+ */
+AWS_CAL_API struct aws_ecc_key_pool *aws_ecc_key_pool_new(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_ecc_key_pool_options *options);
+
+/**
+ * Stops the worker and releases the key pairs it had made. Key pairs already taken are unaffected.
+ */
+AWS_CAL_API void aws_ecc_key_pool_destroy(struct aws_ecc_key_pool *pool);
+
+/**
+ * Hands out a ready key pair, which the caller owns and releases as usual. Thread safe and lock free: takers never
+ * wait on each other or on the worker. If the pool has run dry the key pair is generated on the spot, as
+ * aws_ecc_key_pair_new_generate_random() would. Returns NULL only if that fails.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pool_take(struct aws_ecc_key_pool *pool);
+#endif /* !AWS_OS_IOS */
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_CAL_ECC_H */
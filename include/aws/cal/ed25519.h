@@ -0,0 +1,124 @@
+#ifndef AWS_CAL_ED25519_H
+#define AWS_CAL_ED25519_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/ecc.h>
+
+#define AWS_ED25519_PUBLIC_KEY_LEN 32
+#define AWS_ED25519_PRIVATE_KEY_LEN 32
+#define AWS_ED25519_SIGNATURE_LEN 64
+
+/**
+ * An Ed25519 (RFC 8032) key pair. Its own type rather than another aws_ecc_curve_name: Ed25519 keys are 32 byte
+ * strings rather than coordinates, its signatures are a fixed 64 bytes rather than DER, and it signs messages
+ * rather than digests, so none of the ECDSA entry points would apply to it.
+ */
+struct aws_ed25519_key_pair;
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Selects the provider Ed25519 key pairs are created with from now on; existing key pairs keep theirs. PLATFORM is
+ * libcrypto's Ed25519, where it has one, NATIVE is aws-c-cal's own. Key pairs from either provider verify each other's
+ * signatures, and signatures are deterministic, so both sign a message the same way. Raises
+ * AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM for PLATFORM when the platform has no Ed25519. Not thread safe, call it at
+ * startup.
+ */
+AWS_CAL_API int aws_ed25519_set_provider(enum aws_ecc_provider provider);
+
+/**
+ * The provider new Ed25519 key pairs come from: PLATFORM by default where the platform supports Ed25519, NATIVE
+ * otherwise.
+ */
+AWS_CAL_API enum aws_ecc_provider aws_ed25519_get_provider(void);
+
+/**
+ * Creates a key pair from a AWS_ED25519_PRIVATE_KEY_LEN byte private key, the seed of RFC 8032, and computes its
+ * public key. Returns NULL and raises AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM for any other length.
+ */
+AWS_CAL_API struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_private_key(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *private_key);
+
+/**
+ * Creates a key pair from a random private key.
+ */
+AWS_CAL_API struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_generate_random(struct aws_allocator *allocator);
+
+/**
+ * Creates a key pair for verifying from a AWS_ED25519_PUBLIC_KEY_LEN byte public key. Returns NULL and raises
+ * AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM for any other length, and AWS_ERROR_INVALID_ARGUMENT if it doesn't
+ * encode a point on the curve.
+ */
+AWS_CAL_API struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_public_key(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *public_key);
+
+/**
+ * Adds one to an Ed25519 key pair's ref count.
+ */
+AWS_CAL_API void aws_ed25519_key_pair_acquire(struct aws_ed25519_key_pair *key_pair);
+
+/**
+ * Subtracts one from an Ed25519 key pair's ref count. If ref count reaches zero, the key pair is destroyed.
+ */
+AWS_CAL_API void aws_ed25519_key_pair_release(struct aws_ed25519_key_pair *key_pair);
+
+/**
+ * Points public_key at the key pair's AWS_ED25519_PUBLIC_KEY_LEN byte public key.
+ */
+AWS_CAL_API void aws_ed25519_key_pair_get_public_key(
+    const struct aws_ed25519_key_pair *key_pair,
+    struct aws_byte_cursor *public_key);
+
+/**
+ * Points private_key at the key pair's private key; empty for key pairs made from a public key.
+ */
+AWS_CAL_API void aws_ed25519_key_pair_get_private_key(
+    const struct aws_ed25519_key_pair *key_pair,
+    struct aws_byte_cursor *private_key);
+
+/**
+ * Appends the AWS_ED25519_SIGNATURE_LEN byte signature of message (the message itself, not a digest: Ed25519 hashes
+ * it with SHA512 twice as part of signing). Raises AWS_ERROR_SHORT_BUFFER if signature has no room for it, and
+ * AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT for key pairs without a private key. Thread safe.
+ */
+AWS_CAL_API int aws_ed25519_key_pair_sign_message(
+    const struct aws_ed25519_key_pair *key_pair,
+    const struct aws_byte_cursor *message,
+    struct aws_byte_buf *signature);
+
+/**
+ * Verifies signature over message. Raises AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED if it is not a valid signature,
+ * including non-canonical ones. Thread safe.
+ */
+AWS_CAL_API int aws_ed25519_key_pair_verify_signature(
+    const struct aws_ed25519_key_pair *key_pair,
+    const struct aws_byte_cursor *message,
+    const struct aws_byte_cursor *signature);
+
+/**
+ * Verifies count signatures, signatures[i] over messages[i] with keys[i], as one random linear combination checked
+ * with a single multi-scalar multiplication, which shares the doublings of every signature in a block and merges the
+ * terms of signatures by the same key. This uses the native implementation for keys from either provider. When the
+ * combination of a block fails, each of its signatures is verified on its own to find the bad ones. The combination
+ * is the cofactored equation RFC 8032 allows, so a signature crafted with small order components can pass here and
+ * fail aws_ed25519_key_pair_verify_signature(); signatures from honest signers get the same answer from both.
+ *
+ * results[i] is set to AWS_ERROR_SUCCESS if signatures[i] is valid, else to the error its verification raised. Returns
+ * AWS_OP_SUCCESS if every signature is valid, raises AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED if any is not, and
+ * fails without touching results if the batch's scratch space cannot be allocated. keys may repeat.
+ */
+AWS_CAL_API int aws_ed25519_verify_batch(
+    struct aws_allocator *allocator,
+    struct aws_ed25519_key_pair *const *keys,
+    const struct aws_byte_cursor *messages,
+    const struct aws_byte_cursor *signatures,
+    size_t count,
+    int *results);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_CAL_ED25519_H */
@@ -84,6 +84,24 @@ AWS_CAL_API int aws_sha256_compute(
     struct aws_byte_buf *output,
     size_t truncate_to);
 
+/**
+ * Compares two digests (or MACs, signatures, or any other secret-dependent byte strings) in time that depends only
+ * on their lengths, never on their contents. Returns true if they have the same length and the same bytes.
+ * Comparison runs eight bytes at a time and has no data-dependent branches, so compilers are free to vectorize it.
+ */
+AWS_CAL_API bool aws_cal_digest_equals(const struct aws_byte_cursor *a, const struct aws_byte_cursor *b);
+
+/**
+ * Compares a[i] to b[i] for each of the count pairs with aws_cal_digest_equals(). If results is not NULL, results[i]
+ * is set to the outcome for pair i. Returns true only if every pair matched. Every pair is always compared, so the
+ * time taken does not reveal which pair, if any, differed.
+ */
+AWS_CAL_API bool aws_cal_digest_equals_batch(
+    const struct aws_byte_cursor *a,
+    const struct aws_byte_cursor *b,
+    size_t count,
+    bool *results);
+
 /**
  * Set the implementation of md5 to use. If you compiled without AWS_BYO_CRYPTO,
  * you do not need to call this. However, if use this, we will honor it,
@@ -38,6 +38,18 @@ AWS_EXTERN_C_BEGIN
  */
 AWS_CAL_API struct aws_hmac *aws_sha256_hmac_new(struct aws_allocator *allocator, const struct aws_byte_cursor *secret);
 
+/**
+ * Allocates and initializes a sha256 hmac instance backed by aws-c-cal's own SHA256 implementation instead of the
+ * platform's. The whole instance is a single fixed-size allocation of roughly 200 bytes and setting it up costs two
+ * SHA256 block compressions, which makes it much cheaper than the platform implementations for short messages.
+ * It is available in every build, including AWS_BYO_CRYPTO. To make aws_sha256_hmac_new() use it, call
+ * aws_set_sha256_hmac_new_fn(aws_sha256_hmac_native_new). It is not the default: aws_sha256_hmac_new() keeps using
+ * the platform library so that applications built against a validated crypto module keep every HMAC inside it.
+ */
+AWS_CAL_API struct aws_hmac *aws_sha256_hmac_native_new(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *secret);
+
 /**
  * Cleans up and deallocates hmac.
  */
@@ -56,6 +68,14 @@ AWS_CAL_API int aws_hmac_update(struct aws_hmac *hmac, const struct aws_byte_cur
  * to 0.
  */
 AWS_CAL_API int aws_hmac_finalize(struct aws_hmac *hmac, struct aws_byte_buf *output, size_t truncate_to);
+/**
+ * Completes the hmac computation and compares the result against expected in constant time. expected may be a
+ * truncated MAC, in which case only its first expected->len bytes are compared; it must not be empty or longer
+ * than the digest size. Returns AWS_OP_SUCCESS if the MAC matches. Otherwise raises
+ * AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED and returns AWS_OP_ERR. Like aws_hmac_finalize(), this ends the hmac
+ * computation. The computed MAC only ever sits in a stack buffer, which is wiped before this returns.
+ */
+AWS_CAL_API int aws_hmac_verify(struct aws_hmac *hmac, const struct aws_byte_cursor *expected);
 /**
  * Computes the sha256 hmac over input and writes the digest output to 'output'.
  * Use this if you don't need to stream the data you're hashing and you can load
@@ -70,6 +90,23 @@ AWS_CAL_API int aws_sha256_hmac_compute(
     const struct aws_byte_cursor *to_hmac,
     struct aws_byte_buf *output,
     size_t truncate_to);
+/**
+ * Computes the sha256 hmac of each of the count buffers in to_hmac and appends the digest to the matching entry of
+ * outputs. secret_count must be either 1, in which case every message is signed with secrets[0], or count, in which
+ * case message i is signed with secrets[i]. truncate_to behaves as it does for aws_sha256_hmac_compute().
+ *
+ * Messages are processed several at a time through a multi-lane SHA256 kernel (AVX2 when the CPU supports it), so
+ * this is considerably faster than calling aws_sha256_hmac_compute() in a loop for many short messages. It does not
+ * allocate and does not go through the function set by aws_set_sha256_hmac_new_fn(). Every output is checked for
+ * capacity before any work is done; on failure no output is modified.
+ */
+AWS_CAL_API int aws_sha256_hmac_compute_batch(
+    const struct aws_byte_cursor *secrets,
+    size_t secret_count,
+    const struct aws_byte_cursor *to_hmac,
+    struct aws_byte_buf *outputs,
+    size_t count,
+    size_t truncate_to);
 /**
  * Set the implementation of sha256 hmac to use. If you compiled without
  * AWS_BYO_CRYPTO, you do not need to call this. However, if use this, we will
@@ -0,0 +1,61 @@
+#ifndef AWS_CAL_KDF_H_
+#define AWS_CAL_KDF_H_
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/exports.h>
+
+#include <aws/common/byte_buf.h>
+#include <aws/common/common.h>
+
+/* RFC 5869 caps HKDF output at 255 blocks of the underlying hash. */
+#define AWS_HKDF_SHA256_MAX_OUTPUT_LEN (255 * 32)
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * HKDF-Extract (RFC 5869) using HMAC-SHA256. Writes the 32 byte pseudorandom key to the end of prk.
+ * An empty salt is treated as 32 zero bytes, as specified by the RFC.
+ */
+AWS_CAL_API int aws_hkdf_sha256_extract(
+    const struct aws_byte_cursor *salt,
+    const struct aws_byte_cursor *ikm,
+    struct aws_byte_buf *prk);
+
+/**
+ * HKDF-Expand (RFC 5869) using HMAC-SHA256. Writes length bytes of keying material to the end of output.
+ * length may not exceed AWS_HKDF_SHA256_MAX_OUTPUT_LEN, and output must have room for it. This function does
+ * not allocate: the key midstate is computed once and every output block is produced directly into output.
+ */
+AWS_CAL_API int aws_hkdf_sha256_expand(
+    const struct aws_byte_cursor *prk,
+    const struct aws_byte_cursor *info,
+    struct aws_byte_buf *output,
+    size_t length);
+
+/**
+ * HKDF-Extract followed by HKDF-Expand. Writes length bytes of keying material to the end of output.
+ */
+AWS_CAL_API int aws_hkdf_sha256_derive(
+    const struct aws_byte_cursor *salt,
+    const struct aws_byte_cursor *ikm,
+    const struct aws_byte_cursor *info,
+    struct aws_byte_buf *output,
+    size_t length);
+
+/**
+ * NIST SP 800-108 KDF in counter mode with HMAC-SHA256 as the PRF. Each block is computed as
+ * PRF(key, [i]_32 || label || 0x00 || context || [L]_32), where i starts at 1 and L is the output length in bits.
+ * Writes length bytes of keying material to the end of output. This function does not allocate.
+ */
+AWS_CAL_API int aws_sp800_108_counter_kdf_hmac_sha256(
+    const struct aws_byte_cursor *key,
+    const struct aws_byte_cursor *label,
+    const struct aws_byte_cursor *context,
+    struct aws_byte_buf *output,
+    size_t length);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_CAL_KDF_H_ */
@@ -13,6 +13,9 @@
 struct aws_der_encoder;
 struct aws_der_decoder;
 
+/* Largest scalar the ECDSA signature helpers handle, that of P-521. */
+#define AWS_DER_ECDSA_MAX_ELEMENT_SIZE 66
+
 enum aws_der_type {
     /* Primitives */
     AWS_DER_BOOLEAN = 0x01,
@@ -213,6 +216,58 @@ AWS_CAL_API int aws_der_decoder_tlv_boolean(struct aws_der_decoder *decoder, boo
  */
 AWS_CAL_API int aws_der_decoder_tlv_blob(struct aws_der_decoder *decoder, struct aws_byte_cursor *blob);
 
+/**
+ * Largest ECDSA-Sig-Value (SEQUENCE { r INTEGER, s INTEGER }) for scalars of element_size bytes
+ * @param element_size The size in bytes of the curve's order, at most AWS_DER_ECDSA_MAX_ELEMENT_SIZE
+ * @return The encoded length in bytes
+ */
+AWS_CAL_API size_t aws_der_ecdsa_signature_max_length(size_t element_size);
+
+/**
+ * Strictly parses an ECDSA-Sig-Value without allocating: definite minimal lengths, non negative minimal INTEGERs and
+ * nothing after the SEQUENCE
+ * @param signature The DER encoded signature
+ * @param r Set to the unsigned big endian value of r, pointing into signature
+ * @param s Set to the unsigned big endian value of s, pointing into signature
+ * @return AWS_OP_ERR and AWS_ERROR_CAL_MALFORMED_ASN1_ENCOUNTERED if the signature is malformed, otherwise
+ * AWS_OP_SUCCESS
+ */
+AWS_CAL_API int aws_der_ecdsa_signature_parse(
+    struct aws_byte_cursor signature,
+    struct aws_byte_cursor *r,
+    struct aws_byte_cursor *s);
+
+/**
+ * Converts DER encoded ECDSA signatures to the fixed width r || s form, each half big endian and element_size bytes
+ * long. Every output is checked for capacity before any conversion is done, and nothing is allocated.
+ * @param der_signatures The count signatures to convert
+ * @param count The number of signatures
+ * @param element_size The size in bytes of the curve's order, at most AWS_DER_ECDSA_MAX_ELEMENT_SIZE
+ * @param raw_signatures raw_signatures[i] has the conversion of der_signatures[i] appended
+ * @return AWS_OP_ERR if an error occurs, otherwise AWS_OP_SUCCESS. On AWS_ERROR_CAL_MALFORMED_ASN1_ENCOUNTERED, the
+ * conversions before the malformed signature have already been appended.
+ */
+AWS_CAL_API int aws_der_ecdsa_signatures_to_raw(
+    const struct aws_byte_cursor *der_signatures,
+    size_t count,
+    size_t element_size,
+    struct aws_byte_buf *raw_signatures);
+
+/**
+ * Converts fixed width r || s ECDSA signatures to DER. Every input is checked for length and every output for room
+ * for aws_der_ecdsa_signature_max_length() bytes before any conversion is done, and nothing is allocated.
+ * @param raw_signatures The count signatures to convert, each exactly 2 * element_size bytes
+ * @param count The number of signatures
+ * @param element_size The size in bytes of the curve's order, at most AWS_DER_ECDSA_MAX_ELEMENT_SIZE
+ * @param der_signatures der_signatures[i] has the conversion of raw_signatures[i] appended
+ * @return AWS_OP_ERR if an error occurs, otherwise AWS_OP_SUCCESS
+ */
+AWS_CAL_API int aws_der_ecdsa_signatures_from_raw(
+    const struct aws_byte_cursor *raw_signatures,
+    size_t count,
+    size_t element_size,
+    struct aws_byte_buf *der_signatures);
+
 AWS_EXTERN_C_END
 
 #endif
@@ -0,0 +1,348 @@
+#ifndef AWS_C_CAL_PRIVATE_EC_NATIVE_H
+#define AWS_C_CAL_PRIVATE_EC_NATIVE_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/ecc.h>
+#include <aws/cal/private/sha256.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/byte_buf.h>
+
+/*
+ * aws-c-cal's own short Weierstrass arithmetic for the NIST prime curves (a = -3). Field and scalar elements are
+ * little endian arrays of 64 bit limbs in Montgomery form: 4 limbs for P-256, 6 for P-384. Points are kept in
+ * Jacobian coordinates while being worked on and in affine coordinates in the precomputed tables.
+ */
+#define AWS_EC_NATIVE_MAX_LIMBS 6
+
+/*
+ * Scalars are recoded into signed 5 bit digits in [-16, 16], so each window only needs the multiples 1..16 of
+ * 32^i * P; negative digits use the negated point.
+ */
+#define AWS_EC_NATIVE_WINDOW_BITS 5
+#define AWS_EC_NATIVE_WINDOW_ENTRIES 16
+
+struct aws_ec_native_modulus {
+    uint64_t m[AWS_EC_NATIVE_MAX_LIMBS];
+    /* R^2 mod m and R mod m, where R = 2^(64 * limbs) */
+    uint64_t rr[AWS_EC_NATIVE_MAX_LIMBS];
+    uint64_t one[AWS_EC_NATIVE_MAX_LIMBS];
+    /* -m^-1 mod 2^64 */
+    uint64_t m0inv;
+};
+
+struct aws_ec_native_curve {
+    enum aws_ecc_curve_name name;
+    size_t limbs;
+    size_t coordinate_size;
+    struct aws_ec_native_modulus p;
+    struct aws_ec_native_modulus n;
+    /* curve constant and generator, in Montgomery form mod p */
+    uint64_t b[AWS_EC_NATIVE_MAX_LIMBS];
+    uint64_t gx[AWS_EC_NATIVE_MAX_LIMBS];
+    uint64_t gy[AWS_EC_NATIVE_MAX_LIMBS];
+};
+
+/*
+ * Fixed window precomputation for one point. Entry (i, j) is (j + 1) * 32^i * P in affine coordinates, so a scalar
+ * multiplication is one mixed addition per non-zero digit and no doublings. That costs
+ * windows * 16 * 2 * limbs * 8 bytes: 52KiB for P-256 and 116KiB for P-384.
+ */
+struct aws_ec_native_table {
+    struct aws_allocator *allocator;
+    struct aws_atomic_var ref_count;
+    const struct aws_ec_native_curve *curve;
+    size_t windows;
+    /* windows * AWS_EC_NATIVE_WINDOW_ENTRIES affine points, each x then y, each curve->limbs long */
+    const uint64_t *points;
+};
+
+/*
+ * The part of RFC 6979 nonce generation that only depends on the private scalar: the HMAC-SHA256 key for the initial
+ * all zero K, and the first HMAC of the derivation with V || 0x00 || d already absorbed.
+ */
+struct aws_ec_native_rfc6979_midstate {
+    struct aws_sha256_hmac_key zero_key;
+    struct aws_sha256_ctx prefix;
+};
+
+/*
+ * A key as the native engine works with it. The private scalar is kept as plain limbs and the public point as affine
+ * Montgomery form coordinates, so neither is parsed again on every operation.
+ */
+struct aws_ec_native_key {
+    const struct aws_ec_native_curve *curve;
+    bool has_private_key;
+    bool has_public_key;
+    /* set by aws_ec_native_key_set_deterministic_signing(), rfc6979 is only valid while it is */
+    bool deterministic_signing;
+    uint64_t d[AWS_EC_NATIVE_MAX_LIMBS];
+    uint64_t x[AWS_EC_NATIVE_MAX_LIMBS];
+    uint64_t y[AWS_EC_NATIVE_MAX_LIMBS];
+    struct aws_ec_native_rfc6979_midstate rfc6979;
+};
+
+/*
+ * The message independent half of an ECDSA signature: k^-1 mod n in Montgomery form and r = x(k * G) mod n, plain.
+ * Secret, and good for exactly one signature.
+ */
+struct aws_ec_native_nonce {
+    uint64_t k_inv[AWS_EC_NATIVE_MAX_LIMBS];
+    uint64_t r[AWS_EC_NATIVE_MAX_LIMBS];
+};
+
+/* How signatures are encoded on the way in and out of the engine. */
+enum aws_ec_native_signature_format {
+    /* ECDSA-Sig-Value, as the platform providers produce */
+    AWS_EC_NATIVE_SIGNATURE_DER,
+    /* r || s, each big endian and exactly the curve's coordinate size */
+    AWS_EC_NATIVE_SIGNATURE_RAW,
+};
+
+/* Nonces for one key computed ahead of time on a worker thread. */
+struct aws_ec_native_nonce_pool;
+
+AWS_EXTERN_C_BEGIN
+
+AWS_CAL_API const struct aws_ec_native_curve *aws_ec_native_curve_get(enum aws_ecc_curve_name curve_name);
+
+/**
+ * Number of uint64_t words in the generator's table for curve_name, or 0 if the engine does not implement the curve.
+ */
+AWS_CAL_API size_t aws_ec_native_generator_table_length(enum aws_ecc_curve_name curve_name);
+
+/**
+ * Computes the generator's table for curve_name into points, which must hold
+ * aws_ec_native_generator_table_length() words. Used by bin/ec_table_gen to emit the tables at build time, and at
+ * runtime by builds that could not run it.
+ */
+AWS_CAL_API int aws_ec_native_build_generator_table(enum aws_ecc_curve_name curve_name, uint64_t *points);
+
+/**
+ * The generator's table the engine signs and verifies with: read only data in builds with build time tables, built
+ * on first use otherwise.
+ */
+AWS_CAL_API const struct aws_ec_native_table *aws_ec_native_generator_table(enum aws_ecc_curve_name curve_name);
+
+/**
+ * Sets up an empty key for curve_name. Raises AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM for curves the engine does not
+ * implement.
+ */
+AWS_CAL_API int aws_ec_native_key_init(struct aws_ec_native_key *key, enum aws_ecc_curve_name curve_name);
+
+/**
+ * Wipes the private scalar.
+ */
+AWS_CAL_API void aws_ec_native_key_clean_up(struct aws_ec_native_key *key);
+
+/**
+ * Sets the private scalar from its big endian encoding, which must be exactly the curve's coordinate size. Raises
+ * AWS_ERROR_INVALID_ARGUMENT unless 0 < d < n. Constant time in the value of d. Turns deterministic signing off.
+ */
+AWS_CAL_API int aws_ec_native_key_set_private_key(struct aws_ec_native_key *key, struct aws_byte_cursor d);
+
+/**
+ * Sets the public point from its big endian coordinates, which may be shorter than the curve's coordinate size.
+ * Raises AWS_ERROR_INVALID_ARGUMENT if the point is not on the curve.
+ */
+AWS_CAL_API int aws_ec_native_key_set_public_key(
+    struct aws_ec_native_key *key,
+    struct aws_byte_cursor x,
+    struct aws_byte_cursor y);
+
+/**
+ * Picks a uniformly random private scalar and computes its public point. Turns deterministic signing off.
+ */
+AWS_CAL_API int aws_ec_native_key_generate(struct aws_ec_native_key *key);
+
+/**
+ * aws_ec_native_key_generate() without the public point, for keys that may only ever sign. Any public key the key had
+ * is forgotten; aws_ec_native_key_derive_public_key() computes the new one.
+ */
+AWS_CAL_API int aws_ec_native_key_generate_private_key(struct aws_ec_native_key *key);
+
+/**
+ * aws_ec_native_key_generate() for each of count keys initialized for the same curve. The public points of each block
+ * of keys share one field inversion to get their affine coordinates (Montgomery's trick), which makes each key
+ * cheaper than generating it on its own. If generating fails, none of the keys should be used.
+ */
+AWS_CAL_API int aws_ec_native_key_generate_batch(struct aws_ec_native_key *const *keys, size_t count);
+
+/**
+ * Computes the public point from the private scalar, in constant time.
+ */
+AWS_CAL_API int aws_ec_native_key_derive_public_key(struct aws_ec_native_key *key);
+
+/**
+ * Appends the big endian encodings, each exactly the curve's coordinate size, of the public coordinates or the
+ * private scalar. The buffers must have room for them.
+ */
+AWS_CAL_API int aws_ec_native_key_write_public_key(
+    const struct aws_ec_native_key *key,
+    struct aws_byte_buf *x,
+    struct aws_byte_buf *y);
+AWS_CAL_API int aws_ec_native_key_write_private_key(const struct aws_ec_native_key *key, struct aws_byte_buf *d);
+
+/**
+ * SEC1 point decompression: appends the y coordinate, exactly the curve's coordinate size big endian, of the point
+ * whose x coordinate is x (also exactly the coordinate size) and whose y has the given parity. Raises
+ * AWS_ERROR_INVALID_ARGUMENT if no point on the curve has that x. The square root is a fixed exponentiation and the
+ * parity is picked without branching, so the timing only depends on whether x is valid.
+ */
+AWS_CAL_API int aws_ec_native_decompress_point(
+    enum aws_ecc_curve_name curve_name,
+    struct aws_byte_cursor x,
+    bool y_is_odd,
+    struct aws_byte_buf *y);
+
+/**
+ * Largest DER encoded signature on curve_name.
+ */
+AWS_CAL_API size_t aws_ec_native_signature_length(enum aws_ecc_curve_name curve_name);
+
+/**
+ * Switches the key between random nonces and RFC 6979 deterministic nonces, derived from the private scalar and the
+ * hash with HMAC-SHA256 whatever the curve. Deterministic keys never use the RNG to sign, and always produce the same
+ * signature for the same hash. Turning it on precomputes the HMAC state that only depends on the private scalar, and
+ * raises AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT for keys without one.
+ */
+AWS_CAL_API int aws_ec_native_key_set_deterministic_signing(struct aws_ec_native_key *key, bool deterministic);
+
+/**
+ * ECDSA signature over hash, encoded in format and appended to signature, which must have room for
+ * aws_ec_native_signature_length() bytes for DER or twice the coordinate size for raw. The nonce is random unless the
+ * key signs deterministically. Everything that touches the private scalar or the nonce is constant time.
+ */
+AWS_CAL_API int aws_ec_native_sign(
+    const struct aws_ec_native_key *key,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_buf *signature);
+
+/**
+ * Makes a fresh random nonce for curve_name, in constant time.
+ */
+AWS_CAL_API int aws_ec_native_nonce_generate(enum aws_ecc_curve_name curve_name, struct aws_ec_native_nonce *nonce);
+
+/**
+ * Makes count nonces, sharing the inversions of each block of them (Montgomery's trick), which makes each one
+ * substantially cheaper than aws_ec_native_nonce_generate().
+ */
+AWS_CAL_API int aws_ec_native_nonce_generate_batch(
+    enum aws_ecc_curve_name curve_name,
+    struct aws_ec_native_nonce *nonces,
+    size_t count);
+
+/**
+ * aws_ec_native_sign() with a nonce made earlier for the key's curve, which leaves a multiply-add mod n and the
+ * encoding. The nonce is wiped whatever happens.
+ */
+AWS_CAL_API int aws_ec_native_sign_with_nonce(
+    const struct aws_ec_native_key *key,
+    struct aws_ec_native_nonce *nonce,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_buf *signature);
+
+/**
+ * DER aws_ec_native_sign() of hashes[i] into signatures[i] for each of the count hashes, with nonces from
+ * aws_ec_native_nonce_generate_batch(), or one at a time for keys that sign deterministically.
+ * Raises AWS_ERROR_SHORT_BUFFER before signing anything if any buffer is too small; if signing fails part way, the
+ * signatures before the failing one have already been appended.
+ */
+AWS_CAL_API int aws_ec_native_sign_batch(
+    const struct aws_ec_native_key *key,
+    const struct aws_byte_cursor *hashes,
+    size_t count,
+    struct aws_byte_buf *signatures);
+
+/**
+ * ECDSA verification of a signature in format against the key's public point, for keys without a precomputed table.
+ * Same error behaviour as aws_ec_native_verify().
+ */
+AWS_CAL_API int aws_ec_native_key_verify(
+    const struct aws_ec_native_key *key,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    const struct aws_byte_cursor *signature);
+
+/**
+ * ECDH: appends x(d * Q) for key's private scalar d and peer's public point Q, big endian and exactly the curve's
+ * coordinate size, as SP 800-56A's shared secret Z. peer_table, if not NULL, is a table built for Q, which replaces
+ * the doublings with one lookup per window. Constant time in d. Raises AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT
+ * if key has no private scalar or peer no public point, and AWS_ERROR_INVALID_ARGUMENT if they are on different
+ * curves.
+ */
+AWS_CAL_API int aws_ec_native_key_derive_shared_secret(
+    const struct aws_ec_native_key *key,
+    const struct aws_ec_native_key *peer,
+    const struct aws_ec_native_table *peer_table,
+    struct aws_byte_buf *shared_secret);
+
+/**
+ * aws_ec_native_key_derive_shared_secret() with peers[i] and peer_tables[i] into shared_secrets[i] for each of the
+ * count peers; peer_tables may be NULL, as may any of its entries. The private scalar is recoded once and the shared
+ * points of each block of peers share one inversion (Montgomery's trick). Everything is checked, buffer sizes
+ * included, before anything is computed.
+ */
+AWS_CAL_API int aws_ec_native_key_derive_shared_secret_batch(
+    const struct aws_ec_native_key *key,
+    const struct aws_ec_native_key *const *peers,
+    const struct aws_ec_native_table *const *peer_tables,
+    size_t count,
+    struct aws_byte_buf *shared_secrets);
+
+/**
+ * Builds the verification table for the public point (pub_x, pub_y). The coordinates are big endian and may be
+ * shorter than the curve's coordinate size. Raises AWS_ERROR_INVALID_ARGUMENT if the point is not on the curve.
+ */
+AWS_CAL_API struct aws_ec_native_table *aws_ec_native_table_new(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_byte_cursor pub_x,
+    struct aws_byte_cursor pub_y);
+
+AWS_CAL_API struct aws_ec_native_table *aws_ec_native_table_acquire(struct aws_ec_native_table *table);
+
+AWS_CAL_API void aws_ec_native_table_release(struct aws_ec_native_table *table);
+
+/**
+ * ECDSA verification of a signature in format over hash against the point table was built for. Raises
+ * AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED on any failure, including a malformed signature or a raw one of the wrong
+ * length. Runs in variable time: everything it touches is public.
+ */
+AWS_CAL_API int aws_ec_native_verify(
+    const struct aws_ec_native_table *table,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    const struct aws_byte_cursor *signature);
+
+/**
+ * Starts a worker thread that keeps up to depth nonces for curve_name ready, and makes more whenever no more than
+ * refill_threshold are left. Requires refill_threshold < depth.
+ */
+AWS_CAL_API struct aws_ec_native_nonce_pool *aws_ec_native_nonce_pool_new(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    size_t depth,
+    size_t refill_threshold);
+
+/**
+ * Stops the worker and wipes the nonces it had made.
+ */
+AWS_CAL_API void aws_ec_native_nonce_pool_destroy(struct aws_ec_native_nonce_pool *pool);
+
+/**
+ * Moves a ready nonce into nonce and returns true, or returns false if the pool has run dry, in which case the caller
+ * makes its own. Thread safe.
+ */
+AWS_CAL_API bool aws_ec_native_nonce_pool_take(
+    struct aws_ec_native_nonce_pool *pool,
+    struct aws_ec_native_nonce *nonce);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_C_CAL_PRIVATE_EC_NATIVE_H */
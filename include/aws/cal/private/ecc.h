@@ -20,6 +20,106 @@ AWS_CAL_API int aws_der_decoder_load_ecc_key_pair(
     struct aws_byte_cursor *out_private_d,
     enum aws_ecc_curve_name *out_curve_name);
 
+/*
+ * Allocates a provider's key struct, impl_size bytes that start with its struct aws_ecc_key_pair, in a single block
+ * together with the storage for the key pair's pub_x, pub_y and priv_d, and sets the key pair up with
+ * aws_ecc_key_pair_init(), impl pointing at the block. The three buffers start out empty with room for exactly
+ * one coordinate of curve_name; they don't own their storage, so destroying the key pair takes
+ * aws_byte_buf_clean_up_secure() on priv_d and one aws_mem_release() of the key pair. Returns NULL if the allocation
+ * fails.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_with_storage(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    size_t impl_size,
+    struct aws_ecc_key_pair_vtable *vtable);
+
+/*
+ * Sets one of the buffers aws_ecc_key_pair_new_with_storage() set up to value, left padded with zeros to the full
+ * coordinate size. Raises AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM if value doesn't fit.
+ */
+AWS_CAL_API int aws_ecc_key_pair_write_coordinate(struct aws_byte_buf *coordinate, struct aws_byte_cursor value);
+
+/*
+ * Copies the contents of key_pair's pub_x, pub_y and priv_d into replica's, for replicate implementations. Both must
+ * come from aws_ecc_key_pair_new_with_storage() on the same curve.
+ */
+AWS_CAL_API void aws_ecc_key_pair_copy_coordinates(
+    struct aws_ecc_key_pair *replica,
+    const struct aws_ecc_key_pair *key_pair);
+
+/*
+ * The platform provider's constructors, one set per platform source directory. The public constructors in ecc.c call
+ * these for curves whose provider is AWS_ECC_PROVIDER_PLATFORM. Not compiled in AWS_BYO_CRYPTO builds.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *priv_key);
+
+#if !defined(AWS_OS_IOS)
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name);
+
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_deferred_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name);
+#endif /* !AWS_OS_IOS */
+
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *public_key_x,
+    const struct aws_byte_cursor *public_key_y);
+
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1_impl(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *encoded_keys);
+
+/*
+ * The native provider's constructors, in native_ecc.c. Same contracts as the public constructors.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_from_private_key(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *priv_key);
+
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_generate_random(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name);
+
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_generate_random_deferred(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name);
+
+/*
+ * Generates count native key pairs into key_pairs, with their public points converted to coordinates in batches
+ * (see aws_ec_native_key_generate_batch()) and written up front. On failure key_pairs is left all NULL.
+ */
+AWS_CAL_API int aws_ecc_key_pair_new_native_generate_batch(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_ecc_key_pair **key_pairs,
+    size_t count);
+
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_from_public_key(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *public_key_x,
+    const struct aws_byte_cursor *public_key_y);
+
+/*
+ * Builds a native key pair from the components aws_der_decoder_load_ecc_key_pair() found; priv_d or pub_x/pub_y may
+ * be empty, not both.
+ */
+AWS_CAL_API struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_from_components(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_byte_cursor priv_d,
+    struct aws_byte_cursor pub_x,
+    struct aws_byte_cursor pub_y);
+
 AWS_EXTERN_C_END
 
 #endif /* AWS_C_CAL_PRIVATE_ECC_H */
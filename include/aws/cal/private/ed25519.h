@@ -0,0 +1,78 @@
+#ifndef AWS_C_CAL_PRIVATE_ED25519_H
+#define AWS_C_CAL_PRIVATE_ED25519_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/ed25519.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/byte_buf.h>
+
+struct aws_ed25519_native_key;
+
+struct aws_ed25519_key_pair_vtable {
+    void (*destroy)(struct aws_ed25519_key_pair *key_pair);
+    int (*sign_message)(
+        const struct aws_ed25519_key_pair *key_pair,
+        struct aws_byte_cursor message,
+        struct aws_byte_buf *signature);
+    int (*verify_signature)(
+        const struct aws_ed25519_key_pair *key_pair,
+        struct aws_byte_cursor message,
+        struct aws_byte_cursor signature);
+};
+
+struct aws_ed25519_key_pair {
+    struct aws_allocator *allocator;
+    struct aws_atomic_var ref_count;
+    struct aws_ed25519_key_pair_vtable *vtable;
+    uint8_t public_key[AWS_ED25519_PUBLIC_KEY_LEN];
+    uint8_t private_key[AWS_ED25519_PRIVATE_KEY_LEN];
+    bool has_private_key;
+    /* the native engine's parsed key, which aws_ed25519_verify_batch() works from; NULL for platform key pairs */
+    const struct aws_ed25519_native_key *native_key;
+    void *impl;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Fills in the common fields of a provider's key pair, with a ref count of one.
+ */
+AWS_CAL_API void aws_ed25519_key_pair_init(
+    struct aws_ed25519_key_pair *key_pair,
+    struct aws_allocator *allocator,
+    struct aws_ed25519_key_pair_vtable *vtable,
+    void *impl);
+
+/*
+ * The native provider's constructors, in native_ed25519.c. Same contracts as the public constructors, whose length
+ * checks they rely on.
+ */
+AWS_CAL_API struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_native_from_private_key(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor private_key);
+
+AWS_CAL_API struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_native_from_public_key(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor public_key);
+
+/*
+ * The platform provider, one per platform source directory; platforms without Ed25519 report it unsupported and are
+ * never asked for key pairs. Not compiled in AWS_BYO_CRYPTO builds.
+ */
+AWS_CAL_API bool aws_ed25519_platform_is_supported(void);
+
+AWS_CAL_API struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_private_key_impl(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor private_key);
+
+AWS_CAL_API struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_public_key_impl(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor public_key);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_C_CAL_PRIVATE_ED25519_H */
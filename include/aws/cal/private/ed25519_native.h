@@ -0,0 +1,102 @@
+#ifndef AWS_C_CAL_PRIVATE_ED25519_NATIVE_H
+#define AWS_C_CAL_PRIVATE_ED25519_NATIVE_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/ed25519.h>
+
+#include <aws/common/byte_buf.h>
+
+/*
+ * aws-c-cal's own Ed25519 (RFC 8032). Field elements mod 2^255 - 19 are five 51 bit limbs, little endian and only
+ * loosely reduced between operations; points on the twisted Edwards curve are kept in extended coordinates.
+ */
+#define AWS_ED25519_NATIVE_LIMBS 5
+
+/* signatures aws_ed25519_native_verify_batch() combines into one multi-scalar multiplication */
+#define AWS_ED25519_NATIVE_BATCH_BLOCK 64
+
+/* (X : Y : Z : T) with x = X / Z, y = Y / Z and x * y = T / Z */
+struct aws_ed25519_native_point {
+    uint64_t x[AWS_ED25519_NATIVE_LIMBS];
+    uint64_t y[AWS_ED25519_NATIVE_LIMBS];
+    uint64_t z[AWS_ED25519_NATIVE_LIMBS];
+    uint64_t t[AWS_ED25519_NATIVE_LIMBS];
+};
+
+struct aws_ed25519_native_key {
+    uint8_t public_key[AWS_ED25519_PUBLIC_KEY_LEN];
+    /* -A, the negated public point, decoded once since verification only ever subtracts multiples of A */
+    struct aws_ed25519_native_point neg_a;
+    /* the two halves of SHA-512(seed): the clamped secret scalar, and the prefix nonces are derived from */
+    uint64_t scalar[4];
+    uint8_t prefix[32];
+    bool has_private_key;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Expands a 32 byte private key (the RFC 8032 seed) and computes its public key, in constant time.
+ */
+AWS_CAL_API int aws_ed25519_native_key_set_private_key(struct aws_ed25519_native_key *key, struct aws_byte_cursor seed);
+
+/**
+ * Decodes a 32 byte public key. Raises AWS_ERROR_INVALID_ARGUMENT unless it is the canonical encoding of a point on
+ * the curve.
+ */
+AWS_CAL_API int aws_ed25519_native_key_set_public_key(
+    struct aws_ed25519_native_key *key,
+    struct aws_byte_cursor public_key);
+
+/**
+ * Zeroes the key's secrets.
+ */
+AWS_CAL_API void aws_ed25519_native_key_clean_up(struct aws_ed25519_native_key *key);
+
+/**
+ * Appends the AWS_ED25519_SIGNATURE_LEN byte signature of message. Signing is deterministic and constant time.
+ */
+AWS_CAL_API int aws_ed25519_native_sign(
+    const struct aws_ed25519_native_key *key,
+    struct aws_byte_cursor message,
+    struct aws_byte_buf *signature);
+
+/**
+ * Checks [S]B = R + [k]A the way RFC 8032 and libcrypto do: S must be below the group order and the encoding of
+ * [S]B - [k]A must be R's, byte for byte. Raises AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED otherwise.
+ */
+AWS_CAL_API int aws_ed25519_native_verify(
+    const struct aws_ed25519_native_key *key,
+    struct aws_byte_cursor message,
+    struct aws_byte_cursor signature);
+
+/**
+ * Size of the scratch space aws_ed25519_native_verify_batch() needs, about 200KiB: odd multiple tables for two points
+ * per signature of a block.
+ */
+AWS_CAL_API size_t aws_ed25519_native_batch_scratch_size(void);
+
+/**
+ * Verifies up to AWS_ED25519_NATIVE_BATCH_BLOCK signatures at once with a random linear combination: for random 128
+ * bit z_i, checks 8 * ([sum z_i S_i]B - sum [z_i]R_i - sum [z_i k_i]A_i) = 0 with a single multi-scalar
+ * multiplication, where the A_i of signatures from the same key are merged. A forged signature gets through with
+ * probability about 2^-128. scratch is aws_ed25519_native_batch_scratch_size() bytes, any alignment malloc gives.
+ *
+ * Only tells whether every signature is valid: raises AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED if any is not, and
+ * the caller verifies them one by one to find out which. The cofactor makes this the cofactored equation RFC 8032
+ * allows, so a signature crafted with small order components can pass here and fail aws_ed25519_native_verify();
+ * signatures from honest signers get the same answer from both.
+ */
+AWS_CAL_API int aws_ed25519_native_verify_batch(
+    void *scratch,
+    const struct aws_ed25519_native_key *const *keys,
+    const struct aws_byte_cursor *messages,
+    const struct aws_byte_cursor *signatures,
+    size_t count);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_C_CAL_PRIVATE_ED25519_NATIVE_H */
@@ -33,14 +33,83 @@ typedef int (*evp_md_ctx_digest_init_ex)(EVP_MD_CTX *, const EVP_MD *, ENGINE *)
 typedef int (*evp_md_ctx_digest_update)(EVP_MD_CTX *, const void *, size_t);
 typedef int (*evp_md_ctx_digest_final_ex)(EVP_MD_CTX *, unsigned char *, unsigned int *);
 
+struct ossl_lib_ctx_st;
+
+typedef EVP_MD *(*evp_md_fetch)(struct ossl_lib_ctx_st *, const char *, const char *);
+typedef void (*evp_md_free)(EVP_MD *);
+
 struct openssl_evp_md_ctx_table {
     evp_md_ctx_new new_fn;
     evp_md_ctx_free free_fn;
     evp_md_ctx_digest_init_ex init_ex_fn;
     evp_md_ctx_digest_update update_fn;
     evp_md_ctx_digest_final_ex final_ex_fn;
+
+    /* OpenSSL 3 only, NULL otherwise */
+    evp_md_fetch md_fetch_fn;
+    evp_md_free md_free_fn;
+
+    /*
+     * Digests to pass to EVP_DigestInit_ex and HMAC_Init_ex. On OpenSSL 3 these are fetched from the default
+     * library context once at init; EVP_sha256() and friends would make every init do an implicit fetch, which
+     * takes a global lock. Otherwise they are the static EVP_sha256()/EVP_md5() objects.
+     *
+     * Only the default library context is covered, with the providers loaded into it when aws_cal_library_init()
+     * runs. Providers loaded later, or another OSSL_LIB_CTX, are not picked up until the library is cleaned up and
+     * initialized again.
+     */
+    const EVP_MD *sha256;
+    const EVP_MD *md5;
 };
 
 extern struct openssl_evp_md_ctx_table *g_aws_openssl_evp_md_ctx_table;
 
+/*
+ * OpenSSL 3 EVP_MAC. These are resolved at runtime and declared against the opaque struct tags so that this builds
+ * with headers (AWS-LC, OpenSSL 1.x) that do not have them.
+ */
+struct evp_mac_st;
+struct evp_mac_ctx_st;
+
+/* Layout compatible with OpenSSL 3's OSSL_PARAM */
+struct aws_ossl_param {
+    const char *key;
+    unsigned int data_type;
+    void *data;
+    size_t data_size;
+    size_t return_size;
+};
+
+#define AWS_OSSL_PARAM_UTF8_STRING 4
+#define AWS_OSSL_PARAM_UNMODIFIED ((size_t)-1)
+
+typedef struct evp_mac_st *(*evp_mac_fetch)(struct ossl_lib_ctx_st *, const char *, const char *);
+typedef void (*evp_mac_free)(struct evp_mac_st *);
+typedef struct evp_mac_ctx_st *(*evp_mac_ctx_new)(struct evp_mac_st *);
+typedef void (*evp_mac_ctx_free)(struct evp_mac_ctx_st *);
+typedef struct evp_mac_ctx_st *(*evp_mac_ctx_dup)(const struct evp_mac_ctx_st *);
+typedef int (*evp_mac_ctx_set_params)(struct evp_mac_ctx_st *, const struct aws_ossl_param *);
+typedef int (*evp_mac_init)(struct evp_mac_ctx_st *, const unsigned char *, size_t, const struct aws_ossl_param *);
+typedef int (*evp_mac_update)(struct evp_mac_ctx_st *, const unsigned char *, size_t);
+typedef int (*evp_mac_final)(struct evp_mac_ctx_st *, unsigned char *, size_t *, size_t);
+
+struct openssl_evp_mac_table {
+    evp_mac_fetch fetch_fn;
+    evp_mac_free free_fn;
+    evp_mac_ctx_new ctx_new_fn;
+    evp_mac_ctx_free ctx_free_fn;
+    evp_mac_ctx_dup ctx_dup_fn;
+    evp_mac_ctx_set_params ctx_set_params_fn;
+    evp_mac_init init_fn;
+    evp_mac_update update_fn;
+    evp_mac_final final_fn;
+
+    /* HMAC is fetched once at init. Keyed contexts are duplicated from a template that already has SHA256 set. */
+    struct evp_mac_st *hmac;
+    struct evp_mac_ctx_st *sha256_hmac_template;
+};
+
+/* NULL unless EVP_MAC was found at init, in which case HMAC goes through it instead of the HMAC_CTX API */
+extern struct openssl_evp_mac_table *g_aws_openssl_evp_mac_table;
+
 #endif /* AWS_C_CAL_OPENSSLCRYPTO_COMMON_H */
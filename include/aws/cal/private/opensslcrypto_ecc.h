@@ -0,0 +1,46 @@
+#ifndef AWS_C_CAL_OPENSSLCRYPTO_ECC_H
+#define AWS_C_CAL_OPENSSLCRYPTO_ECC_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/exports.h>
+#include <aws/cal/ecc.h>
+
+/*
+ * The libcrypto ECDSA backends. aws_cal_library_init() selects EVP_PKEY when the loaded libcrypto is OpenSSL 3,
+ * where EC_KEY and ECDSA_sign()/ECDSA_verify() are compatibility shims that build a fresh EVP_PKEY_CTX on every
+ * call, and EC_KEY otherwise.
+ */
+enum aws_libcrypto_ecc_backend {
+    AWS_LIBCRYPTO_ECC_BACKEND_EC_KEY,
+    AWS_LIBCRYPTO_ECC_BACKEND_EVP_PKEY,
+};
+
+AWS_EXTERN_C_BEGIN
+
+/**
+ * Builds the shared per-curve EC_GROUPs. Called from aws_cal_library_init().
+ */
+AWS_CAL_API void aws_libcrypto_ecc_init(void);
+
+/**
+ * Releases the shared per-curve EC_GROUPs. Called from aws_cal_library_clean_up().
+ */
+AWS_CAL_API void aws_libcrypto_ecc_clean_up(void);
+
+/**
+ * Selects the backend used by key pairs created after this call; existing key pairs keep the one they were created
+ * with. Exposed for tests and benchmarks. Not thread safe with respect to concurrent key creation.
+ */
+AWS_CAL_API void aws_libcrypto_ecc_set_backend(enum aws_libcrypto_ecc_backend backend);
+
+/**
+ * Returns the backend new key pairs will be created with.
+ */
+AWS_CAL_API enum aws_libcrypto_ecc_backend aws_libcrypto_ecc_get_backend(void);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_C_CAL_OPENSSLCRYPTO_ECC_H */
@@ -0,0 +1,34 @@
+#ifndef AWS_C_CAL_OPENSSLCRYPTO_HMAC_H
+#define AWS_C_CAL_OPENSSLCRYPTO_HMAC_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/exports.h>
+#include <aws/cal/hmac.h>
+
+/*
+ * The individual libcrypto HMAC backends. aws_sha256_hmac_new() picks between them at aws_cal_library_init(); they
+ * are exposed separately for tests and benchmarks.
+ */
+AWS_EXTERN_C_BEGIN
+
+/**
+ * HMAC_CTX based implementation. Available with every supported libcrypto.
+ */
+AWS_CAL_API struct aws_hmac *aws_sha256_hmac_libcrypto_legacy_new(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *secret);
+
+/**
+ * OpenSSL 3 EVP_MAC based implementation. Raises AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM and returns NULL when the
+ * loaded libcrypto does not provide EVP_MAC.
+ */
+AWS_CAL_API struct aws_hmac *aws_sha256_hmac_libcrypto_evp_mac_new(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *secret);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_C_CAL_OPENSSLCRYPTO_HMAC_H */
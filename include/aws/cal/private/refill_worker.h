@@ -0,0 +1,74 @@
+#ifndef AWS_C_CAL_PRIVATE_REFILL_WORKER_H
+#define AWS_C_CAL_PRIVATE_REFILL_WORKER_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/exports.h>
+
+#include <aws/common/condition_variable.h>
+#include <aws/common/mutex.h>
+#include <aws/common/thread.h>
+
+/* the most items a refill worker makes between two looks at its pool, which is also its batch size */
+#define AWS_CAL_REFILL_CHUNK 32
+
+/*
+ * What a pool plugs into its refill worker. make_chunk runs outside the worker's lock, everything else with it held.
+ */
+struct aws_cal_refill_worker_vtable {
+    /* whether the pool wants refilling; the worker sleeps until it does */
+    bool (*has_work)(void *pool);
+    /* how many items the pool is short of full; 0 ends the refill */
+    size_t (*missing)(void *pool);
+    /* makes count items, at most AWS_CAL_REFILL_CHUNK; returns AWS_OP_SUCCESS or AWS_OP_ERR */
+    int (*make_chunk)(void *pool, size_t count);
+    /* hands the pool make_chunk's result; returning false ends the refill early */
+    bool (*finish_chunk)(void *pool, int result, size_t count);
+};
+
+/*
+ * A thread that keeps a pool topped up, shared by the ECC key pool and the native nonce pool. It sleeps on a condition
+ * variable until the pool has work for it, then refills the pool all the way up, a chunk at a time so a shutdown
+ * doesn't wait for the whole pool. Chunks are made outside the lock, so the pool's users never wait on one; pools
+ * that keep state under a lock use the worker's.
+ */
+struct aws_cal_refill_worker {
+    const struct aws_cal_refill_worker_vtable *vtable;
+    void *pool;
+
+    struct aws_thread thread;
+    struct aws_mutex lock;
+    struct aws_condition_variable signal;
+
+    /* protected by lock */
+    bool shutting_down;
+};
+
+AWS_EXTERN_C_BEGIN
+
+/*
+ * Sets up worker's lock and condition variable and launches its thread, which starts by asking the pool has_work.
+ */
+AWS_CAL_API int aws_cal_refill_worker_start(
+    struct aws_cal_refill_worker *worker,
+    struct aws_allocator *allocator,
+    const struct aws_cal_refill_worker_vtable *vtable,
+    void *pool);
+
+/*
+ * Stops the thread, letting a chunk in progress finish, and cleans up the lock and condition variable. The pool can
+ * be torn down afterwards.
+ */
+AWS_CAL_API void aws_cal_refill_worker_stop(struct aws_cal_refill_worker *worker);
+
+/*
+ * Has the worker ask the pool has_work again. Takes the lock; callers already holding it notify worker->signal
+ * themselves.
+ */
+AWS_CAL_API void aws_cal_refill_worker_wake(struct aws_cal_refill_worker *worker);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_C_CAL_PRIVATE_REFILL_WORKER_H */
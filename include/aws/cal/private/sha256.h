@@ -0,0 +1,108 @@
+#ifndef AWS_C_CAL_PRIVATE_SHA256_H
+#define AWS_C_CAL_PRIVATE_SHA256_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/exports.h>
+#include <aws/cal/hash.h>
+
+#include <aws/common/common.h>
+
+#define AWS_SHA256_BLOCK_LEN 64
+
+#define AWS_SHA256_ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+/**
+ * In-place SHA256 state. This never allocates and can live on the stack or be embedded in another struct.
+ */
+struct aws_sha256_ctx {
+    uint32_t state[8];
+    uint64_t total_len;
+    uint8_t buffer[AWS_SHA256_BLOCK_LEN];
+    size_t buffer_len;
+};
+
+/**
+ * Precomputed HMAC-SHA256 key: the chaining values after absorbing (key ^ ipad) and (key ^ opad).
+ * Once built, every HMAC computed under the key skips the key schedule and both pad blocks.
+ */
+struct aws_sha256_hmac_key {
+    uint32_t inner_state[8];
+    uint32_t outer_state[8];
+};
+
+AWS_EXTERN_C_BEGIN
+
+/* FIPS 180-4 round constants, shared by the scalar and multi-buffer kernels. */
+extern const uint32_t aws_sha256_round_constants[64];
+
+AWS_STATIC_IMPL uint32_t aws_sha256_load_be32(const uint8_t *src) {
+    return ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 8) | (uint32_t)src[3];
+}
+
+AWS_STATIC_IMPL void aws_sha256_store_be32(uint8_t *dest, uint32_t value) {
+    dest[0] = (uint8_t)(value >> 24);
+    dest[1] = (uint8_t)(value >> 16);
+    dest[2] = (uint8_t)(value >> 8);
+    dest[3] = (uint8_t)value;
+}
+
+AWS_STATIC_IMPL void aws_sha256_store_be64(uint8_t *dest, uint64_t value) {
+    aws_sha256_store_be32(dest, (uint32_t)(value >> 32));
+    aws_sha256_store_be32(dest + 4, (uint32_t)value);
+}
+
+/**
+ * Picks the kernel aws_sha256_compress() calls for this CPU. Called once from aws_cal_library_init(); until then
+ * aws_sha256_compress() runs the portable kernel.
+ */
+AWS_CAL_API void aws_sha256_compress_init(void);
+
+/**
+ * Runs the SHA256 compression function over block_count consecutive 64 byte blocks.
+ */
+AWS_CAL_API void aws_sha256_compress(uint32_t state[8], const uint8_t *blocks, size_t block_count);
+
+/**
+ * The portable kernel aws_sha256_compress() falls back to when the CPU has no SHA extensions. Exposed so the
+ * accelerated kernel can be checked against it.
+ */
+AWS_CAL_API void aws_sha256_compress_portable(uint32_t state[8], const uint8_t *blocks, size_t block_count);
+
+AWS_CAL_API void aws_sha256_ctx_init(struct aws_sha256_ctx *ctx);
+
+AWS_CAL_API void aws_sha256_ctx_update(struct aws_sha256_ctx *ctx, const uint8_t *data, size_t len);
+
+/**
+ * Writes AWS_SHA256_LEN bytes to digest. ctx must be re-initialized before it is used again.
+ */
+AWS_CAL_API void aws_sha256_ctx_finalize(struct aws_sha256_ctx *ctx, uint8_t *digest);
+
+/**
+ * Builds the inner and outer midstates for secret. Keys longer than the block size are hashed first, per RFC 2104.
+ */
+AWS_CAL_API void aws_sha256_hmac_key_init(struct aws_sha256_hmac_key *key, const uint8_t *secret, size_t secret_len);
+
+/**
+ * Zeroes the key material.
+ */
+AWS_CAL_API void aws_sha256_hmac_key_clean_up(struct aws_sha256_hmac_key *key);
+
+/**
+ * Starts an HMAC computation under key. Feed the message with aws_sha256_ctx_update().
+ */
+AWS_CAL_API void aws_sha256_hmac_ctx_init(struct aws_sha256_ctx *ctx, const struct aws_sha256_hmac_key *key);
+
+/**
+ * Finishes an HMAC computation started with aws_sha256_hmac_ctx_init() and writes AWS_SHA256_HMAC_LEN bytes to mac.
+ */
+AWS_CAL_API void aws_sha256_hmac_ctx_finalize(
+    struct aws_sha256_ctx *ctx,
+    const struct aws_sha256_hmac_key *key,
+    uint8_t *mac);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_C_CAL_PRIVATE_SHA256_H */
@@ -0,0 +1,39 @@
+#ifndef AWS_C_CAL_PRIVATE_SHA512_H
+#define AWS_C_CAL_PRIVATE_SHA512_H
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/cal/exports.h>
+
+#include <aws/common/common.h>
+
+#define AWS_SHA512_LEN 64
+#define AWS_SHA512_BLOCK_LEN 128
+
+/**
+ * In-place SHA512 state, for the native Ed25519 engine, which hashes with SHA512 by definition. Like struct
+ * aws_sha256_ctx, it never allocates.
+ */
+struct aws_sha512_ctx {
+    uint64_t state[8];
+    uint64_t total_len;
+    uint8_t buffer[AWS_SHA512_BLOCK_LEN];
+    size_t buffer_len;
+};
+
+AWS_EXTERN_C_BEGIN
+
+AWS_CAL_API void aws_sha512_ctx_init(struct aws_sha512_ctx *ctx);
+
+AWS_CAL_API void aws_sha512_ctx_update(struct aws_sha512_ctx *ctx, const uint8_t *data, size_t len);
+
+/**
+ * Writes AWS_SHA512_LEN bytes to digest. ctx must be re-initialized before it is used again.
+ */
+AWS_CAL_API void aws_sha512_ctx_finalize(struct aws_sha512_ctx *ctx, uint8_t *digest);
+
+AWS_EXTERN_C_END
+
+#endif /* AWS_C_CAL_PRIVATE_SHA512_H */
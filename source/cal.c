@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 #include <aws/cal/cal.h>
+#include <aws/cal/private/sha256.h>
 #include <aws/common/common.h>
 #include <aws/common/error.h>
 
@@ -49,6 +50,7 @@ void aws_cal_library_init(struct aws_allocator *allocator) {
     if (!s_cal_library_initialized) {
         aws_common_library_init(allocator);
         aws_register_error_info(&s_list);
+        aws_sha256_compress_init();
         aws_cal_platform_init(allocator);
         s_cal_library_initialized = true;
     }
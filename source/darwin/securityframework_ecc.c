@@ -145,9 +145,7 @@ static struct commoncrypto_ecc_key_pair *s_alloc_pair_and_init_buffers(
         return NULL;
     }
 
-    aws_atomic_init_int(&cc_key_pair->key_pair.ref_count, 1);
-    cc_key_pair->key_pair.impl = cc_key_pair;
-    cc_key_pair->key_pair.allocator = allocator;
+    aws_ecc_key_pair_init(&cc_key_pair->key_pair, allocator, curve_name, &s_key_pair_vtable, cc_key_pair);
     cc_key_pair->cf_allocator = aws_wrapped_cf_allocator_new(allocator);
 
     if (!cc_key_pair->cf_allocator) {
@@ -198,8 +196,6 @@ static struct commoncrypto_ecc_key_pair *s_alloc_pair_and_init_buffers(
 
     cc_key_pair->key_pair.priv_d.buffer = cc_key_pair->key_pair.key_buf.buffer + 1 + (s_key_coordinate_size * 2);
     cc_key_pair->key_pair.priv_d.len = s_key_coordinate_size;
-    cc_key_pair->key_pair.vtable = &s_key_pair_vtable;
-    cc_key_pair->key_pair.curve_name = curve_name;
 
     return cc_key_pair;
 
@@ -208,7 +204,7 @@ error:
     return NULL;
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key_impl(
     struct aws_allocator *allocator,
     enum aws_ecc_curve_name curve_name,
     const struct aws_byte_cursor *priv_key) {
@@ -271,7 +267,7 @@ error:
     return NULL;
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key_impl(
     struct aws_allocator *allocator,
     enum aws_ecc_curve_name curve_name,
     const struct aws_byte_cursor *public_key_x,
@@ -337,7 +333,7 @@ error:
 }
 
 #if !defined(AWS_OS_IOS)
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_impl(
     struct aws_allocator *allocator,
     enum aws_ecc_curve_name curve_name) {
     struct commoncrypto_ecc_key_pair *cc_key_pair =
@@ -352,9 +348,7 @@ struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random(
     CFMutableDictionaryRef key_attributes = NULL;
     struct aws_der_decoder *decoder = NULL;
 
-    aws_atomic_init_int(&cc_key_pair->key_pair.ref_count, 1);
-    cc_key_pair->key_pair.impl = cc_key_pair;
-    cc_key_pair->key_pair.allocator = allocator;
+    aws_ecc_key_pair_init(&cc_key_pair->key_pair, allocator, curve_name, &s_key_pair_vtable, cc_key_pair);
     cc_key_pair->cf_allocator = aws_wrapped_cf_allocator_new(allocator);
 
     if (!cc_key_pair->cf_allocator) {
@@ -457,8 +451,6 @@ struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random(
     cc_key_pair->key_pair.priv_d =
         aws_byte_buf_from_array(cc_key_pair->key_pair.pub_y.buffer + key_coordinate_size, key_coordinate_size);
 
-    cc_key_pair->key_pair.curve_name = curve_name;
-    cc_key_pair->key_pair.vtable = &s_key_pair_vtable;
 
     CFRelease(sec_key_export_data);
     CFRelease(key_size_cf_str);
@@ -487,9 +479,16 @@ error:
     s_destroy_key(&cc_key_pair->key_pair);
     return NULL;
 }
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_deferred_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name) {
+    /* SecItemExport() hands back the public key together with the private key, nothing to defer */
+    return aws_ecc_key_pair_new_generate_random_impl(allocator, curve_name);
+}
 #endif /* AWS_OS_IOS */
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1_impl(
     struct aws_allocator *allocator,
     const struct aws_byte_cursor *encoded_keys) {
 
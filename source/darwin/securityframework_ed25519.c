@@ -0,0 +1,30 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ed25519.h>
+
+#include <aws/cal/cal.h>
+
+/* Security.framework has no Ed25519, so Ed25519 key pairs always come from the native provider here */
+bool aws_ed25519_platform_is_supported(void) {
+    return false;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_private_key_impl(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor private_key) {
+    (void)allocator;
+    (void)private_key;
+    aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    return NULL;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_public_key_impl(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor public_key) {
+    (void)allocator;
+    (void)public_key;
+    aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    return NULL;
+}
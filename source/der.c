@@ -496,6 +496,181 @@ int aws_der_decoder_tlv_blob(struct aws_der_decoder *decoder, struct aws_byte_cu
     return AWS_OP_SUCCESS;
 }
 
+/*
+ * ECDSA-Sig-Value helpers. These sit on the signing and verification paths, so unlike the decoder above they work
+ * straight on the caller's buffers. With scalars of at most AWS_DER_ECDSA_MAX_ELEMENT_SIZE bytes, every INTEGER has a
+ * one byte length and the SEQUENCE at most a two byte one.
+ */
+static bool s_ecdsa_read_length(struct aws_byte_cursor *cur, size_t *length) {
+    uint8_t first = 0;
+    if (!aws_byte_cursor_read_u8(cur, &first)) {
+        return false;
+    }
+
+    if (first < 0x80) {
+        *length = first;
+        return true;
+    }
+
+    uint8_t value = 0;
+    if (first != 0x81 || !aws_byte_cursor_read_u8(cur, &value) || value < 0x80) {
+        return false;
+    }
+
+    *length = value;
+    return true;
+}
+
+static bool s_ecdsa_read_integer(struct aws_byte_cursor *cur, struct aws_byte_cursor *value) {
+    uint8_t tag = 0;
+    size_t length = 0;
+
+    if (!aws_byte_cursor_read_u8(cur, &tag) || tag != AWS_DER_INTEGER || !s_ecdsa_read_length(cur, &length) ||
+        length == 0 || length > cur->len) {
+        return false;
+    }
+
+    *value = aws_byte_cursor_advance(cur, length);
+
+    /* negative, or a redundant leading zero */
+    if (value->ptr[0] & 0x80) {
+        return false;
+    }
+    if (value->ptr[0] == 0 && value->len > 1) {
+        if (!(value->ptr[1] & 0x80)) {
+            return false;
+        }
+        aws_byte_cursor_advance(value, 1);
+    }
+
+    return true;
+}
+
+/* value without its leading zero bytes, keeping one for zero itself */
+static struct aws_byte_cursor s_ecdsa_trim_integer(struct aws_byte_cursor value) {
+    while (value.len > 1 && value.ptr[0] == 0) {
+        aws_byte_cursor_advance(&value, 1);
+    }
+    return value;
+}
+
+/* the encoded INTEGER's length, tag and length byte included */
+static size_t s_ecdsa_integer_length(struct aws_byte_cursor trimmed) {
+    return 2 + trimmed.len + ((trimmed.ptr[0] & 0x80) != 0);
+}
+
+static void s_ecdsa_write_integer(struct aws_byte_buf *buf, struct aws_byte_cursor trimmed) {
+    bool sign_byte = (trimmed.ptr[0] & 0x80) != 0;
+    aws_byte_buf_write_u8(buf, AWS_DER_INTEGER);
+    aws_byte_buf_write_u8(buf, (uint8_t)(trimmed.len + sign_byte));
+    if (sign_byte) {
+        aws_byte_buf_write_u8(buf, 0);
+    }
+    aws_byte_buf_write_from_whole_cursor(buf, trimmed);
+}
+
+/* appends value left padded with zeroes to element_size bytes; value is no longer than that */
+static void s_ecdsa_write_padded(struct aws_byte_buf *buf, struct aws_byte_cursor value, size_t element_size) {
+    memset(buf->buffer + buf->len, 0, element_size - value.len);
+    memcpy(buf->buffer + buf->len + element_size - value.len, value.ptr, value.len);
+    buf->len += element_size;
+}
+
+size_t aws_der_ecdsa_signature_max_length(size_t element_size) {
+    /* each INTEGER is a tag, a length, a sign byte and the value */
+    size_t body = 2 * (3 + element_size);
+    return (body < 0x80 ? 2 : 3) + body;
+}
+
+int aws_der_ecdsa_signature_parse(
+    struct aws_byte_cursor signature,
+    struct aws_byte_cursor *r,
+    struct aws_byte_cursor *s) {
+    uint8_t tag = 0;
+    size_t length = 0;
+
+    if (!aws_byte_cursor_read_u8(&signature, &tag) || tag != AWS_DER_SEQUENCE ||
+        !s_ecdsa_read_length(&signature, &length) || length != signature.len ||
+        !s_ecdsa_read_integer(&signature, r) || !s_ecdsa_read_integer(&signature, s) || signature.len != 0) {
+        return aws_raise_error(AWS_ERROR_CAL_MALFORMED_ASN1_ENCOUNTERED);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_der_ecdsa_signatures_to_raw(
+    const struct aws_byte_cursor *der_signatures,
+    size_t count,
+    size_t element_size,
+    struct aws_byte_buf *raw_signatures) {
+    if (element_size == 0 || element_size > AWS_DER_ECDSA_MAX_ELEMENT_SIZE) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (raw_signatures[i].capacity - raw_signatures[i].len < 2 * element_size) {
+            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        struct aws_byte_cursor r;
+        struct aws_byte_cursor s;
+        if (aws_der_ecdsa_signature_parse(der_signatures[i], &r, &s)) {
+            return AWS_OP_ERR;
+        }
+
+        r = s_ecdsa_trim_integer(r);
+        s = s_ecdsa_trim_integer(s);
+        if (r.len > element_size || s.len > element_size) {
+            return aws_raise_error(AWS_ERROR_CAL_MALFORMED_ASN1_ENCOUNTERED);
+        }
+
+        s_ecdsa_write_padded(&raw_signatures[i], r, element_size);
+        s_ecdsa_write_padded(&raw_signatures[i], s, element_size);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_der_ecdsa_signatures_from_raw(
+    const struct aws_byte_cursor *raw_signatures,
+    size_t count,
+    size_t element_size,
+    struct aws_byte_buf *der_signatures) {
+    if (element_size == 0 || element_size > AWS_DER_ECDSA_MAX_ELEMENT_SIZE) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    size_t max_length = aws_der_ecdsa_signature_max_length(element_size);
+    for (size_t i = 0; i < count; ++i) {
+        if (raw_signatures[i].len != 2 * element_size) {
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        }
+        if (der_signatures[i].capacity - der_signatures[i].len < max_length) {
+            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t *raw = raw_signatures[i].ptr;
+        struct aws_byte_cursor r = s_ecdsa_trim_integer(aws_byte_cursor_from_array(raw, element_size));
+        struct aws_byte_cursor s = s_ecdsa_trim_integer(aws_byte_cursor_from_array(raw + element_size, element_size));
+        size_t body = s_ecdsa_integer_length(r) + s_ecdsa_integer_length(s);
+
+        struct aws_byte_buf *der = &der_signatures[i];
+        aws_byte_buf_write_u8(der, AWS_DER_SEQUENCE);
+        if (body >= 0x80) {
+            aws_byte_buf_write_u8(der, 0x81);
+        }
+        aws_byte_buf_write_u8(der, (uint8_t)body);
+        s_ecdsa_write_integer(der, r);
+        s_ecdsa_write_integer(der, s);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 #ifdef _MSC_VER
 #    pragma warning(pop)
 #endif
@@ -0,0 +1,2628 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ec_native.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/hmac.h>
+#include <aws/cal/private/der.h>
+#include <aws/common/device_random.h>
+#include <aws/common/math.h>
+#include <aws/common/thread.h>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#    include <intrin.h>
+#endif
+
+#define S_MAX_LIMBS AWS_EC_NATIVE_MAX_LIMBS
+/* one extra bit for the carry out of the signed recoding */
+#define S_WINDOW_COUNT(bits) (((bits) + AWS_EC_NATIVE_WINDOW_BITS) / AWS_EC_NATIVE_WINDOW_BITS)
+#define S_P256_WINDOWS S_WINDOW_COUNT(256)
+#define S_P384_WINDOWS S_WINDOW_COUNT(384)
+
+static const struct aws_ec_native_curve s_p256 = {
+    .name = AWS_CAL_ECDSA_P256,
+    .limbs = 4,
+    .coordinate_size = 32,
+    .p =
+        {
+            .m = {0xffffffffffffffffULL, 0x00000000ffffffffULL, 0x0000000000000000ULL, 0xffffffff00000001ULL},
+            .rr = {0x0000000000000003ULL, 0xfffffffbffffffffULL, 0xfffffffffffffffeULL, 0x00000004fffffffdULL},
+            .one = {0x0000000000000001ULL, 0xffffffff00000000ULL, 0xffffffffffffffffULL, 0x00000000fffffffeULL},
+            .m0inv = 0x0000000000000001ULL,
+        },
+    .n =
+        {
+            .m = {0xf3b9cac2fc632551ULL, 0xbce6faada7179e84ULL, 0xffffffffffffffffULL, 0xffffffff00000000ULL},
+            .rr = {0x83244c95be79eea2ULL, 0x4699799c49bd6fa6ULL, 0x2845b2392b6bec59ULL, 0x66e12d94f3d95620ULL},
+            .one = {0x0c46353d039cdaafULL, 0x4319055258e8617bULL, 0x0000000000000000ULL, 0x00000000ffffffffULL},
+            .m0inv = 0xccd1c8aaee00bc4fULL,
+        },
+    .b = {0xd89cdf6229c4bddfULL, 0xacf005cd78843090ULL, 0xe5a220abf7212ed6ULL, 0xdc30061d04874834ULL},
+    .gx = {0x79e730d418a9143cULL, 0x75ba95fc5fedb601ULL, 0x79fb732b77622510ULL, 0x18905f76a53755c6ULL},
+    .gy = {0xddf25357ce95560aULL, 0x8b4ab8e4ba19e45cULL, 0xd2e88688dd21f325ULL, 0x8571ff1825885d85ULL},
+};
+
+static const struct aws_ec_native_curve s_p384 = {
+    .name = AWS_CAL_ECDSA_P384,
+    .limbs = 6,
+    .coordinate_size = 48,
+    .p =
+        {
+            .m =
+                {
+                    0x00000000ffffffffULL,
+                    0xffffffff00000000ULL,
+                    0xfffffffffffffffeULL,
+                    0xffffffffffffffffULL,
+                    0xffffffffffffffffULL,
+                    0xffffffffffffffffULL,
+                },
+            .rr =
+                {
+                    0xfffffffe00000001ULL,
+                    0x0000000200000000ULL,
+                    0xfffffffe00000000ULL,
+                    0x0000000200000000ULL,
+                    0x0000000000000001ULL,
+                    0x0000000000000000ULL,
+                },
+            .one =
+                {
+                    0xffffffff00000001ULL,
+                    0x00000000ffffffffULL,
+                    0x0000000000000001ULL,
+                    0x0000000000000000ULL,
+                    0x0000000000000000ULL,
+                    0x0000000000000000ULL,
+                },
+            .m0inv = 0x0000000100000001ULL,
+        },
+    .n =
+        {
+            .m =
+                {
+                    0xecec196accc52973ULL,
+                    0x581a0db248b0a77aULL,
+                    0xc7634d81f4372ddfULL,
+                    0xffffffffffffffffULL,
+                    0xffffffffffffffffULL,
+                    0xffffffffffffffffULL,
+                },
+            .rr =
+                {
+                    0x2d319b2419b409a9ULL,
+                    0xff3d81e5df1aa419ULL,
+                    0xbc3e483afcb82947ULL,
+                    0xd40d49174aab1cc5ULL,
+                    0x3fb05b7a28266895ULL,
+                    0x0c84ee012b39bf21ULL,
+                },
+            .one =
+                {
+                    0x1313e695333ad68dULL,
+                    0xa7e5f24db74f5885ULL,
+                    0x389cb27e0bc8d220ULL,
+                    0x0000000000000000ULL,
+                    0x0000000000000000ULL,
+                    0x0000000000000000ULL,
+                },
+            .m0inv = 0x6ed46089e88fdc45ULL,
+        },
+    .b =
+        {
+            0x081188719d412dccULL,
+            0xf729add87a4c32ecULL,
+            0x77f2209b1920022eULL,
+            0xe3374bee94938ae2ULL,
+            0xb62b21f41f022094ULL,
+            0xcd08114b604fbff9ULL,
+        },
+    .gx =
+        {
+            0x3dd0756649c0b528ULL,
+            0x20e378e2a0d6ce38ULL,
+            0x879c3afc541b4d6eULL,
+            0x6454868459a30effULL,
+            0x812ff723614ede2bULL,
+            0x4d3aadc2299e1513ULL,
+        },
+    .gy =
+        {
+            0x23043dad4b03a4feULL,
+            0xa1bfa8bf7bb4a9acULL,
+            0x8bade7562e83b050ULL,
+            0xc6c3521968f4ffd9ULL,
+            0xdd8002263969a840ULL,
+            0x2b78abc25a15c5e9ULL,
+        },
+};
+
+const struct aws_ec_native_curve *aws_ec_native_curve_get(enum aws_ecc_curve_name curve_name) {
+    switch (curve_name) {
+        case AWS_CAL_ECDSA_P256:
+            return &s_p256;
+        case AWS_CAL_ECDSA_P384:
+            return &s_p384;
+        default:
+            return NULL;
+    }
+}
+
+/*
+ * Word arithmetic. s_mac() returns the low word of a * b + c + d and writes the high word to *hi; the sum cannot
+ * overflow 128 bits.
+ */
+#if defined(__SIZEOF_INT128__)
+/* __extension__ keeps -pedantic builds quiet about the non-ISO type */
+__extension__ typedef unsigned __int128 s_uint128;
+#endif
+
+static inline uint64_t s_mac(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t *hi) {
+#if defined(__SIZEOF_INT128__)
+    s_uint128 t = (s_uint128)a * b + c + d;
+    *hi = (uint64_t)(t >> 64);
+    return (uint64_t)t;
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    uint64_t high = 0;
+    uint64_t low = _umul128(a, b, &high);
+    _addcarry_u64(_addcarry_u64(0, low, c, &low), high, 0, &high);
+    _addcarry_u64(_addcarry_u64(0, low, d, &low), high, 0, &high);
+    *hi = high;
+    return low;
+#else
+    uint64_t a_lo = a & 0xffffffff;
+    uint64_t a_hi = a >> 32;
+    uint64_t b_lo = b & 0xffffffff;
+    uint64_t b_hi = b >> 32;
+
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t middle = (lo_lo >> 32) + (lo_hi & 0xffffffff) + (hi_lo & 0xffffffff);
+
+    uint64_t low = (lo_lo & 0xffffffff) | (middle << 32);
+    uint64_t high = a_hi * b_hi + (lo_hi >> 32) + (hi_lo >> 32) + (middle >> 32);
+
+    low += c;
+    high += low < c;
+    low += d;
+    high += low < d;
+    *hi = high;
+    return low;
+#endif
+}
+
+static inline uint64_t s_adc(uint64_t a, uint64_t b, uint64_t carry_in, uint64_t *carry_out) {
+    uint64_t t = a + carry_in;
+    uint64_t r = t + b;
+    *carry_out = (t < carry_in) | (r < b);
+    return r;
+}
+
+static inline uint64_t s_sbb(uint64_t a, uint64_t b, uint64_t borrow_in, uint64_t *borrow_out) {
+    uint64_t t = a - b;
+    uint64_t r = t - borrow_in;
+    *borrow_out = (a < b) | (t < borrow_in);
+    return r;
+}
+
+/*
+ * Modular arithmetic. Everything up to s_mod_inv() is constant time; the helpers named _vartime and the comparisons
+ * used on public data are not. The limb count is passed down as a constant from the 4 and 6 limb wrappers so that
+ * the compiler can unroll each specialization.
+ */
+
+/* r = t - m if t >= m, else t. t_high is the word above t's top limb. */
+static inline void s_mod_reduce_once(uint64_t *r, const uint64_t *t, uint64_t t_high, const uint64_t *m, size_t limbs) {
+    uint64_t reduced[S_MAX_LIMBS];
+    uint64_t borrow = 0;
+
+    for (size_t i = 0; i < limbs; ++i) {
+        reduced[i] = s_sbb(t[i], m[i], borrow, &borrow);
+    }
+    s_sbb(t_high, 0, borrow, &borrow);
+
+    uint64_t keep_t = 0 - borrow;
+    for (size_t i = 0; i < limbs; ++i) {
+        r[i] = (t[i] & keep_t) | (reduced[i] & ~keep_t);
+    }
+}
+
+/* Montgomery multiplication: a full product followed by word by word reduction. */
+static inline void s_mont_mul_limbs(
+    uint64_t *r,
+    const uint64_t *a,
+    const uint64_t *b,
+    const struct aws_ec_native_modulus *mod,
+    size_t limbs) {
+    uint64_t t[2 * S_MAX_LIMBS];
+    uint64_t carry = 0;
+
+    for (size_t j = 0; j < limbs; ++j) {
+        t[j] = s_mac(a[j], b[0], 0, carry, &carry);
+    }
+    t[limbs] = carry;
+
+    for (size_t i = 1; i < limbs; ++i) {
+        carry = 0;
+        for (size_t j = 0; j < limbs; ++j) {
+            t[i + j] = s_mac(a[j], b[i], t[i + j], carry, &carry);
+        }
+        t[i + limbs] = carry;
+    }
+
+    uint64_t overflow = 0;
+    for (size_t i = 0; i < limbs; ++i) {
+        uint64_t q = t[i] * mod->m0inv;
+        s_mac(q, mod->m[0], t[i], 0, &carry);
+        for (size_t j = 1; j < limbs; ++j) {
+            t[i + j] = s_mac(q, mod->m[j], t[i + j], carry, &carry);
+        }
+        t[i + limbs] = s_adc(t[i + limbs], carry, overflow, &overflow);
+    }
+
+    s_mod_reduce_once(r, t + limbs, overflow, mod->m, limbs);
+}
+
+static void s_mont_mul_4(uint64_t *r, const uint64_t *a, const uint64_t *b, const struct aws_ec_native_modulus *mod) {
+    s_mont_mul_limbs(r, a, b, mod, 4);
+}
+
+static void s_mont_mul_6(uint64_t *r, const uint64_t *a, const uint64_t *b, const struct aws_ec_native_modulus *mod) {
+    s_mont_mul_limbs(r, a, b, mod, 6);
+}
+
+static inline void s_mod_mul(
+    uint64_t *r,
+    const uint64_t *a,
+    const uint64_t *b,
+    const struct aws_ec_native_modulus *mod,
+    size_t limbs) {
+    if (limbs == 4) {
+        s_mont_mul_4(r, a, b, mod);
+    } else {
+        s_mont_mul_6(r, a, b, mod);
+    }
+}
+
+static inline void s_mod_add_limbs(
+    uint64_t *r,
+    const uint64_t *a,
+    const uint64_t *b,
+    const uint64_t *m,
+    size_t limbs) {
+    uint64_t t[S_MAX_LIMBS];
+    uint64_t carry = 0;
+
+    for (size_t i = 0; i < limbs; ++i) {
+        t[i] = s_adc(a[i], b[i], carry, &carry);
+    }
+
+    s_mod_reduce_once(r, t, carry, m, limbs);
+}
+
+static inline void s_mod_sub_limbs(
+    uint64_t *r,
+    const uint64_t *a,
+    const uint64_t *b,
+    const uint64_t *m,
+    size_t limbs) {
+    uint64_t borrow = 0;
+
+    for (size_t i = 0; i < limbs; ++i) {
+        r[i] = s_sbb(a[i], b[i], borrow, &borrow);
+    }
+
+    uint64_t add_back = 0 - borrow;
+    uint64_t carry = 0;
+    for (size_t i = 0; i < limbs; ++i) {
+        r[i] = s_adc(r[i], m[i] & add_back, carry, &carry);
+    }
+}
+
+static inline void s_mod_add(uint64_t *r, const uint64_t *a, const uint64_t *b, const uint64_t *m, size_t limbs) {
+    if (limbs == 4) {
+        s_mod_add_limbs(r, a, b, m, 4);
+    } else {
+        s_mod_add_limbs(r, a, b, m, 6);
+    }
+}
+
+static inline void s_mod_sub(uint64_t *r, const uint64_t *a, const uint64_t *b, const uint64_t *m, size_t limbs) {
+    if (limbs == 4) {
+        s_mod_sub_limbs(r, a, b, m, 4);
+    } else {
+        s_mod_sub_limbs(r, a, b, m, 6);
+    }
+}
+
+static inline bool s_limbs_is_zero(const uint64_t *a, size_t limbs) {
+    uint64_t acc = 0;
+    for (size_t i = 0; i < limbs; ++i) {
+        acc |= a[i];
+    }
+    return acc == 0;
+}
+
+static inline bool s_limbs_equal(const uint64_t *a, const uint64_t *b, size_t limbs) {
+    uint64_t acc = 0;
+    for (size_t i = 0; i < limbs; ++i) {
+        acc |= a[i] ^ b[i];
+    }
+    return acc == 0;
+}
+
+/* a < b, variable time */
+static bool s_limbs_less_than(const uint64_t *a, const uint64_t *b, size_t limbs) {
+    for (size_t i = limbs; i > 0; --i) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] < b[i - 1];
+        }
+    }
+    return false;
+}
+
+/*
+ * a^(m - 2), which is a^-1 for prime m. Both input and output are in Montgomery form. Fixed 4 bit windows over the
+ * public exponent, so the timing does not depend on a.
+ */
+static void s_mod_inv(uint64_t *r, const uint64_t *a, const struct aws_ec_native_modulus *mod, size_t limbs) {
+    uint64_t powers[16][S_MAX_LIMBS];
+    memcpy(powers[0], mod->one, sizeof(powers[0]));
+    memcpy(powers[1], a, limbs * sizeof(uint64_t));
+    for (size_t i = 2; i < 16; ++i) {
+        s_mod_mul(powers[i], powers[i - 1], a, mod, limbs);
+    }
+
+    uint64_t exponent[S_MAX_LIMBS];
+    uint64_t borrow = 0;
+    exponent[0] = s_sbb(mod->m[0], 2, 0, &borrow);
+    for (size_t i = 1; i < limbs; ++i) {
+        exponent[i] = s_sbb(mod->m[i], 0, borrow, &borrow);
+    }
+
+    uint64_t acc[S_MAX_LIMBS];
+    memcpy(acc, mod->one, sizeof(acc));
+    for (size_t window = limbs * 16; window > 0; --window) {
+        size_t bit = (window - 1) * 4;
+        size_t digit = (size_t)(exponent[bit / 64] >> (bit % 64)) & 0xf;
+        for (size_t i = 0; i < 4; ++i) {
+            s_mod_mul(acc, acc, acc, mod, limbs);
+        }
+        s_mod_mul(acc, acc, powers[digit], mod, limbs);
+    }
+
+    memcpy(r, acc, limbs * sizeof(uint64_t));
+}
+
+static inline bool s_limbs_is_even(const uint64_t *a) {
+    return (a[0] & 1) == 0;
+}
+
+static inline bool s_limbs_is_one(const uint64_t *a, size_t limbs) {
+    uint64_t acc = a[0] ^ 1;
+    for (size_t i = 1; i < limbs; ++i) {
+        acc |= a[i];
+    }
+    return acc == 0;
+}
+
+/* a = (a + (top << 64 * limbs)) / 2 */
+static inline void s_limbs_halve(uint64_t *a, uint64_t top, size_t limbs) {
+    for (size_t i = 0; i + 1 < limbs; ++i) {
+        a[i] = (a[i] >> 1) | (a[i + 1] << 63);
+    }
+    a[limbs - 1] = (a[limbs - 1] >> 1) | (top << 63);
+}
+
+/* x = x / 2 mod m, for odd m */
+static inline void s_mod_halve(uint64_t *x, const uint64_t *m, size_t limbs) {
+    uint64_t carry = 0;
+    if (!s_limbs_is_even(x)) {
+        for (size_t i = 0; i < limbs; ++i) {
+            x[i] = s_adc(x[i], m[i], carry, &carry);
+        }
+    }
+    s_limbs_halve(x, carry, limbs);
+}
+
+static inline void s_limbs_sub(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t limbs) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < limbs; ++i) {
+        r[i] = s_sbb(a[i], b[i], borrow, &borrow);
+    }
+}
+
+/*
+ * a^-1 mod m for odd m and 0 < a < m, by the binary extended Euclidean algorithm. Plain (not Montgomery) values in
+ * and out. Its running time depends on a, so it is only ever used on public values.
+ */
+static void s_mod_inv_vartime(uint64_t *r, const uint64_t *a, const uint64_t *m, size_t limbs) {
+    uint64_t u[S_MAX_LIMBS], v[S_MAX_LIMBS], x1[S_MAX_LIMBS] = {1}, x2[S_MAX_LIMBS] = {0};
+    memcpy(u, a, limbs * sizeof(uint64_t));
+    memcpy(v, m, limbs * sizeof(uint64_t));
+
+    /* invariants: x1 * a = u and x2 * a = v (mod m) */
+    while (!s_limbs_is_one(u, limbs) && !s_limbs_is_one(v, limbs)) {
+        while (s_limbs_is_even(u)) {
+            s_limbs_halve(u, 0, limbs);
+            s_mod_halve(x1, m, limbs);
+        }
+        while (s_limbs_is_even(v)) {
+            s_limbs_halve(v, 0, limbs);
+            s_mod_halve(x2, m, limbs);
+        }
+        if (s_limbs_less_than(u, v, limbs)) {
+            s_limbs_sub(v, v, u, limbs);
+            s_mod_sub(x2, x2, x1, m, limbs);
+        } else {
+            s_limbs_sub(u, u, v, limbs);
+            s_mod_sub(x1, x1, x2, m, limbs);
+        }
+    }
+
+    memcpy(r, s_limbs_is_one(u, limbs) ? x1 : x2, limbs * sizeof(uint64_t));
+}
+
+/*
+ * Big endian bytes to limbs. Returns false if the value does not fit in limbs words. Leading zeros are only looked at
+ * when the input is longer than the limbs, so for inputs of a fixed length it is constant time.
+ */
+static bool s_limbs_from_be_bytes(uint64_t *r, struct aws_byte_cursor bytes, size_t limbs) {
+    while (bytes.len > limbs * 8 && bytes.ptr[0] == 0) {
+        aws_byte_cursor_advance(&bytes, 1);
+    }
+
+    if (bytes.len > limbs * 8) {
+        return false;
+    }
+
+    memset(r, 0, limbs * sizeof(uint64_t));
+    for (size_t i = 0; i < bytes.len; ++i) {
+        size_t shift = 8 * (bytes.len - 1 - i);
+        r[shift / 64] |= (uint64_t)bytes.ptr[i] << (shift % 64);
+    }
+
+    return true;
+}
+
+/* Writes the low size bytes of a, big endian. */
+static void s_limbs_to_be_bytes(uint8_t *out, const uint64_t *a, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        out[size - 1 - i] = (uint8_t)(a[i / 8] >> (8 * (i % 8)));
+    }
+}
+
+/* Constant time helpers for the code paths that handle secrets. */
+
+/* all ones if a == 0, else zero */
+static inline uint64_t s_ct_is_zero_mask(uint64_t a) {
+    return ((a | (0 - a)) >> 63) - 1;
+}
+
+/* r = mask ? a : b, for a mask of all ones or all zeros */
+static inline void s_ct_select(uint64_t *r, const uint64_t *a, const uint64_t *b, uint64_t mask, size_t limbs) {
+    for (size_t i = 0; i < limbs; ++i) {
+        r[i] = (a[i] & mask) | (b[i] & ~mask);
+    }
+}
+
+static const uint64_t s_plain_one[S_MAX_LIMBS] = {1};
+
+/* Jacobian points over the curve's field, (X, Y, Z) represents (X / Z^2, Y / Z^3). Z = 0 is the point at infinity. */
+struct s_jacobian {
+    uint64_t x[S_MAX_LIMBS];
+    uint64_t y[S_MAX_LIMBS];
+    uint64_t z[S_MAX_LIMBS];
+};
+
+#define S_FMUL(r, a, b) s_mod_mul((r), (a), (b), &curve->p, limbs)
+#define S_FADD(r, a, b) s_mod_add((r), (a), (b), curve->p.m, limbs)
+#define S_FSUB(r, a, b) s_mod_sub((r), (a), (b), curve->p.m, limbs)
+
+/* dbl-2001-b, for a = -3. Handles infinity and may run in place. */
+static void s_point_double(const struct aws_ec_native_curve *curve, struct s_jacobian *r, const struct s_jacobian *a) {
+    size_t limbs = curve->limbs;
+    uint64_t delta[S_MAX_LIMBS], gamma[S_MAX_LIMBS], beta[S_MAX_LIMBS], alpha[S_MAX_LIMBS];
+    uint64_t t0[S_MAX_LIMBS], t1[S_MAX_LIMBS];
+
+    S_FMUL(delta, a->z, a->z);
+    S_FMUL(gamma, a->y, a->y);
+    S_FMUL(beta, a->x, gamma);
+
+    /* alpha = 3 * (X - delta) * (X + delta) */
+    S_FSUB(t0, a->x, delta);
+    S_FADD(t1, a->x, delta);
+    S_FMUL(alpha, t0, t1);
+    S_FADD(t0, alpha, alpha);
+    S_FADD(alpha, t0, alpha);
+
+    /* Z3 = (Y + Z)^2 - gamma - delta, before X and Y are overwritten */
+    S_FADD(t0, a->y, a->z);
+    S_FMUL(t0, t0, t0);
+    S_FSUB(t0, t0, gamma);
+    S_FSUB(r->z, t0, delta);
+
+    /* X3 = alpha^2 - 8 * beta */
+    S_FADD(beta, beta, beta);
+    S_FADD(beta, beta, beta);
+    S_FMUL(t0, alpha, alpha);
+    S_FADD(t1, beta, beta);
+    S_FSUB(r->x, t0, t1);
+
+    /* Y3 = alpha * (4 * beta - X3) - 8 * gamma^2 */
+    S_FSUB(t0, beta, r->x);
+    S_FMUL(t0, alpha, t0);
+    S_FMUL(gamma, gamma, gamma);
+    S_FADD(gamma, gamma, gamma);
+    S_FADD(gamma, gamma, gamma);
+    S_FADD(gamma, gamma, gamma);
+    S_FSUB(r->y, t0, gamma);
+}
+
+/*
+ * Shared tail of the additions: given H = U2 - U1 and R = S2 - S1, with U1, S1 from the first operand, computes
+ * X3 = R^2 - H^3 - 2 * U1 * H^2, Y3 = R * (U1 * H^2 - X3) - S1 * H^3. The caller sets Z3.
+ */
+static void s_point_add_finish(
+    const struct aws_ec_native_curve *curve,
+    struct s_jacobian *r,
+    const uint64_t *u1,
+    const uint64_t *s1,
+    const uint64_t *h,
+    const uint64_t *rr) {
+    size_t limbs = curve->limbs;
+    uint64_t hh[S_MAX_LIMBS], hhh[S_MAX_LIMBS], v[S_MAX_LIMBS], t0[S_MAX_LIMBS];
+
+    S_FMUL(hh, h, h);
+    S_FMUL(hhh, hh, h);
+    S_FMUL(v, u1, hh);
+
+    S_FMUL(t0, rr, rr);
+    S_FSUB(t0, t0, hhh);
+    S_FSUB(t0, t0, v);
+    S_FSUB(r->x, t0, v);
+
+    S_FSUB(t0, v, r->x);
+    S_FMUL(t0, rr, t0);
+    S_FMUL(v, s1, hhh);
+    S_FSUB(r->y, t0, v);
+}
+
+/*
+ * r = a + b, where b is affine (x, y) and not infinity. Not constant time: the exceptional cases are branched on,
+ * which is only acceptable because verification works on public data.
+ */
+static void s_point_add_mixed(
+    const struct aws_ec_native_curve *curve,
+    struct s_jacobian *r,
+    const struct s_jacobian *a,
+    const uint64_t *bx,
+    const uint64_t *by) {
+    size_t limbs = curve->limbs;
+
+    if (s_limbs_is_zero(a->z, limbs)) {
+        memcpy(r->x, bx, limbs * sizeof(uint64_t));
+        memcpy(r->y, by, limbs * sizeof(uint64_t));
+        memcpy(r->z, curve->p.one, limbs * sizeof(uint64_t));
+        return;
+    }
+
+    uint64_t zz[S_MAX_LIMBS], u2[S_MAX_LIMBS], s2[S_MAX_LIMBS], h[S_MAX_LIMBS], rr[S_MAX_LIMBS];
+
+    S_FMUL(zz, a->z, a->z);
+    S_FMUL(u2, bx, zz);
+    S_FMUL(s2, a->z, zz);
+    S_FMUL(s2, by, s2);
+    S_FSUB(h, u2, a->x);
+    S_FSUB(rr, s2, a->y);
+
+    if (s_limbs_is_zero(h, limbs)) {
+        if (s_limbs_is_zero(rr, limbs)) {
+            struct s_jacobian b;
+            memcpy(b.x, bx, limbs * sizeof(uint64_t));
+            memcpy(b.y, by, limbs * sizeof(uint64_t));
+            memcpy(b.z, curve->p.one, limbs * sizeof(uint64_t));
+            s_point_double(curve, r, &b);
+        } else {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+
+    uint64_t z3[S_MAX_LIMBS];
+    S_FMUL(z3, a->z, h);
+
+    struct s_jacobian a_copy = *a;
+    s_point_add_finish(curve, r, a_copy.x, a_copy.y, h, rr);
+    memcpy(r->z, z3, limbs * sizeof(uint64_t));
+}
+
+/* r = a + b for Jacobian a and b. Same caveats as s_point_add_mixed(). */
+static void s_point_add(
+    const struct aws_ec_native_curve *curve,
+    struct s_jacobian *r,
+    const struct s_jacobian *a,
+    const struct s_jacobian *b) {
+    size_t limbs = curve->limbs;
+
+    if (s_limbs_is_zero(a->z, limbs)) {
+        *r = *b;
+        return;
+    }
+    if (s_limbs_is_zero(b->z, limbs)) {
+        *r = *a;
+        return;
+    }
+
+    uint64_t z1z1[S_MAX_LIMBS], z2z2[S_MAX_LIMBS], u1[S_MAX_LIMBS], u2[S_MAX_LIMBS];
+    uint64_t s1[S_MAX_LIMBS], s2[S_MAX_LIMBS], h[S_MAX_LIMBS], rr[S_MAX_LIMBS];
+
+    S_FMUL(z1z1, a->z, a->z);
+    S_FMUL(z2z2, b->z, b->z);
+    S_FMUL(u1, a->x, z2z2);
+    S_FMUL(u2, b->x, z1z1);
+    S_FMUL(s1, b->z, z2z2);
+    S_FMUL(s1, a->y, s1);
+    S_FMUL(s2, a->z, z1z1);
+    S_FMUL(s2, b->y, s2);
+    S_FSUB(h, u2, u1);
+    S_FSUB(rr, s2, s1);
+
+    if (s_limbs_is_zero(h, limbs)) {
+        if (s_limbs_is_zero(rr, limbs)) {
+            s_point_double(curve, r, a);
+        } else {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+
+    uint64_t z3[S_MAX_LIMBS];
+    S_FMUL(z3, a->z, b->z);
+    S_FMUL(z3, z3, h);
+
+    s_point_add_finish(curve, r, u1, s1, h, rr);
+    memcpy(r->z, z3, limbs * sizeof(uint64_t));
+}
+
+/* rhs = x^3 - 3x + b, the right hand side of the curve equation */
+static void s_curve_rhs(const struct aws_ec_native_curve *curve, uint64_t *rhs, const uint64_t *x) {
+    size_t limbs = curve->limbs;
+    uint64_t t0[S_MAX_LIMBS];
+
+    S_FMUL(rhs, x, x);
+    S_FMUL(rhs, rhs, x);
+    S_FADD(t0, x, x);
+    S_FADD(t0, t0, x);
+    S_FSUB(rhs, rhs, t0);
+    S_FADD(rhs, rhs, curve->b);
+}
+
+static bool s_point_is_on_curve(const struct aws_ec_native_curve *curve, const uint64_t *x, const uint64_t *y) {
+    size_t limbs = curve->limbs;
+    uint64_t lhs[S_MAX_LIMBS], rhs[S_MAX_LIMBS];
+
+    /* y^2 = x^3 - 3x + b */
+    S_FMUL(lhs, y, y);
+    s_curve_rhs(curve, rhs, x);
+
+    return s_limbs_equal(lhs, rhs, limbs);
+}
+
+/* r = a^(2^n), in place allowed */
+static void s_field_square_n(const struct aws_ec_native_curve *curve, uint64_t *r, const uint64_t *a, size_t n) {
+    size_t limbs = curve->limbs;
+
+    memcpy(r, a, limbs * sizeof(uint64_t));
+    for (size_t i = 0; i < n; ++i) {
+        S_FMUL(r, r, r);
+    }
+}
+
+/*
+ * r = a^((p + 1) / 4), which is a square root of a whenever a has one, since both primes are 3 mod 4. Each curve has
+ * its own addition chain over the runs of ones in the exponent: 253 squarings and 7 multiplications for P-256, 383
+ * squarings and 13 multiplications for P-384. The chain is fixed, so the timing does not depend on a.
+ */
+static void s_field_sqrt_candidate(const struct aws_ec_native_curve *curve, uint64_t *r, const uint64_t *a) {
+    size_t limbs = curve->limbs;
+    /* xk = a^(2^k - 1) */
+    uint64_t x2[S_MAX_LIMBS], x3[S_MAX_LIMBS], x6[S_MAX_LIMBS], x12[S_MAX_LIMBS], x15[S_MAX_LIMBS];
+    uint64_t x30[S_MAX_LIMBS], x32[S_MAX_LIMBS], x60[S_MAX_LIMBS], x120[S_MAX_LIMBS], acc[S_MAX_LIMBS];
+
+    S_FMUL(x2, a, a);
+    S_FMUL(x2, x2, a);
+
+    if (curve->name == AWS_CAL_ECDSA_P256) {
+        /* (p + 1) / 4 = ((((2^32 - 1) * 2^32 + 1) * 2^96 + 1) * 2^94 */
+        uint64_t x4[S_MAX_LIMBS], x8[S_MAX_LIMBS], x16[S_MAX_LIMBS];
+
+        s_field_square_n(curve, x4, x2, 2);
+        S_FMUL(x4, x4, x2);
+        s_field_square_n(curve, x8, x4, 4);
+        S_FMUL(x8, x8, x4);
+        s_field_square_n(curve, x16, x8, 8);
+        S_FMUL(x16, x16, x8);
+        s_field_square_n(curve, x32, x16, 16);
+        S_FMUL(x32, x32, x16);
+
+        s_field_square_n(curve, acc, x32, 32);
+        S_FMUL(acc, acc, a);
+        s_field_square_n(curve, acc, acc, 96);
+        S_FMUL(acc, acc, a);
+        s_field_square_n(curve, r, acc, 94);
+        return;
+    }
+
+    /* (p + 1) / 4 = ((((2^255 - 1) * 2^33 + 2^32 - 1) * 2^64 + 1) * 2^30 */
+    S_FMUL(x3, x2, x2);
+    S_FMUL(x3, x3, a);
+    s_field_square_n(curve, x6, x3, 3);
+    S_FMUL(x6, x6, x3);
+    s_field_square_n(curve, x12, x6, 6);
+    S_FMUL(x12, x12, x6);
+    s_field_square_n(curve, x15, x12, 3);
+    S_FMUL(x15, x15, x3);
+    s_field_square_n(curve, x30, x15, 15);
+    S_FMUL(x30, x30, x15);
+    s_field_square_n(curve, x32, x30, 2);
+    S_FMUL(x32, x32, x2);
+
+    s_field_square_n(curve, x60, x30, 30);
+    S_FMUL(x60, x60, x30);
+    s_field_square_n(curve, x120, x60, 60);
+    S_FMUL(x120, x120, x60);
+    s_field_square_n(curve, acc, x120, 120);
+    S_FMUL(acc, acc, x120);
+    s_field_square_n(curve, acc, acc, 15);
+    S_FMUL(acc, acc, x15);
+
+    s_field_square_n(curve, acc, acc, 33);
+    S_FMUL(acc, acc, x32);
+    s_field_square_n(curve, acc, acc, 64);
+    S_FMUL(acc, acc, a);
+    s_field_square_n(curve, r, acc, 30);
+}
+
+static size_t s_window_count(const struct aws_ec_native_curve *curve) {
+    return S_WINDOW_COUNT(curve->limbs * 64);
+}
+
+/*
+ * Fills points (windows * 16 affine entries) for the base point (x, y): within each window, entry j is (j + 1) * B
+ * and the next window's B is 32 * B = 2 * (16 * B). Everything is computed in Jacobian coordinates and converted
+ * with a single inversion using Montgomery's trick.
+ */
+static int s_build_table(
+    struct aws_allocator *allocator,
+    const struct aws_ec_native_curve *curve,
+    const uint64_t *x,
+    const uint64_t *y,
+    uint64_t *points) {
+    size_t limbs = curve->limbs;
+    size_t windows = s_window_count(curve);
+    size_t count = windows * AWS_EC_NATIVE_WINDOW_ENTRIES;
+
+    struct s_jacobian *jacobian = aws_mem_calloc(allocator, count, sizeof(struct s_jacobian));
+    uint64_t *prefix = aws_mem_calloc(allocator, count, S_MAX_LIMBS * sizeof(uint64_t));
+    if (!jacobian || !prefix) {
+        aws_mem_release(allocator, jacobian);
+        aws_mem_release(allocator, prefix);
+        return AWS_OP_ERR;
+    }
+
+    struct s_jacobian base;
+    AWS_ZERO_STRUCT(base);
+    memcpy(base.x, x, limbs * sizeof(uint64_t));
+    memcpy(base.y, y, limbs * sizeof(uint64_t));
+    memcpy(base.z, curve->p.one, limbs * sizeof(uint64_t));
+
+    for (size_t window = 0; window < windows; ++window) {
+        struct s_jacobian *row = jacobian + window * AWS_EC_NATIVE_WINDOW_ENTRIES;
+        row[0] = base;
+        s_point_double(curve, &row[1], &base);
+        for (size_t j = 2; j < AWS_EC_NATIVE_WINDOW_ENTRIES; ++j) {
+            s_point_add(curve, &row[j], &row[j - 1], &base);
+        }
+        s_point_double(curve, &base, &row[AWS_EC_NATIVE_WINDOW_ENTRIES - 1]);
+    }
+
+    /*
+     * prefix[i] = z_0 * ... * z_i. None of the multiples is infinity: they are all small multiples of powers of two
+     * times a point of prime order.
+     */
+    memcpy(prefix, jacobian[0].z, limbs * sizeof(uint64_t));
+    for (size_t i = 1; i < count; ++i) {
+        S_FMUL(prefix + i * S_MAX_LIMBS, prefix + (i - 1) * S_MAX_LIMBS, jacobian[i].z);
+    }
+
+    uint64_t inverse[S_MAX_LIMBS];
+    s_mod_inv(inverse, prefix + (count - 1) * S_MAX_LIMBS, &curve->p, limbs);
+
+    for (size_t i = count; i > 0; --i) {
+        size_t index = i - 1;
+        uint64_t z_inv[S_MAX_LIMBS], z_inv2[S_MAX_LIMBS], z_inv3[S_MAX_LIMBS];
+
+        if (index > 0) {
+            S_FMUL(z_inv, inverse, prefix + (index - 1) * S_MAX_LIMBS);
+            S_FMUL(inverse, inverse, jacobian[index].z);
+        } else {
+            memcpy(z_inv, inverse, sizeof(z_inv));
+        }
+
+        S_FMUL(z_inv2, z_inv, z_inv);
+        S_FMUL(z_inv3, z_inv2, z_inv);
+
+        uint64_t *entry = points + index * 2 * limbs;
+        S_FMUL(entry, jacobian[index].x, z_inv2);
+        S_FMUL(entry + limbs, jacobian[index].y, z_inv3);
+    }
+
+    aws_mem_release(allocator, jacobian);
+    aws_mem_release(allocator, prefix);
+
+    return AWS_OP_SUCCESS;
+}
+
+size_t aws_ec_native_generator_table_length(enum aws_ecc_curve_name curve_name) {
+    const struct aws_ec_native_curve *curve = aws_ec_native_curve_get(curve_name);
+    if (!curve) {
+        return 0;
+    }
+
+    return s_window_count(curve) * AWS_EC_NATIVE_WINDOW_ENTRIES * 2 * curve->limbs;
+}
+
+int aws_ec_native_build_generator_table(enum aws_ecc_curve_name curve_name, uint64_t *points) {
+    const struct aws_ec_native_curve *curve = aws_ec_native_curve_get(curve_name);
+    if (!curve) {
+        return aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    }
+
+    return s_build_table(aws_default_allocator(), curve, curve->gx, curve->gy, points);
+}
+
+#ifdef AWS_EC_NATIVE_PRECOMPUTED_TABLES
+/*
+ * The generator tables were computed at build time by bin/ec_table_gen into read only data, so there is nothing to
+ * build or synchronize at runtime.
+ */
+extern const uint64_t aws_ec_native_p256_generator_points[S_P256_WINDOWS * AWS_EC_NATIVE_WINDOW_ENTRIES * 2 * 4];
+extern const uint64_t aws_ec_native_p384_generator_points[S_P384_WINDOWS * AWS_EC_NATIVE_WINDOW_ENTRIES * 2 * 6];
+
+static const struct aws_ec_native_table s_p256_generator_table = {
+    .curve = &s_p256,
+    .windows = S_P256_WINDOWS,
+    .points = aws_ec_native_p256_generator_points,
+};
+
+static const struct aws_ec_native_table s_p384_generator_table = {
+    .curve = &s_p384,
+    .windows = S_P384_WINDOWS,
+    .points = aws_ec_native_p384_generator_points,
+};
+
+static const struct aws_ec_native_table *s_generator_table(const struct aws_ec_native_curve *curve) {
+    return curve->name == AWS_CAL_ECDSA_P256 ? &s_p256_generator_table : &s_p384_generator_table;
+}
+#else
+/*
+ * Without build time tables (cross compiled builds, and ec_table_gen itself), the generator tables are built the
+ * first time a curve is used and live for the rest of the process; they are a pure function of the curve, so there
+ * is nothing to tear down with the library.
+ */
+static uint64_t s_p256_generator_points[S_P256_WINDOWS * AWS_EC_NATIVE_WINDOW_ENTRIES * 2 * 4];
+static uint64_t s_p384_generator_points[S_P384_WINDOWS * AWS_EC_NATIVE_WINDOW_ENTRIES * 2 * 6];
+
+static struct aws_ec_native_table s_p256_generator_table = {
+    .curve = &s_p256,
+    .windows = S_P256_WINDOWS,
+    .points = s_p256_generator_points,
+};
+
+static struct aws_ec_native_table s_p384_generator_table = {
+    .curve = &s_p384,
+    .windows = S_P384_WINDOWS,
+    .points = s_p384_generator_points,
+};
+
+static aws_thread_once s_p256_generator_once = AWS_THREAD_ONCE_STATIC_INIT;
+static aws_thread_once s_p384_generator_once = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void s_build_generator_table(void *user_data) {
+    uint64_t *points = user_data;
+    enum aws_ecc_curve_name curve_name = points == s_p256_generator_points ? AWS_CAL_ECDSA_P256 : AWS_CAL_ECDSA_P384;
+
+    AWS_FATAL_ASSERT(
+        aws_ec_native_build_generator_table(curve_name, points) == AWS_OP_SUCCESS &&
+        "building the generator table failed");
+}
+
+static const struct aws_ec_native_table *s_generator_table(const struct aws_ec_native_curve *curve) {
+    if (curve->name == AWS_CAL_ECDSA_P256) {
+        aws_thread_call_once(&s_p256_generator_once, s_build_generator_table, s_p256_generator_points);
+        return &s_p256_generator_table;
+    }
+
+    aws_thread_call_once(&s_p384_generator_once, s_build_generator_table, s_p384_generator_points);
+    return &s_p384_generator_table;
+}
+#endif /* AWS_EC_NATIVE_PRECOMPUTED_TABLES */
+
+const struct aws_ec_native_table *aws_ec_native_generator_table(enum aws_ecc_curve_name curve_name) {
+    const struct aws_ec_native_curve *curve = aws_ec_native_curve_get(curve_name);
+    if (!curve) {
+        aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+        return NULL;
+    }
+
+    return s_generator_table(curve);
+}
+
+/* Parses and validates an affine public point, leaving it in Montgomery form. */
+static bool s_point_from_be_bytes(
+    const struct aws_ec_native_curve *curve,
+    struct aws_byte_cursor x_bytes,
+    struct aws_byte_cursor y_bytes,
+    uint64_t *x,
+    uint64_t *y) {
+    size_t limbs = curve->limbs;
+
+    if (x_bytes.len > curve->coordinate_size || y_bytes.len > curve->coordinate_size ||
+        !s_limbs_from_be_bytes(x, x_bytes, limbs) || !s_limbs_from_be_bytes(y, y_bytes, limbs) ||
+        !s_limbs_less_than(x, curve->p.m, limbs) || !s_limbs_less_than(y, curve->p.m, limbs)) {
+        return false;
+    }
+
+    S_FMUL(x, x, curve->p.rr);
+    S_FMUL(y, y, curve->p.rr);
+
+    return s_point_is_on_curve(curve, x, y);
+}
+
+struct aws_ec_native_table *aws_ec_native_table_new(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_byte_cursor pub_x,
+    struct aws_byte_cursor pub_y) {
+    const struct aws_ec_native_curve *curve = aws_ec_native_curve_get(curve_name);
+    if (!curve) {
+        aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+        return NULL;
+    }
+
+    size_t limbs = curve->limbs;
+    uint64_t x[S_MAX_LIMBS], y[S_MAX_LIMBS];
+
+    if (!s_point_from_be_bytes(curve, pub_x, pub_y, x, y)) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    size_t windows = s_window_count(curve);
+    size_t points_size = windows * AWS_EC_NATIVE_WINDOW_ENTRIES * 2 * limbs * sizeof(uint64_t);
+
+    struct aws_ec_native_table *table = aws_mem_calloc(allocator, 1, sizeof(struct aws_ec_native_table) + points_size);
+    if (!table) {
+        return NULL;
+    }
+
+    table->allocator = allocator;
+    aws_atomic_init_int(&table->ref_count, 1);
+    table->curve = curve;
+    table->windows = windows;
+    uint64_t *points = (uint64_t *)(table + 1);
+    table->points = points;
+
+    if (s_build_table(allocator, curve, x, y, points)) {
+        aws_mem_release(allocator, table);
+        return NULL;
+    }
+
+    return table;
+}
+
+struct aws_ec_native_table *aws_ec_native_table_acquire(struct aws_ec_native_table *table) {
+    aws_atomic_fetch_add(&table->ref_count, 1);
+    return table;
+}
+
+void aws_ec_native_table_release(struct aws_ec_native_table *table) {
+    if (table == NULL) {
+        return;
+    }
+
+    if (aws_atomic_fetch_sub(&table->ref_count, 1) == 1) {
+        aws_mem_release(table->allocator, table);
+    }
+}
+
+/* 0 < k < n, without branching on k */
+static bool s_scalar_is_valid_ct(const struct aws_ec_native_curve *curve, const uint64_t *k) {
+    size_t limbs = curve->limbs;
+    uint64_t borrow = 0;
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < limbs; ++i) {
+        s_sbb(k[i], curve->n.m[i], borrow, &borrow);
+        acc |= k[i];
+    }
+
+    return (borrow & ~s_ct_is_zero_mask(acc) & 1) != 0;
+}
+
+/* reads a scalar and checks 0 < k < n */
+static bool s_scalar_from_be_bytes(const struct aws_ec_native_curve *curve, uint64_t *k, struct aws_byte_cursor bytes) {
+    return s_limbs_from_be_bytes(k, bytes, curve->limbs) && !s_limbs_is_zero(k, curve->limbs) &&
+           s_limbs_less_than(k, curve->n.m, curve->limbs);
+}
+
+/*
+ * Recodes k into signed digits d_i in [-16, 16] with k = sum(d_i * 32^i). digits must hold s_window_count() entries.
+ * Constant time in k.
+ */
+static void s_scalar_recode(int8_t *digits, const uint64_t *k, size_t limbs, size_t windows) {
+    int carry = 0;
+
+    for (size_t window = 0; window < windows; ++window) {
+        size_t bit = window * AWS_EC_NATIVE_WINDOW_BITS;
+        uint64_t bits = 0;
+        if (bit / 64 < limbs) {
+            bits = k[bit / 64] >> (bit % 64);
+            if (bit % 64 > 64 - AWS_EC_NATIVE_WINDOW_BITS && bit / 64 + 1 < limbs) {
+                bits |= k[bit / 64 + 1] << (64 - bit % 64);
+            }
+        }
+
+        int digit = (int)(bits & 0x1f) + carry;
+        carry = (int)((uint32_t)(16 - digit) >> 31);
+        digits[window] = (int8_t)(digit - (carry << 5));
+    }
+}
+
+/* acc += digit * (32^window * P), where P is the point table was built for */
+static void s_accumulate_digit(
+    const struct aws_ec_native_table *table,
+    struct s_jacobian *acc,
+    size_t window,
+    int8_t digit) {
+    const struct aws_ec_native_curve *curve = table->curve;
+    size_t limbs = curve->limbs;
+
+    if (digit == 0) {
+        return;
+    }
+
+    size_t magnitude = (size_t)(digit < 0 ? -digit : digit);
+    const uint64_t *entry = table->points + (window * AWS_EC_NATIVE_WINDOW_ENTRIES + magnitude - 1) * 2 * limbs;
+
+    if (digit > 0) {
+        s_point_add_mixed(curve, acc, acc, entry, entry + limbs);
+        return;
+    }
+
+    uint64_t zero[S_MAX_LIMBS] = {0};
+    uint64_t neg_y[S_MAX_LIMBS];
+    S_FSUB(neg_y, zero, entry + limbs);
+    s_point_add_mixed(curve, acc, acc, entry, neg_y);
+}
+
+/* e is the leftmost bits of the hash, as many as the order has; reduce once since e < 2^bits < 2n */
+static void s_hash_to_scalar(const struct aws_ec_native_curve *curve, const struct aws_byte_cursor *hash, uint64_t *e) {
+    struct aws_byte_cursor e_bytes = *hash;
+    if (e_bytes.len > curve->coordinate_size) {
+        e_bytes.len = curve->coordinate_size;
+    }
+
+    s_limbs_from_be_bytes(e, e_bytes, curve->limbs);
+    s_mod_reduce_once(e, e, 0, curve->n.m, curve->limbs);
+}
+
+/* Splits a signature in either format into r and s, without checking their values. */
+static bool s_parse_signature(
+    const struct aws_ec_native_curve *curve,
+    struct aws_byte_cursor signature,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_cursor *r,
+    struct aws_byte_cursor *s) {
+    if (format == AWS_EC_NATIVE_SIGNATURE_DER) {
+        return aws_der_ecdsa_signature_parse(signature, r, s) == AWS_OP_SUCCESS;
+    }
+
+    if (signature.len != 2 * curve->coordinate_size) {
+        return false;
+    }
+
+    *r = aws_byte_cursor_advance(&signature, curve->coordinate_size);
+    *s = signature;
+    return true;
+}
+
+/*
+ * The start of every verification: parses the signature and computes u1 = e / s and u2 = r / s. Returns false if the
+ * signature is malformed or either half is out of range.
+ */
+static bool s_verify_scalars(
+    const struct aws_ec_native_curve *curve,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    const struct aws_byte_cursor *signature,
+    uint64_t *r,
+    uint64_t *u1,
+    uint64_t *u2) {
+    size_t limbs = curve->limbs;
+
+    struct aws_byte_cursor r_bytes;
+    struct aws_byte_cursor s_bytes;
+    uint64_t s[S_MAX_LIMBS], e[S_MAX_LIMBS];
+
+    if (!s_parse_signature(curve, *signature, format, &r_bytes, &s_bytes) ||
+        !s_scalar_from_be_bytes(curve, r, r_bytes) || !s_scalar_from_be_bytes(curve, s, s_bytes)) {
+        return false;
+    }
+
+    s_hash_to_scalar(curve, hash, e);
+
+    /* w = s^-1 in Montgomery form, so multiplying a plain value by it gives a plain result */
+    uint64_t w[S_MAX_LIMBS];
+    s_mod_inv_vartime(w, s, curve->n.m, limbs);
+    s_mod_mul(w, w, curve->n.rr, &curve->n, limbs);
+    s_mod_mul(u1, e, w, &curve->n, limbs);
+    s_mod_mul(u2, r, w, &curve->n, limbs);
+
+    return true;
+}
+
+/*
+ * The end of every verification: accept if x(acc) mod n == r. Rather than inverting Z, compares X against r * Z^2,
+ * and against (r + n) * Z^2 when r + n is still a field element, which covers n <= x(acc) < p.
+ */
+static int s_verify_result(const struct aws_ec_native_curve *curve, const struct s_jacobian *acc, const uint64_t *r) {
+    size_t limbs = curve->limbs;
+
+    if (s_limbs_is_zero(acc->z, limbs)) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    uint64_t zz[S_MAX_LIMBS], candidate[S_MAX_LIMBS], expected_x[S_MAX_LIMBS];
+    S_FMUL(zz, acc->z, acc->z);
+
+    S_FMUL(expected_x, r, curve->p.rr);
+    S_FMUL(expected_x, expected_x, zz);
+    if (s_limbs_equal(expected_x, acc->x, limbs)) {
+        return AWS_OP_SUCCESS;
+    }
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < limbs; ++i) {
+        candidate[i] = s_adc(r[i], curve->n.m[i], carry, &carry);
+    }
+    if (!carry && s_limbs_less_than(candidate, curve->p.m, limbs)) {
+        S_FMUL(expected_x, candidate, curve->p.rr);
+        S_FMUL(expected_x, expected_x, zz);
+        if (s_limbs_equal(expected_x, acc->x, limbs)) {
+            return AWS_OP_SUCCESS;
+        }
+    }
+
+    return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+}
+
+int aws_ec_native_verify(
+    const struct aws_ec_native_table *table,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    const struct aws_byte_cursor *signature) {
+    const struct aws_ec_native_curve *curve = table->curve;
+    size_t limbs = curve->limbs;
+
+    uint64_t r[S_MAX_LIMBS], u1[S_MAX_LIMBS], u2[S_MAX_LIMBS];
+    if (!s_verify_scalars(curve, hash, format, signature, r, u1, u2)) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    /* u1 * G + u2 * Q, one mixed addition per non-zero digit */
+    int8_t u1_digits[S_WINDOW_COUNT(S_MAX_LIMBS * 64)];
+    int8_t u2_digits[S_WINDOW_COUNT(S_MAX_LIMBS * 64)];
+    s_scalar_recode(u1_digits, u1, limbs, table->windows);
+    s_scalar_recode(u2_digits, u2, limbs, table->windows);
+
+    const struct aws_ec_native_table *generator = s_generator_table(curve);
+    struct s_jacobian acc;
+    AWS_ZERO_STRUCT(acc);
+
+    for (size_t window = 0; window < table->windows; ++window) {
+        s_accumulate_digit(generator, &acc, window, u1_digits[window]);
+        s_accumulate_digit(table, &acc, window, u2_digits[window]);
+    }
+
+    return s_verify_result(curve, &acc, r);
+}
+
+/*
+ * Verification for keys without a table of their own: u2 * Q by double and add over the width 5 NAF of u2, with the
+ * odd multiples Q, 3Q, ..., 15Q made affine up front, then u1 * G from the generator's table on top.
+ */
+#define S_WNAF_ODD_MULTIPLES 8
+
+/* r = a^-1 for a field element in Montgomery form. Variable time. */
+static void s_field_inv_vartime(const struct aws_ec_native_curve *curve, uint64_t *r, const uint64_t *a) {
+    size_t limbs = curve->limbs;
+
+    /* the plain inverse of a * R is a^-1 * R^-1; two multiplications by R^2 bring it to a^-1 * R */
+    s_mod_inv_vartime(r, a, curve->p.m, limbs);
+    S_FMUL(r, r, curve->p.rr);
+    S_FMUL(r, r, curve->p.rr);
+}
+
+static void s_odd_multiples(
+    const struct aws_ec_native_curve *curve,
+    const uint64_t *x,
+    const uint64_t *y,
+    uint64_t multiples[S_WNAF_ODD_MULTIPLES][2][S_MAX_LIMBS]) {
+    size_t limbs = curve->limbs;
+    struct s_jacobian jacobian[S_WNAF_ODD_MULTIPLES];
+    struct s_jacobian twice;
+
+    AWS_ZERO_STRUCT(jacobian[0]);
+    memcpy(jacobian[0].x, x, limbs * sizeof(uint64_t));
+    memcpy(jacobian[0].y, y, limbs * sizeof(uint64_t));
+    memcpy(jacobian[0].z, curve->p.one, limbs * sizeof(uint64_t));
+    s_point_double(curve, &twice, &jacobian[0]);
+
+    for (size_t i = 1; i < S_WNAF_ODD_MULTIPLES; ++i) {
+        s_point_add(curve, &jacobian[i], &jacobian[i - 1], &twice);
+    }
+
+    /* one inversion for all of them; none is infinity since Q has prime order */
+    uint64_t prefix[S_WNAF_ODD_MULTIPLES][S_MAX_LIMBS];
+    memcpy(prefix[0], jacobian[0].z, sizeof(prefix[0]));
+    for (size_t i = 1; i < S_WNAF_ODD_MULTIPLES; ++i) {
+        S_FMUL(prefix[i], prefix[i - 1], jacobian[i].z);
+    }
+
+    uint64_t inverse[S_MAX_LIMBS];
+    s_field_inv_vartime(curve, inverse, prefix[S_WNAF_ODD_MULTIPLES - 1]);
+
+    for (size_t i = S_WNAF_ODD_MULTIPLES; i > 0; --i) {
+        size_t index = i - 1;
+        uint64_t z_inv[S_MAX_LIMBS], z_inv2[S_MAX_LIMBS];
+
+        if (index > 0) {
+            S_FMUL(z_inv, inverse, prefix[index - 1]);
+            S_FMUL(inverse, inverse, jacobian[index].z);
+        } else {
+            memcpy(z_inv, inverse, sizeof(z_inv));
+        }
+
+        S_FMUL(z_inv2, z_inv, z_inv);
+        S_FMUL(multiples[index][0], jacobian[index].x, z_inv2);
+        S_FMUL(z_inv2, z_inv2, z_inv);
+        S_FMUL(multiples[index][1], jacobian[index].y, z_inv2);
+    }
+}
+
+/*
+ * Width 5 NAF of k: every digit is zero or odd in [-15, 15], least significant first. Returns the number of digits.
+ * k < n keeps k + 15 within the limbs.
+ */
+static size_t s_scalar_wnaf(int8_t *naf, const uint64_t *k_in, size_t limbs) {
+    uint64_t k[S_MAX_LIMBS];
+    memcpy(k, k_in, limbs * sizeof(uint64_t));
+    size_t length = 0;
+
+    while (!s_limbs_is_zero(k, limbs)) {
+        int digit = 0;
+
+        if (k[0] & 1) {
+            digit = (int)(k[0] & 0x1f);
+            if (digit > 16) {
+                digit -= 32;
+            }
+
+            uint64_t carry = 0;
+            if (digit > 0) {
+                k[0] = s_sbb(k[0], (uint64_t)digit, 0, &carry);
+                for (size_t i = 1; i < limbs; ++i) {
+                    k[i] = s_sbb(k[i], 0, carry, &carry);
+                }
+            } else {
+                k[0] = s_adc(k[0], (uint64_t)-digit, 0, &carry);
+                for (size_t i = 1; i < limbs; ++i) {
+                    k[i] = s_adc(k[i], 0, carry, &carry);
+                }
+            }
+        }
+
+        naf[length++] = (int8_t)digit;
+        s_limbs_halve(k, 0, limbs);
+    }
+
+    return length;
+}
+
+int aws_ec_native_key_verify(
+    const struct aws_ec_native_key *key,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    const struct aws_byte_cursor *signature) {
+    const struct aws_ec_native_curve *curve = key->curve;
+    size_t limbs = curve->limbs;
+
+    if (!key->has_public_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    uint64_t r[S_MAX_LIMBS], u1[S_MAX_LIMBS], u2[S_MAX_LIMBS];
+    if (!s_verify_scalars(curve, hash, format, signature, r, u1, u2)) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    uint64_t multiples[S_WNAF_ODD_MULTIPLES][2][S_MAX_LIMBS];
+    s_odd_multiples(curve, key->x, key->y, multiples);
+
+    int8_t naf[S_MAX_LIMBS * 64 + 1];
+    size_t naf_length = s_scalar_wnaf(naf, u2, limbs);
+
+    struct s_jacobian acc;
+    AWS_ZERO_STRUCT(acc);
+
+    for (size_t i = naf_length; i > 0; --i) {
+        if (!s_limbs_is_zero(acc.z, limbs)) {
+            s_point_double(curve, &acc, &acc);
+        }
+
+        int digit = naf[i - 1];
+        if (digit > 0) {
+            s_point_add_mixed(curve, &acc, &acc, multiples[digit / 2][0], multiples[digit / 2][1]);
+        } else if (digit < 0) {
+            uint64_t zero[S_MAX_LIMBS] = {0};
+            uint64_t neg_y[S_MAX_LIMBS];
+            S_FSUB(neg_y, zero, multiples[-digit / 2][1]);
+            s_point_add_mixed(curve, &acc, &acc, multiples[-digit / 2][0], neg_y);
+        }
+    }
+
+    int8_t u1_digits[S_WINDOW_COUNT(S_MAX_LIMBS * 64)];
+    const struct aws_ec_native_table *generator = s_generator_table(curve);
+    s_scalar_recode(u1_digits, u1, limbs, generator->windows);
+
+    for (size_t window = 0; window < generator->windows; ++window) {
+        s_accumulate_digit(generator, &acc, window, u1_digits[window]);
+    }
+
+    return s_verify_result(curve, &acc, r);
+}
+
+/*
+ * Fixed base scalar multiplication for the secret scalars of signing and key generation. Points are in homogeneous
+ * projective coordinates, (X : Y : Z) represents (X / Z, Y / Z) and (0 : 1 : 0) is infinity, so that the complete
+ * addition formulas apply: every window costs the same whatever the scalar is.
+ */
+struct s_projective {
+    uint64_t x[S_MAX_LIMBS];
+    uint64_t y[S_MAX_LIMBS];
+    uint64_t z[S_MAX_LIMBS];
+};
+
+/*
+ * r = a + (x2, y2) for any a, including infinity, (x2, y2) and its negation. Complete mixed addition for a = -3,
+ * algorithm 5 of Renes, Costello and Batina, "Complete addition formulas for prime order elliptic curves" (2016).
+ * May run in place.
+ */
+static void s_point_add_complete_mixed(
+    const struct aws_ec_native_curve *curve,
+    struct s_projective *r,
+    const struct s_projective *a,
+    const uint64_t *x2,
+    const uint64_t *y2) {
+    size_t limbs = curve->limbs;
+    uint64_t t0[S_MAX_LIMBS], t1[S_MAX_LIMBS], t2[S_MAX_LIMBS], t3[S_MAX_LIMBS], t4[S_MAX_LIMBS];
+    uint64_t x3[S_MAX_LIMBS], y3[S_MAX_LIMBS], z3[S_MAX_LIMBS];
+
+    S_FMUL(t0, a->x, x2);
+    S_FMUL(t1, a->y, y2);
+    S_FADD(t3, x2, y2);
+    S_FADD(t4, a->x, a->y);
+    S_FMUL(t3, t3, t4);
+    S_FADD(t4, t0, t1);
+    S_FSUB(t3, t3, t4);
+    S_FMUL(t4, y2, a->z);
+    S_FADD(t4, t4, a->y);
+    S_FMUL(y3, x2, a->z);
+    S_FADD(y3, y3, a->x);
+    S_FMUL(z3, curve->b, a->z);
+    S_FSUB(x3, y3, z3);
+    S_FADD(z3, x3, x3);
+    S_FADD(x3, x3, z3);
+    S_FSUB(z3, t1, x3);
+    S_FADD(x3, t1, x3);
+    S_FMUL(y3, curve->b, y3);
+    S_FADD(t1, a->z, a->z);
+    S_FADD(t2, t1, a->z);
+    S_FSUB(y3, y3, t2);
+    S_FSUB(y3, y3, t0);
+    S_FADD(t1, y3, y3);
+    S_FADD(y3, t1, y3);
+    S_FADD(t1, t0, t0);
+    S_FADD(t0, t1, t0);
+    S_FSUB(t0, t0, t2);
+    S_FMUL(t1, t4, y3);
+    S_FMUL(t2, t0, y3);
+    S_FMUL(y3, x3, z3);
+    S_FADD(y3, y3, t2);
+    S_FMUL(x3, t3, x3);
+    S_FSUB(x3, x3, t1);
+    S_FMUL(z3, t4, z3);
+    S_FMUL(t1, t3, t0);
+    S_FADD(z3, z3, t1);
+
+    memcpy(r->x, x3, sizeof(x3));
+    memcpy(r->y, y3, sizeof(y3));
+    memcpy(r->z, z3, sizeof(z3));
+}
+
+/* r = a + b for any projective a and b, algorithm 4 of the same paper. May run in place. */
+static void s_point_add_complete(
+    const struct aws_ec_native_curve *curve,
+    struct s_projective *r,
+    const struct s_projective *a,
+    const struct s_projective *b) {
+    size_t limbs = curve->limbs;
+    uint64_t t0[S_MAX_LIMBS], t1[S_MAX_LIMBS], t2[S_MAX_LIMBS], t3[S_MAX_LIMBS], t4[S_MAX_LIMBS];
+    uint64_t x3[S_MAX_LIMBS], y3[S_MAX_LIMBS], z3[S_MAX_LIMBS];
+
+    S_FMUL(t0, a->x, b->x);
+    S_FMUL(t1, a->y, b->y);
+    S_FMUL(t2, a->z, b->z);
+    S_FADD(t3, a->x, a->y);
+    S_FADD(t4, b->x, b->y);
+    S_FMUL(t3, t3, t4);
+    S_FADD(t4, t0, t1);
+    S_FSUB(t3, t3, t4);
+    S_FADD(t4, a->y, a->z);
+    S_FADD(x3, b->y, b->z);
+    S_FMUL(t4, t4, x3);
+    S_FADD(x3, t1, t2);
+    S_FSUB(t4, t4, x3);
+    S_FADD(x3, a->x, a->z);
+    S_FADD(y3, b->x, b->z);
+    S_FMUL(x3, x3, y3);
+    S_FADD(y3, t0, t2);
+    S_FSUB(y3, x3, y3);
+    S_FMUL(z3, curve->b, t2);
+    S_FSUB(x3, y3, z3);
+    S_FADD(z3, x3, x3);
+    S_FADD(x3, x3, z3);
+    S_FSUB(z3, t1, x3);
+    S_FADD(x3, t1, x3);
+    S_FMUL(y3, curve->b, y3);
+    S_FADD(t1, t2, t2);
+    S_FADD(t2, t1, t2);
+    S_FSUB(y3, y3, t2);
+    S_FSUB(y3, y3, t0);
+    S_FADD(t1, y3, y3);
+    S_FADD(y3, t1, y3);
+    S_FADD(t1, t0, t0);
+    S_FADD(t0, t1, t0);
+    S_FSUB(t0, t0, t2);
+    S_FMUL(t1, t4, y3);
+    S_FMUL(t2, t0, y3);
+    S_FMUL(y3, x3, z3);
+    S_FADD(y3, y3, t2);
+    S_FMUL(x3, t3, x3);
+    S_FSUB(x3, x3, t1);
+    S_FMUL(z3, t4, z3);
+    S_FMUL(t1, t3, t0);
+    S_FADD(z3, z3, t1);
+
+    memcpy(r->x, x3, sizeof(x3));
+    memcpy(r->y, y3, sizeof(y3));
+    memcpy(r->z, z3, sizeof(z3));
+}
+
+/* r = 2 * a for any projective a, algorithm 6 of the same paper. May run in place. */
+static void s_point_double_complete(
+    const struct aws_ec_native_curve *curve,
+    struct s_projective *r,
+    const struct s_projective *a) {
+    size_t limbs = curve->limbs;
+    uint64_t t0[S_MAX_LIMBS], t1[S_MAX_LIMBS], t2[S_MAX_LIMBS], t3[S_MAX_LIMBS];
+    uint64_t x3[S_MAX_LIMBS], y3[S_MAX_LIMBS], z3[S_MAX_LIMBS];
+
+    S_FMUL(t0, a->x, a->x);
+    S_FMUL(t1, a->y, a->y);
+    S_FMUL(t2, a->z, a->z);
+    S_FMUL(t3, a->x, a->y);
+    S_FADD(t3, t3, t3);
+    S_FMUL(z3, a->x, a->z);
+    S_FADD(z3, z3, z3);
+    S_FMUL(y3, curve->b, t2);
+    S_FSUB(y3, y3, z3);
+    S_FADD(x3, y3, y3);
+    S_FADD(y3, x3, y3);
+    S_FSUB(x3, t1, y3);
+    S_FADD(y3, t1, y3);
+    S_FMUL(y3, x3, y3);
+    S_FMUL(x3, x3, t3);
+    S_FADD(t3, t2, t2);
+    S_FADD(t2, t2, t3);
+    S_FMUL(z3, curve->b, z3);
+    S_FSUB(z3, z3, t2);
+    S_FSUB(z3, z3, t0);
+    S_FADD(t3, z3, z3);
+    S_FADD(z3, z3, t3);
+    S_FADD(t3, t0, t0);
+    S_FADD(t0, t3, t0);
+    S_FSUB(t0, t0, t2);
+    S_FMUL(t0, t0, z3);
+    S_FADD(y3, y3, t0);
+    S_FMUL(t0, a->y, a->z);
+    S_FADD(t0, t0, t0);
+    S_FMUL(z3, t0, z3);
+    S_FSUB(x3, x3, z3);
+    S_FMUL(z3, t0, t1);
+    S_FADD(z3, z3, z3);
+    S_FADD(z3, z3, z3);
+
+    memcpy(r->x, x3, sizeof(x3));
+    memcpy(r->y, y3, sizeof(y3));
+    memcpy(r->z, z3, sizeof(z3));
+}
+
+/*
+ * (x, y) = digit * (32^window * P), where P is the point table was built for, reading every entry of the row. For
+ * digit 0 the output is meaningless and has to be discarded by the caller.
+ */
+static void s_table_lookup_ct(
+    const struct aws_ec_native_table *table,
+    size_t window,
+    int digit,
+    uint64_t *x,
+    uint64_t *y) {
+    const struct aws_ec_native_curve *curve = table->curve;
+    size_t limbs = curve->limbs;
+
+    uint64_t negative = 0 - (uint64_t)((uint32_t)digit >> 31);
+    uint64_t magnitude = (uint32_t)(((uint32_t)digit ^ (uint32_t)negative) - (uint32_t)negative);
+
+    memset(x, 0, limbs * sizeof(uint64_t));
+    memset(y, 0, limbs * sizeof(uint64_t));
+
+    const uint64_t *row = table->points + window * AWS_EC_NATIVE_WINDOW_ENTRIES * 2 * limbs;
+    for (size_t j = 0; j < AWS_EC_NATIVE_WINDOW_ENTRIES; ++j) {
+        uint64_t mask = s_ct_is_zero_mask((uint64_t)(j + 1) ^ magnitude);
+        const uint64_t *entry = row + j * 2 * limbs;
+        for (size_t i = 0; i < limbs; ++i) {
+            x[i] |= entry[i] & mask;
+            y[i] |= entry[limbs + i] & mask;
+        }
+    }
+
+    uint64_t zero[S_MAX_LIMBS] = {0};
+    uint64_t neg_y[S_MAX_LIMBS];
+    S_FSUB(neg_y, zero, y);
+    s_ct_select(y, neg_y, y, negative, limbs);
+}
+
+/*
+ * acc = k * P in projective coordinates, for the point P table was built for and 0 < k < n, so Z is never zero. digits
+ * is k recoded by s_scalar_recode(). Constant time in k.
+ */
+static void s_point_mul_table_projective_ct(
+    const struct aws_ec_native_table *table,
+    const int8_t *digits,
+    struct s_projective *acc_out) {
+    const struct aws_ec_native_curve *curve = table->curve;
+    size_t limbs = curve->limbs;
+
+    struct s_projective acc;
+    AWS_ZERO_STRUCT(acc);
+    memcpy(acc.y, curve->p.one, sizeof(acc.y));
+
+    struct s_projective sum;
+    uint64_t entry_x[S_MAX_LIMBS], entry_y[S_MAX_LIMBS];
+
+    for (size_t window = 0; window < table->windows; ++window) {
+        s_table_lookup_ct(table, window, digits[window], entry_x, entry_y);
+        s_point_add_complete_mixed(curve, &sum, &acc, entry_x, entry_y);
+
+        uint64_t keep = s_ct_is_zero_mask((uint64_t)(uint8_t)digits[window]);
+        s_ct_select(acc.x, acc.x, sum.x, keep, limbs);
+        s_ct_select(acc.y, acc.y, sum.y, keep, limbs);
+        s_ct_select(acc.z, acc.z, sum.z, keep, limbs);
+    }
+
+    *acc_out = acc;
+
+    aws_secure_zero(&acc, sizeof(acc));
+    aws_secure_zero(&sum, sizeof(sum));
+    aws_secure_zero(entry_x, sizeof(entry_x));
+    aws_secure_zero(entry_y, sizeof(entry_y));
+}
+
+/* acc = k * G in projective coordinates, for 0 < k < n, so Z is never zero. Constant time in k. */
+static void s_point_mul_base_projective_ct(
+    const struct aws_ec_native_curve *curve,
+    const uint64_t *k,
+    struct s_projective *acc_out) {
+    const struct aws_ec_native_table *generator = s_generator_table(curve);
+
+    int8_t digits[S_WINDOW_COUNT(S_MAX_LIMBS * 64)];
+    s_scalar_recode(digits, k, curve->limbs, generator->windows);
+    s_point_mul_table_projective_ct(generator, digits, acc_out);
+
+    aws_secure_zero(digits, sizeof(digits));
+}
+
+/* (x, y) = k * G in affine Montgomery coordinates, for 0 < k < n. Constant time in k. */
+static void s_point_mul_base_ct(const struct aws_ec_native_curve *curve, const uint64_t *k, uint64_t *x, uint64_t *y) {
+    size_t limbs = curve->limbs;
+
+    struct s_projective acc;
+    s_point_mul_base_projective_ct(curve, k, &acc);
+
+    uint64_t z_inv[S_MAX_LIMBS];
+    s_mod_inv(z_inv, acc.z, &curve->p, limbs);
+    S_FMUL(x, acc.x, z_inv);
+    S_FMUL(y, acc.y, z_inv);
+
+    aws_secure_zero(&acc, sizeof(acc));
+}
+
+/*
+ * Replaces each of the count non-zero Montgomery form values with its inverse mod m, at the cost of a single
+ * inversion and 3 (count - 1) multiplications (Montgomery's trick). prefix is scratch space for count values. Only
+ * multiplications and a constant time inversion, so it is constant time in the values too.
+ */
+static void s_mod_inv_batch(
+    uint64_t (*values)[S_MAX_LIMBS],
+    uint64_t (*prefix)[S_MAX_LIMBS],
+    size_t count,
+    const struct aws_ec_native_modulus *mod,
+    size_t limbs) {
+
+    memcpy(prefix[0], values[0], sizeof(prefix[0]));
+    for (size_t i = 1; i < count; ++i) {
+        s_mod_mul(prefix[i], prefix[i - 1], values[i], mod, limbs);
+    }
+
+    uint64_t inverse[S_MAX_LIMBS];
+    s_mod_inv(inverse, prefix[count - 1], mod, limbs);
+
+    uint64_t value_inv[S_MAX_LIMBS];
+    for (size_t i = count - 1; i > 0; --i) {
+        s_mod_mul(value_inv, inverse, prefix[i - 1], mod, limbs);
+        s_mod_mul(inverse, inverse, values[i], mod, limbs);
+        memcpy(values[i], value_inv, sizeof(value_inv));
+    }
+    memcpy(values[0], inverse, sizeof(inverse));
+
+    aws_secure_zero(inverse, sizeof(inverse));
+    aws_secure_zero(value_inv, sizeof(value_inv));
+}
+
+/* Uniform in [1, n - 1] by rejection sampling. */
+static int s_random_scalar(const struct aws_ec_native_curve *curve, uint64_t *k) {
+    uint8_t bytes[S_MAX_LIMBS * 8];
+    int result = AWS_OP_ERR;
+
+    /* a draw is rejected with probability below 2^-32 on either curve, so running out means the RNG is broken */
+    for (size_t attempt = 0; attempt < 64; ++attempt) {
+        struct aws_byte_buf buf = aws_byte_buf_from_empty_array(bytes, curve->coordinate_size);
+        if (aws_device_random_buffer(&buf)) {
+            goto done;
+        }
+
+        s_limbs_from_be_bytes(k, aws_byte_cursor_from_buf(&buf), curve->limbs);
+        if (s_scalar_is_valid_ct(curve, k)) {
+            result = AWS_OP_SUCCESS;
+            goto done;
+        }
+    }
+
+    aws_raise_error(AWS_ERROR_INVALID_STATE);
+
+done:
+    aws_secure_zero(bytes, sizeof(bytes));
+    return result;
+}
+
+int aws_ec_native_key_init(struct aws_ec_native_key *key, enum aws_ecc_curve_name curve_name) {
+    AWS_ZERO_STRUCT(*key);
+
+    key->curve = aws_ec_native_curve_get(curve_name);
+    if (!key->curve) {
+        return aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+void aws_ec_native_key_clean_up(struct aws_ec_native_key *key) {
+    aws_secure_zero(key->d, sizeof(key->d));
+    aws_secure_zero(&key->rfc6979, sizeof(key->rfc6979));
+    key->has_private_key = false;
+    key->deterministic_signing = false;
+}
+
+int aws_ec_native_key_set_private_key(struct aws_ec_native_key *key, struct aws_byte_cursor d) {
+    const struct aws_ec_native_curve *curve = key->curve;
+
+    if (d.len != curve->coordinate_size) {
+        return aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+    }
+
+    aws_ec_native_key_set_deterministic_signing(key, false);
+
+    s_limbs_from_be_bytes(key->d, d, curve->limbs);
+    if (!s_scalar_is_valid_ct(curve, key->d)) {
+        aws_secure_zero(key->d, sizeof(key->d));
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    key->has_private_key = true;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ec_native_key_set_public_key(
+    struct aws_ec_native_key *key,
+    struct aws_byte_cursor x,
+    struct aws_byte_cursor y) {
+    if (!s_point_from_be_bytes(key->curve, x, y, key->x, key->y)) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    key->has_public_key = true;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ec_native_key_derive_public_key(struct aws_ec_native_key *key) {
+    if (!key->has_private_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    s_point_mul_base_ct(key->curve, key->d, key->x, key->y);
+    key->has_public_key = true;
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ec_native_key_generate_private_key(struct aws_ec_native_key *key) {
+    aws_ec_native_key_set_deterministic_signing(key, false);
+    key->has_public_key = false;
+
+    if (s_random_scalar(key->curve, key->d)) {
+        return AWS_OP_ERR;
+    }
+
+    key->has_private_key = true;
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ec_native_key_generate(struct aws_ec_native_key *key) {
+    if (aws_ec_native_key_generate_private_key(key)) {
+        return AWS_OP_ERR;
+    }
+
+    return aws_ec_native_key_derive_public_key(key);
+}
+
+/*
+ * Points worked on in blocks, the public points of generated keys and the shared points of ECDH, are left projective
+ * and share one field inversion.
+ */
+#define S_KEY_BLOCK 32
+
+struct s_key_block {
+    struct s_projective points[S_KEY_BLOCK];
+    uint64_t z_inv[S_KEY_BLOCK][S_MAX_LIMBS];
+    uint64_t prefix[S_KEY_BLOCK][S_MAX_LIMBS];
+};
+
+static int s_key_generate_block(
+    const struct aws_ec_native_curve *curve,
+    struct aws_ec_native_key *const *keys,
+    size_t count,
+    struct s_key_block *block) {
+    size_t limbs = curve->limbs;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (aws_ec_native_key_generate_private_key(keys[i])) {
+            return AWS_OP_ERR;
+        }
+
+        s_point_mul_base_projective_ct(curve, keys[i]->d, &block->points[i]);
+        memcpy(block->z_inv[i], block->points[i].z, sizeof(block->z_inv[i]));
+    }
+
+    s_mod_inv_batch(block->z_inv, block->prefix, count, &curve->p, limbs);
+
+    for (size_t i = 0; i < count; ++i) {
+        S_FMUL(keys[i]->x, block->points[i].x, block->z_inv[i]);
+        S_FMUL(keys[i]->y, block->points[i].y, block->z_inv[i]);
+        keys[i]->has_public_key = true;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ec_native_key_generate_batch(struct aws_ec_native_key *const *keys, size_t count) {
+    if (count == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    const struct aws_ec_native_curve *curve = keys[0]->curve;
+    for (size_t i = 1; i < count; ++i) {
+        if (keys[i]->curve != curve) {
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        }
+    }
+
+    struct s_key_block block;
+    int result = AWS_OP_SUCCESS;
+
+    for (size_t start = 0; start < count; start += S_KEY_BLOCK) {
+        if (s_key_generate_block(curve, keys + start, aws_min_size(S_KEY_BLOCK, count - start), &block)) {
+            result = AWS_OP_ERR;
+            break;
+        }
+    }
+
+    aws_secure_zero(&block, sizeof(block));
+    return result;
+}
+
+/* Appends a field element or scalar, plain or Montgomery form, as exactly coordinate_size big endian bytes. */
+static int s_write_element(
+    const struct aws_ec_native_curve *curve,
+    const uint64_t *value,
+    bool montgomery,
+    struct aws_byte_buf *out) {
+    size_t limbs = curve->limbs;
+    uint64_t plain[S_MAX_LIMBS];
+    uint8_t bytes[S_MAX_LIMBS * 8];
+
+    if (out->capacity - out->len < curve->coordinate_size) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    if (montgomery) {
+        S_FMUL(plain, value, s_plain_one);
+    } else {
+        memcpy(plain, value, limbs * sizeof(uint64_t));
+    }
+
+    s_limbs_to_be_bytes(bytes, plain, curve->coordinate_size);
+    aws_byte_buf_write(out, bytes, curve->coordinate_size);
+
+    aws_secure_zero(plain, sizeof(plain));
+    aws_secure_zero(bytes, sizeof(bytes));
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ec_native_key_write_public_key(
+    const struct aws_ec_native_key *key,
+    struct aws_byte_buf *x,
+    struct aws_byte_buf *y) {
+    if (!key->has_public_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    if (s_write_element(key->curve, key->x, true, x) || s_write_element(key->curve, key->y, true, y)) {
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ec_native_key_write_private_key(const struct aws_ec_native_key *key, struct aws_byte_buf *d) {
+    if (!key->has_private_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    return s_write_element(key->curve, key->d, false, d);
+}
+
+int aws_ec_native_decompress_point(
+    enum aws_ecc_curve_name curve_name,
+    struct aws_byte_cursor x_bytes,
+    bool y_is_odd,
+    struct aws_byte_buf *y_out) {
+    const struct aws_ec_native_curve *curve = aws_ec_native_curve_get(curve_name);
+    if (curve == NULL) {
+        return aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    }
+
+    size_t limbs = curve->limbs;
+    uint64_t x[S_MAX_LIMBS], rhs[S_MAX_LIMBS], y[S_MAX_LIMBS], check[S_MAX_LIMBS], neg[S_MAX_LIMBS];
+    const uint64_t zero[S_MAX_LIMBS] = {0};
+
+    if (x_bytes.len != curve->coordinate_size || !s_limbs_from_be_bytes(x, x_bytes, limbs) ||
+        !s_limbs_less_than(x, curve->p.m, limbs)) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    S_FMUL(x, x, curve->p.rr);
+    s_curve_rhs(curve, rhs, x);
+    s_field_sqrt_candidate(curve, y, rhs);
+
+    /* when rhs has no square root, the candidate squares to -rhs instead and no point has this x */
+    S_FMUL(check, y, y);
+    if (!s_limbs_equal(check, rhs, limbs)) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* the parity is of the plain value; swap in p - y when it is the wrong one */
+    S_FMUL(y, y, s_plain_one);
+    s_mod_sub(neg, zero, y, curve->p.m, limbs);
+    uint64_t swap = ~s_ct_is_zero_mask((y[0] & 1) ^ (uint64_t)y_is_odd);
+    s_ct_select(y, neg, y, swap, limbs);
+
+    return s_write_element(curve, y, false, y_out);
+}
+
+/*
+ * Variable base scalar multiplication for ECDH, where the point is a peer's and the scalar is secret: the same signed
+ * 5 bit digits as the fixed base code, with a single table of 1..16 * Q and five complete doublings per window. The
+ * table stays projective, so building it takes no inversion.
+ */
+static void s_multiples_projective(
+    const struct aws_ec_native_curve *curve,
+    const uint64_t *x,
+    const uint64_t *y,
+    struct s_projective multiples[AWS_EC_NATIVE_WINDOW_ENTRIES]) {
+    size_t limbs = curve->limbs;
+
+    AWS_ZERO_STRUCT(multiples[0]);
+    memcpy(multiples[0].x, x, limbs * sizeof(uint64_t));
+    memcpy(multiples[0].y, y, limbs * sizeof(uint64_t));
+    memcpy(multiples[0].z, curve->p.one, limbs * sizeof(uint64_t));
+
+    s_point_double_complete(curve, &multiples[1], &multiples[0]);
+    for (size_t j = 2; j < AWS_EC_NATIVE_WINDOW_ENTRIES; ++j) {
+        s_point_add_complete_mixed(curve, &multiples[j], &multiples[j - 1], x, y);
+    }
+}
+
+/* r = digit * Q, reading every one of Q's multiples. For digit 0 the output is meaningless. */
+static void s_multiples_lookup_ct(
+    const struct aws_ec_native_curve *curve,
+    const struct s_projective multiples[AWS_EC_NATIVE_WINDOW_ENTRIES],
+    int digit,
+    struct s_projective *r) {
+    size_t limbs = curve->limbs;
+
+    uint64_t negative = 0 - (uint64_t)((uint32_t)digit >> 31);
+    uint64_t magnitude = (uint32_t)(((uint32_t)digit ^ (uint32_t)negative) - (uint32_t)negative);
+
+    AWS_ZERO_STRUCT(*r);
+
+    for (size_t j = 0; j < AWS_EC_NATIVE_WINDOW_ENTRIES; ++j) {
+        uint64_t mask = s_ct_is_zero_mask((uint64_t)(j + 1) ^ magnitude);
+        for (size_t i = 0; i < limbs; ++i) {
+            r->x[i] |= multiples[j].x[i] & mask;
+            r->y[i] |= multiples[j].y[i] & mask;
+            r->z[i] |= multiples[j].z[i] & mask;
+        }
+    }
+
+    uint64_t zero[S_MAX_LIMBS] = {0};
+    uint64_t neg_y[S_MAX_LIMBS];
+    S_FSUB(neg_y, zero, r->y);
+    s_ct_select(r->y, neg_y, r->y, negative, limbs);
+}
+
+/*
+ * acc = k * (x, y) in projective coordinates, for 0 < k < n and a point on the curve, so Z is never zero. digits is k
+ * recoded by s_scalar_recode(). Constant time in k.
+ */
+static void s_point_mul_projective_ct(
+    const struct aws_ec_native_curve *curve,
+    const int8_t *digits,
+    const uint64_t *x,
+    const uint64_t *y,
+    struct s_projective *acc_out) {
+    size_t limbs = curve->limbs;
+
+    struct s_projective multiples[AWS_EC_NATIVE_WINDOW_ENTRIES];
+    s_multiples_projective(curve, x, y, multiples);
+
+    struct s_projective acc;
+    AWS_ZERO_STRUCT(acc);
+    memcpy(acc.y, curve->p.one, sizeof(acc.y));
+
+    struct s_projective entry;
+    struct s_projective sum;
+
+    /* the first window's doublings are of infinity, and only there to keep every window the same */
+    for (size_t window = s_window_count(curve); window > 0; --window) {
+        for (size_t i = 0; i < AWS_EC_NATIVE_WINDOW_BITS; ++i) {
+            s_point_double_complete(curve, &acc, &acc);
+        }
+
+        s_multiples_lookup_ct(curve, multiples, digits[window - 1], &entry);
+        s_point_add_complete(curve, &sum, &acc, &entry);
+
+        uint64_t keep = s_ct_is_zero_mask((uint64_t)(uint8_t)digits[window - 1]);
+        s_ct_select(acc.x, acc.x, sum.x, keep, limbs);
+        s_ct_select(acc.y, acc.y, sum.y, keep, limbs);
+        s_ct_select(acc.z, acc.z, sum.z, keep, limbs);
+    }
+
+    *acc_out = acc;
+
+    aws_secure_zero(&acc, sizeof(acc));
+    aws_secure_zero(&entry, sizeof(entry));
+    aws_secure_zero(&sum, sizeof(sum));
+}
+
+static int s_check_shared_secret(
+    const struct aws_ec_native_key *key,
+    const struct aws_ec_native_key *peer,
+    const struct aws_ec_native_table *peer_table,
+    const struct aws_byte_buf *shared_secret) {
+    const struct aws_ec_native_curve *curve = key->curve;
+
+    if (!key->has_private_key || !peer->has_public_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    if (peer->curve != curve || (peer_table && peer_table->curve != curve)) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (shared_secret->capacity - shared_secret->len < curve->coordinate_size) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* d * Q for the private scalar recoded into digits, from the peer's table when it has one */
+static void s_shared_point_ct(
+    const int8_t *digits,
+    const struct aws_ec_native_key *peer,
+    const struct aws_ec_native_table *peer_table,
+    struct s_projective *point) {
+    if (peer_table) {
+        s_point_mul_table_projective_ct(peer_table, digits, point);
+    } else {
+        s_point_mul_projective_ct(peer->curve, digits, peer->x, peer->y, point);
+    }
+}
+
+int aws_ec_native_key_derive_shared_secret(
+    const struct aws_ec_native_key *key,
+    const struct aws_ec_native_key *peer,
+    const struct aws_ec_native_table *peer_table,
+    struct aws_byte_buf *shared_secret) {
+    if (s_check_shared_secret(key, peer, peer_table, shared_secret)) {
+        return AWS_OP_ERR;
+    }
+
+    const struct aws_ec_native_curve *curve = key->curve;
+    size_t limbs = curve->limbs;
+
+    int8_t digits[S_WINDOW_COUNT(S_MAX_LIMBS * 64)];
+    s_scalar_recode(digits, key->d, limbs, s_window_count(curve));
+
+    struct s_projective point;
+    s_shared_point_ct(digits, peer, peer_table, &point);
+
+    uint64_t z_inv[S_MAX_LIMBS], x[S_MAX_LIMBS];
+    s_mod_inv(z_inv, point.z, &curve->p, limbs);
+    S_FMUL(x, point.x, z_inv);
+    int result = s_write_element(curve, x, true, shared_secret);
+
+    aws_secure_zero(digits, sizeof(digits));
+    aws_secure_zero(&point, sizeof(point));
+    aws_secure_zero(z_inv, sizeof(z_inv));
+    aws_secure_zero(x, sizeof(x));
+    return result;
+}
+
+int aws_ec_native_key_derive_shared_secret_batch(
+    const struct aws_ec_native_key *key,
+    const struct aws_ec_native_key *const *peers,
+    const struct aws_ec_native_table *const *peer_tables,
+    size_t count,
+    struct aws_byte_buf *shared_secrets) {
+    for (size_t i = 0; i < count; ++i) {
+        if (s_check_shared_secret(key, peers[i], peer_tables ? peer_tables[i] : NULL, &shared_secrets[i])) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    if (count == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    const struct aws_ec_native_curve *curve = key->curve;
+    size_t limbs = curve->limbs;
+
+    /* the private scalar is recoded once for the whole batch */
+    int8_t digits[S_WINDOW_COUNT(S_MAX_LIMBS * 64)];
+    s_scalar_recode(digits, key->d, limbs, s_window_count(curve));
+
+    struct s_key_block block;
+    uint64_t x[S_MAX_LIMBS];
+
+    for (size_t start = 0; start < count; start += S_KEY_BLOCK) {
+        size_t block_count = aws_min_size(S_KEY_BLOCK, count - start);
+
+        for (size_t i = 0; i < block_count; ++i) {
+            const struct aws_ec_native_table *peer_table = peer_tables ? peer_tables[start + i] : NULL;
+            s_shared_point_ct(digits, peers[start + i], peer_table, &block.points[i]);
+            memcpy(block.z_inv[i], block.points[i].z, sizeof(block.z_inv[i]));
+        }
+
+        s_mod_inv_batch(block.z_inv, block.prefix, block_count, &curve->p, limbs);
+
+        /* every buffer was checked for room up front */
+        for (size_t i = 0; i < block_count; ++i) {
+            S_FMUL(x, block.points[i].x, block.z_inv[i]);
+            s_write_element(curve, x, true, &shared_secrets[start + i]);
+        }
+    }
+
+    aws_secure_zero(digits, sizeof(digits));
+    aws_secure_zero(&block, sizeof(block));
+    aws_secure_zero(x, sizeof(x));
+    return AWS_OP_SUCCESS;
+}
+
+size_t aws_ec_native_signature_length(enum aws_ecc_curve_name curve_name) {
+    const struct aws_ec_native_curve *curve = aws_ec_native_curve_get(curve_name);
+    if (!curve) {
+        return 0;
+    }
+
+    /* SEQUENCE of two INTEGERs, each of which may need a leading zero */
+    return 2 + 2 * (2 + curve->coordinate_size + 1);
+}
+
+/* Appends INTEGER value to out, which has room for it. */
+static void s_der_write_integer(
+    const struct aws_ec_native_curve *curve,
+    const uint64_t *value,
+    struct aws_byte_buf *out) {
+    uint8_t bytes[S_MAX_LIMBS * 8 + 1];
+    bytes[0] = 0;
+    s_limbs_to_be_bytes(bytes + 1, value, curve->coordinate_size);
+
+    /* minimal encoding, keeping one zero byte in front of a set top bit */
+    size_t start = 0;
+    while (start < curve->coordinate_size && bytes[start] == 0 && !(bytes[start + 1] & 0x80)) {
+        ++start;
+    }
+
+    size_t length = curve->coordinate_size + 1 - start;
+    aws_byte_buf_write_u8(out, 0x02);
+    aws_byte_buf_write_u8(out, (uint8_t)length);
+    aws_byte_buf_write(out, bytes + start, length);
+}
+
+/* r = x mod n for the affine x coordinate of k * G, in Montgomery form mod p; x < p < 2n. */
+static void s_signature_r(const struct aws_ec_native_curve *curve, const uint64_t *x, uint64_t *r) {
+    size_t limbs = curve->limbs;
+    S_FMUL(r, x, s_plain_one);
+    s_mod_reduce_once(r, r, 0, curve->n.m, limbs);
+}
+
+/* Appends (r, s) in format to signature, which has room for it. */
+static void s_write_signature(
+    const struct aws_ec_native_curve *curve,
+    const uint64_t *r,
+    const uint64_t *s,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_buf *signature) {
+    if (format == AWS_EC_NATIVE_SIGNATURE_RAW) {
+        size_t size = curve->coordinate_size;
+        s_limbs_to_be_bytes(signature->buffer + signature->len, r, size);
+        s_limbs_to_be_bytes(signature->buffer + signature->len + size, s, size);
+        signature->len += 2 * size;
+        return;
+    }
+
+    uint8_t body[2 * (2 + S_MAX_LIMBS * 8 + 1)];
+    struct aws_byte_buf body_buf = aws_byte_buf_from_empty_array(body, sizeof(body));
+    s_der_write_integer(curve, r, &body_buf);
+    s_der_write_integer(curve, s, &body_buf);
+
+    /* at most 104 bytes, so the short length form always applies */
+    aws_byte_buf_write_u8(signature, 0x30);
+    aws_byte_buf_write_u8(signature, (uint8_t)body_buf.len);
+    aws_byte_buf_write(signature, body, body_buf.len);
+}
+
+/*
+ * The nonce for 0 < k < n. Returns false if r comes out zero, with probability about 2^-256, in which case the
+ * standard says to start over with another k.
+ */
+static bool s_nonce_from_scalar(
+    const struct aws_ec_native_curve *curve,
+    const uint64_t *k,
+    struct aws_ec_native_nonce *nonce) {
+    size_t limbs = curve->limbs;
+    uint64_t x[S_MAX_LIMBS], y[S_MAX_LIMBS];
+
+    s_point_mul_base_ct(curve, k, x, y);
+    s_signature_r(curve, x, nonce->r);
+    s_mod_mul(nonce->k_inv, k, curve->n.rr, &curve->n, limbs);
+    s_mod_inv(nonce->k_inv, nonce->k_inv, &curve->n, limbs);
+
+    aws_secure_zero(x, sizeof(x));
+    aws_secure_zero(y, sizeof(y));
+    return !s_limbs_is_zero(nonce->r, limbs);
+}
+
+int aws_ec_native_nonce_generate(enum aws_ecc_curve_name curve_name, struct aws_ec_native_nonce *nonce) {
+    const struct aws_ec_native_curve *curve = aws_ec_native_curve_get(curve_name);
+    if (!curve) {
+        return aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    }
+
+    int result = AWS_OP_ERR;
+    uint64_t k[S_MAX_LIMBS];
+
+    do {
+        if (s_random_scalar(curve, k)) {
+            goto done;
+        }
+    } while (!s_nonce_from_scalar(curve, k, nonce));
+
+    result = AWS_OP_SUCCESS;
+
+done:
+    aws_secure_zero(k, sizeof(k));
+    return result;
+}
+
+/*
+ * Nonces are made in blocks: the nonce points of a block are left projective and share one field inversion to get
+ * their x coordinates, and the nonces share one scalar inversion.
+ */
+#define S_NONCE_BLOCK 32
+
+struct s_nonce_block {
+    struct s_projective points[S_NONCE_BLOCK];
+    uint64_t z_inv[S_NONCE_BLOCK][S_MAX_LIMBS];
+    uint64_t k_inv[S_NONCE_BLOCK][S_MAX_LIMBS];
+    uint64_t prefix[S_NONCE_BLOCK][S_MAX_LIMBS];
+};
+
+static int s_nonce_generate_block(
+    const struct aws_ec_native_curve *curve,
+    struct aws_ec_native_nonce *nonces,
+    size_t count,
+    struct s_nonce_block *block) {
+    size_t limbs = curve->limbs;
+
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t *k = block->k_inv[i];
+        if (s_random_scalar(curve, k)) {
+            return AWS_OP_ERR;
+        }
+
+        s_point_mul_base_projective_ct(curve, k, &block->points[i]);
+        memcpy(block->z_inv[i], block->points[i].z, sizeof(block->z_inv[i]));
+        s_mod_mul(k, k, curve->n.rr, &curve->n, limbs);
+    }
+
+    s_mod_inv_batch(block->z_inv, block->prefix, count, &curve->p, limbs);
+    s_mod_inv_batch(block->k_inv, block->prefix, count, &curve->n, limbs);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t x[S_MAX_LIMBS];
+        S_FMUL(x, block->points[i].x, block->z_inv[i]);
+        s_signature_r(curve, x, nonces[i].r);
+        memcpy(nonces[i].k_inv, block->k_inv[i], sizeof(nonces[i].k_inv));
+
+        /* as unlikely as in aws_ec_native_nonce_generate(); start this one over on its own */
+        if (s_limbs_is_zero(nonces[i].r, limbs) && aws_ec_native_nonce_generate(curve->name, &nonces[i])) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ec_native_nonce_generate_batch(
+    enum aws_ecc_curve_name curve_name,
+    struct aws_ec_native_nonce *nonces,
+    size_t count) {
+    const struct aws_ec_native_curve *curve = aws_ec_native_curve_get(curve_name);
+    if (!curve) {
+        return aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    }
+
+    struct s_nonce_block block;
+    int result = AWS_OP_SUCCESS;
+
+    for (size_t start = 0; start < count; start += S_NONCE_BLOCK) {
+        if (s_nonce_generate_block(curve, nonces + start, aws_min_size(S_NONCE_BLOCK, count - start), &block)) {
+            result = AWS_OP_ERR;
+            break;
+        }
+    }
+
+    aws_secure_zero(&block, sizeof(block));
+    return result;
+}
+
+/*
+ * s = k^-1 * (e + r * d), the only part of signing that depends on the message; Montgomery form factors times plain
+ * ones give plain products. Returns false if s is zero, in which case the signature has to be made with another nonce.
+ */
+static bool s_sign_with_nonce(
+    const struct aws_ec_native_key *key,
+    const struct aws_ec_native_nonce *nonce,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_buf *signature) {
+    const struct aws_ec_native_curve *curve = key->curve;
+    size_t limbs = curve->limbs;
+    uint64_t e[S_MAX_LIMBS], t[S_MAX_LIMBS], s[S_MAX_LIMBS];
+
+    s_hash_to_scalar(curve, hash, e);
+    s_mod_mul(t, nonce->r, curve->n.rr, &curve->n, limbs);
+    s_mod_mul(t, t, key->d, &curve->n, limbs);
+    s_mod_add(t, t, e, curve->n.m, limbs);
+    s_mod_mul(s, nonce->k_inv, t, &curve->n, limbs);
+    aws_secure_zero(t, sizeof(t));
+
+    if (s_limbs_is_zero(s, limbs)) {
+        return false;
+    }
+
+    s_write_signature(curve, nonce->r, s, format, signature);
+    return true;
+}
+
+static int s_check_signing(
+    const struct aws_ec_native_key *key,
+    enum aws_ec_native_signature_format format,
+    const struct aws_byte_buf *signature) {
+    if (!key->has_private_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    size_t length = format == AWS_EC_NATIVE_SIGNATURE_RAW ? 2 * key->curve->coordinate_size
+                                                          : aws_ec_native_signature_length(key->curve->name);
+    if (signature->capacity - signature->len < length) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * RFC 6979 section 3.2 with HMAC-SHA256. The order's bit length is a multiple of 8 on both curves, so bits2int is
+ * taking the leading bytes, and bits2octets(h) is the big endian encoding of s_hash_to_scalar().
+ */
+struct s_rfc6979_drbg {
+    struct aws_sha256_hmac_key k;
+    uint8_t v[AWS_SHA256_HMAC_LEN];
+};
+
+/* V = HMAC_K(V) */
+static void s_rfc6979_update_v(struct s_rfc6979_drbg *drbg) {
+    struct aws_sha256_ctx ctx;
+    aws_sha256_hmac_ctx_init(&ctx, &drbg->k);
+    aws_sha256_ctx_update(&ctx, drbg->v, sizeof(drbg->v));
+    aws_sha256_hmac_ctx_finalize(&ctx, &drbg->k, drbg->v);
+}
+
+/* K = HMAC_K(V || ...), the HMAC in ctx with everything already absorbed, then V = HMAC_K(V) */
+static void s_rfc6979_rekey(struct s_rfc6979_drbg *drbg, struct aws_sha256_ctx *ctx) {
+    uint8_t k[AWS_SHA256_HMAC_LEN];
+    aws_sha256_hmac_ctx_finalize(ctx, &drbg->k, k);
+    aws_sha256_hmac_key_init(&drbg->k, k, sizeof(k));
+    aws_secure_zero(k, sizeof(k));
+
+    s_rfc6979_update_v(drbg);
+}
+
+/* steps b to g, starting from the key's midstate for the first HMAC */
+static void s_rfc6979_init(
+    const struct aws_ec_native_key *key,
+    const struct aws_byte_cursor *hash,
+    struct s_rfc6979_drbg *drbg) {
+    const struct aws_ec_native_curve *curve = key->curve;
+    size_t size = curve->coordinate_size;
+    uint8_t d[S_MAX_LIMBS * 8], h[S_MAX_LIMBS * 8];
+    uint64_t e[S_MAX_LIMBS];
+    static const uint8_t s_one = 0x01;
+
+    s_hash_to_scalar(curve, hash, e);
+    s_limbs_to_be_bytes(h, e, size);
+
+    drbg->k = key->rfc6979.zero_key;
+    memset(drbg->v, 0x01, sizeof(drbg->v));
+
+    struct aws_sha256_ctx ctx = key->rfc6979.prefix;
+    aws_sha256_ctx_update(&ctx, h, size);
+    s_rfc6979_rekey(drbg, &ctx);
+
+    s_limbs_to_be_bytes(d, key->d, size);
+    aws_sha256_hmac_ctx_init(&ctx, &drbg->k);
+    aws_sha256_ctx_update(&ctx, drbg->v, sizeof(drbg->v));
+    aws_sha256_ctx_update(&ctx, &s_one, 1);
+    aws_sha256_ctx_update(&ctx, d, size);
+    aws_sha256_ctx_update(&ctx, h, size);
+    s_rfc6979_rekey(drbg, &ctx);
+
+    aws_secure_zero(&ctx, sizeof(ctx));
+    aws_secure_zero(d, sizeof(d));
+}
+
+/* step h: the next candidate k, which the caller still has to check is in [1, n - 1] */
+static void s_rfc6979_candidate(const struct aws_ec_native_curve *curve, struct s_rfc6979_drbg *drbg, uint64_t *k) {
+    uint8_t t[2 * AWS_SHA256_HMAC_LEN];
+
+    for (size_t len = 0; len < curve->coordinate_size; len += AWS_SHA256_HMAC_LEN) {
+        s_rfc6979_update_v(drbg);
+        memcpy(t + len, drbg->v, sizeof(drbg->v));
+    }
+
+    s_limbs_from_be_bytes(k, aws_byte_cursor_from_array(t, curve->coordinate_size), curve->limbs);
+    aws_secure_zero(t, sizeof(t));
+}
+
+/* step h's retry, for a candidate that was out of range or gave r = 0 or s = 0: K = HMAC_K(V || 0x00) */
+static void s_rfc6979_reseed(struct s_rfc6979_drbg *drbg) {
+    static const uint8_t s_zero = 0x00;
+    struct aws_sha256_ctx ctx;
+    aws_sha256_hmac_ctx_init(&ctx, &drbg->k);
+    aws_sha256_ctx_update(&ctx, drbg->v, sizeof(drbg->v));
+    aws_sha256_ctx_update(&ctx, &s_zero, 1);
+    s_rfc6979_rekey(drbg, &ctx);
+}
+
+int aws_ec_native_key_set_deterministic_signing(struct aws_ec_native_key *key, bool deterministic) {
+    if (!deterministic) {
+        aws_secure_zero(&key->rfc6979, sizeof(key->rfc6979));
+        key->deterministic_signing = false;
+        return AWS_OP_SUCCESS;
+    }
+
+    if (!key->has_private_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    /* K starts out all zero and V all 0x01, so the first HMAC of every signature starts with V || 0x00 || d */
+    const uint8_t zero_k[AWS_SHA256_HMAC_LEN] = {0};
+    uint8_t prefix[AWS_SHA256_HMAC_LEN + 1 + S_MAX_LIMBS * 8];
+    size_t size = key->curve->coordinate_size;
+
+    memset(prefix, 0x01, AWS_SHA256_HMAC_LEN);
+    prefix[AWS_SHA256_HMAC_LEN] = 0x00;
+    s_limbs_to_be_bytes(prefix + AWS_SHA256_HMAC_LEN + 1, key->d, size);
+
+    aws_sha256_hmac_key_init(&key->rfc6979.zero_key, zero_k, sizeof(zero_k));
+    aws_sha256_hmac_ctx_init(&key->rfc6979.prefix, &key->rfc6979.zero_key);
+    aws_sha256_ctx_update(&key->rfc6979.prefix, prefix, AWS_SHA256_HMAC_LEN + 1 + size);
+    aws_secure_zero(prefix, sizeof(prefix));
+
+    key->deterministic_signing = true;
+    return AWS_OP_SUCCESS;
+}
+
+static void s_sign_deterministic(
+    const struct aws_ec_native_key *key,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_buf *signature) {
+    const struct aws_ec_native_curve *curve = key->curve;
+    struct s_rfc6979_drbg drbg;
+    struct aws_ec_native_nonce nonce;
+    uint64_t k[S_MAX_LIMBS];
+
+    s_rfc6979_init(key, hash, &drbg);
+
+    for (;;) {
+        s_rfc6979_candidate(curve, &drbg, k);
+        if (s_scalar_is_valid_ct(curve, k) && s_nonce_from_scalar(curve, k, &nonce) &&
+            s_sign_with_nonce(key, &nonce, hash, format, signature)) {
+            break;
+        }
+        s_rfc6979_reseed(&drbg);
+    }
+
+    aws_secure_zero(&drbg, sizeof(drbg));
+    aws_secure_zero(&nonce, sizeof(nonce));
+    aws_secure_zero(k, sizeof(k));
+}
+
+int aws_ec_native_sign(
+    const struct aws_ec_native_key *key,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_buf *signature) {
+    if (s_check_signing(key, format, signature)) {
+        return AWS_OP_ERR;
+    }
+
+    if (key->deterministic_signing) {
+        s_sign_deterministic(key, hash, format, signature);
+        return AWS_OP_SUCCESS;
+    }
+
+    struct aws_ec_native_nonce nonce;
+    int result = AWS_OP_ERR;
+
+    do {
+        if (aws_ec_native_nonce_generate(key->curve->name, &nonce)) {
+            goto done;
+        }
+    } while (!s_sign_with_nonce(key, &nonce, hash, format, signature));
+
+    result = AWS_OP_SUCCESS;
+
+done:
+    aws_secure_zero(&nonce, sizeof(nonce));
+    return result;
+}
+
+int aws_ec_native_sign_with_nonce(
+    const struct aws_ec_native_key *key,
+    struct aws_ec_native_nonce *nonce,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_buf *signature) {
+    if (s_check_signing(key, format, signature)) {
+        aws_secure_zero(nonce, sizeof(*nonce));
+        return AWS_OP_ERR;
+    }
+
+    bool signed_with_nonce = s_sign_with_nonce(key, nonce, hash, format, signature);
+    aws_secure_zero(nonce, sizeof(*nonce));
+
+    return signed_with_nonce ? AWS_OP_SUCCESS : aws_ec_native_sign(key, hash, format, signature);
+}
+
+int aws_ec_native_sign_batch(
+    const struct aws_ec_native_key *key,
+    const struct aws_byte_cursor *hashes,
+    size_t count,
+    struct aws_byte_buf *signatures) {
+    for (size_t i = 0; i < count; ++i) {
+        if (s_check_signing(key, AWS_EC_NATIVE_SIGNATURE_DER, &signatures[i])) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    /* each nonce depends on its hash, so there is nothing to share */
+    if (key->deterministic_signing) {
+        for (size_t i = 0; i < count; ++i) {
+            s_sign_deterministic(key, &hashes[i], AWS_EC_NATIVE_SIGNATURE_DER, &signatures[i]);
+        }
+        return AWS_OP_SUCCESS;
+    }
+
+    struct aws_ec_native_nonce nonces[S_NONCE_BLOCK];
+    int result = AWS_OP_SUCCESS;
+
+    for (size_t start = 0; start < count && result == AWS_OP_SUCCESS; start += S_NONCE_BLOCK) {
+        size_t block_count = aws_min_size(S_NONCE_BLOCK, count - start);
+        if (aws_ec_native_nonce_generate_batch(key->curve->name, nonces, block_count)) {
+            result = AWS_OP_ERR;
+            break;
+        }
+
+        for (size_t i = 0; i < block_count; ++i) {
+            if (aws_ec_native_sign_with_nonce(
+                    key, &nonces[i], &hashes[start + i], AWS_EC_NATIVE_SIGNATURE_DER, &signatures[start + i])) {
+                result = AWS_OP_ERR;
+                break;
+            }
+        }
+    }
+
+    aws_secure_zero(nonces, sizeof(nonces));
+    return result;
+}
@@ -0,0 +1,154 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ec_native.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/private/refill_worker.h>
+
+/*
+ * A ring of ready nonces, filled by a refill worker and emptied by signers. The worker makes nonces outside the lock
+ * and only takes it to publish them, so a signer never waits on a scalar multiplication.
+ */
+struct aws_ec_native_nonce_pool {
+    struct aws_allocator *allocator;
+    enum aws_ecc_curve_name curve_name;
+    size_t depth;
+    size_t refill_threshold;
+
+    /* its lock protects the ring and wanted */
+    struct aws_cal_refill_worker worker;
+
+    struct aws_ec_native_nonce *nonces;
+    size_t head;
+    size_t count;
+    /* set when nonces are taken, so a worker that failed to make any tries again */
+    bool wanted;
+
+    /* the chunk the worker is making; only the worker touches it */
+    struct aws_ec_native_nonce fresh[AWS_CAL_REFILL_CHUNK];
+};
+
+static bool s_has_work(void *user_data) {
+    struct aws_ec_native_nonce_pool *pool = user_data;
+    return pool->wanted && pool->count <= pool->refill_threshold;
+}
+
+static size_t s_missing(void *user_data) {
+    struct aws_ec_native_nonce_pool *pool = user_data;
+    return pool->depth - pool->count;
+}
+
+static int s_make_chunk(void *user_data, size_t count) {
+    struct aws_ec_native_nonce_pool *pool = user_data;
+    return aws_ec_native_nonce_generate_batch(pool->curve_name, pool->fresh, count);
+}
+
+static bool s_finish_chunk(void *user_data, int result, size_t count) {
+    struct aws_ec_native_nonce_pool *pool = user_data;
+
+    if (result) {
+        /* the RNG failed; signers make their own nonces and hit the error themselves */
+        aws_secure_zero(pool->fresh, count * sizeof(pool->fresh[0]));
+        pool->wanted = false;
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        pool->nonces[(pool->head + pool->count) % pool->depth] = pool->fresh[i];
+        ++pool->count;
+    }
+    /* the ring holds the only copy of a nonce from here on */
+    aws_secure_zero(pool->fresh, count * sizeof(pool->fresh[0]));
+    return true;
+}
+
+static const struct aws_cal_refill_worker_vtable s_refill_vtable = {
+    .has_work = s_has_work,
+    .missing = s_missing,
+    .make_chunk = s_make_chunk,
+    .finish_chunk = s_finish_chunk,
+};
+
+struct aws_ec_native_nonce_pool *aws_ec_native_nonce_pool_new(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    size_t depth,
+    size_t refill_threshold) {
+
+    if (!aws_ec_native_curve_get(curve_name)) {
+        aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+        return NULL;
+    }
+
+    if (depth == 0 || refill_threshold >= depth) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    struct aws_ec_native_nonce_pool *pool = aws_mem_calloc(allocator, 1, sizeof(struct aws_ec_native_nonce_pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->allocator = allocator;
+    pool->curve_name = curve_name;
+    pool->depth = depth;
+    pool->refill_threshold = refill_threshold;
+    /* fill up straight away */
+    pool->wanted = true;
+
+    pool->nonces = aws_mem_calloc(allocator, depth, sizeof(struct aws_ec_native_nonce));
+    if (!pool->nonces) {
+        goto on_error;
+    }
+
+    if (aws_cal_refill_worker_start(&pool->worker, allocator, &s_refill_vtable, pool)) {
+        goto on_error;
+    }
+
+    return pool;
+
+on_error:
+    aws_mem_release(allocator, pool->nonces);
+    aws_mem_release(allocator, pool);
+    return NULL;
+}
+
+void aws_ec_native_nonce_pool_destroy(struct aws_ec_native_nonce_pool *pool) {
+    if (!pool) {
+        return;
+    }
+
+    aws_cal_refill_worker_stop(&pool->worker);
+
+    aws_secure_zero(pool->nonces, pool->depth * sizeof(struct aws_ec_native_nonce));
+    aws_mem_release(pool->allocator, pool->nonces);
+    aws_mem_release(pool->allocator, pool);
+}
+
+bool aws_ec_native_nonce_pool_take(struct aws_ec_native_nonce_pool *pool, struct aws_ec_native_nonce *nonce) {
+    bool taken = false;
+
+    aws_mutex_lock(&pool->worker.lock);
+
+    if (pool->count) {
+        struct aws_ec_native_nonce *ready = &pool->nonces[pool->head];
+        *nonce = *ready;
+        aws_secure_zero(ready, sizeof(*ready));
+
+        pool->head = (pool->head + 1) % pool->depth;
+        --pool->count;
+        taken = true;
+    }
+
+    pool->wanted = true;
+    if (pool->count <= pool->refill_threshold) {
+        aws_condition_variable_notify_one(&pool->worker.signal);
+    }
+
+    aws_mutex_unlock(&pool->worker.lock);
+
+    return taken;
+}
@@ -6,8 +6,12 @@
 
 #include <aws/cal/cal.h>
 #include <aws/cal/private/der.h>
+#include <aws/cal/private/ec_native.h>
 #include <aws/common/encoding.h>
 
+/* aws_der_ecdsa_signature_max_length() of the largest scalars: the raw entry points go through DER on the stack */
+#define S_MAX_DER_SIGNATURE_LENGTH (3 + 2 * (3 + AWS_DER_ECDSA_MAX_ELEMENT_SIZE))
+
 #define STATIC_INIT_BYTE_CURSOR(a, name)                                                                               \
     static struct aws_byte_cursor s_##name = {                                                                         \
         .ptr = (a),                                                                                                    \
@@ -62,13 +66,163 @@ int aws_ecc_oid_from_curve_name(enum aws_ecc_curve_name curve_name, struct aws_b
     return AWS_OP_SUCCESS;
 }
 
+/* in AWS_BYO_CRYPTO builds the platform provider is the application's */
+static enum aws_ecc_provider s_ecc_providers[] = {
+    [AWS_CAL_ECDSA_P256] = AWS_ECC_PROVIDER_PLATFORM,
+    [AWS_CAL_ECDSA_P384] = AWS_ECC_PROVIDER_PLATFORM,
+};
+
+static bool s_is_native(enum aws_ecc_curve_name curve_name) {
+    return (size_t)curve_name < AWS_ARRAY_SIZE(s_ecc_providers) &&
+           s_ecc_providers[curve_name] == AWS_ECC_PROVIDER_NATIVE;
+}
+
+int aws_ecc_set_provider(enum aws_ecc_curve_name curve_name, enum aws_ecc_provider provider) {
+    if ((size_t)curve_name >= AWS_ARRAY_SIZE(s_ecc_providers)) {
+        return aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    }
+
+    switch (provider) {
+        case AWS_ECC_PROVIDER_PLATFORM:
+            break;
+        case AWS_ECC_PROVIDER_NATIVE:
+            if (!aws_ec_native_curve_get(curve_name)) {
+                return aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+            }
+            break;
+        default:
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    s_ecc_providers[curve_name] = provider;
+    return AWS_OP_SUCCESS;
+}
+
+enum aws_ecc_provider aws_ecc_get_provider(enum aws_ecc_curve_name curve_name) {
+    return s_is_native(curve_name) ? AWS_ECC_PROVIDER_NATIVE : AWS_ECC_PROVIDER_PLATFORM;
+}
+
+/* AWS_BYO_CRYPTO applications supply these four themselves */
+#ifndef AWS_BYO_CRYPTO
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *priv_key) {
+    if (s_is_native(curve_name)) {
+        return aws_ecc_key_pair_new_native_from_private_key(allocator, curve_name, priv_key);
+    }
+
+    return aws_ecc_key_pair_new_from_private_key_impl(allocator, curve_name, priv_key);
+}
+
+#    if !defined(AWS_OS_IOS)
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name) {
+    if (s_is_native(curve_name)) {
+        return aws_ecc_key_pair_new_native_generate_random(allocator, curve_name);
+    }
+
+    return aws_ecc_key_pair_new_generate_random_impl(allocator, curve_name);
+}
+#    endif /* !AWS_OS_IOS */
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *public_key_x,
+    const struct aws_byte_cursor *public_key_y) {
+    if (s_is_native(curve_name)) {
+        return aws_ecc_key_pair_new_native_from_public_key(allocator, curve_name, public_key_x, public_key_y);
+    }
+
+    return aws_ecc_key_pair_new_from_public_key_impl(allocator, curve_name, public_key_x, public_key_y);
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *encoded_keys) {
+
+    /* the curve is only known once the key is decoded, which the platform providers do their own way */
+    bool any_native = false;
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_ecc_providers); ++i) {
+        any_native |= s_ecc_providers[i] == AWS_ECC_PROVIDER_NATIVE;
+    }
+    if (!any_native) {
+        return aws_ecc_key_pair_new_from_asn1_impl(allocator, encoded_keys);
+    }
+
+    struct aws_der_decoder *decoder = aws_der_decoder_new(allocator, *encoded_keys);
+    if (!decoder) {
+        return NULL;
+    }
+
+    struct aws_ecc_key_pair *key = NULL;
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    struct aws_byte_cursor priv_d;
+    enum aws_ecc_curve_name curve_name;
+
+    if (!aws_der_decoder_load_ecc_key_pair(decoder, &pub_x, &pub_y, &priv_d, &curve_name)) {
+        if (s_is_native(curve_name)) {
+            key = aws_ecc_key_pair_new_native_from_components(allocator, curve_name, priv_d, pub_x, pub_y);
+        } else {
+            key = aws_ecc_key_pair_new_from_asn1_impl(allocator, encoded_keys);
+        }
+    }
+
+    aws_der_decoder_destroy(decoder);
+    return key;
+}
+#endif /* AWS_BYO_CRYPTO */
+
+#if !defined(AWS_OS_IOS)
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_deferred(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name) {
+    if (s_is_native(curve_name)) {
+        return aws_ecc_key_pair_new_native_generate_random_deferred(allocator, curve_name);
+    }
+
+#    ifndef AWS_BYO_CRYPTO
+    return aws_ecc_key_pair_new_generate_random_deferred_impl(allocator, curve_name);
+#    else
+    /* the application's provider has no way to defer, so its key pairs come complete */
+    return aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+#    endif
+}
+#endif /* !AWS_OS_IOS */
+
 static void s_aws_ecc_key_pair_destroy(struct aws_ecc_key_pair *key_pair) {
     if (key_pair) {
+        aws_ec_native_table_release(aws_atomic_load_ptr(&key_pair->verification_table));
         AWS_FATAL_ASSERT(key_pair->vtable->destroy && "ECC KEY PAIR destroy function must be included on the vtable");
         key_pair->vtable->destroy(key_pair);
     }
 }
 
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_replica(
+    struct aws_allocator *allocator,
+    struct aws_ecc_key_pair *key_pair) {
+    if (!key_pair->vtable->replicate) {
+        aws_ecc_key_pair_acquire(key_pair);
+        return key_pair;
+    }
+
+    struct aws_ecc_key_pair *replica = key_pair->vtable->replicate(key_pair, allocator);
+    if (!replica) {
+        return NULL;
+    }
+
+    /* the table is read only once built, so every replica can use the same one */
+    struct aws_ec_native_table *table = aws_atomic_load_ptr(&key_pair->verification_table);
+    if (table) {
+        aws_atomic_store_ptr(&replica->verification_table, aws_ec_native_table_acquire(table));
+    }
+
+    return replica;
+}
+
 int aws_ecc_key_pair_derive_public_key(struct aws_ecc_key_pair *key_pair) {
     AWS_FATAL_ASSERT(key_pair->vtable->derive_pub_key && "ECC KEY PAIR derive function must be included on the vtable");
     return key_pair->vtable->derive_pub_key(key_pair);
@@ -82,21 +236,238 @@ int aws_ecc_key_pair_sign_message(
     return key_pair->vtable->sign_message(key_pair, message, signature);
 }
 
+int aws_ecc_key_pair_sign_message_batch(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *messages,
+    size_t count,
+    struct aws_byte_buf *signatures) {
+    AWS_FATAL_ASSERT(key_pair->vtable->sign_message && "ECC KEY PAIR sign message must be included on the vtable");
+
+    size_t signature_length = aws_ecc_key_pair_signature_length(key_pair);
+    for (size_t i = 0; i < count; ++i) {
+        if (signatures[i].capacity - signatures[i].len < signature_length) {
+            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+        }
+    }
+
+    if (key_pair->vtable->sign_message_batch) {
+        return key_pair->vtable->sign_message_batch(key_pair, messages, count, signatures);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (key_pair->vtable->sign_message(key_pair, &messages[i], &signatures[i])) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ecc_key_pair_enable_nonce_pool(
+    struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_nonce_pool_options *options) {
+    if (!key_pair->vtable->enable_nonce_pool) {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
+
+    return key_pair->vtable->enable_nonce_pool(key_pair, options);
+}
+
+int aws_ecc_key_pair_set_deterministic_signing(struct aws_ecc_key_pair *key_pair, bool deterministic) {
+    if (!key_pair->vtable->set_deterministic_signing) {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
+
+    return key_pair->vtable->set_deterministic_signing(key_pair, deterministic);
+}
+
 int aws_ecc_key_pair_verify_signature(
     const struct aws_ecc_key_pair *key_pair,
     const struct aws_byte_cursor *message,
     const struct aws_byte_cursor *signature) {
     AWS_FATAL_ASSERT(
         key_pair->vtable->verify_signature && "ECC KEY PAIR verify signature must be included on the vtable");
+
+    const struct aws_ec_native_table *table = aws_atomic_load_ptr(&key_pair->verification_table);
+    if (table) {
+        return aws_ec_native_verify(table, message, AWS_EC_NATIVE_SIGNATURE_DER, signature);
+    }
+
     return key_pair->vtable->verify_signature(key_pair, message, signature);
 }
 
+int aws_ecc_key_pair_prepare_for_verification(struct aws_ecc_key_pair *key_pair) {
+    if (aws_atomic_load_ptr(&key_pair->verification_table)) {
+        return AWS_OP_SUCCESS;
+    }
+
+    if (!key_pair->pub_x.len || !key_pair->pub_y.len) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    struct aws_ec_native_table *table = aws_ec_native_table_new(
+        key_pair->allocator,
+        key_pair->curve_name,
+        aws_byte_cursor_from_buf(&key_pair->pub_x),
+        aws_byte_cursor_from_buf(&key_pair->pub_y));
+    if (!table) {
+        return AWS_OP_ERR;
+    }
+
+    /* another thread may have got there first; keep whichever table was published */
+    void *expected = NULL;
+    if (!aws_atomic_compare_exchange_ptr(&key_pair->verification_table, &expected, table)) {
+        aws_ec_native_table_release(table);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* The checks common to the ECDH entry points. */
+static int s_check_shared_secret(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *peer,
+    const struct aws_byte_buf *shared_secret) {
+    if (peer->curve_name != key_pair->curve_name) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (shared_secret->capacity - shared_secret->len <
+        aws_ecc_key_coordinate_byte_size_from_curve_name(key_pair->curve_name)) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    if (!peer->pub_x.len || !peer->pub_y.len) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ecc_key_pair_derive_shared_secret(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *peer,
+    struct aws_byte_buf *shared_secret) {
+    if (!key_pair->vtable->derive_shared_secret) {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
+
+    if (s_check_shared_secret(key_pair, peer, shared_secret)) {
+        return AWS_OP_ERR;
+    }
+
+    return key_pair->vtable->derive_shared_secret(key_pair, peer, shared_secret);
+}
+
+int aws_ecc_key_pair_derive_shared_secret_batch(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *const *peers,
+    size_t count,
+    struct aws_byte_buf *shared_secrets) {
+    if (!key_pair->vtable->derive_shared_secret) {
+        return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (s_check_shared_secret(key_pair, peers[i], &shared_secrets[i])) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    if (key_pair->vtable->derive_shared_secret_batch) {
+        return key_pair->vtable->derive_shared_secret_batch(key_pair, peers, count, shared_secrets);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (key_pair->vtable->derive_shared_secret(key_pair, peers[i], &shared_secrets[i])) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
 size_t aws_ecc_key_pair_signature_length(const struct aws_ecc_key_pair *key_pair) {
     AWS_FATAL_ASSERT(
         key_pair->vtable->signature_length && "ECC KEY PAIR signature length must be included on the vtable");
     return key_pair->vtable->signature_length(key_pair);
 }
 
+size_t aws_ecc_raw_signature_length(enum aws_ecc_curve_name curve_name) {
+    return 2 * aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+}
+
+int aws_ecc_key_pair_sign_message_raw(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *message,
+    struct aws_byte_buf *signature) {
+    AWS_FATAL_ASSERT(key_pair->vtable->sign_message && "ECC KEY PAIR sign message must be included on the vtable");
+
+    if (signature->capacity - signature->len < aws_ecc_raw_signature_length(key_pair->curve_name)) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    if (key_pair->vtable->sign_message_raw) {
+        return key_pair->vtable->sign_message_raw(key_pair, message, signature);
+    }
+
+    uint8_t der[S_MAX_DER_SIGNATURE_LENGTH] = {0};
+    AWS_FATAL_ASSERT(aws_ecc_key_pair_signature_length(key_pair) <= sizeof(der));
+    struct aws_byte_buf der_buf = aws_byte_buf_from_empty_array(der, sizeof(der));
+
+    if (key_pair->vtable->sign_message(key_pair, message, &der_buf)) {
+        return AWS_OP_ERR;
+    }
+
+    struct aws_byte_cursor der_cur = aws_byte_cursor_from_buf(&der_buf);
+    return aws_ecc_signatures_der_to_raw(key_pair->curve_name, &der_cur, 1, signature);
+}
+
+int aws_ecc_key_pair_verify_signature_raw(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *message,
+    const struct aws_byte_cursor *signature) {
+    AWS_FATAL_ASSERT(
+        key_pair->vtable->verify_signature && "ECC KEY PAIR verify signature must be included on the vtable");
+
+    const struct aws_ec_native_table *table = aws_atomic_load_ptr(&key_pair->verification_table);
+    if (table) {
+        return aws_ec_native_verify(table, message, AWS_EC_NATIVE_SIGNATURE_RAW, signature);
+    }
+
+    if (key_pair->vtable->verify_signature_raw) {
+        return key_pair->vtable->verify_signature_raw(key_pair, message, signature);
+    }
+
+    uint8_t der[S_MAX_DER_SIGNATURE_LENGTH] = {0};
+    struct aws_byte_buf der_buf = aws_byte_buf_from_empty_array(der, sizeof(der));
+
+    if (aws_ecc_signatures_raw_to_der(key_pair->curve_name, signature, 1, &der_buf)) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    struct aws_byte_cursor der_cur = aws_byte_cursor_from_buf(&der_buf);
+    return key_pair->vtable->verify_signature(key_pair, message, &der_cur);
+}
+
+int aws_ecc_signatures_der_to_raw(
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *der_signatures,
+    size_t count,
+    struct aws_byte_buf *raw_signatures) {
+    return aws_der_ecdsa_signatures_to_raw(
+        der_signatures, count, aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name), raw_signatures);
+}
+
+int aws_ecc_signatures_raw_to_der(
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *raw_signatures,
+    size_t count,
+    struct aws_byte_buf *der_signatures) {
+    return aws_der_ecdsa_signatures_from_raw(
+        raw_signatures, count, aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name), der_signatures);
+}
+
 void aws_ecc_key_pair_get_public_key(
     const struct aws_ecc_key_pair *key_pair,
     struct aws_byte_cursor *pub_x,
@@ -211,6 +582,87 @@ int aws_der_decoder_load_ecc_key_pair(
     return AWS_OP_SUCCESS;
 }
 
+void aws_ecc_key_pair_init(
+    struct aws_ecc_key_pair *key_pair,
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_ecc_key_pair_vtable *vtable,
+    void *impl) {
+    AWS_ZERO_STRUCT(*key_pair);
+    key_pair->allocator = allocator;
+    key_pair->curve_name = curve_name;
+    key_pair->vtable = vtable;
+    key_pair->impl = impl;
+    aws_atomic_init_int(&key_pair->ref_count, 1);
+    aws_atomic_init_ptr(&key_pair->verification_table, NULL);
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_with_storage(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    size_t impl_size,
+    struct aws_ecc_key_pair_vtable *vtable) {
+    AWS_FATAL_ASSERT(impl_size >= sizeof(struct aws_ecc_key_pair));
+
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+    uint8_t *block = aws_mem_calloc(allocator, 1, impl_size + 3 * coordinate_size);
+    if (!block) {
+        return NULL;
+    }
+
+    struct aws_ecc_key_pair *key_pair = (struct aws_ecc_key_pair *)block;
+    uint8_t *storage = block + impl_size;
+
+    aws_ecc_key_pair_init(key_pair, allocator, curve_name, vtable, block);
+    key_pair->pub_x = aws_byte_buf_from_empty_array(storage, coordinate_size);
+    key_pair->pub_y = aws_byte_buf_from_empty_array(storage + coordinate_size, coordinate_size);
+    key_pair->priv_d = aws_byte_buf_from_empty_array(storage + 2 * coordinate_size, coordinate_size);
+
+    return key_pair;
+}
+
+int aws_ecc_key_pair_write_coordinate(struct aws_byte_buf *coordinate, struct aws_byte_cursor value) {
+    /* encodings longer than the curve's are fine as long as the extra bytes are leading zeros */
+    while (value.len > coordinate->capacity && *value.ptr == 0) {
+        aws_byte_cursor_advance(&value, 1);
+    }
+
+    if (value.len > coordinate->capacity) {
+        return aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+    }
+
+    size_t padding = coordinate->capacity - value.len;
+    memset(coordinate->buffer, 0, padding);
+    if (value.len) {
+        memcpy(coordinate->buffer + padding, value.ptr, value.len);
+    }
+    coordinate->len = coordinate->capacity;
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_copy_coordinate(struct aws_byte_buf *to, const struct aws_byte_buf *from) {
+    AWS_FATAL_ASSERT(to->capacity == from->capacity);
+    if (from->len) {
+        memcpy(to->buffer, from->buffer, from->len);
+    }
+    to->len = from->len;
+}
+
+void aws_ecc_key_pair_copy_coordinates(struct aws_ecc_key_pair *replica, const struct aws_ecc_key_pair *key_pair) {
+    s_copy_coordinate(&replica->pub_x, &key_pair->pub_x);
+    s_copy_coordinate(&replica->pub_y, &key_pair->pub_y);
+    s_copy_coordinate(&replica->priv_d, &key_pair->priv_d);
+}
+
+int aws_ecc_key_pair_materialize_public_key(struct aws_ecc_key_pair *key_pair) {
+    if (!key_pair->vtable->materialize_public_key) {
+        return AWS_OP_SUCCESS;
+    }
+
+    return key_pair->vtable->materialize_public_key(key_pair);
+}
+
 void aws_ecc_key_pair_acquire(struct aws_ecc_key_pair *key_pair) {
     aws_atomic_fetch_add(&key_pair->ref_count, 1);
 }
@@ -267,3 +719,92 @@ done:
 
     return key;
 }
+
+/* SEC1 point encoding prefixes */
+#define S_SEC1_COMPRESSED_EVEN 0x02
+#define S_SEC1_COMPRESSED_ODD 0x03
+#define S_SEC1_UNCOMPRESSED 0x04
+
+size_t aws_ecc_sec1_public_key_length(enum aws_ecc_curve_name curve_name, bool compressed) {
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+    if (coordinate_size == 0) {
+        return 0;
+    }
+
+    return 1 + (compressed ? coordinate_size : 2 * coordinate_size);
+}
+
+/* appends value left padded with zeros to size bytes; the caller has checked that out has room */
+static void s_write_padded(struct aws_byte_buf *out, struct aws_byte_cursor value, size_t size) {
+    size_t padding = size - value.len;
+    memset(out->buffer + out->len, 0, padding);
+    out->len += padding;
+    aws_byte_buf_write_from_whole_cursor(out, value);
+}
+
+int aws_ecc_key_pair_write_sec1_public_key(
+    const struct aws_ecc_key_pair *key_pair,
+    bool compressed,
+    struct aws_byte_buf *out) {
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(key_pair->curve_name);
+
+    if (out->capacity - out->len < aws_ecc_sec1_public_key_length(key_pair->curve_name, compressed)) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    struct aws_byte_cursor x = aws_byte_cursor_from_buf(&key_pair->pub_x);
+    struct aws_byte_cursor y = aws_byte_cursor_from_buf(&key_pair->pub_y);
+    if (!x.len || !y.len) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    if (x.len > coordinate_size || y.len > coordinate_size) {
+        return aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+    }
+
+    if (compressed) {
+        uint8_t prefix = (y.ptr[y.len - 1] & 1) ? S_SEC1_COMPRESSED_ODD : S_SEC1_COMPRESSED_EVEN;
+        aws_byte_buf_write_u8(out, prefix);
+        s_write_padded(out, x, coordinate_size);
+    } else {
+        aws_byte_buf_write_u8(out, S_SEC1_UNCOMPRESSED);
+        s_write_padded(out, x, coordinate_size);
+        s_write_padded(out, y, coordinate_size);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_sec1_public_key(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *encoded) {
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+    if (coordinate_size == 0) {
+        aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+        return NULL;
+    }
+
+    struct aws_byte_cursor x = {0};
+    struct aws_byte_cursor y = {0};
+    uint8_t y_storage[AWS_EC_NATIVE_MAX_LIMBS * 8];
+
+    if (encoded->len == aws_ecc_sec1_public_key_length(curve_name, false) && encoded->ptr[0] == S_SEC1_UNCOMPRESSED) {
+        x = aws_byte_cursor_from_array(encoded->ptr + 1, coordinate_size);
+        y = aws_byte_cursor_from_array(encoded->ptr + 1 + coordinate_size, coordinate_size);
+    } else if (
+        encoded->len == aws_ecc_sec1_public_key_length(curve_name, true) &&
+        (encoded->ptr[0] == S_SEC1_COMPRESSED_EVEN || encoded->ptr[0] == S_SEC1_COMPRESSED_ODD)) {
+        x = aws_byte_cursor_from_array(encoded->ptr + 1, coordinate_size);
+        struct aws_byte_buf y_buf = aws_byte_buf_from_empty_array(y_storage, sizeof(y_storage));
+        if (aws_ec_native_decompress_point(curve_name, x, encoded->ptr[0] == S_SEC1_COMPRESSED_ODD, &y_buf)) {
+            return NULL;
+        }
+        y = aws_byte_cursor_from_buf(&y_buf);
+    } else {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    return aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &x, &y);
+}
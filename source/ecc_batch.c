@@ -0,0 +1,415 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/ecc.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/private/ec_native.h>
+#include <aws/common/condition_variable.h>
+#include <aws/common/math.h>
+#include <aws/common/mutex.h>
+#include <aws/common/system_info.h>
+#include <aws/common/thread.h>
+
+#include <stdlib.h>
+
+/*
+ * Smallest number of signatures from one key in a batch for which building a verification table just for the batch
+ * beats verifying them one by one through the key's provider, from bin/ecc_profile against libcrypto. On P-256 the
+ * platform providers are already about as fast as a table, so only very large groups are worth it there.
+ */
+static const size_t s_batch_table_threshold[] = {
+    [AWS_CAL_ECDSA_P256] = 256,
+    [AWS_CAL_ECDSA_P384] = 4,
+};
+
+/* Upper bound on the signatures a worker claims at once, so one large key group still spreads over every thread. */
+#define S_BATCH_SLICE_SIZE 32
+
+struct batch_item {
+    const struct aws_ecc_key_pair *key;
+    size_t index;
+};
+
+/* The signatures of one key, in batch order. */
+struct batch_group {
+    size_t start;
+    size_t count;
+    /* the key's own table if it was prepared for verification, else one built for this batch, else NULL */
+    const struct aws_ec_native_table *table;
+    struct aws_ec_native_table *owned_table;
+    bool build_table;
+};
+
+/* A run of at most S_BATCH_SLICE_SIZE signatures from one group. */
+struct batch_slice {
+    struct batch_group *group;
+    size_t start;
+    size_t count;
+};
+
+struct verify_batch {
+    const struct aws_byte_cursor *messages;
+    const struct aws_byte_cursor *signatures;
+    int *results;
+    struct batch_item *items;
+    struct batch_group *groups;
+    size_t group_count;
+    struct batch_slice *slices;
+    size_t slice_count;
+    struct aws_atomic_var next;
+    struct aws_atomic_var failures;
+};
+
+typedef void(s_batch_task_fn)(struct verify_batch *batch, size_t task);
+
+struct batch_phase {
+    struct verify_batch *batch;
+    s_batch_task_fn *task_fn;
+    size_t task_count;
+};
+
+struct verify_worker {
+    struct aws_ecc_verify_workers *workers;
+    struct aws_thread thread;
+    /* the last phase this worker ran its share of */
+    uint64_t generation;
+};
+
+struct aws_ecc_verify_workers {
+    struct aws_allocator *allocator;
+    struct verify_worker *workers;
+    size_t worker_count;
+
+    /* held by a batch for its whole run: batches sharing the workers take turns */
+    struct aws_mutex batch_lock;
+
+    struct aws_mutex lock;
+    struct aws_condition_variable work_signal;
+    struct aws_condition_variable done_signal;
+
+    /* protected by lock */
+    struct batch_phase *phase;
+    uint64_t generation;
+    size_t busy;
+    bool shutting_down;
+};
+
+static int s_compare_items(const void *a, const void *b) {
+    const struct batch_item *item_a = a;
+    const struct batch_item *item_b = b;
+
+    if (item_a->key != item_b->key) {
+        return (uintptr_t)item_a->key < (uintptr_t)item_b->key ? -1 : 1;
+    }
+
+    return item_a->index < item_b->index ? -1 : item_a->index > item_b->index;
+}
+
+static bool s_group_needs_table(const struct batch_group *group, const struct aws_ecc_key_pair *key) {
+    return !group->table && key->pub_x.len && (size_t)key->curve_name < AWS_ARRAY_SIZE(s_batch_table_threshold) &&
+           group->count >= s_batch_table_threshold[key->curve_name];
+}
+
+static void s_build_group_table(struct verify_batch *batch, size_t task) {
+    struct batch_group *group = &batch->groups[task];
+    if (!group->build_table) {
+        return;
+    }
+
+    /* on failure the group just goes through the key's provider */
+    const struct aws_ecc_key_pair *key = batch->items[group->start].key;
+    group->owned_table = aws_ec_native_table_new(
+        key->allocator, key->curve_name, aws_byte_cursor_from_buf(&key->pub_x), aws_byte_cursor_from_buf(&key->pub_y));
+    group->table = group->owned_table;
+}
+
+static void s_verify_slice(struct verify_batch *batch, size_t task) {
+    struct batch_slice *slice = &batch->slices[task];
+
+    for (size_t i = slice->start; i < slice->start + slice->count; ++i) {
+        const struct batch_item *item = &batch->items[i];
+        const struct aws_byte_cursor *message = &batch->messages[item->index];
+        const struct aws_byte_cursor *signature = &batch->signatures[item->index];
+
+        int result = slice->group->table
+                         ? aws_ec_native_verify(slice->group->table, message, AWS_EC_NATIVE_SIGNATURE_DER, signature)
+                         : aws_ecc_key_pair_verify_signature(item->key, message, signature);
+
+        batch->results[item->index] = result == AWS_OP_SUCCESS ? AWS_ERROR_SUCCESS : aws_last_error();
+        if (result != AWS_OP_SUCCESS) {
+            aws_atomic_fetch_add(&batch->failures, 1);
+        }
+    }
+}
+
+static void s_phase_worker(void *user_data) {
+    struct batch_phase *phase = user_data;
+
+    for (;;) {
+        size_t task = aws_atomic_fetch_add(&phase->batch->next, 1);
+        if (task >= phase->task_count) {
+            return;
+        }
+        phase->task_fn(phase->batch, task);
+    }
+}
+
+static bool s_worker_has_work(void *user_data) {
+    struct verify_worker *worker = user_data;
+    return worker->workers->shutting_down || worker->workers->generation != worker->generation;
+}
+
+static void s_worker_thread(void *user_data) {
+    struct verify_worker *worker = user_data;
+    struct aws_ecc_verify_workers *workers = worker->workers;
+
+    aws_mutex_lock(&workers->lock);
+    for (;;) {
+        aws_condition_variable_wait_pred(&workers->work_signal, &workers->lock, s_worker_has_work, worker);
+        if (workers->shutting_down) {
+            break;
+        }
+
+        worker->generation = workers->generation;
+        struct batch_phase *phase = workers->phase;
+        aws_mutex_unlock(&workers->lock);
+
+        s_phase_worker(phase);
+
+        aws_mutex_lock(&workers->lock);
+        if (--workers->busy == 0) {
+            aws_condition_variable_notify_one(&workers->done_signal);
+        }
+    }
+    aws_mutex_unlock(&workers->lock);
+}
+
+static bool s_phase_done(void *user_data) {
+    struct aws_ecc_verify_workers *workers = user_data;
+    return workers->busy == 0;
+}
+
+/* stops and joins the first launched workers, then frees the set */
+static void s_workers_destroy(struct aws_ecc_verify_workers *workers, size_t launched) {
+    aws_mutex_lock(&workers->lock);
+    workers->shutting_down = true;
+    aws_condition_variable_notify_all(&workers->work_signal);
+    aws_mutex_unlock(&workers->lock);
+
+    for (size_t i = 0; i < launched; ++i) {
+        aws_thread_join(&workers->workers[i].thread);
+        aws_thread_clean_up(&workers->workers[i].thread);
+    }
+
+    aws_condition_variable_clean_up(&workers->done_signal);
+    aws_condition_variable_clean_up(&workers->work_signal);
+    aws_mutex_clean_up(&workers->lock);
+    aws_mutex_clean_up(&workers->batch_lock);
+    aws_mem_release(workers->allocator, workers->workers);
+    aws_mem_release(workers->allocator, workers);
+}
+
+struct aws_ecc_verify_workers *aws_ecc_verify_workers_new(struct aws_allocator *allocator, size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = aws_system_info_processor_count();
+    }
+
+    struct aws_ecc_verify_workers *workers = aws_mem_calloc(allocator, 1, sizeof(struct aws_ecc_verify_workers));
+    if (!workers) {
+        return NULL;
+    }
+
+    workers->allocator = allocator;
+    /* the thread calling aws_ecc_verify_batch() is the last one */
+    workers->worker_count = thread_count > 1 ? thread_count - 1 : 0;
+
+    if (aws_mutex_init(&workers->batch_lock)) {
+        goto on_alloc_error;
+    }
+    if (aws_mutex_init(&workers->lock)) {
+        goto on_batch_lock_error;
+    }
+    if (aws_condition_variable_init(&workers->work_signal)) {
+        goto on_lock_error;
+    }
+    if (aws_condition_variable_init(&workers->done_signal)) {
+        goto on_work_signal_error;
+    }
+
+    if (workers->worker_count) {
+        workers->workers = aws_mem_calloc(allocator, workers->worker_count, sizeof(struct verify_worker));
+        if (!workers->workers) {
+            goto on_done_signal_error;
+        }
+    }
+
+    for (size_t i = 0; i < workers->worker_count; ++i) {
+        struct verify_worker *worker = &workers->workers[i];
+        worker->workers = workers;
+
+        if (aws_thread_init(&worker->thread, allocator)) {
+            s_workers_destroy(workers, i);
+            return NULL;
+        }
+        if (aws_thread_launch(&worker->thread, s_worker_thread, worker, NULL)) {
+            aws_thread_clean_up(&worker->thread);
+            s_workers_destroy(workers, i);
+            return NULL;
+        }
+    }
+
+    return workers;
+
+on_done_signal_error:
+    aws_condition_variable_clean_up(&workers->done_signal);
+on_work_signal_error:
+    aws_condition_variable_clean_up(&workers->work_signal);
+on_lock_error:
+    aws_mutex_clean_up(&workers->lock);
+on_batch_lock_error:
+    aws_mutex_clean_up(&workers->batch_lock);
+on_alloc_error:
+    aws_mem_release(allocator, workers);
+    return NULL;
+}
+
+void aws_ecc_verify_workers_destroy(struct aws_ecc_verify_workers *workers) {
+    if (workers == NULL) {
+        return;
+    }
+
+    s_workers_destroy(workers, workers->worker_count);
+}
+
+/*
+ * Runs task_fn for every task in [0, task_count) on the calling thread and, if there is more than one task, on every
+ * one of workers' threads. Tasks are claimed one at a time, so threads that find nothing left just go back to sleep.
+ */
+static void s_run_phase(
+    struct verify_batch *batch,
+    s_batch_task_fn *task_fn,
+    size_t task_count,
+    struct aws_ecc_verify_workers *workers) {
+
+    struct batch_phase phase = {
+        .batch = batch,
+        .task_fn = task_fn,
+        .task_count = task_count,
+    };
+    aws_atomic_store_int(&batch->next, 0);
+
+    bool wake = workers && workers->worker_count && task_count > 1;
+    if (wake) {
+        aws_mutex_lock(&workers->lock);
+        workers->phase = &phase;
+        workers->generation++;
+        workers->busy = workers->worker_count;
+        aws_condition_variable_notify_all(&workers->work_signal);
+        aws_mutex_unlock(&workers->lock);
+    }
+
+    s_phase_worker(&phase);
+
+    if (wake) {
+        /* phase lives on this stack, so every worker has to be done with it */
+        aws_mutex_lock(&workers->lock);
+        aws_condition_variable_wait_pred(&workers->done_signal, &workers->lock, s_phase_done, workers);
+        workers->phase = NULL;
+        aws_mutex_unlock(&workers->lock);
+    }
+}
+
+int aws_ecc_verify_batch(
+    struct aws_allocator *allocator,
+    struct aws_ecc_key_pair *const *keys,
+    const struct aws_byte_cursor *messages,
+    const struct aws_byte_cursor *signatures,
+    size_t count,
+    struct aws_ecc_verify_workers *workers,
+    int *results) {
+
+    if (count == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    struct verify_batch batch = {
+        .messages = messages,
+        .signatures = signatures,
+        .results = results,
+    };
+    aws_atomic_init_int(&batch.failures, 0);
+
+    int ret = AWS_OP_ERR;
+
+    batch.items = aws_mem_calloc(allocator, count, sizeof(struct batch_item));
+    batch.groups = aws_mem_calloc(allocator, count, sizeof(struct batch_group));
+    /* every group is cut into slices, so there are fewer than count / S_BATCH_SLICE_SIZE + group_count of them */
+    batch.slices = aws_mem_calloc(allocator, count / S_BATCH_SLICE_SIZE + count, sizeof(struct batch_slice));
+    if (!batch.items || !batch.groups || !batch.slices) {
+        goto done;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        batch.items[i].key = keys[i];
+        batch.items[i].index = i;
+    }
+
+    /* same key, same worker: its table or the provider's per key state stays hot in that core's cache */
+    qsort(batch.items, count, sizeof(struct batch_item), s_compare_items);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (i == 0 || batch.items[i].key != batch.items[i - 1].key) {
+            batch.groups[batch.group_count++].start = i;
+        }
+        batch.groups[batch.group_count - 1].count++;
+    }
+
+    size_t table_builds = 0;
+    for (size_t i = 0; i < batch.group_count; ++i) {
+        struct batch_group *group = &batch.groups[i];
+        const struct aws_ecc_key_pair *key = batch.items[group->start].key;
+
+        group->table = aws_atomic_load_ptr(&key->verification_table);
+        group->build_table = s_group_needs_table(group, key);
+        table_builds += group->build_table;
+
+        for (size_t offset = 0; offset < group->count; offset += S_BATCH_SLICE_SIZE) {
+            struct batch_slice *slice = &batch.slices[batch.slice_count++];
+            slice->group = group;
+            slice->start = group->start + offset;
+            slice->count = aws_min_size(S_BATCH_SLICE_SIZE, group->count - offset);
+        }
+    }
+
+    if (workers) {
+        aws_mutex_lock(&workers->batch_lock);
+    }
+    if (table_builds) {
+        s_run_phase(&batch, s_build_group_table, batch.group_count, workers);
+    }
+    s_run_phase(&batch, s_verify_slice, batch.slice_count, workers);
+    if (workers) {
+        aws_mutex_unlock(&workers->batch_lock);
+    }
+
+    if (aws_atomic_load_int(&batch.failures)) {
+        aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    } else {
+        ret = AWS_OP_SUCCESS;
+    }
+
+done:
+    if (batch.groups) {
+        for (size_t i = 0; i < batch.group_count; ++i) {
+            aws_ec_native_table_release(batch.groups[i].owned_table);
+        }
+    }
+
+    aws_mem_release(allocator, batch.slices);
+    aws_mem_release(allocator, batch.groups);
+    aws_mem_release(allocator, batch.items);
+
+    return ret;
+}
@@ -0,0 +1,298 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ecc.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/private/ec_native.h>
+#include <aws/cal/private/refill_worker.h>
+#include <aws/common/math.h>
+
+#if !defined(AWS_OS_IOS)
+
+/*
+ * A slot of the ring. sequence says whose turn it is, as in Vyukov's bounded MPMC queue: it equals the position a
+ * producer may fill the slot at, and that position + 1 once the key pair in it is ready to be taken.
+ */
+struct key_pool_slot {
+    struct aws_atomic_var sequence;
+    struct aws_ecc_key_pair *key_pair;
+};
+
+/*
+ * Key pairs for one curve, generated ahead of time by a refill worker. The worker is the ring's only producer, takers
+ * claim slots with a compare and swap on dequeue_pos, so taking a key pair never blocks. The worker's lock only serves
+ * to put it to sleep and wake it up again, and takers take it once per refill at most.
+ */
+struct aws_ecc_key_pool {
+    struct aws_allocator *allocator;
+    enum aws_ecc_curve_name curve_name;
+    bool native;
+    size_t depth;
+    size_t refill_threshold;
+
+    /* the ring holds depth rounded up to a power of two */
+    struct key_pool_slot *slots;
+    size_t mask;
+    struct aws_atomic_var enqueue_pos;
+    struct aws_atomic_var dequeue_pos;
+
+    /* set by the first taker to leave the pool at or below refill_threshold, cleared when the worker wakes up */
+    struct aws_atomic_var refill_requested;
+
+    struct aws_cal_refill_worker worker;
+
+    /* key pairs the worker made but could not push yet, see s_push(); only the worker touches them */
+    struct aws_ecc_key_pair *unpushed[AWS_CAL_REFILL_CHUNK];
+    size_t unpushed_count;
+
+    /* protected by the worker's lock */
+    bool refill_stalled;
+};
+
+/* How many key pairs are ready; exact for the worker, a snapshot for everyone else. */
+static size_t s_ready_count(struct aws_ecc_key_pool *pool) {
+    /* dequeue_pos first: enqueue_pos only grows, so the difference can't wrap */
+    size_t dequeue_pos = aws_atomic_load_int(&pool->dequeue_pos);
+    size_t enqueue_pos = aws_atomic_load_int(&pool->enqueue_pos);
+    return enqueue_pos - dequeue_pos;
+}
+
+/*
+ * Only called by the worker. A taker moves dequeue_pos on before it hands its slot back, so s_ready_count() can show
+ * room while the slot at enqueue_pos is still taken; as in Vyukov's queue the ring counts as full then, and this
+ * returns false.
+ */
+static bool s_push(struct aws_ecc_key_pool *pool, struct aws_ecc_key_pair *key_pair) {
+    size_t pos = aws_atomic_load_int(&pool->enqueue_pos);
+    struct key_pool_slot *slot = &pool->slots[pos & pool->mask];
+    if (aws_atomic_load_int(&slot->sequence) != pos) {
+        return false;
+    }
+
+    slot->key_pair = key_pair;
+    aws_atomic_store_int(&pool->enqueue_pos, pos + 1);
+    aws_atomic_store_int(&slot->sequence, pos + 1);
+    return true;
+}
+
+/* Pushes as many of the unpushed key pairs as the ring takes, oldest first. */
+static void s_push_unpushed(struct aws_ecc_key_pool *pool) {
+    size_t pushed = 0;
+    while (pushed < pool->unpushed_count && s_push(pool, pool->unpushed[pushed])) {
+        ++pushed;
+    }
+
+    pool->unpushed_count -= pushed;
+    memmove(pool->unpushed, pool->unpushed + pushed, pool->unpushed_count * sizeof(pool->unpushed[0]));
+}
+
+static struct aws_ecc_key_pair *s_pop(struct aws_ecc_key_pool *pool) {
+    size_t pos = aws_atomic_load_int(&pool->dequeue_pos);
+
+    for (;;) {
+        struct key_pool_slot *slot = &pool->slots[pos & pool->mask];
+        size_t sequence = aws_atomic_load_int(&slot->sequence);
+
+        if (sequence == pos + 1) {
+            /* on failure pos is updated to whatever another taker moved dequeue_pos to */
+            if (aws_atomic_compare_exchange_int(&pool->dequeue_pos, &pos, pos + 1)) {
+                struct aws_ecc_key_pair *key_pair = slot->key_pair;
+                slot->key_pair = NULL;
+                aws_atomic_store_int(&slot->sequence, pos + pool->mask + 1);
+                return key_pair;
+            }
+        } else if (sequence == pos) {
+            /* not filled yet, the pool is empty */
+            return NULL;
+        } else {
+            /* another taker got this slot first */
+            pos = aws_atomic_load_int(&pool->dequeue_pos);
+        }
+    }
+}
+
+/* One key pair from the pool's provider, for takers that found the pool empty. */
+static struct aws_ecc_key_pair *s_generate_one(struct aws_ecc_key_pool *pool) {
+    if (pool->native) {
+        return aws_ecc_key_pair_new_native_generate_random(pool->allocator, pool->curve_name);
+    }
+
+#    ifndef AWS_BYO_CRYPTO
+    return aws_ecc_key_pair_new_generate_random_impl(pool->allocator, pool->curve_name);
+#    else
+    /* the application's constructor */
+    return aws_ecc_key_pair_new_generate_random(pool->allocator, pool->curve_name);
+#    endif
+}
+
+/* count complete key pairs, ready to hand out. */
+static int s_generate(struct aws_ecc_key_pool *pool, struct aws_ecc_key_pair **key_pairs, size_t count) {
+    if (pool->native) {
+        return aws_ecc_key_pair_new_native_generate_batch(pool->allocator, pool->curve_name, key_pairs, count);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        key_pairs[i] = s_generate_one(pool);
+        if (!key_pairs[i]) {
+            for (size_t j = 0; j <= i; ++j) {
+                aws_ecc_key_pair_release(key_pairs[j]);
+                key_pairs[j] = NULL;
+            }
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static bool s_has_work(void *user_data) {
+    struct aws_ecc_key_pool *pool = user_data;
+
+    /* after a refill stopped early, only try again once a taker asks */
+    return aws_atomic_load_int(&pool->refill_requested) ||
+           (!pool->refill_stalled && s_ready_count(pool) <= pool->refill_threshold);
+}
+
+static size_t s_missing(void *user_data) {
+    struct aws_ecc_key_pool *pool = user_data;
+
+    /* the refill under way answers any request, and ends a stall */
+    aws_atomic_store_int(&pool->refill_requested, 0);
+    pool->refill_stalled = false;
+
+    size_t ready = s_ready_count(pool);
+    return ready < pool->depth ? pool->depth - ready : 0;
+}
+
+static int s_make_chunk(void *user_data, size_t count) {
+    struct aws_ecc_key_pool *pool = user_data;
+
+    int result = AWS_OP_SUCCESS;
+    if (!pool->unpushed_count) {
+        result = s_generate(pool, pool->unpushed, count);
+        pool->unpushed_count = result == AWS_OP_SUCCESS ? count : 0;
+    }
+    s_push_unpushed(pool);
+
+    return result;
+}
+
+static bool s_finish_chunk(void *user_data, int result, size_t count) {
+    struct aws_ecc_key_pool *pool = user_data;
+    (void)count;
+
+    /*
+     * Either the RNG failed, and takers make their own key pairs and hit the error themselves, or the ring is full
+     * behind a taker that hasn't handed its slot back; the leftovers go in first next time.
+     */
+    if (result || pool->unpushed_count) {
+        pool->refill_stalled = true;
+        return false;
+    }
+
+    return true;
+}
+
+static const struct aws_cal_refill_worker_vtable s_refill_vtable = {
+    .has_work = s_has_work,
+    .missing = s_missing,
+    .make_chunk = s_make_chunk,
+    .finish_chunk = s_finish_chunk,
+};
+
+struct aws_ecc_key_pool *aws_ecc_key_pool_new(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_ecc_key_pool_options *options) {
+
+    bool native = aws_ecc_get_provider(curve_name) == AWS_ECC_PROVIDER_NATIVE;
+    if (!aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name) ||
+        (native && !aws_ec_native_curve_get(curve_name))) {
+        aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+        return NULL;
+    }
+
+    if (options->depth == 0 || options->refill_threshold >= options->depth) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    size_t capacity = 0;
+    if (aws_round_up_to_power_of_two(options->depth, &capacity)) {
+        return NULL;
+    }
+
+    struct aws_ecc_key_pool *pool = aws_mem_calloc(allocator, 1, sizeof(struct aws_ecc_key_pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->allocator = allocator;
+    pool->curve_name = curve_name;
+    pool->native = native;
+    pool->depth = options->depth;
+    pool->refill_threshold = options->refill_threshold;
+    pool->mask = capacity - 1;
+    aws_atomic_init_int(&pool->enqueue_pos, 0);
+    aws_atomic_init_int(&pool->dequeue_pos, 0);
+    /* fill up straight away */
+    aws_atomic_init_int(&pool->refill_requested, 1);
+
+    pool->slots = aws_mem_calloc(allocator, capacity, sizeof(struct key_pool_slot));
+    if (!pool->slots) {
+        goto on_error;
+    }
+
+    for (size_t i = 0; i < capacity; ++i) {
+        aws_atomic_init_int(&pool->slots[i].sequence, i);
+    }
+
+    if (aws_cal_refill_worker_start(&pool->worker, allocator, &s_refill_vtable, pool)) {
+        goto on_error;
+    }
+
+    return pool;
+
+on_error:
+    aws_mem_release(allocator, pool->slots);
+    aws_mem_release(allocator, pool);
+    return NULL;
+}
+
+void aws_ecc_key_pool_destroy(struct aws_ecc_key_pool *pool) {
+    if (!pool) {
+        return;
+    }
+
+    aws_cal_refill_worker_stop(&pool->worker);
+
+    struct aws_ecc_key_pair *key_pair = NULL;
+    while ((key_pair = s_pop(pool)) != NULL) {
+        aws_ecc_key_pair_release(key_pair);
+    }
+    for (size_t i = 0; i < pool->unpushed_count; ++i) {
+        aws_ecc_key_pair_release(pool->unpushed[i]);
+    }
+
+    aws_mem_release(pool->allocator, pool->slots);
+    aws_mem_release(pool->allocator, pool);
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pool_take(struct aws_ecc_key_pool *pool) {
+    struct aws_ecc_key_pair *key_pair = s_pop(pool);
+
+    /* only the taker that flips the flag wakes the worker, everyone else stays off the lock */
+    if (s_ready_count(pool) <= pool->refill_threshold && !aws_atomic_exchange_int(&pool->refill_requested, 1)) {
+        aws_cal_refill_worker_wake(&pool->worker);
+    }
+
+    if (key_pair) {
+        return key_pair;
+    }
+
+    return s_generate_one(pool);
+}
+
+#endif /* !AWS_OS_IOS */
@@ -0,0 +1,237 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/ecc.h>
+
+#include <aws/common/array_list.h>
+#include <aws/common/mutex.h>
+
+/*
+ * Epoch based reclamation. The slot's epoch goes up by one every time a key pair is published. A reader records the
+ * epoch it entered in before it loads the current key pair, and clears it when it leaves. A key pair replaced while
+ * the epoch was E can only be in use by readers that entered in E or earlier, so it is released once every reader is
+ * either outside or entered after E.
+ */
+struct aws_ecc_key_slot {
+    struct aws_allocator *allocator;
+
+    /* read by every reader, only written by aws_ecc_key_slot_publish() */
+    struct aws_atomic_var current;
+    struct aws_atomic_var epoch;
+
+    /* protects readers and retired, which only publishers and reader registration touch */
+    struct aws_mutex lock;
+    /* struct aws_ecc_key_slot_reader * */
+    struct aws_array_list readers;
+    /* struct retired_key_pair */
+    struct aws_array_list retired;
+};
+
+struct aws_ecc_key_slot_reader {
+    struct aws_ecc_key_slot *slot;
+    /* the epoch the reader entered in, 0 while it is outside */
+    struct aws_atomic_var epoch;
+    /* keeps each reader's epoch off the cache lines of neighbouring allocations, which it writes twice per read */
+    uint8_t padding[64];
+};
+
+struct retired_key_pair {
+    struct aws_ecc_key_pair *key_pair;
+    /* the slot's epoch when the key pair was replaced */
+    size_t epoch;
+};
+
+struct aws_ecc_key_slot *aws_ecc_key_slot_new(struct aws_allocator *allocator, struct aws_ecc_key_pair *key_pair) {
+    struct aws_ecc_key_slot *slot = aws_mem_calloc(allocator, 1, sizeof(struct aws_ecc_key_slot));
+    if (!slot) {
+        return NULL;
+    }
+
+    slot->allocator = allocator;
+
+    if (aws_mutex_init(&slot->lock)) {
+        goto on_error;
+    }
+
+    if (aws_array_list_init_dynamic(&slot->readers, allocator, 8, sizeof(struct aws_ecc_key_slot_reader *))) {
+        goto on_mutex_error;
+    }
+
+    if (aws_array_list_init_dynamic(&slot->retired, allocator, 4, sizeof(struct retired_key_pair))) {
+        goto on_readers_error;
+    }
+
+    if (key_pair) {
+        aws_ecc_key_pair_acquire(key_pair);
+    }
+    aws_atomic_init_ptr(&slot->current, key_pair);
+    /* 0 marks readers that are outside */
+    aws_atomic_init_int(&slot->epoch, 1);
+
+    return slot;
+
+on_readers_error:
+    aws_array_list_clean_up(&slot->readers);
+on_mutex_error:
+    aws_mutex_clean_up(&slot->lock);
+on_error:
+    aws_mem_release(allocator, slot);
+    return NULL;
+}
+
+/* Releases the retired key pairs no reader can still be using. Call with the lock held. */
+static void s_reclaim(struct aws_ecc_key_slot *slot) {
+    size_t oldest = aws_atomic_load_int(&slot->epoch);
+
+    size_t reader_count = aws_array_list_length(&slot->readers);
+    for (size_t i = 0; i < reader_count; ++i) {
+        struct aws_ecc_key_slot_reader *reader = NULL;
+        aws_array_list_get_at(&slot->readers, &reader, i);
+
+        size_t reader_epoch = aws_atomic_load_int(&reader->epoch);
+        if (reader_epoch && reader_epoch < oldest) {
+            oldest = reader_epoch;
+        }
+    }
+
+    /* keep the ones still in their grace period at the front, in order */
+    size_t retired_count = aws_array_list_length(&slot->retired);
+    size_t kept = 0;
+    for (size_t i = 0; i < retired_count; ++i) {
+        struct retired_key_pair *retired = NULL;
+        aws_array_list_get_at_ptr(&slot->retired, (void **)&retired, i);
+
+        if (retired->epoch < oldest) {
+            aws_ecc_key_pair_release(retired->key_pair);
+            continue;
+        }
+
+        struct retired_key_pair *keep = NULL;
+        aws_array_list_get_at_ptr(&slot->retired, (void **)&keep, kept++);
+        *keep = *retired;
+    }
+
+    for (size_t i = kept; i < retired_count; ++i) {
+        aws_array_list_pop_back(&slot->retired);
+    }
+}
+
+void aws_ecc_key_slot_destroy(struct aws_ecc_key_slot *slot) {
+    if (!slot) {
+        return;
+    }
+
+    AWS_FATAL_ASSERT(aws_array_list_length(&slot->readers) == 0 && "key slot destroyed with readers registered");
+
+    size_t retired_count = aws_array_list_length(&slot->retired);
+    for (size_t i = 0; i < retired_count; ++i) {
+        struct retired_key_pair *retired = NULL;
+        aws_array_list_get_at_ptr(&slot->retired, (void **)&retired, i);
+        aws_ecc_key_pair_release(retired->key_pair);
+    }
+
+    aws_ecc_key_pair_release(aws_atomic_load_ptr(&slot->current));
+
+    aws_array_list_clean_up(&slot->retired);
+    aws_array_list_clean_up(&slot->readers);
+    aws_mutex_clean_up(&slot->lock);
+    aws_mem_release(slot->allocator, slot);
+}
+
+int aws_ecc_key_slot_publish(struct aws_ecc_key_slot *slot, struct aws_ecc_key_pair *key_pair) {
+    aws_mutex_lock(&slot->lock);
+
+    /* make room first, so failing leaves the current key pair in place */
+    struct retired_key_pair retired = {.key_pair = NULL};
+    if (aws_array_list_push_back(&slot->retired, &retired)) {
+        aws_mutex_unlock(&slot->lock);
+        return AWS_OP_ERR;
+    }
+
+    if (key_pair) {
+        aws_ecc_key_pair_acquire(key_pair);
+    }
+
+    /* readers that load the old key pair entered no later than the epoch read here */
+    retired.key_pair = aws_atomic_exchange_ptr(&slot->current, key_pair);
+    retired.epoch = aws_atomic_fetch_add(&slot->epoch, 1);
+
+    struct retired_key_pair *back = NULL;
+    aws_array_list_get_at_ptr(&slot->retired, (void **)&back, aws_array_list_length(&slot->retired) - 1);
+    *back = retired;
+
+    s_reclaim(slot);
+
+    aws_mutex_unlock(&slot->lock);
+    return AWS_OP_SUCCESS;
+}
+
+void aws_ecc_key_slot_reclaim(struct aws_ecc_key_slot *slot) {
+    aws_mutex_lock(&slot->lock);
+    s_reclaim(slot);
+    aws_mutex_unlock(&slot->lock);
+}
+
+struct aws_ecc_key_slot_reader *aws_ecc_key_slot_reader_new(struct aws_ecc_key_slot *slot) {
+    struct aws_ecc_key_slot_reader *reader = aws_mem_calloc(slot->allocator, 1, sizeof(struct aws_ecc_key_slot_reader));
+    if (!reader) {
+        return NULL;
+    }
+
+    reader->slot = slot;
+    aws_atomic_init_int(&reader->epoch, 0);
+
+    aws_mutex_lock(&slot->lock);
+    int result = aws_array_list_push_back(&slot->readers, &reader);
+    aws_mutex_unlock(&slot->lock);
+
+    if (result) {
+        aws_mem_release(slot->allocator, reader);
+        return NULL;
+    }
+
+    return reader;
+}
+
+void aws_ecc_key_slot_reader_destroy(struct aws_ecc_key_slot_reader *reader) {
+    if (!reader) {
+        return;
+    }
+
+    struct aws_ecc_key_slot *slot = reader->slot;
+    AWS_FATAL_ASSERT(aws_atomic_load_int(&reader->epoch) == 0 && "key slot reader destroyed inside a read");
+
+    aws_mutex_lock(&slot->lock);
+
+    size_t reader_count = aws_array_list_length(&slot->readers);
+    for (size_t i = 0; i < reader_count; ++i) {
+        struct aws_ecc_key_slot_reader **entry = NULL;
+        aws_array_list_get_at_ptr(&slot->readers, (void **)&entry, i);
+        if (*entry == reader) {
+            aws_array_list_get_at(&slot->readers, entry, reader_count - 1);
+            aws_array_list_pop_back(&slot->readers);
+            break;
+        }
+    }
+
+    /* this reader may have been all that held some retired key pairs back */
+    s_reclaim(slot);
+
+    aws_mutex_unlock(&slot->lock);
+
+    aws_mem_release(slot->allocator, reader);
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_slot_read_begin(struct aws_ecc_key_slot_reader *reader) {
+    struct aws_ecc_key_slot *slot = reader->slot;
+    AWS_FATAL_ASSERT(aws_atomic_load_int(&reader->epoch) == 0 && "key slot reads don't nest");
+
+    /* announce the epoch before loading the key pair, so a publisher that swaps it out sees this reader */
+    aws_atomic_store_int(&reader->epoch, aws_atomic_load_int(&slot->epoch));
+    return aws_atomic_load_ptr(&slot->current);
+}
+
+void aws_ecc_key_slot_read_end(struct aws_ecc_key_slot_reader *reader) {
+    aws_atomic_store_int(&reader->epoch, 0);
+}
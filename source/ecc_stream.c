@@ -0,0 +1,115 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/ecc.h>
+
+#include <aws/cal/hash.h>
+#include <aws/cal/private/sha256.h>
+
+/*
+ * Both directions are a key reference plus an in-place SHA-256 state: updates go straight into the compression
+ * function and the digest only ever exists on the stack of the call that signs or verifies it.
+ */
+struct aws_ecc_signer {
+    struct aws_allocator *allocator;
+    struct aws_ecc_key_pair *key_pair;
+    struct aws_sha256_ctx hash;
+};
+
+struct aws_ecc_verifier {
+    struct aws_allocator *allocator;
+    struct aws_ecc_key_pair *key_pair;
+    struct aws_sha256_ctx hash;
+};
+
+/* Finishes hash into digest and restarts it for the next message. */
+static struct aws_byte_cursor s_finish_digest(struct aws_sha256_ctx *hash, uint8_t digest[AWS_SHA256_LEN]) {
+    aws_sha256_ctx_finalize(hash, digest);
+    aws_sha256_ctx_init(hash);
+    return aws_byte_cursor_from_array(digest, AWS_SHA256_LEN);
+}
+
+struct aws_ecc_signer *aws_ecc_signer_new(struct aws_allocator *allocator, struct aws_ecc_key_pair *key_pair) {
+    struct aws_ecc_signer *signer = aws_mem_calloc(allocator, 1, sizeof(struct aws_ecc_signer));
+    if (!signer) {
+        return NULL;
+    }
+
+    signer->allocator = allocator;
+    signer->key_pair = key_pair;
+    aws_ecc_key_pair_acquire(key_pair);
+    aws_sha256_ctx_init(&signer->hash);
+
+    return signer;
+}
+
+void aws_ecc_signer_destroy(struct aws_ecc_signer *signer) {
+    if (!signer) {
+        return;
+    }
+
+    aws_ecc_key_pair_release(signer->key_pair);
+    aws_mem_release(signer->allocator, signer);
+}
+
+int aws_ecc_signer_update(struct aws_ecc_signer *signer, const struct aws_byte_cursor *data) {
+    aws_sha256_ctx_update(&signer->hash, data->ptr, data->len);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ecc_signer_finalize(struct aws_ecc_signer *signer, struct aws_byte_buf *signature) {
+    uint8_t digest[AWS_SHA256_LEN];
+    struct aws_byte_cursor digest_cur = s_finish_digest(&signer->hash, digest);
+
+    return aws_ecc_key_pair_sign_message(signer->key_pair, &digest_cur, signature);
+}
+
+int aws_ecc_signer_finalize_raw(struct aws_ecc_signer *signer, struct aws_byte_buf *signature) {
+    uint8_t digest[AWS_SHA256_LEN];
+    struct aws_byte_cursor digest_cur = s_finish_digest(&signer->hash, digest);
+
+    return aws_ecc_key_pair_sign_message_raw(signer->key_pair, &digest_cur, signature);
+}
+
+struct aws_ecc_verifier *aws_ecc_verifier_new(struct aws_allocator *allocator, struct aws_ecc_key_pair *key_pair) {
+    struct aws_ecc_verifier *verifier = aws_mem_calloc(allocator, 1, sizeof(struct aws_ecc_verifier));
+    if (!verifier) {
+        return NULL;
+    }
+
+    verifier->allocator = allocator;
+    verifier->key_pair = key_pair;
+    aws_ecc_key_pair_acquire(key_pair);
+    aws_sha256_ctx_init(&verifier->hash);
+
+    return verifier;
+}
+
+void aws_ecc_verifier_destroy(struct aws_ecc_verifier *verifier) {
+    if (!verifier) {
+        return;
+    }
+
+    aws_ecc_key_pair_release(verifier->key_pair);
+    aws_mem_release(verifier->allocator, verifier);
+}
+
+int aws_ecc_verifier_update(struct aws_ecc_verifier *verifier, const struct aws_byte_cursor *data) {
+    aws_sha256_ctx_update(&verifier->hash, data->ptr, data->len);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ecc_verifier_finalize(struct aws_ecc_verifier *verifier, const struct aws_byte_cursor *signature) {
+    uint8_t digest[AWS_SHA256_LEN];
+    struct aws_byte_cursor digest_cur = s_finish_digest(&verifier->hash, digest);
+
+    return aws_ecc_key_pair_verify_signature(verifier->key_pair, &digest_cur, signature);
+}
+
+int aws_ecc_verifier_finalize_raw(struct aws_ecc_verifier *verifier, const struct aws_byte_cursor *signature) {
+    uint8_t digest[AWS_SHA256_LEN];
+    struct aws_byte_cursor digest_cur = s_finish_digest(&verifier->hash, digest);
+
+    return aws_ecc_key_pair_verify_signature_raw(verifier->key_pair, &digest_cur, signature);
+}
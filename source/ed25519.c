@@ -0,0 +1,258 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ed25519.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/private/ed25519_native.h>
+#include <aws/common/device_random.h>
+#include <aws/common/math.h>
+
+/* set by aws_ed25519_set_provider(); until then the platform's Ed25519 where it has one, the native one otherwise */
+static bool s_provider_selected = false;
+static enum aws_ecc_provider s_provider = AWS_ECC_PROVIDER_NATIVE;
+
+static bool s_platform_is_supported(void) {
+#ifndef AWS_BYO_CRYPTO
+    return aws_ed25519_platform_is_supported();
+#else
+    return false;
+#endif
+}
+
+int aws_ed25519_set_provider(enum aws_ecc_provider provider) {
+    switch (provider) {
+        case AWS_ECC_PROVIDER_PLATFORM:
+            if (!s_platform_is_supported()) {
+                return aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+            }
+            break;
+        case AWS_ECC_PROVIDER_NATIVE:
+            break;
+        default:
+            return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    s_provider = provider;
+    s_provider_selected = true;
+    return AWS_OP_SUCCESS;
+}
+
+enum aws_ecc_provider aws_ed25519_get_provider(void) {
+    if (s_provider_selected) {
+        return s_provider;
+    }
+
+    return s_platform_is_supported() ? AWS_ECC_PROVIDER_PLATFORM : AWS_ECC_PROVIDER_NATIVE;
+}
+
+void aws_ed25519_key_pair_init(
+    struct aws_ed25519_key_pair *key_pair,
+    struct aws_allocator *allocator,
+    struct aws_ed25519_key_pair_vtable *vtable,
+    void *impl) {
+    AWS_ZERO_STRUCT(*key_pair);
+    key_pair->allocator = allocator;
+    aws_atomic_init_int(&key_pair->ref_count, 1);
+    key_pair->vtable = vtable;
+    key_pair->impl = impl;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_private_key(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *private_key) {
+    if (private_key->len != AWS_ED25519_PRIVATE_KEY_LEN) {
+        aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+        return NULL;
+    }
+
+#ifndef AWS_BYO_CRYPTO
+    if (aws_ed25519_get_provider() == AWS_ECC_PROVIDER_PLATFORM) {
+        return aws_ed25519_key_pair_new_from_private_key_impl(allocator, *private_key);
+    }
+#endif
+
+    return aws_ed25519_key_pair_new_native_from_private_key(allocator, *private_key);
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_generate_random(struct aws_allocator *allocator) {
+    uint8_t seed[AWS_ED25519_PRIVATE_KEY_LEN] = {0};
+    struct aws_byte_buf seed_buf = aws_byte_buf_from_empty_array(seed, sizeof(seed));
+    if (aws_device_random_buffer(&seed_buf)) {
+        return NULL;
+    }
+
+    struct aws_byte_cursor private_key = aws_byte_cursor_from_buf(&seed_buf);
+    struct aws_ed25519_key_pair *key_pair = aws_ed25519_key_pair_new_from_private_key(allocator, &private_key);
+    aws_secure_zero(seed, sizeof(seed));
+    return key_pair;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_public_key(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *public_key) {
+    if (public_key->len != AWS_ED25519_PUBLIC_KEY_LEN) {
+        aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+        return NULL;
+    }
+
+#ifndef AWS_BYO_CRYPTO
+    if (aws_ed25519_get_provider() == AWS_ECC_PROVIDER_PLATFORM) {
+        return aws_ed25519_key_pair_new_from_public_key_impl(allocator, *public_key);
+    }
+#endif
+
+    return aws_ed25519_key_pair_new_native_from_public_key(allocator, *public_key);
+}
+
+void aws_ed25519_key_pair_acquire(struct aws_ed25519_key_pair *key_pair) {
+    aws_atomic_fetch_add(&key_pair->ref_count, 1);
+}
+
+void aws_ed25519_key_pair_release(struct aws_ed25519_key_pair *key_pair) {
+    if (key_pair == NULL) {
+        return;
+    }
+
+    size_t old_value = aws_atomic_fetch_sub(&key_pair->ref_count, 1);
+
+    if (old_value == 1) {
+        aws_secure_zero(key_pair->private_key, sizeof(key_pair->private_key));
+        key_pair->vtable->destroy(key_pair);
+    }
+}
+
+void aws_ed25519_key_pair_get_public_key(
+    const struct aws_ed25519_key_pair *key_pair,
+    struct aws_byte_cursor *public_key) {
+    *public_key = aws_byte_cursor_from_array(key_pair->public_key, sizeof(key_pair->public_key));
+}
+
+void aws_ed25519_key_pair_get_private_key(
+    const struct aws_ed25519_key_pair *key_pair,
+    struct aws_byte_cursor *private_key) {
+    size_t len = key_pair->has_private_key ? AWS_ED25519_PRIVATE_KEY_LEN : 0;
+    *private_key = aws_byte_cursor_from_array(key_pair->private_key, len);
+}
+
+int aws_ed25519_key_pair_sign_message(
+    const struct aws_ed25519_key_pair *key_pair,
+    const struct aws_byte_cursor *message,
+    struct aws_byte_buf *signature) {
+    if (!key_pair->has_private_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    if (signature->capacity - signature->len < AWS_ED25519_SIGNATURE_LEN) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    return key_pair->vtable->sign_message(key_pair, *message, signature);
+}
+
+int aws_ed25519_key_pair_verify_signature(
+    const struct aws_ed25519_key_pair *key_pair,
+    const struct aws_byte_cursor *message,
+    const struct aws_byte_cursor *signature) {
+    if (signature->len != AWS_ED25519_SIGNATURE_LEN) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    return key_pair->vtable->verify_signature(key_pair, *message, *signature);
+}
+
+/*
+ * Batches run on the native engine whatever provider the keys are from: platform key pairs get a native key decoded
+ * from their public key for the duration of the batch, once per distinct key pair in a block. Everything the batch
+ * needs is allocated up front, in one block.
+ */
+int aws_ed25519_verify_batch(
+    struct aws_allocator *allocator,
+    struct aws_ed25519_key_pair *const *keys,
+    const struct aws_byte_cursor *messages,
+    const struct aws_byte_cursor *signatures,
+    size_t count,
+    int *results) {
+    if (count == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    size_t block_size = aws_min_size(count, AWS_ED25519_NATIVE_BATCH_BLOCK);
+    size_t scratch_size = aws_ed25519_native_batch_scratch_size();
+    void *scratch = NULL;
+    struct aws_ed25519_native_key *decoded_keys = NULL;
+    const struct aws_ed25519_native_key **native_keys = NULL;
+    if (!aws_mem_acquire_many(
+            allocator,
+            3,
+            &scratch,
+            scratch_size,
+            &decoded_keys,
+            block_size * sizeof(struct aws_ed25519_native_key),
+            &native_keys,
+            block_size * sizeof(struct aws_ed25519_native_key *))) {
+        return AWS_OP_ERR;
+    }
+
+    bool all_valid = true;
+    for (size_t start = 0; start < count; start += block_size) {
+        size_t block_count = aws_min_size(count - start, block_size);
+        size_t decoded_count = 0;
+        bool block_checked = true;
+
+        for (size_t i = 0; i < block_count; ++i) {
+            const struct aws_ed25519_key_pair *key_pair = keys[start + i];
+            if (key_pair->native_key) {
+                native_keys[i] = key_pair->native_key;
+                continue;
+            }
+
+            /* the same platform key pair earlier in the block already has its native key */
+            size_t earlier = 0;
+            while (earlier < i && keys[start + earlier] != key_pair) {
+                ++earlier;
+            }
+            if (earlier < i) {
+                native_keys[i] = native_keys[earlier];
+                continue;
+            }
+
+            struct aws_ed25519_native_key *decoded = &decoded_keys[decoded_count++];
+            AWS_ZERO_STRUCT(*decoded);
+            if (aws_ed25519_native_key_set_public_key(
+                    decoded, aws_byte_cursor_from_array(key_pair->public_key, sizeof(key_pair->public_key)))) {
+                block_checked = false;
+                break;
+            }
+            native_keys[i] = decoded;
+        }
+
+        if (block_checked &&
+            !aws_ed25519_native_verify_batch(scratch, native_keys, messages + start, signatures + start, block_count)) {
+            for (size_t i = 0; i < block_count; ++i) {
+                results[start + i] = AWS_ERROR_SUCCESS;
+            }
+            continue;
+        }
+
+        /* something in the block is bad: find out what, one signature at a time */
+        for (size_t i = 0; i < block_count; ++i) {
+            size_t index = start + i;
+            if (aws_ed25519_key_pair_verify_signature(keys[index], &messages[index], &signatures[index])) {
+                results[index] = aws_last_error();
+                all_valid = false;
+            } else {
+                results[index] = AWS_ERROR_SUCCESS;
+            }
+        }
+    }
+
+    aws_mem_release(allocator, scratch);
+
+    if (!all_valid) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    return AWS_OP_SUCCESS;
+}
@@ -0,0 +1,1170 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ed25519_native.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/private/sha512.h>
+#include <aws/common/device_random.h>
+#include <aws/common/math.h>
+#include <aws/common/thread.h>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#    include <intrin.h>
+#endif
+
+#define S_LIMBS AWS_ED25519_NATIVE_LIMBS
+#define S_MASK51 ((UINT64_C(1) << 51) - 1)
+
+/*
+ * 64 x 64 -> 128 bit products for the field and scalar code: the compiler's 128 bit integers where it has them, a
+ * pair of words otherwise.
+ */
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 s_wide;
+
+static inline s_wide s_mul(uint64_t a, uint64_t b) {
+    return (s_wide)a * b;
+}
+
+static inline s_wide s_wide_add(s_wide a, s_wide b) {
+    return a + b;
+}
+
+static inline s_wide s_wide_add64(s_wide a, uint64_t b) {
+    return a + b;
+}
+
+static inline uint64_t s_wide_lo(s_wide a) {
+    return (uint64_t)a;
+}
+
+static inline uint64_t s_wide_hi(s_wide a) {
+    return (uint64_t)(a >> 64);
+}
+#else
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+} s_wide;
+
+static inline s_wide s_mul(uint64_t a, uint64_t b) {
+    s_wide r;
+#    if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    r.lo = _umul128(a, b, &r.hi);
+#    else
+    uint64_t a_lo = a & 0xffffffff;
+    uint64_t a_hi = a >> 32;
+    uint64_t b_lo = b & 0xffffffff;
+    uint64_t b_hi = b >> 32;
+
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t middle = (lo_lo >> 32) + (lo_hi & 0xffffffff) + (hi_lo & 0xffffffff);
+
+    r.lo = (lo_lo & 0xffffffff) | (middle << 32);
+    r.hi = a_hi * b_hi + (lo_hi >> 32) + (hi_lo >> 32) + (middle >> 32);
+#    endif
+    return r;
+}
+
+static inline s_wide s_wide_add(s_wide a, s_wide b) {
+    s_wide r;
+    r.lo = a.lo + b.lo;
+    r.hi = a.hi + b.hi + (r.lo < a.lo);
+    return r;
+}
+
+static inline s_wide s_wide_add64(s_wide a, uint64_t b) {
+    s_wide r;
+    r.lo = a.lo + b;
+    r.hi = a.hi + (r.lo < b);
+    return r;
+}
+
+static inline uint64_t s_wide_lo(s_wide a) {
+    return a.lo;
+}
+
+static inline uint64_t s_wide_hi(s_wide a) {
+    return a.hi;
+}
+#endif
+
+/* the carry out of a 51 bit limb; the field code keeps every sum below 2^115, so it fits a word */
+static inline uint64_t s_wide_shr51(s_wide a) {
+    return (s_wide_lo(a) >> 51) | (s_wide_hi(a) << 13);
+}
+
+static inline uint64_t s_load64_le(const uint8_t *in) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value |= (uint64_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+static inline void s_store64_le(uint8_t *out, uint64_t value) {
+    for (size_t i = 0; i < 8; ++i) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/* all ones if a == b, else zero */
+static inline uint64_t s_ct_eq_mask(uint64_t a, uint64_t b) {
+    uint64_t x = a ^ b;
+    return ((x | (0 - x)) >> 63) - 1;
+}
+
+/*
+ * Field arithmetic mod p = 2^255 - 19. Limbs are below 2^52 between operations: every operation ends with a carry
+ * pass, so sums and differences can feed multiplications directly. Only s_fe_to_bytes() reduces fully.
+ */
+static const uint64_t s_fe_one[S_LIMBS] = {1};
+static const uint64_t s_fe_d[S_LIMBS] = {
+    0x34dca135978a3ULL, 0x1a8283b156ebdULL, 0x5e7a26001c029ULL, 0x739c663a03cbbULL, 0x52036cee2b6ffULL};
+static const uint64_t s_fe_2d[S_LIMBS] = {
+    0x69b9426b2f159ULL, 0x35050762add7aULL, 0x3cf44c0038052ULL, 0x6738cc7407977ULL, 0x2406d9dc56dffULL};
+static const uint64_t s_fe_sqrtm1[S_LIMBS] = {
+    0x61b274a0ea0b0ULL, 0x0d5a5fc8f189dULL, 0x7ef5e9cbd0c60ULL, 0x78595a6804c9eULL, 0x2b8324804fc1dULL};
+
+/* the base point, y = 4/5 and x even */
+static const uint64_t s_base_x[S_LIMBS] = {
+    0x62d608f25d51aULL, 0x412a4b4f6592aULL, 0x75b7171a4b31dULL, 0x1ff60527118feULL, 0x216936d3cd6e5ULL};
+static const uint64_t s_base_y[S_LIMBS] = {
+    0x6666666666658ULL, 0x4ccccccccccccULL, 0x1999999999999ULL, 0x3333333333333ULL, 0x6666666666666ULL};
+
+static inline void s_fe_carry(uint64_t *r) {
+    uint64_t c = r[0] >> 51;
+    r[0] &= S_MASK51;
+    for (size_t i = 1; i < S_LIMBS; ++i) {
+        r[i] += c;
+        c = r[i] >> 51;
+        r[i] &= S_MASK51;
+    }
+    r[0] += c * 19;
+}
+
+static inline void s_fe_add(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+    for (size_t i = 0; i < S_LIMBS; ++i) {
+        r[i] = a[i] + b[i];
+    }
+    s_fe_carry(r);
+}
+
+/* adds 4p first so no limb goes negative */
+static inline void s_fe_sub(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+    r[0] = a[0] + 0x1fffffffffffb4ULL - b[0];
+    for (size_t i = 1; i < S_LIMBS; ++i) {
+        r[i] = a[i] + 0x1ffffffffffffcULL - b[i];
+    }
+    s_fe_carry(r);
+}
+
+static inline void s_fe_neg(uint64_t *r, const uint64_t *a) {
+    static const uint64_t zero[S_LIMBS] = {0};
+    s_fe_sub(r, zero, a);
+}
+
+/* r = mask ? a : r, for a mask of all ones or all zeros */
+static inline void s_fe_cmov(uint64_t *r, const uint64_t *a, uint64_t mask) {
+    for (size_t i = 0; i < S_LIMBS; ++i) {
+        r[i] ^= mask & (r[i] ^ a[i]);
+    }
+}
+
+static inline void s_fe_reduce_wide(uint64_t *r, s_wide t0, s_wide t1, s_wide t2, s_wide t3, s_wide t4) {
+    t1 = s_wide_add64(t1, s_wide_shr51(t0));
+    t2 = s_wide_add64(t2, s_wide_shr51(t1));
+    t3 = s_wide_add64(t3, s_wide_shr51(t2));
+    t4 = s_wide_add64(t4, s_wide_shr51(t3));
+
+    r[0] = (s_wide_lo(t0) & S_MASK51) + s_wide_shr51(t4) * 19;
+    r[1] = (s_wide_lo(t1) & S_MASK51) + (r[0] >> 51);
+    r[0] &= S_MASK51;
+    r[2] = s_wide_lo(t2) & S_MASK51;
+    r[3] = s_wide_lo(t3) & S_MASK51;
+    r[4] = s_wide_lo(t4) & S_MASK51;
+}
+
+/* 2^255 = 19 mod p, so the products that land past limb 4 wrap around times 19 */
+static void s_fe_mul(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+    uint64_t b1_19 = b[1] * 19;
+    uint64_t b2_19 = b[2] * 19;
+    uint64_t b3_19 = b[3] * 19;
+    uint64_t b4_19 = b[4] * 19;
+
+    s_wide t0 = s_wide_add(
+        s_wide_add(s_mul(a[0], b[0]), s_mul(a[1], b4_19)),
+        s_wide_add(s_wide_add(s_mul(a[2], b3_19), s_mul(a[3], b2_19)), s_mul(a[4], b1_19)));
+    s_wide t1 = s_wide_add(
+        s_wide_add(s_mul(a[0], b[1]), s_mul(a[1], b[0])),
+        s_wide_add(s_wide_add(s_mul(a[2], b4_19), s_mul(a[3], b3_19)), s_mul(a[4], b2_19)));
+    s_wide t2 = s_wide_add(
+        s_wide_add(s_mul(a[0], b[2]), s_mul(a[1], b[1])),
+        s_wide_add(s_wide_add(s_mul(a[2], b[0]), s_mul(a[3], b4_19)), s_mul(a[4], b3_19)));
+    s_wide t3 = s_wide_add(
+        s_wide_add(s_mul(a[0], b[3]), s_mul(a[1], b[2])),
+        s_wide_add(s_wide_add(s_mul(a[2], b[1]), s_mul(a[3], b[0])), s_mul(a[4], b4_19)));
+    s_wide t4 = s_wide_add(
+        s_wide_add(s_mul(a[0], b[4]), s_mul(a[1], b[3])),
+        s_wide_add(s_wide_add(s_mul(a[2], b[2]), s_mul(a[3], b[1])), s_mul(a[4], b[0])));
+
+    s_fe_reduce_wide(r, t0, t1, t2, t3, t4);
+}
+
+static void s_fe_sq(uint64_t *r, const uint64_t *a) {
+    uint64_t d0 = a[0] * 2;
+    uint64_t d1 = a[1] * 2;
+    uint64_t d2 = a[2] * 2;
+    uint64_t d3 = a[3] * 2;
+    uint64_t a3_19 = a[3] * 19;
+    uint64_t a4_19 = a[4] * 19;
+
+    s_wide t0 = s_wide_add(s_wide_add(s_mul(a[0], a[0]), s_mul(d1, a4_19)), s_mul(d2, a3_19));
+    s_wide t1 = s_wide_add(s_wide_add(s_mul(d0, a[1]), s_mul(d2, a4_19)), s_mul(a[3], a3_19));
+    s_wide t2 = s_wide_add(s_wide_add(s_mul(d0, a[2]), s_mul(a[1], a[1])), s_mul(d3, a4_19));
+    s_wide t3 = s_wide_add(s_wide_add(s_mul(d0, a[3]), s_mul(d1, a[2])), s_mul(a[4], a4_19));
+    s_wide t4 = s_wide_add(s_wide_add(s_mul(d0, a[4]), s_mul(d1, a[3])), s_mul(a[2], a[2]));
+
+    s_fe_reduce_wide(r, t0, t1, t2, t3, t4);
+}
+
+/* r = a^(2^n), in place allowed */
+static void s_fe_sq_n(uint64_t *r, const uint64_t *a, size_t n) {
+    s_fe_sq(r, a);
+    for (size_t i = 1; i < n; ++i) {
+        s_fe_sq(r, r);
+    }
+}
+
+/*
+ * The shared start of the inversion and square root chains: z11 = a^11 and z2_250 = a^(2^250 - 1). A fixed chain,
+ * so constant time.
+ */
+static void s_fe_pow_2_250(uint64_t *z2_250, uint64_t *z11, const uint64_t *a) {
+    uint64_t t0[S_LIMBS], t1[S_LIMBS], z2_5[S_LIMBS], z2_10[S_LIMBS], z2_50[S_LIMBS];
+
+    s_fe_sq(t0, a);
+    s_fe_sq_n(t1, t0, 2);
+    s_fe_mul(t1, t1, a);
+    s_fe_mul(z11, t0, t1);
+    s_fe_sq(t0, z11);
+    s_fe_mul(z2_5, t0, t1);
+
+    s_fe_sq_n(t0, z2_5, 5);
+    s_fe_mul(z2_10, t0, z2_5);
+    s_fe_sq_n(t0, z2_10, 10);
+    s_fe_mul(t0, t0, z2_10);
+    s_fe_sq_n(t1, t0, 20);
+    s_fe_mul(t0, t1, t0);
+    s_fe_sq_n(t0, t0, 10);
+    s_fe_mul(z2_50, t0, z2_10);
+    s_fe_sq_n(t0, z2_50, 50);
+    s_fe_mul(t0, t0, z2_50);
+    s_fe_sq_n(t1, t0, 100);
+    s_fe_mul(t0, t1, t0);
+    s_fe_sq_n(t0, t0, 50);
+    s_fe_mul(z2_250, t0, z2_50);
+}
+
+/* r = a^(p - 2) = a^(2^255 - 21) */
+static void s_fe_invert(uint64_t *r, const uint64_t *a) {
+    uint64_t z2_250[S_LIMBS], z11[S_LIMBS];
+
+    s_fe_pow_2_250(z2_250, z11, a);
+    s_fe_sq_n(z2_250, z2_250, 5);
+    s_fe_mul(r, z2_250, z11);
+}
+
+/* r = a^((p - 5) / 8) = a^(2^252 - 3), the exponentiation in the square root for p = 5 mod 8 */
+static void s_fe_pow22523(uint64_t *r, const uint64_t *a) {
+    uint64_t z2_250[S_LIMBS], z11[S_LIMBS];
+
+    s_fe_pow_2_250(z2_250, z11, a);
+    s_fe_sq_n(z2_250, z2_250, 2);
+    s_fe_mul(r, z2_250, a);
+}
+
+/* Little endian, ignoring the top bit, which point encodings use for the sign of x. */
+static void s_fe_from_bytes(uint64_t *r, const uint8_t *in) {
+    r[0] = s_load64_le(in) & S_MASK51;
+    r[1] = (s_load64_le(in + 6) >> 3) & S_MASK51;
+    r[2] = (s_load64_le(in + 12) >> 6) & S_MASK51;
+    r[3] = (s_load64_le(in + 19) >> 1) & S_MASK51;
+    r[4] = (s_load64_le(in + 24) >> 12) & S_MASK51;
+}
+
+/* The canonical encoding: fully reduced, then packed little endian. */
+static void s_fe_to_bytes(uint8_t *out, const uint64_t *a) {
+    uint64_t t[S_LIMBS];
+    memcpy(t, a, sizeof(t));
+    s_fe_carry(t);
+    s_fe_carry(t);
+
+    /* t < 2p now; q = 1 exactly when t >= p, found by adding 19 and looking at the carry out of bit 255 */
+    uint64_t q = (t[0] + 19) >> 51;
+    for (size_t i = 1; i < S_LIMBS; ++i) {
+        q = (t[i] + q) >> 51;
+    }
+
+    t[0] += 19 * q;
+    for (size_t i = 1; i < S_LIMBS; ++i) {
+        t[i] += t[i - 1] >> 51;
+        t[i - 1] &= S_MASK51;
+    }
+    t[4] &= S_MASK51;
+
+    s_store64_le(out, t[0] | (t[1] << 51));
+    s_store64_le(out + 8, (t[1] >> 13) | (t[2] << 38));
+    s_store64_le(out + 16, (t[2] >> 26) | (t[3] << 25));
+    s_store64_le(out + 24, (t[3] >> 39) | (t[4] << 12));
+}
+
+static bool s_fe_is_zero(const uint64_t *a) {
+    uint8_t bytes[32];
+    s_fe_to_bytes(bytes, a);
+
+    uint8_t acc = 0;
+    for (size_t i = 0; i < sizeof(bytes); ++i) {
+        acc |= bytes[i];
+    }
+    return acc == 0;
+}
+
+static uint64_t s_fe_is_negative(const uint64_t *a) {
+    uint8_t bytes[32];
+    s_fe_to_bytes(bytes, a);
+    return bytes[0] & 1;
+}
+
+/*
+ * r[i] = a[i]^-1 for up to S_INVERT_BATCH elements, with one inversion (Montgomery's trick). None may be zero. Only
+ * used on public points.
+ */
+#define S_INVERT_BATCH 64
+
+static void s_fe_invert_batch(uint64_t (*r)[S_LIMBS], const uint64_t (*a)[S_LIMBS], size_t count) {
+    uint64_t prefix[S_INVERT_BATCH][S_LIMBS];
+    uint64_t acc[S_LIMBS], t[S_LIMBS];
+
+    AWS_FATAL_ASSERT(count > 0 && count <= S_INVERT_BATCH);
+
+    memcpy(prefix[0], a[0], sizeof(prefix[0]));
+    for (size_t i = 1; i < count; ++i) {
+        s_fe_mul(prefix[i], prefix[i - 1], a[i]);
+    }
+
+    s_fe_invert(acc, prefix[count - 1]);
+    for (size_t i = count - 1; i > 0; --i) {
+        s_fe_mul(t, acc, prefix[i - 1]);
+        s_fe_mul(acc, acc, a[i]);
+        memcpy(r[i], t, sizeof(t));
+    }
+    memcpy(r[0], acc, sizeof(acc));
+}
+
+/*
+ * Group arithmetic on -x^2 + y^2 = 1 + d x^2 y^2, with the formulas of Hisil, Wong, Carter and Dawson for a = -1.
+ * Points that are only ever added are precomputed as (Y + X, Y - X, Z, 2d T), or (y + x, y - x, 2d x y) when affine,
+ * which saves a multiplication per addition.
+ */
+struct s_cached {
+    uint64_t ypx[S_LIMBS];
+    uint64_t ymx[S_LIMBS];
+    uint64_t z[S_LIMBS];
+    uint64_t t2d[S_LIMBS];
+};
+
+struct s_niels {
+    uint64_t ypx[S_LIMBS];
+    uint64_t ymx[S_LIMBS];
+    uint64_t xy2d[S_LIMBS];
+};
+
+static void s_point_identity(struct aws_ed25519_native_point *r) {
+    memset(r, 0, sizeof(*r));
+    r->y[0] = 1;
+    r->z[0] = 1;
+}
+
+static void s_point_negate(struct aws_ed25519_native_point *r, const struct aws_ed25519_native_point *p) {
+    s_fe_neg(r->x, p->x);
+    memcpy(r->y, p->y, sizeof(r->y));
+    memcpy(r->z, p->z, sizeof(r->z));
+    s_fe_neg(r->t, p->t);
+}
+
+static void s_point_to_cached(struct s_cached *r, const struct aws_ed25519_native_point *p) {
+    s_fe_add(r->ypx, p->y, p->x);
+    s_fe_sub(r->ymx, p->y, p->x);
+    memcpy(r->z, p->z, sizeof(r->z));
+    s_fe_mul(r->t2d, p->t, s_fe_2d);
+}
+
+/*
+ * The end of an addition: with E = B - A, F = D - C, G = D + C and H = B + A, the sum is (E F : G H : F G : E H).
+ * Subtracting the point instead swaps Y + X with Y - X and negates its T, which here swaps C's sign.
+ */
+static void s_point_add_finish(
+    struct aws_ed25519_native_point *r,
+    const uint64_t *a,
+    const uint64_t *b,
+    const uint64_t *c,
+    const uint64_t *d,
+    bool subtract) {
+    uint64_t e[S_LIMBS], f[S_LIMBS], g[S_LIMBS], h[S_LIMBS];
+
+    s_fe_sub(e, b, a);
+    s_fe_add(h, b, a);
+    if (subtract) {
+        s_fe_add(f, d, c);
+        s_fe_sub(g, d, c);
+    } else {
+        s_fe_sub(f, d, c);
+        s_fe_add(g, d, c);
+    }
+
+    s_fe_mul(r->x, e, f);
+    s_fe_mul(r->y, g, h);
+    s_fe_mul(r->z, f, g);
+    s_fe_mul(r->t, e, h);
+}
+
+/* r = p +- q. Complete, and may run in place. subtract must not depend on secrets. */
+static void s_point_add_cached(
+    struct aws_ed25519_native_point *r,
+    const struct aws_ed25519_native_point *p,
+    const struct s_cached *q,
+    bool subtract) {
+    uint64_t a[S_LIMBS], b[S_LIMBS], c[S_LIMBS], d[S_LIMBS];
+
+    s_fe_sub(a, p->y, p->x);
+    s_fe_add(b, p->y, p->x);
+    s_fe_mul(a, a, subtract ? q->ypx : q->ymx);
+    s_fe_mul(b, b, subtract ? q->ymx : q->ypx);
+    s_fe_mul(c, p->t, q->t2d);
+    s_fe_mul(d, p->z, q->z);
+    s_fe_add(d, d, d);
+
+    s_point_add_finish(r, a, b, c, d, subtract);
+}
+
+/* r = p +- q for an affine q, as s_point_add_cached() */
+static void s_point_add_niels(
+    struct aws_ed25519_native_point *r,
+    const struct aws_ed25519_native_point *p,
+    const struct s_niels *q,
+    bool subtract) {
+    uint64_t a[S_LIMBS], b[S_LIMBS], c[S_LIMBS], d[S_LIMBS];
+
+    s_fe_sub(a, p->y, p->x);
+    s_fe_add(b, p->y, p->x);
+    s_fe_mul(a, a, subtract ? q->ypx : q->ymx);
+    s_fe_mul(b, b, subtract ? q->ymx : q->ypx);
+    s_fe_mul(c, p->t, q->xy2d);
+    s_fe_add(d, p->z, p->z);
+
+    s_point_add_finish(r, a, b, c, d, subtract);
+}
+
+/*
+ * dbl-2008-hwcd: with E = 2XY, G = Y^2 - X^2, F = 2Z^2 - G and H = X^2 + Y^2, 2P = (E F : G H : F G : E H). T is
+ * not an input, so a run of doublings only needs it after the last one.
+ */
+static void s_point_double(struct aws_ed25519_native_point *r, const struct aws_ed25519_native_point *p) {
+    uint64_t xx[S_LIMBS], yy[S_LIMBS], e[S_LIMBS], f[S_LIMBS], g[S_LIMBS], h[S_LIMBS];
+
+    s_fe_sq(xx, p->x);
+    s_fe_sq(yy, p->y);
+    s_fe_sq(f, p->z);
+    s_fe_add(f, f, f);
+    s_fe_add(e, p->x, p->y);
+    s_fe_sq(e, e);
+
+    s_fe_add(h, yy, xx);
+    s_fe_sub(g, yy, xx);
+    s_fe_sub(e, e, h);
+    s_fe_sub(f, f, g);
+
+    s_fe_mul(r->x, e, f);
+    s_fe_mul(r->y, g, h);
+    s_fe_mul(r->z, f, g);
+    s_fe_mul(r->t, e, h);
+}
+
+static bool s_point_is_identity(const struct aws_ed25519_native_point *p) {
+    uint64_t y_minus_z[S_LIMBS];
+    s_fe_sub(y_minus_z, p->y, p->z);
+    return s_fe_is_zero(p->x) && s_fe_is_zero(y_minus_z);
+}
+
+/* y, with the top bit set for an odd x. Constant time. */
+static void s_point_encode(uint8_t *out, const struct aws_ed25519_native_point *p) {
+    uint64_t z_inv[S_LIMBS], x[S_LIMBS], y[S_LIMBS];
+
+    s_fe_invert(z_inv, p->z);
+    s_fe_mul(x, p->x, z_inv);
+    s_fe_mul(y, p->y, z_inv);
+    s_fe_to_bytes(out, y);
+    out[31] ^= (uint8_t)(s_fe_is_negative(x) << 7);
+}
+
+/*
+ * RFC 8032 5.1.3: x^2 = (y^2 - 1) / (d y^2 + 1), and x = u v^3 (u v^7)^((p - 5) / 8) is a square root of u / v or of
+ * -u / v, in which case sqrt(-1) fixes it up. Rejects y >= p and the encodings of x = 0 with the sign bit set, so
+ * every point has exactly one encoding that decodes. Variable time; points are public.
+ */
+static bool s_point_decode(struct aws_ed25519_native_point *r, const uint8_t *in) {
+    uint64_t u[S_LIMBS], v[S_LIMBS], v3[S_LIMBS], x[S_LIMBS], check[S_LIMBS];
+    uint8_t canonical[32];
+
+    s_fe_from_bytes(r->y, in);
+    s_fe_to_bytes(canonical, r->y);
+    canonical[31] |= in[31] & 0x80;
+    if (memcmp(canonical, in, sizeof(canonical))) {
+        return false;
+    }
+
+    s_fe_sq(u, r->y);
+    s_fe_mul(v, u, s_fe_d);
+    s_fe_sub(u, u, s_fe_one);
+    s_fe_add(v, v, s_fe_one);
+
+    s_fe_sq(v3, v);
+    s_fe_mul(v3, v3, v);
+    s_fe_sq(x, v3);
+    s_fe_mul(x, x, v);
+    s_fe_mul(x, x, u);
+    s_fe_pow22523(x, x);
+    s_fe_mul(x, x, v3);
+    s_fe_mul(x, x, u);
+
+    s_fe_sq(check, x);
+    s_fe_mul(check, check, v);
+    s_fe_sub(check, check, u);
+    if (!s_fe_is_zero(check)) {
+        s_fe_add(check, check, u);
+        s_fe_add(check, check, u);
+        if (!s_fe_is_zero(check)) {
+            return false;
+        }
+        s_fe_mul(x, x, s_fe_sqrtm1);
+    }
+
+    uint64_t sign = in[31] >> 7;
+    if (s_fe_is_zero(x) && sign) {
+        return false;
+    }
+    if (s_fe_is_negative(x) != sign) {
+        s_fe_neg(x, x);
+    }
+
+    memcpy(r->x, x, sizeof(x));
+    memcpy(r->z, s_fe_one, sizeof(r->z));
+    s_fe_mul(r->t, r->x, r->y);
+    return true;
+}
+
+/* Affine (y + x, y - x, 2d x y) for count points, sharing one inversion. */
+static void s_points_to_niels(struct s_niels *r, const struct aws_ed25519_native_point *points, size_t count) {
+    uint64_t z[S_INVERT_BATCH][S_LIMBS];
+    uint64_t x[S_LIMBS], y[S_LIMBS];
+
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(z[i], points[i].z, sizeof(z[i]));
+    }
+    s_fe_invert_batch(z, (const uint64_t(*)[S_LIMBS])z, count);
+
+    for (size_t i = 0; i < count; ++i) {
+        s_fe_mul(x, points[i].x, z[i]);
+        s_fe_mul(y, points[i].y, z[i]);
+        s_fe_add(r[i].ypx, y, x);
+        s_fe_sub(r[i].ymx, y, x);
+        s_fe_mul(r[i].xy2d, x, y);
+        s_fe_mul(r[i].xy2d, r[i].xy2d, s_fe_2d);
+    }
+}
+
+/*
+ * Base point tables, built on first use. s_base_table[i][j] is (j + 1) * 256^i * B for the constant time fixed base
+ * multiplication, 30KiB; s_base_odd[j] is (2j + 1) * B for the width 8 NAF of verification, 7.5KiB.
+ */
+#define S_BASE_WINDOWS 32
+#define S_BASE_WINDOW_ENTRIES 8
+#define S_BASE_NAF_WIDTH 8
+#define S_BASE_ODD_MULTIPLES 64
+
+static struct s_niels s_base_table[S_BASE_WINDOWS][S_BASE_WINDOW_ENTRIES];
+static struct s_niels s_base_odd[S_BASE_ODD_MULTIPLES];
+static aws_thread_once s_base_tables_once = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void s_build_base_tables(void *user_data) {
+    (void)user_data;
+    struct aws_ed25519_native_point points[S_BASE_ODD_MULTIPLES];
+    struct aws_ed25519_native_point base, twice;
+    struct s_cached cached;
+
+    memcpy(base.x, s_base_x, sizeof(base.x));
+    memcpy(base.y, s_base_y, sizeof(base.y));
+    memcpy(base.z, s_fe_one, sizeof(base.z));
+    s_fe_mul(base.t, base.x, base.y);
+
+    s_point_double(&twice, &base);
+    s_point_to_cached(&cached, &twice);
+    points[0] = base;
+    for (size_t j = 1; j < S_BASE_ODD_MULTIPLES; ++j) {
+        s_point_add_cached(&points[j], &points[j - 1], &cached, false);
+    }
+    s_points_to_niels(s_base_odd, points, S_BASE_ODD_MULTIPLES);
+
+    for (size_t i = 0; i < S_BASE_WINDOWS; ++i) {
+        s_point_to_cached(&cached, &base);
+        points[0] = base;
+        for (size_t j = 1; j < S_BASE_WINDOW_ENTRIES; ++j) {
+            s_point_add_cached(&points[j], &points[j - 1], &cached, false);
+        }
+        s_points_to_niels(s_base_table[i], points, S_BASE_WINDOW_ENTRIES);
+
+        for (size_t j = 0; j < 8; ++j) {
+            s_point_double(&base, &base);
+        }
+    }
+}
+
+static void s_base_tables_init(void) {
+    aws_thread_call_once(&s_base_tables_once, s_build_base_tables, NULL);
+}
+
+/* r = digit * 256^window * B for a digit in [-8, 8], reading every entry of the window. */
+static void s_base_table_lookup_ct(struct s_niels *r, size_t window, int8_t digit) {
+    uint64_t negative = (uint64_t)((uint8_t)digit >> 7);
+    uint64_t magnitude = (uint64_t)(uint8_t)(digit - (int8_t)(((uint8_t)(0 - negative) & (uint8_t)digit) << 1));
+
+    memset(r, 0, sizeof(*r));
+    r->ypx[0] = 1;
+    r->ymx[0] = 1;
+    for (size_t j = 0; j < S_BASE_WINDOW_ENTRIES; ++j) {
+        uint64_t mask = s_ct_eq_mask(magnitude, j + 1);
+        s_fe_cmov(r->ypx, s_base_table[window][j].ypx, mask);
+        s_fe_cmov(r->ymx, s_base_table[window][j].ymx, mask);
+        s_fe_cmov(r->xy2d, s_base_table[window][j].xy2d, mask);
+    }
+
+    /* -P swaps y + x with y - x and negates 2dxy */
+    uint64_t mask = 0 - negative;
+    uint64_t swap[S_LIMBS], neg_xy2d[S_LIMBS];
+    memcpy(swap, r->ypx, sizeof(swap));
+    s_fe_cmov(r->ypx, r->ymx, mask);
+    s_fe_cmov(r->ymx, swap, mask);
+    s_fe_neg(neg_xy2d, r->xy2d);
+    s_fe_cmov(r->xy2d, neg_xy2d, mask);
+}
+
+/*
+ * r = k * B in constant time, for k < 2^255: k in signed radix 16, 64 digits in [-8, 8]. The odd digits are added
+ * first from the 256^i tables, multiplied by 16 with four doublings, then the even digits are added.
+ */
+static void s_point_mul_base_ct(struct aws_ed25519_native_point *r, const uint64_t *k) {
+    int8_t digits[64];
+    struct s_niels entry;
+
+    s_base_tables_init();
+
+    for (size_t i = 0; i < 64; ++i) {
+        digits[i] = (int8_t)((k[i / 16] >> (4 * (i % 16))) & 15);
+    }
+    int8_t carry = 0;
+    for (size_t i = 0; i < 63; ++i) {
+        digits[i] += carry;
+        carry = (int8_t)((digits[i] + 8) >> 4);
+        digits[i] -= (int8_t)(carry * 16);
+    }
+    digits[63] += carry;
+
+    s_point_identity(r);
+    for (size_t i = 1; i < 64; i += 2) {
+        s_base_table_lookup_ct(&entry, i / 2, digits[i]);
+        s_point_add_niels(r, r, &entry, false);
+    }
+
+    for (size_t i = 0; i < 4; ++i) {
+        s_point_double(r, r);
+    }
+
+    for (size_t i = 0; i < 64; i += 2) {
+        s_base_table_lookup_ct(&entry, i / 2, digits[i]);
+        s_point_add_niels(r, r, &entry, false);
+    }
+
+    aws_secure_zero(digits, sizeof(digits));
+    aws_secure_zero(&entry, sizeof(entry));
+}
+
+/*
+ * Scalars mod the group order L = 2^252 + 27742317777372353535851937790883648493, as four 64 bit limbs, little
+ * endian. Products go through Montgomery multiplication with R = 2^256; all of it is constant time.
+ */
+static const uint64_t s_l[4] = {
+    0x5812631a5cf5d3edULL, 0x14def9dea2f79cd6ULL, 0x0000000000000000ULL, 0x1000000000000000ULL};
+/* R^2 mod L and R^3 mod L */
+static const uint64_t s_l_rr[4] = {
+    0xa40611e3449c0f01ULL, 0xd00e1ba768859347ULL, 0xceec73d217f5be65ULL, 0x0399411b7c309a3dULL};
+static const uint64_t s_l_rrr[4] = {
+    0x2a9e49687b83a2dbULL, 0x278324e6aef7f3ecULL, 0x8065dc6c04ec5b65ULL, 0x0e530b773599cec7ULL};
+/* -L^-1 mod 2^64 */
+#define S_L_M0INV 0xd2b51da312547e1bULL
+
+static inline uint64_t s_mac(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t *hi) {
+    s_wide t = s_wide_add64(s_wide_add64(s_mul(a, b), c), d);
+    *hi = s_wide_hi(t);
+    return s_wide_lo(t);
+}
+
+static inline uint64_t s_adc(uint64_t a, uint64_t b, uint64_t carry_in, uint64_t *carry_out) {
+    uint64_t t = a + carry_in;
+    uint64_t r = t + b;
+    *carry_out = (t < carry_in) | (r < b);
+    return r;
+}
+
+static inline uint64_t s_sbb(uint64_t a, uint64_t b, uint64_t borrow_in, uint64_t *borrow_out) {
+    uint64_t t = a - b;
+    uint64_t r = t - borrow_in;
+    *borrow_out = (a < b) | (t < borrow_in);
+    return r;
+}
+
+/* r = t mod L for t < 2L, where t has a fifth limb t_high */
+static inline void s_sc_reduce_once(uint64_t *r, const uint64_t *t, uint64_t t_high) {
+    uint64_t d[4];
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        d[i] = s_sbb(t[i], s_l[i], borrow, &borrow);
+    }
+    s_sbb(t_high, 0, borrow, &borrow);
+
+    /* a borrow out means t < L, so t stays */
+    uint64_t keep = 0 - borrow;
+    for (size_t i = 0; i < 4; ++i) {
+        r[i] = (t[i] & keep) | (d[i] & ~keep);
+    }
+}
+
+/* r = a * b / R mod L, for a < R and b < L or the other way around */
+static void s_sc_mont_mul(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+    uint64_t t[6] = {0};
+    uint64_t carry = 0;
+    uint64_t carry2 = 0;
+
+    for (size_t i = 0; i < 4; ++i) {
+        carry = 0;
+        for (size_t j = 0; j < 4; ++j) {
+            t[j] = s_mac(a[j], b[i], t[j], carry, &carry);
+        }
+        t[4] = s_adc(t[4], carry, 0, &carry2);
+        t[5] = carry2;
+
+        uint64_t m = t[0] * S_L_M0INV;
+        s_mac(m, s_l[0], t[0], 0, &carry);
+        for (size_t j = 1; j < 4; ++j) {
+            t[j - 1] = s_mac(m, s_l[j], t[j], carry, &carry);
+        }
+        t[3] = s_adc(t[4], carry, 0, &carry2);
+        t[4] = t[5] + carry2;
+    }
+
+    s_sc_reduce_once(r, t, t[4]);
+}
+
+/* r = a * b mod L, for a < R and b < L */
+static void s_sc_mul(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+    uint64_t a_r[4];
+    s_sc_mont_mul(a_r, a, s_l_rr);
+    s_sc_mont_mul(r, a_r, b);
+}
+
+/* r = a + b mod L, for a, b < L */
+static void s_sc_add(uint64_t *r, const uint64_t *a, const uint64_t *b) {
+    uint64_t t[4];
+    uint64_t carry = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        t[i] = s_adc(a[i], b[i], carry, &carry);
+    }
+    s_sc_reduce_once(r, t, carry);
+}
+
+static void s_sc_from_bytes(uint64_t *r, const uint8_t *in) {
+    for (size_t i = 0; i < 4; ++i) {
+        r[i] = s_load64_le(in + 8 * i);
+    }
+}
+
+static void s_sc_to_bytes(uint8_t *out, const uint64_t *a) {
+    for (size_t i = 0; i < 4; ++i) {
+        s_store64_le(out + 8 * i, a[i]);
+    }
+}
+
+/* r = the 512 bit little endian in mod L: with in = lo + hi R, (lo R + hi R^2) / R. */
+static void s_sc_reduce_wide(uint64_t *r, const uint8_t *in) {
+    static const uint64_t one[4] = {1};
+    uint64_t lo[4], hi[4];
+
+    s_sc_from_bytes(lo, in);
+    s_sc_from_bytes(hi, in + 32);
+    s_sc_mont_mul(lo, lo, s_l_rr);
+    s_sc_mont_mul(hi, hi, s_l_rrr);
+    s_sc_add(r, lo, hi);
+    s_sc_mont_mul(r, r, one);
+
+    aws_secure_zero(lo, sizeof(lo));
+    aws_secure_zero(hi, sizeof(hi));
+}
+
+/* S < L, which RFC 8032 requires of signatures so they are not malleable. Variable time; S is public. */
+static bool s_sc_is_canonical(const uint64_t *a) {
+    for (size_t i = 4; i > 0; --i) {
+        if (a[i - 1] != s_l[i - 1]) {
+            return a[i - 1] < s_l[i - 1];
+        }
+    }
+    return false;
+}
+
+/* r = SHA-512(a || b || message) mod L */
+static void s_hash_to_scalar(
+    uint64_t *r,
+    const uint8_t *a,
+    size_t a_len,
+    const uint8_t *b,
+    size_t b_len,
+    struct aws_byte_cursor message) {
+    struct aws_sha512_ctx ctx;
+    uint8_t digest[AWS_SHA512_LEN];
+
+    aws_sha512_ctx_init(&ctx);
+    aws_sha512_ctx_update(&ctx, a, a_len);
+    aws_sha512_ctx_update(&ctx, b, b_len);
+    aws_sha512_ctx_update(&ctx, message.ptr, message.len);
+    aws_sha512_ctx_finalize(&ctx, digest);
+
+    s_sc_reduce_wide(r, digest);
+    aws_secure_zero(digest, sizeof(digest));
+}
+
+/*
+ * Variable time multi-scalar multiplication for verification (Straus): every scalar in width w NAF, one shared run of
+ * doublings, and an addition of a precomputed odd multiple per non-zero digit.
+ */
+#define S_NAF_LENGTH 256
+#define S_NAF_WIDTH 5
+#define S_ODD_MULTIPLES 8
+
+struct s_msm_term {
+    uint64_t scalar[4];
+    int8_t naf[S_NAF_LENGTH];
+    size_t length;
+    /* P, 3P, ..., 15P */
+    struct s_cached table[S_ODD_MULTIPLES];
+};
+
+/* Width w NAF of k < 2^253; returns the number of digits up to the highest non-zero one. */
+static size_t s_scalar_wnaf(int8_t *naf, const uint64_t *k_in, unsigned width) {
+    uint64_t k[4];
+    memcpy(k, k_in, sizeof(k));
+    memset(naf, 0, S_NAF_LENGTH);
+    size_t length = 0;
+
+    for (size_t i = 0; i < S_NAF_LENGTH && (k[0] | k[1] | k[2] | k[3]); ++i) {
+        if (k[0] & 1) {
+            int digit = (int)(k[0] & ((1u << width) - 1));
+            if (digit > (1 << (width - 1))) {
+                digit -= 1 << width;
+            }
+
+            uint64_t carry = 0;
+            if (digit > 0) {
+                k[0] = s_sbb(k[0], (uint64_t)digit, 0, &carry);
+                for (size_t j = 1; j < 4; ++j) {
+                    k[j] = s_sbb(k[j], 0, carry, &carry);
+                }
+            } else {
+                k[0] = s_adc(k[0], (uint64_t)-digit, 0, &carry);
+                for (size_t j = 1; j < 4; ++j) {
+                    k[j] = s_adc(k[j], 0, carry, &carry);
+                }
+            }
+
+            naf[i] = (int8_t)digit;
+            length = i + 1;
+        }
+
+        for (size_t j = 0; j < 3; ++j) {
+            k[j] = (k[j] >> 1) | (k[j + 1] << 63);
+        }
+        k[3] >>= 1;
+    }
+
+    return length;
+}
+
+static void s_msm_term_init(struct s_msm_term *term, const struct aws_ed25519_native_point *p) {
+    struct aws_ed25519_native_point acc, twice;
+    struct s_cached twice_cached;
+
+    s_point_double(&twice, p);
+    s_point_to_cached(&twice_cached, &twice);
+
+    acc = *p;
+    s_point_to_cached(&term->table[0], &acc);
+    for (size_t i = 1; i < S_ODD_MULTIPLES; ++i) {
+        s_point_add_cached(&acc, &acc, &twice_cached, false);
+        s_point_to_cached(&term->table[i], &acc);
+    }
+
+    term->length = s_scalar_wnaf(term->naf, term->scalar, S_NAF_WIDTH);
+}
+
+/* r = base_scalar * B + sum of term scalar * term point */
+static void s_msm_vartime(
+    struct aws_ed25519_native_point *r,
+    const uint64_t *base_scalar,
+    const struct s_msm_term *terms,
+    size_t count) {
+    int8_t base_naf[S_NAF_LENGTH];
+
+    s_base_tables_init();
+
+    size_t top = s_scalar_wnaf(base_naf, base_scalar, S_BASE_NAF_WIDTH);
+    for (size_t j = 0; j < count; ++j) {
+        top = aws_max_size(top, terms[j].length);
+    }
+
+    s_point_identity(r);
+    for (size_t i = top; i > 0; --i) {
+        s_point_double(r, r);
+
+        int digit = base_naf[i - 1];
+        if (digit) {
+            s_point_add_niels(r, r, &s_base_odd[(digit < 0 ? -digit : digit) / 2], digit < 0);
+        }
+
+        for (size_t j = 0; j < count; ++j) {
+            digit = terms[j].naf[i - 1];
+            if (digit) {
+                s_point_add_cached(r, r, &terms[j].table[(digit < 0 ? -digit : digit) / 2], digit < 0);
+            }
+        }
+    }
+}
+
+int aws_ed25519_native_key_set_private_key(struct aws_ed25519_native_key *key, struct aws_byte_cursor seed) {
+    if (seed.len != AWS_ED25519_PRIVATE_KEY_LEN) {
+        return aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+    }
+
+    struct aws_sha512_ctx ctx;
+    uint8_t digest[AWS_SHA512_LEN];
+    aws_sha512_ctx_init(&ctx);
+    aws_sha512_ctx_update(&ctx, seed.ptr, seed.len);
+    aws_sha512_ctx_finalize(&ctx, digest);
+
+    /* clamping: a multiple of the cofactor, with bit 254 set */
+    digest[0] &= 248;
+    digest[31] &= 127;
+    digest[31] |= 64;
+    s_sc_from_bytes(key->scalar, digest);
+    memcpy(key->prefix, digest + 32, sizeof(key->prefix));
+    aws_secure_zero(digest, sizeof(digest));
+
+    struct aws_ed25519_native_point a;
+    s_point_mul_base_ct(&a, key->scalar);
+    s_point_encode(key->public_key, &a);
+    s_point_negate(&key->neg_a, &a);
+    key->has_private_key = true;
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ed25519_native_key_set_public_key(
+    struct aws_ed25519_native_key *key,
+    struct aws_byte_cursor public_key) {
+    if (public_key.len != AWS_ED25519_PUBLIC_KEY_LEN) {
+        return aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+    }
+
+    struct aws_ed25519_native_point a;
+    if (!s_point_decode(&a, public_key.ptr)) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    memcpy(key->public_key, public_key.ptr, sizeof(key->public_key));
+    s_point_negate(&key->neg_a, &a);
+    return AWS_OP_SUCCESS;
+}
+
+void aws_ed25519_native_key_clean_up(struct aws_ed25519_native_key *key) {
+    aws_secure_zero(key, sizeof(*key));
+}
+
+int aws_ed25519_native_sign(
+    const struct aws_ed25519_native_key *key,
+    struct aws_byte_cursor message,
+    struct aws_byte_buf *signature) {
+    if (!key->has_private_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    if (signature->capacity - signature->len < AWS_ED25519_SIGNATURE_LEN) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    uint64_t r[4], k[4], s[4];
+    uint8_t bytes[AWS_ED25519_SIGNATURE_LEN];
+    struct aws_ed25519_native_point big_r;
+
+    /* the nonce r = SHA-512(prefix || M), R = [r]B, and S = r + SHA-512(R || A || M) * a */
+    s_hash_to_scalar(r, key->prefix, sizeof(key->prefix), NULL, 0, message);
+    s_point_mul_base_ct(&big_r, r);
+    s_point_encode(bytes, &big_r);
+
+    s_hash_to_scalar(k, bytes, 32, key->public_key, sizeof(key->public_key), message);
+    s_sc_mul(s, k, key->scalar);
+    s_sc_add(s, s, r);
+    s_sc_to_bytes(bytes + 32, s);
+
+    aws_byte_buf_write(signature, bytes, sizeof(bytes));
+
+    aws_secure_zero(r, sizeof(r));
+    aws_secure_zero(s, sizeof(s));
+    aws_secure_zero(&big_r, sizeof(big_r));
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ed25519_native_verify(
+    const struct aws_ed25519_native_key *key,
+    struct aws_byte_cursor message,
+    struct aws_byte_cursor signature) {
+    if (signature.len != AWS_ED25519_SIGNATURE_LEN) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    uint64_t s[4];
+    s_sc_from_bytes(s, signature.ptr + 32);
+    if (!s_sc_is_canonical(s)) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    /* [S]B + [k](-A) must encode to R */
+    struct s_msm_term term;
+    s_hash_to_scalar(term.scalar, signature.ptr, 32, key->public_key, sizeof(key->public_key), message);
+    s_msm_term_init(&term, &key->neg_a);
+
+    struct aws_ed25519_native_point check;
+    uint8_t encoded[32];
+    s_msm_vartime(&check, s, &term, 1);
+    s_point_encode(encoded, &check);
+
+    if (memcmp(encoded, signature.ptr, sizeof(encoded))) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/* two terms per signature at most: its R, and its key's A unless an earlier signature in the block had the same key */
+#define S_BATCH_CHUNK AWS_ED25519_NATIVE_BATCH_BLOCK
+#define S_BATCH_Z_BYTES 16
+
+struct s_batch_scratch {
+    struct s_msm_term terms[2 * S_BATCH_CHUNK];
+    /* the key behind each of the A terms, to merge the terms of signatures by the same key */
+    const struct aws_ed25519_native_key *term_keys[S_BATCH_CHUNK];
+    uint8_t z_bytes[S_BATCH_CHUNK * S_BATCH_Z_BYTES];
+};
+
+size_t aws_ed25519_native_batch_scratch_size(void) {
+    return sizeof(struct s_batch_scratch);
+}
+
+int aws_ed25519_native_verify_batch(
+    void *scratch_storage,
+    const struct aws_ed25519_native_key *const *keys,
+    const struct aws_byte_cursor *messages,
+    const struct aws_byte_cursor *signatures,
+    size_t count) {
+    struct s_batch_scratch *scratch = scratch_storage;
+    AWS_FATAL_ASSERT(count <= S_BATCH_CHUNK);
+    if (count == 0) {
+        return AWS_OP_SUCCESS;
+    }
+
+    struct aws_byte_buf z_buf = aws_byte_buf_from_empty_array(scratch->z_bytes, count * S_BATCH_Z_BYTES);
+    if (aws_device_random_buffer(&z_buf)) {
+        return AWS_OP_ERR;
+    }
+
+    /* terms [0, count) are the -R_i with z_i, the ones after are the distinct -A with the sum of their z_i k_i */
+    struct s_msm_term *r_terms = scratch->terms;
+    struct s_msm_term *a_terms = scratch->terms + count;
+    size_t key_count = 0;
+    uint64_t base_scalar[4] = {0};
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t *signature = signatures[i].ptr;
+        struct aws_ed25519_native_point r;
+        uint64_t s[4], k[4], product[4];
+
+        if (signatures[i].len != AWS_ED25519_SIGNATURE_LEN) {
+            return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+        }
+
+        s_sc_from_bytes(s, signature + 32);
+        if (!s_sc_is_canonical(s) || !s_point_decode(&r, signature)) {
+            return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+        }
+        s_point_negate(&r, &r);
+
+        uint64_t *z = r_terms[i].scalar;
+        z[0] = s_load64_le(scratch->z_bytes + i * S_BATCH_Z_BYTES);
+        z[1] = s_load64_le(scratch->z_bytes + i * S_BATCH_Z_BYTES + 8);
+        z[2] = 0;
+        z[3] = 0;
+        s_msm_term_init(&r_terms[i], &r);
+
+        s_sc_mul(product, z, s);
+        s_sc_add(base_scalar, base_scalar, product);
+
+        size_t key_index = 0;
+        while (key_index < key_count && scratch->term_keys[key_index] != keys[i]) {
+            ++key_index;
+        }
+        if (key_index == key_count) {
+            scratch->term_keys[key_count++] = keys[i];
+            memset(a_terms[key_index].scalar, 0, sizeof(a_terms[key_index].scalar));
+        }
+
+        s_hash_to_scalar(k, signature, 32, keys[i]->public_key, sizeof(keys[i]->public_key), messages[i]);
+        s_sc_mul(product, z, k);
+        s_sc_add(a_terms[key_index].scalar, a_terms[key_index].scalar, product);
+    }
+
+    for (size_t i = 0; i < key_count; ++i) {
+        s_msm_term_init(&a_terms[i], &scratch->term_keys[i]->neg_a);
+    }
+
+    struct aws_ed25519_native_point check;
+    s_msm_vartime(&check, base_scalar, scratch->terms, count + key_count);
+    for (size_t i = 0; i < 3; ++i) {
+        s_point_double(&check, &check);
+    }
+
+    if (!s_point_is_identity(&check)) {
+        return aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+    return AWS_OP_SUCCESS;
+}
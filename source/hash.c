@@ -108,3 +108,60 @@ int aws_sha256_compute(
     size_t truncate_to) {
     return compute_hash(aws_sha256_new(allocator), input, output, truncate_to);
 }
+
+/* ORs together the xor of every byte of a and b. Zero means equal. Word loads keep the loop branch free and
+ * vectorizable; there is deliberately no early exit. */
+static uint64_t s_digest_diff(const uint8_t *a, const uint8_t *b, size_t len) {
+    uint64_t diff = 0;
+    size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word_a;
+        uint64_t word_b;
+        memcpy(&word_a, a + i, sizeof(word_a));
+        memcpy(&word_b, b + i, sizeof(word_b));
+        diff |= word_a ^ word_b;
+    }
+
+    for (; i < len; ++i) {
+        diff |= (uint64_t)(a[i] ^ b[i]);
+    }
+
+    return diff;
+}
+
+/* 1 if diff is zero, 0 otherwise, without branching on diff */
+static uint64_t s_diff_is_zero(uint64_t diff) {
+    return 1 ^ ((diff | (0 - diff)) >> 63);
+}
+
+bool aws_cal_digest_equals(const struct aws_byte_cursor *a, const struct aws_byte_cursor *b) {
+    /* lengths are not secret */
+    if (a->len != b->len) {
+        return false;
+    }
+
+    return s_diff_is_zero(s_digest_diff(a->ptr, b->ptr, a->len)) == 1;
+}
+
+bool aws_cal_digest_equals_batch(
+    const struct aws_byte_cursor *a,
+    const struct aws_byte_cursor *b,
+    size_t count,
+    bool *results) {
+    uint64_t all_equal = 1;
+
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t equal = 0;
+        if (a[i].len == b[i].len) {
+            equal = s_diff_is_zero(s_digest_diff(a[i].ptr, b[i].ptr, a[i].len));
+        }
+
+        all_equal &= equal;
+        if (results) {
+            results[i] = equal == 1;
+        }
+    }
+
+    return all_equal == 1;
+}
@@ -4,6 +4,9 @@
  */
 #include <aws/cal/hmac.h>
 
+#include <aws/cal/cal.h>
+#include <aws/cal/hash.h>
+
 #ifndef AWS_BYO_CRYPTO
 extern struct aws_hmac *aws_sha256_hmac_default_new(
     struct aws_allocator *allocator,
@@ -60,6 +63,32 @@ int aws_hmac_finalize(struct aws_hmac *hmac, struct aws_byte_buf *output, size_t
     return hmac->vtable->finalize(hmac, output);
 }
 
+int aws_hmac_verify(struct aws_hmac *hmac, const struct aws_byte_cursor *expected) {
+    if (expected->len == 0 || expected->len > hmac->digest_size) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* the vtable only finalizes into a buffer, so the MAC lands here and is wiped whatever the outcome */
+    uint8_t computed[128] = {0};
+    AWS_FATAL_ASSERT(hmac->digest_size <= sizeof(computed) && "HMAC digest does not fit the verification buffer");
+
+    int result = AWS_OP_SUCCESS;
+    struct aws_byte_buf computed_buf = aws_byte_buf_from_empty_array(computed, sizeof(computed));
+    if (hmac->vtable->finalize(hmac, &computed_buf)) {
+        result = AWS_OP_ERR;
+        goto done;
+    }
+
+    struct aws_byte_cursor computed_cur = aws_byte_cursor_from_array(computed, expected->len);
+    if (!aws_cal_digest_equals(&computed_cur, expected)) {
+        result = aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    }
+
+done:
+    aws_secure_zero(computed, sizeof(computed));
+    return result;
+}
+
 int aws_sha256_hmac_compute(
     struct aws_allocator *allocator,
     const struct aws_byte_cursor *secret,
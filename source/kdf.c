@@ -0,0 +1,175 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/kdf.h>
+
+#include <aws/cal/hmac.h>
+#include <aws/cal/private/sha256.h>
+
+static int s_check_output_capacity(const struct aws_byte_buf *output, size_t length) {
+    if (output->capacity - output->len < length) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Writes the next PRF block either straight into the caller's buffer or, for the final partial block, through a
+ * scratch block that is wiped afterwards.
+ */
+static void s_emit_block(
+    struct aws_sha256_ctx *ctx,
+    const struct aws_sha256_hmac_key *key,
+    struct aws_byte_buf *output,
+    size_t remaining) {
+    if (remaining >= AWS_SHA256_HMAC_LEN) {
+        aws_sha256_hmac_ctx_finalize(ctx, key, output->buffer + output->len);
+        output->len += AWS_SHA256_HMAC_LEN;
+        return;
+    }
+
+    uint8_t last_block[AWS_SHA256_HMAC_LEN];
+    aws_sha256_hmac_ctx_finalize(ctx, key, last_block);
+    memcpy(output->buffer + output->len, last_block, remaining);
+    output->len += remaining;
+    aws_secure_zero(last_block, sizeof(last_block));
+}
+
+int aws_hkdf_sha256_extract(
+    const struct aws_byte_cursor *salt,
+    const struct aws_byte_cursor *ikm,
+    struct aws_byte_buf *prk) {
+    if (s_check_output_capacity(prk, AWS_SHA256_HMAC_LEN)) {
+        return AWS_OP_ERR;
+    }
+
+    /* HMAC zero pads short keys, so an empty salt already behaves as HashLen zero bytes. */
+    struct aws_sha256_hmac_key key;
+    aws_sha256_hmac_key_init(&key, salt->ptr, salt->len);
+
+    struct aws_sha256_ctx ctx;
+    aws_sha256_hmac_ctx_init(&ctx, &key);
+    aws_sha256_ctx_update(&ctx, ikm->ptr, ikm->len);
+    aws_sha256_hmac_ctx_finalize(&ctx, &key, prk->buffer + prk->len);
+    prk->len += AWS_SHA256_HMAC_LEN;
+
+    aws_sha256_hmac_key_clean_up(&key);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_hkdf_sha256_expand(
+    const struct aws_byte_cursor *prk,
+    const struct aws_byte_cursor *info,
+    struct aws_byte_buf *output,
+    size_t length) {
+    if (length > AWS_HKDF_SHA256_MAX_OUTPUT_LEN) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (s_check_output_capacity(output, length)) {
+        return AWS_OP_ERR;
+    }
+
+    struct aws_sha256_hmac_key key;
+    aws_sha256_hmac_key_init(&key, prk->ptr, prk->len);
+
+    struct aws_sha256_ctx ctx;
+    const uint8_t *previous_block = NULL;
+    size_t remaining = length;
+
+    for (uint8_t counter = 1; remaining; ++counter) {
+        aws_sha256_hmac_ctx_init(&ctx, &key);
+        if (previous_block) {
+            aws_sha256_ctx_update(&ctx, previous_block, AWS_SHA256_HMAC_LEN);
+        }
+        aws_sha256_ctx_update(&ctx, info->ptr, info->len);
+        aws_sha256_ctx_update(&ctx, &counter, 1);
+
+        /* T(i) feeds T(i + 1), and a partial block is only ever the last one, so chaining reads from output. */
+        previous_block = output->buffer + output->len;
+        size_t block_len = remaining < AWS_SHA256_HMAC_LEN ? remaining : AWS_SHA256_HMAC_LEN;
+        s_emit_block(&ctx, &key, output, remaining);
+        remaining -= block_len;
+    }
+
+    aws_sha256_hmac_key_clean_up(&key);
+    return AWS_OP_SUCCESS;
+}
+
+int aws_hkdf_sha256_derive(
+    const struct aws_byte_cursor *salt,
+    const struct aws_byte_cursor *ikm,
+    const struct aws_byte_cursor *info,
+    struct aws_byte_buf *output,
+    size_t length) {
+    uint8_t prk[AWS_SHA256_HMAC_LEN] = {0};
+    struct aws_byte_buf prk_buf = aws_byte_buf_from_empty_array(prk, sizeof(prk));
+
+    int result = AWS_OP_ERR;
+    if (aws_hkdf_sha256_extract(salt, ikm, &prk_buf)) {
+        goto done;
+    }
+
+    struct aws_byte_cursor prk_cur = aws_byte_cursor_from_buf(&prk_buf);
+    result = aws_hkdf_sha256_expand(&prk_cur, info, output, length);
+
+done:
+    aws_secure_zero(prk, sizeof(prk));
+    return result;
+}
+
+int aws_sp800_108_counter_kdf_hmac_sha256(
+    const struct aws_byte_cursor *key,
+    const struct aws_byte_cursor *label,
+    const struct aws_byte_cursor *context,
+    struct aws_byte_buf *output,
+    size_t length) {
+    /* [L]_32 is the output length in bits */
+    if (length > UINT32_MAX / 8) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (s_check_output_capacity(output, length)) {
+        return AWS_OP_ERR;
+    }
+
+    struct aws_sha256_hmac_key hmac_key;
+    aws_sha256_hmac_key_init(&hmac_key, key->ptr, key->len);
+
+    uint32_t length_bits = (uint32_t)(length * 8);
+    uint8_t separator = 0x00;
+    uint8_t encoded_length[4] = {
+        (uint8_t)(length_bits >> 24),
+        (uint8_t)(length_bits >> 16),
+        (uint8_t)(length_bits >> 8),
+        (uint8_t)length_bits,
+    };
+
+    struct aws_sha256_ctx ctx;
+    size_t remaining = length;
+
+    for (uint32_t counter = 1; remaining; ++counter) {
+        uint8_t encoded_counter[4] = {
+            (uint8_t)(counter >> 24),
+            (uint8_t)(counter >> 16),
+            (uint8_t)(counter >> 8),
+            (uint8_t)counter,
+        };
+
+        aws_sha256_hmac_ctx_init(&ctx, &hmac_key);
+        aws_sha256_ctx_update(&ctx, encoded_counter, sizeof(encoded_counter));
+        aws_sha256_ctx_update(&ctx, label->ptr, label->len);
+        aws_sha256_ctx_update(&ctx, &separator, 1);
+        aws_sha256_ctx_update(&ctx, context->ptr, context->len);
+        aws_sha256_ctx_update(&ctx, encoded_length, sizeof(encoded_length));
+
+        size_t block_len = remaining < AWS_SHA256_HMAC_LEN ? remaining : AWS_SHA256_HMAC_LEN;
+        s_emit_block(&ctx, &hmac_key, output, remaining);
+        remaining -= block_len;
+    }
+
+    aws_sha256_hmac_key_clean_up(&hmac_key);
+    return AWS_OP_SUCCESS;
+}
@@ -0,0 +1,466 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ecc.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/private/ec_native.h>
+#include <aws/common/math.h>
+
+/*
+ * The native ECC provider: key pairs backed by aws-c-cal's own curve arithmetic in ec_native.c instead of the
+ * platform's crypto library. pub_x, pub_y and priv_d hold the same encodings the platform providers produce, the
+ * engine works from its own parsed copy of them.
+ */
+struct native_ecc_key {
+    struct aws_ecc_key_pair key_pair;
+    struct aws_ec_native_key key;
+    /* set by aws_ecc_key_pair_enable_nonce_pool() */
+    struct aws_ec_native_nonce_pool *nonce_pool;
+    /* generated without its public point, which aws_ecc_key_pair_materialize_public_key() computes */
+    bool public_key_deferred;
+};
+
+static void s_key_pair_destroy(struct aws_ecc_key_pair *key_pair) {
+    if (key_pair) {
+        /* pub_x, pub_y and priv_d live in the same block as key_impl */
+        aws_byte_buf_clean_up_secure(&key_pair->priv_d);
+
+        struct native_ecc_key *key_impl = key_pair->impl;
+        aws_ec_native_nonce_pool_destroy(key_impl->nonce_pool);
+        aws_ec_native_key_clean_up(&key_impl->key);
+
+        aws_mem_release(key_pair->allocator, key_impl);
+    }
+}
+
+static int s_sign(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *hash,
+    enum aws_ec_native_signature_format format,
+    struct aws_byte_buf *signature_output) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+
+    /* deterministic nonces depend on the message, so pooled ones can't stand in for them */
+    struct aws_ec_native_nonce nonce;
+    if (key_impl->nonce_pool && !key_impl->key.deterministic_signing &&
+        aws_ec_native_nonce_pool_take(key_impl->nonce_pool, &nonce)) {
+        return aws_ec_native_sign_with_nonce(&key_impl->key, &nonce, hash, format, signature_output);
+    }
+
+    return aws_ec_native_sign(&key_impl->key, hash, format, signature_output);
+}
+
+static int s_sign_payload(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *hash,
+    struct aws_byte_buf *signature_output) {
+    return s_sign(key_pair, hash, AWS_EC_NATIVE_SIGNATURE_DER, signature_output);
+}
+
+static int s_sign_payload_raw(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *hash,
+    struct aws_byte_buf *signature_output) {
+    return s_sign(key_pair, hash, AWS_EC_NATIVE_SIGNATURE_RAW, signature_output);
+}
+
+static int s_sign_payload_batch(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *hashes,
+    size_t count,
+    struct aws_byte_buf *signatures) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+    return aws_ec_native_sign_batch(&key_impl->key, hashes, count, signatures);
+}
+
+static int s_enable_nonce_pool(struct aws_ecc_key_pair *key_pair, const struct aws_ecc_nonce_pool_options *options) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+
+    if (!key_impl->key.has_private_key) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    if (key_impl->nonce_pool) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    key_impl->nonce_pool = aws_ec_native_nonce_pool_new(
+        key_pair->allocator, key_pair->curve_name, options->depth, options->refill_threshold);
+
+    return key_impl->nonce_pool ? AWS_OP_SUCCESS : AWS_OP_ERR;
+}
+
+static int s_set_deterministic_signing(struct aws_ecc_key_pair *key_pair, bool deterministic) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+    return aws_ec_native_key_set_deterministic_signing(&key_impl->key, deterministic);
+}
+
+static int s_verify_payload(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *hash,
+    const struct aws_byte_cursor *signature) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+    return aws_ec_native_key_verify(&key_impl->key, hash, AWS_EC_NATIVE_SIGNATURE_DER, signature);
+}
+
+static int s_verify_payload_raw(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *hash,
+    const struct aws_byte_cursor *signature) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+    return aws_ec_native_key_verify(&key_impl->key, hash, AWS_EC_NATIVE_SIGNATURE_RAW, signature);
+}
+
+static size_t s_signature_length(const struct aws_ecc_key_pair *key_pair) {
+    return aws_ec_native_signature_length(key_pair->curve_name);
+}
+
+/* Sets key_pair's pub_x and pub_y from the engine's public point. */
+static int s_fill_in_public_key_info(struct native_ecc_key *key_impl) {
+    struct aws_ecc_key_pair *key_pair = &key_impl->key_pair;
+    key_pair->pub_x.len = 0;
+    key_pair->pub_y.len = 0;
+
+    return aws_ec_native_key_write_public_key(&key_impl->key, &key_pair->pub_x, &key_pair->pub_y);
+}
+
+static int s_derive_public_key(struct aws_ecc_key_pair *key_pair) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+
+    if (!key_impl->key.has_private_key) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    /* we already have a public key. */
+    if (key_pair->pub_x.len) {
+        return AWS_OP_SUCCESS;
+    }
+
+    if (aws_ec_native_key_derive_public_key(&key_impl->key) || s_fill_in_public_key_info(key_impl)) {
+        return AWS_OP_ERR;
+    }
+
+    key_impl->public_key_deferred = false;
+    return AWS_OP_SUCCESS;
+}
+
+static int s_materialize_public_key(struct aws_ecc_key_pair *key_pair) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+    return key_impl->public_key_deferred ? s_derive_public_key(key_pair) : AWS_OP_SUCCESS;
+}
+
+static struct native_ecc_key *s_key_impl_new(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name);
+
+static struct aws_ecc_key_pair *s_replicate(const struct aws_ecc_key_pair *key_pair, struct aws_allocator *allocator) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+
+    struct native_ecc_key *replica = s_key_impl_new(allocator, key_pair->curve_name);
+    if (!replica) {
+        return NULL;
+    }
+
+    /* the engine key is plain data, deterministic signing state included */
+    replica->key = key_impl->key;
+    replica->public_key_deferred = key_impl->public_key_deferred;
+    aws_ecc_key_pair_copy_coordinates(&replica->key_pair, key_pair);
+
+    return &replica->key_pair;
+}
+
+static struct aws_ecc_key_pair_vtable s_native_vtable;
+
+/*
+ * The engine key for peer's public point: a native peer's own, otherwise parsed from its coordinates into scratch,
+ * which checks the point is on the curve.
+ */
+static const struct aws_ec_native_key *s_peer_key(
+    const struct aws_ecc_key_pair *peer,
+    struct aws_ec_native_key *scratch) {
+    if (peer->vtable == &s_native_vtable) {
+        struct native_ecc_key *peer_impl = peer->impl;
+        return &peer_impl->key;
+    }
+
+    if (aws_ec_native_key_init(scratch, peer->curve_name) ||
+        aws_ec_native_key_set_public_key(
+            scratch, aws_byte_cursor_from_buf(&peer->pub_x), aws_byte_cursor_from_buf(&peer->pub_y))) {
+        return NULL;
+    }
+
+    return scratch;
+}
+
+static int s_derive_shared_secret(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *peer,
+    struct aws_byte_buf *shared_secret) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+
+    struct aws_ec_native_key scratch;
+    const struct aws_ec_native_key *peer_key = s_peer_key(peer, &scratch);
+    if (!peer_key) {
+        return AWS_OP_ERR;
+    }
+
+    /* a peer prepared for verification, of any provider, has a table for its point */
+    return aws_ec_native_key_derive_shared_secret(
+        &key_impl->key, peer_key, aws_atomic_load_ptr(&peer->verification_table), shared_secret);
+}
+
+/* the most peers s_derive_shared_secret_batch() hands the engine at once, bounded by the scratch keys on the stack */
+#define S_PEER_CHUNK 16
+
+static int s_derive_shared_secret_batch(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *const *peers,
+    size_t count,
+    struct aws_byte_buf *shared_secrets) {
+    struct native_ecc_key *key_impl = key_pair->impl;
+
+    struct aws_ec_native_key scratch[S_PEER_CHUNK];
+    const struct aws_ec_native_key *peer_keys[S_PEER_CHUNK];
+    const struct aws_ec_native_table *peer_tables[S_PEER_CHUNK];
+
+    for (size_t start = 0; start < count; start += S_PEER_CHUNK) {
+        size_t chunk = aws_min_size(S_PEER_CHUNK, count - start);
+
+        for (size_t i = 0; i < chunk; ++i) {
+            peer_keys[i] = s_peer_key(peers[start + i], &scratch[i]);
+            if (!peer_keys[i]) {
+                return AWS_OP_ERR;
+            }
+            peer_tables[i] = aws_atomic_load_ptr(&peers[start + i]->verification_table);
+        }
+
+        if (aws_ec_native_key_derive_shared_secret_batch(
+                &key_impl->key, peer_keys, peer_tables, chunk, shared_secrets + start)) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static struct aws_ecc_key_pair_vtable s_native_vtable = {
+    .destroy = s_key_pair_destroy,
+    .derive_pub_key = s_derive_public_key,
+    .sign_message = s_sign_payload,
+    .verify_signature = s_verify_payload,
+    .signature_length = s_signature_length,
+    .sign_message_batch = s_sign_payload_batch,
+    .enable_nonce_pool = s_enable_nonce_pool,
+    .set_deterministic_signing = s_set_deterministic_signing,
+    .sign_message_raw = s_sign_payload_raw,
+    .verify_signature_raw = s_verify_payload_raw,
+    .materialize_public_key = s_materialize_public_key,
+    .replicate = s_replicate,
+    .derive_shared_secret = s_derive_shared_secret,
+    .derive_shared_secret_batch = s_derive_shared_secret_batch,
+};
+
+static struct native_ecc_key *s_key_impl_new(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    if (!aws_ec_native_curve_get(curve_name)) {
+        aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+        return NULL;
+    }
+
+    struct native_ecc_key *key_impl = (struct native_ecc_key *)aws_ecc_key_pair_new_with_storage(
+        allocator, curve_name, sizeof(struct native_ecc_key), &s_native_vtable);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    aws_ec_native_key_init(&key_impl->key, curve_name);
+
+    return key_impl;
+}
+
+static int s_set_private_key(struct native_ecc_key *key_impl, struct aws_byte_cursor priv_key) {
+    if (priv_key.len != aws_ecc_key_coordinate_byte_size_from_curve_name(key_impl->key_pair.curve_name)) {
+        return aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+    }
+
+    if (aws_ec_native_key_set_private_key(&key_impl->key, priv_key)) {
+        return AWS_OP_ERR;
+    }
+
+    return aws_ecc_key_pair_write_coordinate(&key_impl->key_pair.priv_d, priv_key);
+}
+
+static int s_set_public_key(
+    struct native_ecc_key *key_impl,
+    struct aws_byte_cursor public_key_x,
+    struct aws_byte_cursor public_key_y) {
+    struct aws_ecc_key_pair *key_pair = &key_impl->key_pair;
+
+    /* padded to full size first, which is what the engine parses */
+    if (aws_ecc_key_pair_write_coordinate(&key_pair->pub_x, public_key_x) ||
+        aws_ecc_key_pair_write_coordinate(&key_pair->pub_y, public_key_y) ||
+        aws_ec_native_key_set_public_key(
+            &key_impl->key, aws_byte_cursor_from_buf(&key_pair->pub_x), aws_byte_cursor_from_buf(&key_pair->pub_y))) {
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_from_private_key(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *priv_key) {
+    struct native_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    if (s_set_private_key(key_impl, *priv_key)) {
+        s_key_pair_destroy(&key_impl->key_pair);
+        return NULL;
+    }
+
+    return &key_impl->key_pair;
+}
+
+static struct aws_ecc_key_pair *s_generate_random(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    bool defer_public_key) {
+    struct native_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    struct aws_ecc_key_pair *key_pair = &key_impl->key_pair;
+
+    if (aws_ec_native_key_generate_private_key(&key_impl->key) ||
+        aws_ec_native_key_write_private_key(&key_impl->key, &key_pair->priv_d)) {
+        s_key_pair_destroy(key_pair);
+        return NULL;
+    }
+
+    key_impl->public_key_deferred = defer_public_key;
+    if (!defer_public_key && s_derive_public_key(key_pair)) {
+        s_key_pair_destroy(key_pair);
+        return NULL;
+    }
+
+    return key_pair;
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_generate_random(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name) {
+    return s_generate_random(allocator, curve_name, false);
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_generate_random_deferred(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name) {
+    return s_generate_random(allocator, curve_name, true);
+}
+
+/* the most key pairs aws_ecc_key_pair_new_native_generate_batch() hands the engine at once */
+#define S_GENERATE_CHUNK 32
+
+static int s_generate_chunk(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_ecc_key_pair **key_pairs,
+    size_t count) {
+    struct aws_ec_native_key *keys[S_GENERATE_CHUNK];
+
+    for (size_t i = 0; i < count; ++i) {
+        struct native_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+        if (!key_impl) {
+            return AWS_OP_ERR;
+        }
+
+        key_pairs[i] = &key_impl->key_pair;
+        keys[i] = &key_impl->key;
+    }
+
+    if (aws_ec_native_key_generate_batch(keys, count)) {
+        return AWS_OP_ERR;
+    }
+
+    /* the public points were converted together, so writing the coordinates is just serialization */
+    for (size_t i = 0; i < count; ++i) {
+        struct native_ecc_key *key_impl = key_pairs[i]->impl;
+        if (aws_ec_native_key_write_private_key(&key_impl->key, &key_pairs[i]->priv_d) ||
+            s_fill_in_public_key_info(key_impl)) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+int aws_ecc_key_pair_new_native_generate_batch(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_ecc_key_pair **key_pairs,
+    size_t count) {
+    memset(key_pairs, 0, count * sizeof(struct aws_ecc_key_pair *));
+
+    for (size_t start = 0; start < count; start += S_GENERATE_CHUNK) {
+        if (s_generate_chunk(allocator, curve_name, key_pairs + start, aws_min_size(S_GENERATE_CHUNK, count - start))) {
+            for (size_t i = 0; i < count && key_pairs[i]; ++i) {
+                s_key_pair_destroy(key_pairs[i]);
+                key_pairs[i] = NULL;
+            }
+            return AWS_OP_ERR;
+        }
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_from_public_key(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *public_key_x,
+    const struct aws_byte_cursor *public_key_y) {
+    struct native_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    if (s_set_public_key(key_impl, *public_key_x, *public_key_y)) {
+        s_key_pair_destroy(&key_impl->key_pair);
+        return NULL;
+    }
+
+    return &key_impl->key_pair;
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_native_from_components(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    struct aws_byte_cursor priv_d,
+    struct aws_byte_cursor pub_x,
+    struct aws_byte_cursor pub_y) {
+    struct native_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    if (priv_d.ptr && s_set_private_key(key_impl, priv_d)) {
+        goto error;
+    }
+
+    if (pub_x.ptr) {
+        if (s_set_public_key(key_impl, pub_x, pub_y)) {
+            goto error;
+        }
+    } else if (s_derive_public_key(&key_impl->key_pair)) {
+        goto error;
+    }
+
+    return &key_impl->key_pair;
+
+error:
+    s_key_pair_destroy(&key_impl->key_pair);
+    return NULL;
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ed25519.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/private/ed25519_native.h>
+
+/*
+ * The native Ed25519 provider: key pairs backed by ed25519_native.c instead of the platform's crypto library.
+ */
+struct native_ed25519_key {
+    struct aws_ed25519_key_pair key_pair;
+    struct aws_ed25519_native_key key;
+};
+
+static void s_key_pair_destroy(struct aws_ed25519_key_pair *key_pair) {
+    struct native_ed25519_key *key_impl = key_pair->impl;
+    aws_ed25519_native_key_clean_up(&key_impl->key);
+    aws_mem_release(key_pair->allocator, key_impl);
+}
+
+static int s_sign_message(
+    const struct aws_ed25519_key_pair *key_pair,
+    struct aws_byte_cursor message,
+    struct aws_byte_buf *signature) {
+    struct native_ed25519_key *key_impl = key_pair->impl;
+    return aws_ed25519_native_sign(&key_impl->key, message, signature);
+}
+
+static int s_verify_signature(
+    const struct aws_ed25519_key_pair *key_pair,
+    struct aws_byte_cursor message,
+    struct aws_byte_cursor signature) {
+    struct native_ed25519_key *key_impl = key_pair->impl;
+    return aws_ed25519_native_verify(&key_impl->key, message, signature);
+}
+
+static struct aws_ed25519_key_pair_vtable s_key_pair_vtable = {
+    .destroy = s_key_pair_destroy,
+    .sign_message = s_sign_message,
+    .verify_signature = s_verify_signature,
+};
+
+static struct native_ed25519_key *s_key_impl_new(struct aws_allocator *allocator) {
+    struct native_ed25519_key *key_impl = aws_mem_calloc(allocator, 1, sizeof(struct native_ed25519_key));
+    if (!key_impl) {
+        return NULL;
+    }
+
+    aws_ed25519_key_pair_init(&key_impl->key_pair, allocator, &s_key_pair_vtable, key_impl);
+    key_impl->key_pair.native_key = &key_impl->key;
+    return key_impl;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_native_from_private_key(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor private_key) {
+    struct native_ed25519_key *key_impl = s_key_impl_new(allocator);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    if (aws_ed25519_native_key_set_private_key(&key_impl->key, private_key)) {
+        s_key_pair_destroy(&key_impl->key_pair);
+        return NULL;
+    }
+
+    memcpy(key_impl->key_pair.private_key, private_key.ptr, AWS_ED25519_PRIVATE_KEY_LEN);
+    memcpy(key_impl->key_pair.public_key, key_impl->key.public_key, AWS_ED25519_PUBLIC_KEY_LEN);
+    key_impl->key_pair.has_private_key = true;
+    return &key_impl->key_pair;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_native_from_public_key(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor public_key) {
+    struct native_ed25519_key *key_impl = s_key_impl_new(allocator);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    if (aws_ed25519_native_key_set_public_key(&key_impl->key, public_key)) {
+        s_key_pair_destroy(&key_impl->key_pair);
+        return NULL;
+    }
+
+    memcpy(key_impl->key_pair.public_key, key_impl->key.public_key, AWS_ED25519_PUBLIC_KEY_LEN);
+    return &key_impl->key_pair;
+}
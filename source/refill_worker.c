@@ -0,0 +1,93 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/refill_worker.h>
+
+#include <aws/common/math.h>
+
+static bool s_worker_has_work(void *user_data) {
+    struct aws_cal_refill_worker *worker = user_data;
+    return worker->shutting_down || worker->vtable->has_work(worker->pool);
+}
+
+static void s_worker(void *user_data) {
+    struct aws_cal_refill_worker *worker = user_data;
+
+    aws_mutex_lock(&worker->lock);
+    for (;;) {
+        aws_condition_variable_wait_pred(&worker->signal, &worker->lock, s_worker_has_work, worker);
+        if (worker->shutting_down) {
+            break;
+        }
+
+        size_t missing = 0;
+        while (!worker->shutting_down && (missing = worker->vtable->missing(worker->pool)) > 0) {
+            size_t count = aws_min_size(AWS_CAL_REFILL_CHUNK, missing);
+            aws_mutex_unlock(&worker->lock);
+
+            int result = worker->vtable->make_chunk(worker->pool, count);
+
+            aws_mutex_lock(&worker->lock);
+            if (!worker->vtable->finish_chunk(worker->pool, result, count)) {
+                break;
+            }
+        }
+    }
+    aws_mutex_unlock(&worker->lock);
+}
+
+int aws_cal_refill_worker_start(
+    struct aws_cal_refill_worker *worker,
+    struct aws_allocator *allocator,
+    const struct aws_cal_refill_worker_vtable *vtable,
+    void *pool) {
+
+    worker->vtable = vtable;
+    worker->pool = pool;
+    worker->shutting_down = false;
+
+    if (aws_mutex_init(&worker->lock)) {
+        return AWS_OP_ERR;
+    }
+
+    if (aws_condition_variable_init(&worker->signal)) {
+        goto on_mutex_error;
+    }
+
+    if (aws_thread_init(&worker->thread, allocator)) {
+        goto on_signal_error;
+    }
+
+    if (aws_thread_launch(&worker->thread, s_worker, worker, NULL)) {
+        aws_thread_clean_up(&worker->thread);
+        goto on_signal_error;
+    }
+
+    return AWS_OP_SUCCESS;
+
+on_signal_error:
+    aws_condition_variable_clean_up(&worker->signal);
+on_mutex_error:
+    aws_mutex_clean_up(&worker->lock);
+    return AWS_OP_ERR;
+}
+
+void aws_cal_refill_worker_stop(struct aws_cal_refill_worker *worker) {
+    aws_mutex_lock(&worker->lock);
+    worker->shutting_down = true;
+    aws_condition_variable_notify_one(&worker->signal);
+    aws_mutex_unlock(&worker->lock);
+
+    aws_thread_join(&worker->thread);
+    aws_thread_clean_up(&worker->thread);
+
+    aws_condition_variable_clean_up(&worker->signal);
+    aws_mutex_clean_up(&worker->lock);
+}
+
+void aws_cal_refill_worker_wake(struct aws_cal_refill_worker *worker) {
+    aws_mutex_lock(&worker->lock);
+    aws_condition_variable_notify_one(&worker->signal);
+    aws_mutex_unlock(&worker->lock);
+}
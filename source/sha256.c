@@ -0,0 +1,330 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/sha256.h>
+
+const uint32_t aws_sha256_round_constants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t s_sha256_iv[8] = {
+    0x6a09e667,
+    0xbb67ae85,
+    0x3c6ef372,
+    0xa54ff53a,
+    0x510e527f,
+    0x9b05688c,
+    0x1f83d9ab,
+    0x5be0cd19,
+};
+
+/*
+ * Portable kernel. Rounds are unrolled eight at a time so the working variables rotate by renaming instead of
+ * being shuffled through registers, and the message schedule lives in a 16 word ring.
+ */
+#define S_CH(e, f, g) ((g) ^ ((e) & ((f) ^ (g))))
+#define S_MAJ(a, b, c) (((a) & (b)) | ((c) & ((a) | (b))))
+#define S_SIGMA0(a) (AWS_SHA256_ROTR32(a, 2) ^ AWS_SHA256_ROTR32(a, 13) ^ AWS_SHA256_ROTR32(a, 22))
+#define S_SIGMA1(e) (AWS_SHA256_ROTR32(e, 6) ^ AWS_SHA256_ROTR32(e, 11) ^ AWS_SHA256_ROTR32(e, 25))
+#define S_GAMMA0(w) (AWS_SHA256_ROTR32(w, 7) ^ AWS_SHA256_ROTR32(w, 18) ^ ((w) >> 3))
+#define S_GAMMA1(w) (AWS_SHA256_ROTR32(w, 17) ^ AWS_SHA256_ROTR32(w, 19) ^ ((w) >> 10))
+
+#define S_SCHEDULE(i)                                                                                                  \
+    (w[(i)&15] += S_GAMMA1(w[((i)-2) & 15]) + w[((i)-7) & 15] + S_GAMMA0(w[((i)-15) & 15]))
+
+#define S_ROUND(a, b, c, d, e, f, g, h, i, wi)                                                                         \
+    do {                                                                                                               \
+        uint32_t t1 = (h) + S_SIGMA1(e) + S_CH(e, f, g) + aws_sha256_round_constants[i] + (wi);                        \
+        (d) += t1;                                                                                                     \
+        (h) = t1 + S_SIGMA0(a) + S_MAJ(a, b, c);                                                                       \
+    } while (0)
+
+#define S_ROUNDS_8(i, W)                                                                                               \
+    do {                                                                                                               \
+        S_ROUND(a, b, c, d, e, f, g, h, (i) + 0, W((i) + 0));                                                          \
+        S_ROUND(h, a, b, c, d, e, f, g, (i) + 1, W((i) + 1));                                                          \
+        S_ROUND(g, h, a, b, c, d, e, f, (i) + 2, W((i) + 2));                                                          \
+        S_ROUND(f, g, h, a, b, c, d, e, (i) + 3, W((i) + 3));                                                          \
+        S_ROUND(e, f, g, h, a, b, c, d, (i) + 4, W((i) + 4));                                                          \
+        S_ROUND(d, e, f, g, h, a, b, c, (i) + 5, W((i) + 5));                                                          \
+        S_ROUND(c, d, e, f, g, h, a, b, (i) + 6, W((i) + 6));                                                          \
+        S_ROUND(b, c, d, e, f, g, h, a, (i) + 7, W((i) + 7));                                                          \
+    } while (0)
+
+#define S_W_LOAD(i) (w[i] = aws_sha256_load_be32(blocks + (i)*4))
+#define S_W_EXPAND(i) S_SCHEDULE(i)
+
+void aws_sha256_compress_portable(uint32_t state[8], const uint8_t *blocks, size_t block_count) {
+    uint32_t w[16];
+
+    while (block_count--) {
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+        uint32_t f = state[5];
+        uint32_t g = state[6];
+        uint32_t h = state[7];
+
+        S_ROUNDS_8(0, S_W_LOAD);
+        S_ROUNDS_8(8, S_W_LOAD);
+        for (size_t i = 16; i < 64; i += 8) {
+            S_ROUNDS_8(i, S_W_EXPAND);
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+
+        blocks += AWS_SHA256_BLOCK_LEN;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        include <intrin.h>
+#        define S_HAVE_SHA_NI_KERNEL
+#        define S_TARGET_SHA_NI
+#    elif defined(__GNUC__) || defined(__clang__)
+#        include <cpuid.h>
+#        define S_HAVE_SHA_NI_KERNEL
+#        define S_TARGET_SHA_NI __attribute__((target("sha,sse4.1,ssse3")))
+#    endif
+#endif
+
+#ifdef S_HAVE_SHA_NI_KERNEL
+#    include <immintrin.h>
+
+/*
+ * x86 SHA extensions. Each 4 round group consumes one schedule vector, and the schedule for group g is derived from
+ * the previous four with sha256msg1/sha256msg2.
+ */
+S_TARGET_SHA_NI static void s_compress_sha_ni(uint32_t state[8], const uint8_t *blocks, size_t block_count) {
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    /* the instructions want the state as ABEF and CDGH */
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (block_count--) {
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+        __m128i msg[4];
+
+        for (size_t g = 0; g < 16; ++g) {
+            __m128i *current = &msg[g & 3];
+            if (g < 4) {
+                *current = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + g * 16)), byte_swap);
+            } else {
+                __m128i next = _mm_sha256msg1_epu32(*current, msg[(g + 1) & 3]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(msg[(g + 3) & 3], msg[(g + 2) & 3], 4));
+                *current = _mm_sha256msg2_epu32(next, msg[(g + 3) & 3]);
+            }
+
+            __m128i wk =
+                _mm_add_epi32(*current, _mm_loadu_si128((const __m128i *)&aws_sha256_round_constants[g * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        blocks += AWS_SHA256_BLOCK_LEN;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, state1, 0xF0));
+    _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+static bool s_cpu_has_sha_ni(void) {
+    /* CPUID.(EAX=7, ECX=0):EBX bit 29 is SHA, CPUID.1:ECX bit 19 is SSE4.1 */
+#    if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) {
+        return false;
+    }
+    __cpuidex(regs, 7, 0);
+    bool has_sha = (regs[1] >> 29) & 1;
+    __cpuid(regs, 1);
+    return has_sha && ((regs[2] >> 19) & 1);
+#    else
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    bool has_sha = (ebx >> 29) & 1;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return has_sha && ((ecx >> 19) & 1);
+#    endif
+}
+#endif /* S_HAVE_SHA_NI_KERNEL */
+
+typedef void(s_compress_fn)(uint32_t state[8], const uint8_t *blocks, size_t block_count);
+
+/* written once by aws_sha256_compress_init() from aws_cal_library_init(), read without synchronization after that */
+static s_compress_fn *s_compress = aws_sha256_compress_portable;
+
+void aws_sha256_compress_init(void) {
+#ifdef S_HAVE_SHA_NI_KERNEL
+    if (s_cpu_has_sha_ni()) {
+        s_compress = s_compress_sha_ni;
+    }
+#endif
+}
+
+void aws_sha256_compress(uint32_t state[8], const uint8_t *blocks, size_t block_count) {
+    s_compress(state, blocks, block_count);
+}
+
+void aws_sha256_ctx_init(struct aws_sha256_ctx *ctx) {
+    memcpy(ctx->state, s_sha256_iv, sizeof(ctx->state));
+    ctx->total_len = 0;
+    ctx->buffer_len = 0;
+}
+
+void aws_sha256_ctx_update(struct aws_sha256_ctx *ctx, const uint8_t *data, size_t len) {
+    if (!len) {
+        return;
+    }
+
+    ctx->total_len += len;
+
+    if (ctx->buffer_len) {
+        size_t to_copy = AWS_SHA256_BLOCK_LEN - ctx->buffer_len;
+        if (to_copy > len) {
+            to_copy = len;
+        }
+
+        memcpy(ctx->buffer + ctx->buffer_len, data, to_copy);
+        ctx->buffer_len += to_copy;
+        data += to_copy;
+        len -= to_copy;
+
+        if (ctx->buffer_len < AWS_SHA256_BLOCK_LEN) {
+            return;
+        }
+
+        aws_sha256_compress(ctx->state, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+
+    size_t full_blocks = len / AWS_SHA256_BLOCK_LEN;
+    if (full_blocks) {
+        aws_sha256_compress(ctx->state, data, full_blocks);
+        data += full_blocks * AWS_SHA256_BLOCK_LEN;
+        len -= full_blocks * AWS_SHA256_BLOCK_LEN;
+    }
+
+    if (len) {
+        memcpy(ctx->buffer, data, len);
+        ctx->buffer_len = len;
+    }
+}
+
+void aws_sha256_ctx_finalize(struct aws_sha256_ctx *ctx, uint8_t *digest) {
+    uint64_t total_bits = ctx->total_len * 8;
+
+    ctx->buffer[ctx->buffer_len++] = 0x80;
+    if (ctx->buffer_len > AWS_SHA256_BLOCK_LEN - 8) {
+        memset(ctx->buffer + ctx->buffer_len, 0, AWS_SHA256_BLOCK_LEN - ctx->buffer_len);
+        aws_sha256_compress(ctx->state, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+
+    memset(ctx->buffer + ctx->buffer_len, 0, AWS_SHA256_BLOCK_LEN - 8 - ctx->buffer_len);
+    aws_sha256_store_be64(ctx->buffer + AWS_SHA256_BLOCK_LEN - 8, total_bits);
+    aws_sha256_compress(ctx->state, ctx->buffer, 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        aws_sha256_store_be32(digest + i * 4, ctx->state[i]);
+    }
+
+    aws_secure_zero(ctx, sizeof(struct aws_sha256_ctx));
+}
+
+void aws_sha256_hmac_key_init(struct aws_sha256_hmac_key *key, const uint8_t *secret, size_t secret_len) {
+    uint8_t block[AWS_SHA256_BLOCK_LEN];
+    AWS_ZERO_ARRAY(block);
+
+    if (secret_len > AWS_SHA256_BLOCK_LEN) {
+        struct aws_sha256_ctx key_hash;
+        aws_sha256_ctx_init(&key_hash);
+        aws_sha256_ctx_update(&key_hash, secret, secret_len);
+        aws_sha256_ctx_finalize(&key_hash, block);
+    } else if (secret_len) {
+        memcpy(block, secret, secret_len);
+    }
+
+    for (size_t i = 0; i < AWS_SHA256_BLOCK_LEN; ++i) {
+        block[i] ^= 0x36;
+    }
+    memcpy(key->inner_state, s_sha256_iv, sizeof(key->inner_state));
+    aws_sha256_compress(key->inner_state, block, 1);
+
+    /* flip from ipad to opad in place: 0x36 ^ 0x5c == 0x6a */
+    for (size_t i = 0; i < AWS_SHA256_BLOCK_LEN; ++i) {
+        block[i] ^= 0x6a;
+    }
+    memcpy(key->outer_state, s_sha256_iv, sizeof(key->outer_state));
+    aws_sha256_compress(key->outer_state, block, 1);
+
+    aws_secure_zero(block, sizeof(block));
+}
+
+void aws_sha256_hmac_key_clean_up(struct aws_sha256_hmac_key *key) {
+    aws_secure_zero(key, sizeof(struct aws_sha256_hmac_key));
+}
+
+void aws_sha256_hmac_ctx_init(struct aws_sha256_ctx *ctx, const struct aws_sha256_hmac_key *key) {
+    memcpy(ctx->state, key->inner_state, sizeof(ctx->state));
+    ctx->total_len = AWS_SHA256_BLOCK_LEN;
+    ctx->buffer_len = 0;
+}
+
+void aws_sha256_hmac_ctx_finalize(
+    struct aws_sha256_ctx *ctx,
+    const struct aws_sha256_hmac_key *key,
+    uint8_t *mac) {
+    uint8_t block[AWS_SHA256_BLOCK_LEN];
+    aws_sha256_ctx_finalize(ctx, block);
+
+    /* the outer hash is always exactly one block: inner digest, padding and the bit length of pad block + digest. */
+    block[AWS_SHA256_LEN] = 0x80;
+    memset(block + AWS_SHA256_LEN + 1, 0, AWS_SHA256_BLOCK_LEN - AWS_SHA256_LEN - 1 - 8);
+    aws_sha256_store_be64(block + AWS_SHA256_BLOCK_LEN - 8, (uint64_t)(AWS_SHA256_BLOCK_LEN + AWS_SHA256_LEN) * 8);
+
+    uint32_t outer_state[8];
+    memcpy(outer_state, key->outer_state, sizeof(outer_state));
+    aws_sha256_compress(outer_state, block, 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        aws_sha256_store_be32(mac + i * 4, outer_state[i]);
+    }
+
+    aws_secure_zero(block, sizeof(block));
+    aws_secure_zero(outer_state, sizeof(outer_state));
+}
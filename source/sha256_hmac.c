@@ -0,0 +1,90 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/hmac.h>
+#include <aws/cal/private/sha256.h>
+
+/*
+ * Everything lives in one allocation: the public struct, the key midstates and the running hash. No platform
+ * context is involved, so creating an instance costs two compression function calls and one allocation.
+ */
+struct sha256_hmac_native {
+    struct aws_hmac hmac;
+    struct aws_sha256_hmac_key key;
+    struct aws_sha256_ctx ctx;
+};
+
+static void s_destroy(struct aws_hmac *hmac);
+static int s_update(struct aws_hmac *hmac, const struct aws_byte_cursor *to_hmac);
+static int s_finalize(struct aws_hmac *hmac, struct aws_byte_buf *output);
+
+static struct aws_hmac_vtable s_sha256_hmac_native_vtable = {
+    .destroy = s_destroy,
+    .update = s_update,
+    .finalize = s_finalize,
+    .alg_name = "SHA256 HMAC",
+    .provider = "aws-c-cal native",
+};
+
+static void s_destroy(struct aws_hmac *hmac) {
+    if (hmac == NULL) {
+        return;
+    }
+
+    struct sha256_hmac_native *native = hmac->impl;
+    aws_secure_zero(&native->key, sizeof(native->key));
+    aws_secure_zero(&native->ctx, sizeof(native->ctx));
+    aws_mem_release(hmac->allocator, native);
+}
+
+struct aws_hmac *aws_sha256_hmac_native_new(struct aws_allocator *allocator, const struct aws_byte_cursor *secret) {
+    AWS_ASSERT(secret->ptr);
+
+    struct sha256_hmac_native *native = aws_mem_acquire(allocator, sizeof(struct sha256_hmac_native));
+
+    if (!native) {
+        return NULL;
+    }
+
+    native->hmac.allocator = allocator;
+    native->hmac.vtable = &s_sha256_hmac_native_vtable;
+    native->hmac.digest_size = AWS_SHA256_HMAC_LEN;
+    native->hmac.impl = native;
+    native->hmac.good = true;
+
+    aws_sha256_hmac_key_init(&native->key, secret->ptr, secret->len);
+    aws_sha256_hmac_ctx_init(&native->ctx, &native->key);
+
+    return &native->hmac;
+}
+
+static int s_update(struct aws_hmac *hmac, const struct aws_byte_cursor *to_hmac) {
+    if (!hmac->good) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    struct sha256_hmac_native *native = hmac->impl;
+    aws_sha256_ctx_update(&native->ctx, to_hmac->ptr, to_hmac->len);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_finalize(struct aws_hmac *hmac, struct aws_byte_buf *output) {
+    if (!hmac->good) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    size_t buffer_len = output->capacity - output->len;
+
+    if (buffer_len < hmac->digest_size) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    struct sha256_hmac_native *native = hmac->impl;
+    aws_sha256_hmac_ctx_finalize(&native->ctx, &native->key, output->buffer + output->len);
+    output->len += hmac->digest_size;
+    hmac->good = false;
+
+    return AWS_OP_SUCCESS;
+}
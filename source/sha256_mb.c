@@ -0,0 +1,360 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/hmac.h>
+#include <aws/cal/private/sha256.h>
+
+#include <aws/common/cpuid.h>
+
+/*
+ * Multi-buffer SHA256: eight independent messages are hashed side by side, one 32 bit lane each, so a single
+ * pass of the round function advances all of them. State is stored word-major (state[word][lane]) so that a
+ * row maps directly onto a SIMD register.
+ */
+#define S_LANES 8
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        define S_HAVE_AVX2_KERNEL
+#        define S_TARGET_AVX2
+#    elif defined(__GNUC__) || defined(__clang__)
+#        define S_HAVE_AVX2_KERNEL
+#        define S_TARGET_AVX2 __attribute__((target("avx2")))
+#    endif
+#endif
+
+#ifdef S_HAVE_AVX2_KERNEL
+#    include <immintrin.h>
+#endif
+
+typedef void(s_compress_x8_fn)(uint32_t state[8][S_LANES], const uint8_t *const blocks[S_LANES]);
+
+static const uint8_t s_idle_block[AWS_SHA256_BLOCK_LEN] = {0};
+
+/* Portable kernel. Every inner loop runs across lanes, which compilers can vectorize on their own. */
+static void s_compress_x8_generic(uint32_t state[8][S_LANES], const uint8_t *const blocks[S_LANES]) {
+    uint32_t w[16][S_LANES];
+    uint32_t v[8][S_LANES];
+
+    memcpy(v, state, sizeof(v));
+
+    for (size_t i = 0; i < 64; ++i) {
+        uint32_t *wi = w[i & 15];
+
+        for (size_t l = 0; l < S_LANES; ++l) {
+            if (i < 16) {
+                wi[l] = aws_sha256_load_be32(blocks[l] + i * 4);
+            } else {
+                uint32_t w15 = w[(i - 15) & 15][l];
+                uint32_t w2 = w[(i - 2) & 15][l];
+                uint32_t s0 = AWS_SHA256_ROTR32(w15, 7) ^ AWS_SHA256_ROTR32(w15, 18) ^ (w15 >> 3);
+                uint32_t s1 = AWS_SHA256_ROTR32(w2, 17) ^ AWS_SHA256_ROTR32(w2, 19) ^ (w2 >> 10);
+                wi[l] += s0 + w[(i - 7) & 15][l] + s1;
+            }
+        }
+
+        for (size_t l = 0; l < S_LANES; ++l) {
+            uint32_t a = v[0][l];
+            uint32_t e = v[4][l];
+            uint32_t s1 = AWS_SHA256_ROTR32(e, 6) ^ AWS_SHA256_ROTR32(e, 11) ^ AWS_SHA256_ROTR32(e, 25);
+            uint32_t ch = (e & v[5][l]) ^ (~e & v[6][l]);
+            uint32_t t1 = v[7][l] + s1 + ch + aws_sha256_round_constants[i] + wi[l];
+            uint32_t s0 = AWS_SHA256_ROTR32(a, 2) ^ AWS_SHA256_ROTR32(a, 13) ^ AWS_SHA256_ROTR32(a, 22);
+            uint32_t maj = (a & v[1][l]) ^ (a & v[2][l]) ^ (v[1][l] & v[2][l]);
+
+            v[7][l] = v[6][l];
+            v[6][l] = v[5][l];
+            v[5][l] = e;
+            v[4][l] = v[3][l] + t1;
+            v[3][l] = v[2][l];
+            v[2][l] = v[1][l];
+            v[1][l] = a;
+            v[0][l] = t1 + s0 + maj;
+        }
+    }
+
+    for (size_t j = 0; j < 8; ++j) {
+        for (size_t l = 0; l < S_LANES; ++l) {
+            state[j][l] += v[j][l];
+        }
+    }
+}
+
+#ifdef S_HAVE_AVX2_KERNEL
+
+#    define S_ROTR_AVX2(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+S_TARGET_AVX2 static void s_compress_x8_avx2(uint32_t state[8][S_LANES], const uint8_t *const blocks[S_LANES]) {
+    __m256i w[16];
+    __m256i a = _mm256_loadu_si256((const __m256i *)state[0]);
+    __m256i b = _mm256_loadu_si256((const __m256i *)state[1]);
+    __m256i c = _mm256_loadu_si256((const __m256i *)state[2]);
+    __m256i d = _mm256_loadu_si256((const __m256i *)state[3]);
+    __m256i e = _mm256_loadu_si256((const __m256i *)state[4]);
+    __m256i f = _mm256_loadu_si256((const __m256i *)state[5]);
+    __m256i g = _mm256_loadu_si256((const __m256i *)state[6]);
+    __m256i h = _mm256_loadu_si256((const __m256i *)state[7]);
+
+    for (size_t i = 0; i < 64; ++i) {
+        if (i < 16) {
+            w[i] = _mm256_setr_epi32(
+                (int)aws_sha256_load_be32(blocks[0] + i * 4),
+                (int)aws_sha256_load_be32(blocks[1] + i * 4),
+                (int)aws_sha256_load_be32(blocks[2] + i * 4),
+                (int)aws_sha256_load_be32(blocks[3] + i * 4),
+                (int)aws_sha256_load_be32(blocks[4] + i * 4),
+                (int)aws_sha256_load_be32(blocks[5] + i * 4),
+                (int)aws_sha256_load_be32(blocks[6] + i * 4),
+                (int)aws_sha256_load_be32(blocks[7] + i * 4));
+        } else {
+            __m256i w15 = w[(i - 15) & 15];
+            __m256i w2 = w[(i - 2) & 15];
+            __m256i s0 = _mm256_xor_si256(
+                _mm256_xor_si256(S_ROTR_AVX2(w15, 7), S_ROTR_AVX2(w15, 18)), _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(
+                _mm256_xor_si256(S_ROTR_AVX2(w2, 17), S_ROTR_AVX2(w2, 19)), _mm256_srli_epi32(w2, 10));
+            w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], s0), _mm256_add_epi32(w[(i - 7) & 15], s1));
+        }
+
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(S_ROTR_AVX2(e, 6), S_ROTR_AVX2(e, 11)), S_ROTR_AVX2(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(
+            _mm256_add_epi32(h, s1),
+            _mm256_add_epi32(_mm256_add_epi32(ch, _mm256_set1_epi32((int)aws_sha256_round_constants[i])), w[i & 15]));
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(S_ROTR_AVX2(a, 2), S_ROTR_AVX2(a, 13)), S_ROTR_AVX2(a, 22));
+        __m256i maj = _mm256_xor_si256(_mm256_and_si256(a, _mm256_xor_si256(b, c)), _mm256_and_si256(b, c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(s0, maj));
+    }
+
+    __m256i *out = (__m256i *)state;
+    _mm256_storeu_si256(out + 0, _mm256_add_epi32(_mm256_loadu_si256(out + 0), a));
+    _mm256_storeu_si256(out + 1, _mm256_add_epi32(_mm256_loadu_si256(out + 1), b));
+    _mm256_storeu_si256(out + 2, _mm256_add_epi32(_mm256_loadu_si256(out + 2), c));
+    _mm256_storeu_si256(out + 3, _mm256_add_epi32(_mm256_loadu_si256(out + 3), d));
+    _mm256_storeu_si256(out + 4, _mm256_add_epi32(_mm256_loadu_si256(out + 4), e));
+    _mm256_storeu_si256(out + 5, _mm256_add_epi32(_mm256_loadu_si256(out + 5), f));
+    _mm256_storeu_si256(out + 6, _mm256_add_epi32(_mm256_loadu_si256(out + 6), g));
+    _mm256_storeu_si256(out + 7, _mm256_add_epi32(_mm256_loadu_si256(out + 7), h));
+}
+
+#endif /* S_HAVE_AVX2_KERNEL */
+
+static s_compress_x8_fn *s_resolve_compress_x8(void) {
+#ifdef S_HAVE_AVX2_KERNEL
+    if (aws_cpu_has_feature(AWS_CPU_FEATURE_AVX2)) {
+        return s_compress_x8_avx2;
+    }
+#endif
+    return s_compress_x8_generic;
+}
+
+/*
+ * A lane runs one message at a time: first the inner hash (message blocks straight from the caller's memory,
+ * then one or two padded tail blocks), then the single outer block. When the outer block finishes, the lane
+ * writes the MAC and immediately picks up the next message so no lane sits idle while work remains.
+ */
+struct s_lane {
+    bool active;
+    bool outer;
+    size_t job;
+    const uint8_t *data;
+    size_t data_blocks;
+    uint8_t tail[2 * AWS_SHA256_BLOCK_LEN];
+    size_t tail_blocks;
+    size_t tail_pos;
+    const struct aws_sha256_hmac_key *key;
+    struct aws_sha256_hmac_key owned_key;
+    struct aws_byte_cursor owned_secret;
+    /* owned_key was built from owned_secret; a zeroed lane holds an empty cursor but no key for it */
+    bool owned_key_valid;
+};
+
+struct s_hmac_batch {
+    uint32_t state[8][S_LANES];
+    struct s_lane lanes[S_LANES];
+};
+
+static void s_set_lane_state(struct s_hmac_batch *batch, size_t lane, const uint32_t *words) {
+    for (size_t j = 0; j < 8; ++j) {
+        batch->state[j][lane] = words[j];
+    }
+}
+
+static void s_lane_start_inner(
+    struct s_hmac_batch *batch,
+    size_t lane_idx,
+    size_t job,
+    const struct aws_sha256_hmac_key *key,
+    const struct aws_byte_cursor *message) {
+    struct s_lane *lane = &batch->lanes[lane_idx];
+    lane->active = true;
+    lane->outer = false;
+    lane->job = job;
+    lane->key = key;
+
+    lane->data = message->ptr;
+    lane->data_blocks = message->len / AWS_SHA256_BLOCK_LEN;
+
+    size_t remainder = message->len % AWS_SHA256_BLOCK_LEN;
+    size_t tail_len = remainder + 1 + 8 > AWS_SHA256_BLOCK_LEN ? 2 * AWS_SHA256_BLOCK_LEN : AWS_SHA256_BLOCK_LEN;
+    if (remainder) {
+        memcpy(lane->tail, message->ptr + lane->data_blocks * AWS_SHA256_BLOCK_LEN, remainder);
+    }
+    lane->tail[remainder] = 0x80;
+    memset(lane->tail + remainder + 1, 0, tail_len - remainder - 1 - 8);
+    /* the inner hash already absorbed the ipad block */
+    aws_sha256_store_be64(lane->tail + tail_len - 8, ((uint64_t)message->len + AWS_SHA256_BLOCK_LEN) * 8);
+    lane->tail_blocks = tail_len / AWS_SHA256_BLOCK_LEN;
+    lane->tail_pos = 0;
+
+    s_set_lane_state(batch, lane_idx, key->inner_state);
+}
+
+static void s_lane_start_outer(struct s_hmac_batch *batch, size_t lane_idx) {
+    struct s_lane *lane = &batch->lanes[lane_idx];
+    lane->outer = true;
+
+    for (size_t j = 0; j < 8; ++j) {
+        aws_sha256_store_be32(lane->tail + j * 4, batch->state[j][lane_idx]);
+    }
+    lane->tail[AWS_SHA256_LEN] = 0x80;
+    memset(lane->tail + AWS_SHA256_LEN + 1, 0, AWS_SHA256_BLOCK_LEN - AWS_SHA256_LEN - 1 - 8);
+    aws_sha256_store_be64(lane->tail + AWS_SHA256_BLOCK_LEN - 8, (uint64_t)(AWS_SHA256_BLOCK_LEN + AWS_SHA256_LEN) * 8);
+    lane->data_blocks = 0;
+    lane->tail_blocks = 1;
+    lane->tail_pos = 0;
+
+    s_set_lane_state(batch, lane_idx, lane->key->outer_state);
+}
+
+static void s_lane_write_output(
+    struct s_hmac_batch *batch,
+    size_t lane_idx,
+    struct aws_byte_buf *output,
+    size_t output_len) {
+    uint8_t mac[AWS_SHA256_HMAC_LEN];
+    for (size_t j = 0; j < 8; ++j) {
+        aws_sha256_store_be32(mac + j * 4, batch->state[j][lane_idx]);
+    }
+
+    memcpy(output->buffer + output->len, mac, output_len);
+    output->len += output_len;
+}
+
+/*
+ * Per-message secrets each need their own midstates. Consecutive messages that pass the very same secret
+ * buffer reuse the lane's midstates instead of rebuilding them.
+ */
+static const struct aws_sha256_hmac_key *s_lane_key_for_secret(
+    struct s_lane *lane,
+    const struct aws_byte_cursor *secret) {
+    if (!lane->owned_key_valid || lane->owned_secret.ptr != secret->ptr || lane->owned_secret.len != secret->len) {
+        aws_sha256_hmac_key_init(&lane->owned_key, secret->ptr, secret->len);
+        lane->owned_secret = *secret;
+        lane->owned_key_valid = true;
+    }
+
+    return &lane->owned_key;
+}
+
+int aws_sha256_hmac_compute_batch(
+    const struct aws_byte_cursor *secrets,
+    size_t secret_count,
+    const struct aws_byte_cursor *to_hmac,
+    struct aws_byte_buf *outputs,
+    size_t count,
+    size_t truncate_to) {
+    if (!count) {
+        return AWS_OP_SUCCESS;
+    }
+
+    if (secret_count != 1 && secret_count != count) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    size_t output_len = truncate_to && truncate_to < AWS_SHA256_HMAC_LEN ? truncate_to : AWS_SHA256_HMAC_LEN;
+    for (size_t i = 0; i < count; ++i) {
+        if (outputs[i].capacity - outputs[i].len < output_len) {
+            return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+        }
+    }
+
+    s_compress_x8_fn *compress_x8 = s_resolve_compress_x8();
+
+    struct aws_sha256_hmac_key shared_key;
+    bool shared_secret = secret_count == 1;
+    if (shared_secret) {
+        aws_sha256_hmac_key_init(&shared_key, secrets[0].ptr, secrets[0].len);
+    }
+
+    struct s_hmac_batch batch;
+    AWS_ZERO_STRUCT(batch);
+
+    size_t next_job = 0;
+    size_t active_lanes = 0;
+
+    for (size_t l = 0; l < S_LANES && next_job < count; ++l, ++next_job) {
+        const struct aws_sha256_hmac_key *key =
+            shared_secret ? &shared_key : s_lane_key_for_secret(&batch.lanes[l], &secrets[next_job]);
+        s_lane_start_inner(&batch, l, next_job, key, &to_hmac[next_job]);
+        ++active_lanes;
+    }
+
+    const uint8_t *blocks[S_LANES];
+    while (active_lanes) {
+        for (size_t l = 0; l < S_LANES; ++l) {
+            struct s_lane *lane = &batch.lanes[l];
+            if (!lane->active) {
+                blocks[l] = s_idle_block;
+            } else if (lane->data_blocks) {
+                blocks[l] = lane->data;
+                lane->data += AWS_SHA256_BLOCK_LEN;
+                --lane->data_blocks;
+            } else {
+                blocks[l] = lane->tail + lane->tail_pos++ * AWS_SHA256_BLOCK_LEN;
+            }
+        }
+
+        compress_x8(batch.state, blocks);
+
+        for (size_t l = 0; l < S_LANES; ++l) {
+            struct s_lane *lane = &batch.lanes[l];
+            if (!lane->active || lane->data_blocks || lane->tail_pos < lane->tail_blocks) {
+                continue;
+            }
+
+            if (!lane->outer) {
+                s_lane_start_outer(&batch, l);
+                continue;
+            }
+
+            s_lane_write_output(&batch, l, &outputs[lane->job], output_len);
+
+            if (next_job < count) {
+                const struct aws_sha256_hmac_key *key =
+                    shared_secret ? &shared_key : s_lane_key_for_secret(lane, &secrets[next_job]);
+                s_lane_start_inner(&batch, l, next_job, key, &to_hmac[next_job]);
+                ++next_job;
+            } else {
+                lane->active = false;
+                --active_lanes;
+            }
+        }
+    }
+
+    if (shared_secret) {
+        aws_sha256_hmac_key_clean_up(&shared_key);
+    }
+    aws_secure_zero(&batch, sizeof(batch));
+
+    return AWS_OP_SUCCESS;
+}
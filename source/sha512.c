@@ -0,0 +1,182 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/sha512.h>
+
+static const uint64_t s_sha512_round_constants[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL,
+    0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL, 0x12835b0145706fbeULL,
+    0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL, 0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL, 0x983e5152ee66dfabULL,
+    0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL,
+    0x53380d139d95b3dfULL, 0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL, 0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL,
+    0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL,
+    0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL, 0xca273eceea26619cULL,
+    0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL,
+    0x113f9804bef90daeULL, 0x1b710b35131c471bULL, 0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static const uint64_t s_sha512_iv[8] = {
+    0x6a09e667f3bcc908ULL,
+    0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL,
+    0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL,
+    0x5be0cd19137e2179ULL,
+};
+
+#define S_ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+/* Same shape as the portable SHA256 kernel: eight round unrolling and a 16 word message schedule ring. */
+#define S_CH(e, f, g) ((g) ^ ((e) & ((f) ^ (g))))
+#define S_MAJ(a, b, c) (((a) & (b)) | ((c) & ((a) | (b))))
+#define S_SIGMA0(a) (S_ROTR64(a, 28) ^ S_ROTR64(a, 34) ^ S_ROTR64(a, 39))
+#define S_SIGMA1(e) (S_ROTR64(e, 14) ^ S_ROTR64(e, 18) ^ S_ROTR64(e, 41))
+#define S_GAMMA0(w) (S_ROTR64(w, 1) ^ S_ROTR64(w, 8) ^ ((w) >> 7))
+#define S_GAMMA1(w) (S_ROTR64(w, 19) ^ S_ROTR64(w, 61) ^ ((w) >> 6))
+
+#define S_SCHEDULE(i)                                                                                                  \
+    (w[(i)&15] += S_GAMMA1(w[((i)-2) & 15]) + w[((i)-7) & 15] + S_GAMMA0(w[((i)-15) & 15]))
+
+#define S_ROUND(a, b, c, d, e, f, g, h, i, wi)                                                                         \
+    do {                                                                                                               \
+        uint64_t t1 = (h) + S_SIGMA1(e) + S_CH(e, f, g) + s_sha512_round_constants[i] + (wi);                          \
+        (d) += t1;                                                                                                     \
+        (h) = t1 + S_SIGMA0(a) + S_MAJ(a, b, c);                                                                       \
+    } while (0)
+
+#define S_ROUNDS_8(i, W)                                                                                               \
+    do {                                                                                                               \
+        S_ROUND(a, b, c, d, e, f, g, h, (i) + 0, W((i) + 0));                                                          \
+        S_ROUND(h, a, b, c, d, e, f, g, (i) + 1, W((i) + 1));                                                          \
+        S_ROUND(g, h, a, b, c, d, e, f, (i) + 2, W((i) + 2));                                                          \
+        S_ROUND(f, g, h, a, b, c, d, e, (i) + 3, W((i) + 3));                                                          \
+        S_ROUND(e, f, g, h, a, b, c, d, (i) + 4, W((i) + 4));                                                          \
+        S_ROUND(d, e, f, g, h, a, b, c, (i) + 5, W((i) + 5));                                                          \
+        S_ROUND(c, d, e, f, g, h, a, b, (i) + 6, W((i) + 6));                                                          \
+        S_ROUND(b, c, d, e, f, g, h, a, (i) + 7, W((i) + 7));                                                          \
+    } while (0)
+
+#define S_W_LOAD(i) (w[i] = s_load_be64(blocks + (i)*8))
+#define S_W_EXPAND(i) S_SCHEDULE(i)
+
+static inline uint64_t s_load_be64(const uint8_t *src) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value = (value << 8) | src[i];
+    }
+    return value;
+}
+
+static inline void s_store_be64(uint8_t *dest, uint64_t value) {
+    for (size_t i = 0; i < 8; ++i) {
+        dest[i] = (uint8_t)(value >> (56 - 8 * i));
+    }
+}
+
+static void s_compress(uint64_t state[8], const uint8_t *blocks, size_t block_count) {
+    uint64_t w[16];
+
+    while (block_count--) {
+        uint64_t a = state[0];
+        uint64_t b = state[1];
+        uint64_t c = state[2];
+        uint64_t d = state[3];
+        uint64_t e = state[4];
+        uint64_t f = state[5];
+        uint64_t g = state[6];
+        uint64_t h = state[7];
+
+        S_ROUNDS_8(0, S_W_LOAD);
+        S_ROUNDS_8(8, S_W_LOAD);
+        for (size_t i = 16; i < 80; i += 8) {
+            S_ROUNDS_8(i, S_W_EXPAND);
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+
+        blocks += AWS_SHA512_BLOCK_LEN;
+    }
+}
+
+void aws_sha512_ctx_init(struct aws_sha512_ctx *ctx) {
+    memcpy(ctx->state, s_sha512_iv, sizeof(ctx->state));
+    ctx->total_len = 0;
+    ctx->buffer_len = 0;
+}
+
+void aws_sha512_ctx_update(struct aws_sha512_ctx *ctx, const uint8_t *data, size_t len) {
+    if (!len) {
+        return;
+    }
+
+    ctx->total_len += len;
+
+    if (ctx->buffer_len) {
+        size_t to_copy = AWS_SHA512_BLOCK_LEN - ctx->buffer_len;
+        if (to_copy > len) {
+            to_copy = len;
+        }
+
+        memcpy(ctx->buffer + ctx->buffer_len, data, to_copy);
+        ctx->buffer_len += to_copy;
+        data += to_copy;
+        len -= to_copy;
+
+        if (ctx->buffer_len < AWS_SHA512_BLOCK_LEN) {
+            return;
+        }
+
+        s_compress(ctx->state, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+
+    size_t full_blocks = len / AWS_SHA512_BLOCK_LEN;
+    if (full_blocks) {
+        s_compress(ctx->state, data, full_blocks);
+        data += full_blocks * AWS_SHA512_BLOCK_LEN;
+        len -= full_blocks * AWS_SHA512_BLOCK_LEN;
+    }
+
+    if (len) {
+        memcpy(ctx->buffer, data, len);
+        ctx->buffer_len = len;
+    }
+}
+
+void aws_sha512_ctx_finalize(struct aws_sha512_ctx *ctx, uint8_t *digest) {
+    ctx->buffer[ctx->buffer_len++] = 0x80;
+    if (ctx->buffer_len > AWS_SHA512_BLOCK_LEN - 16) {
+        memset(ctx->buffer + ctx->buffer_len, 0, AWS_SHA512_BLOCK_LEN - ctx->buffer_len);
+        s_compress(ctx->state, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+
+    /* the length field is 128 bits; the top 64 hold what total_len * 8 overflows */
+    memset(ctx->buffer + ctx->buffer_len, 0, AWS_SHA512_BLOCK_LEN - 16 - ctx->buffer_len);
+    s_store_be64(ctx->buffer + AWS_SHA512_BLOCK_LEN - 16, ctx->total_len >> 61);
+    s_store_be64(ctx->buffer + AWS_SHA512_BLOCK_LEN - 8, ctx->total_len << 3);
+    s_compress(ctx->state, ctx->buffer, 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        s_store_be64(digest + i * 8, ctx->state[i]);
+    }
+
+    aws_secure_zero(ctx, sizeof(struct aws_sha512_ctx));
+}
@@ -8,6 +8,7 @@
 #include <dlfcn.h>
 
 #include <aws/cal/private/opensslcrypto_common.h>
+#include <aws/cal/private/opensslcrypto_ecc.h>
 
 #if defined(AWS_LIBCRYPTO_LOG_RESOLVE)
 #    define FLOGF(...)                                                                                                 \
@@ -22,9 +23,11 @@
 
 static struct openssl_hmac_ctx_table hmac_ctx_table;
 static struct openssl_evp_md_ctx_table evp_md_ctx_table;
+static struct openssl_evp_mac_table evp_mac_table;
 
 struct openssl_hmac_ctx_table *g_aws_openssl_hmac_ctx_table = NULL;
 struct openssl_evp_md_ctx_table *g_aws_openssl_evp_md_ctx_table = NULL;
+struct openssl_evp_mac_table *g_aws_openssl_evp_mac_table = NULL;
 
 /* weak refs to libcrypto functions to force them to at least try to link
  * and avoid dead-stripping
@@ -114,7 +117,21 @@ static int s_resolve_libcrypto_md(enum aws_libcrypto_version version, void *modu
         }
     }
 
+    /* present only in OpenSSL 3, where EVP_sha256() and friends fetch implicitly on every use */
+    evp_md_fetch md_fetch_fn = NULL;
+    evp_md_free md_fetched_free_fn = NULL;
+    *(void **)(&md_fetch_fn) = dlsym(module, "EVP_MD_fetch");
+    *(void **)(&md_fetched_free_fn) = dlsym(module, "EVP_MD_free");
+    if (md_fetch_fn && md_fetched_free_fn) {
+        FLOGF("found dynamic libcrypto 3.x EVP_MD_fetch symbols");
+    } else {
+        md_fetch_fn = NULL;
+        md_fetched_free_fn = NULL;
+    }
+
     /* Add the found symbols to the vtable */
+    evp_md_ctx_table.md_fetch_fn = md_fetch_fn;
+    evp_md_ctx_table.md_free_fn = md_fetched_free_fn;
     evp_md_ctx_table.new_fn = md_new_fn;
     evp_md_ctx_table.free_fn = md_free_fn;
     evp_md_ctx_table.init_ex_fn = md_init_ex_fn;
@@ -125,6 +142,44 @@ static int s_resolve_libcrypto_md(enum aws_libcrypto_version version, void *modu
     return version;
 }
 
+/*
+ * EVP_MAC only exists in OpenSSL 3, where the HMAC_CTX functions are deprecated shims that fetch the algorithm
+ * again on every init. It is optional: if any symbol is missing, HMAC stays on the HMAC_CTX table.
+ */
+static void s_resolve_libcrypto_mac(void *module) {
+    struct openssl_evp_mac_table table;
+    AWS_ZERO_STRUCT(table);
+
+    *(void **)(&table.fetch_fn) = dlsym(module, "EVP_MAC_fetch");
+    *(void **)(&table.free_fn) = dlsym(module, "EVP_MAC_free");
+    *(void **)(&table.ctx_new_fn) = dlsym(module, "EVP_MAC_CTX_new");
+    *(void **)(&table.ctx_free_fn) = dlsym(module, "EVP_MAC_CTX_free");
+    *(void **)(&table.ctx_dup_fn) = dlsym(module, "EVP_MAC_CTX_dup");
+    *(void **)(&table.ctx_set_params_fn) = dlsym(module, "EVP_MAC_CTX_set_params");
+    *(void **)(&table.init_fn) = dlsym(module, "EVP_MAC_init");
+    *(void **)(&table.update_fn) = dlsym(module, "EVP_MAC_update");
+    *(void **)(&table.final_fn) = dlsym(module, "EVP_MAC_final");
+
+    if (table.fetch_fn && table.free_fn && table.ctx_new_fn && table.ctx_free_fn && table.ctx_dup_fn &&
+        table.ctx_set_params_fn && table.init_fn && table.update_fn && table.final_fn) {
+        FLOGF("found dynamic libcrypto 3.x EVP_MAC symbols");
+        evp_mac_table = table;
+    }
+}
+
+/*
+ * EVP_PKEY_CTX_new_from_pkey() only exists in OpenSSL 3. Its presence means EC_KEY is the legacy shim, so ECDSA
+ * should go through EVP_PKEY instead.
+ */
+static bool s_libcrypto_has_providers = false;
+
+static void s_resolve_libcrypto_providers(void *module) {
+    s_libcrypto_has_providers = dlsym(module, "EVP_PKEY_CTX_new_from_pkey") != NULL;
+    if (s_libcrypto_has_providers) {
+        FLOGF("found dynamic libcrypto 3.x provider symbols");
+    }
+}
+
 static int s_resolve_libcrypto_symbols(enum aws_libcrypto_version version, void *module) {
     int found_version = s_resolve_libcrypto_hmac(version, module);
     if (!found_version) {
@@ -133,9 +188,98 @@ static int s_resolve_libcrypto_symbols(enum aws_libcrypto_version version, void
     if (!s_resolve_libcrypto_md(found_version, module)) {
         return AWS_LIBCRYPTO_NONE;
     }
+    s_resolve_libcrypto_mac(module);
+    s_resolve_libcrypto_providers(module);
     return found_version;
 }
 
+static const EVP_MD *s_fetch_md(const char *name, const EVP_MD *fallback) {
+    if (evp_md_ctx_table.md_fetch_fn) {
+        const EVP_MD *fetched = evp_md_ctx_table.md_fetch_fn(NULL, name, NULL);
+        if (fetched) {
+            return fetched;
+        }
+    }
+
+    /* e.g. MD5 is not available from the FIPS provider; keep the old behavior and let init fail later */
+    return fallback;
+}
+
+static void s_release_md(const EVP_MD *md, const EVP_MD *static_md) {
+    if (md && md != static_md && evp_md_ctx_table.md_free_fn) {
+        evp_md_ctx_table.md_free_fn((EVP_MD *)md);
+    }
+}
+
+static void s_evp_md_init(void) {
+    evp_md_ctx_table.sha256 = s_fetch_md("SHA256", EVP_sha256());
+    evp_md_ctx_table.md5 = s_fetch_md("MD5", EVP_md5());
+}
+
+static void s_evp_md_clean_up(void) {
+    s_release_md(evp_md_ctx_table.sha256, EVP_sha256());
+    s_release_md(evp_md_ctx_table.md5, EVP_md5());
+    evp_md_ctx_table.sha256 = NULL;
+    evp_md_ctx_table.md5 = NULL;
+}
+
+static void s_evp_mac_init(void) {
+    if (!evp_mac_table.fetch_fn) {
+        return;
+    }
+
+    evp_mac_table.hmac = evp_mac_table.fetch_fn(NULL, "HMAC", NULL);
+    if (!evp_mac_table.hmac) {
+        return;
+    }
+
+    evp_mac_table.sha256_hmac_template = evp_mac_table.ctx_new_fn(evp_mac_table.hmac);
+    if (!evp_mac_table.sha256_hmac_template) {
+        goto on_error;
+    }
+
+    char digest_name[] = "SHA256";
+    struct aws_ossl_param params[] = {
+        {
+            .key = "digest",
+            .data_type = AWS_OSSL_PARAM_UTF8_STRING,
+            .data = digest_name,
+            .data_size = sizeof(digest_name) - 1,
+            .return_size = AWS_OSSL_PARAM_UNMODIFIED,
+        },
+        {0},
+    };
+
+    if (!evp_mac_table.ctx_set_params_fn(evp_mac_table.sha256_hmac_template, params)) {
+        goto on_error;
+    }
+
+    g_aws_openssl_evp_mac_table = &evp_mac_table;
+    return;
+
+on_error:
+    if (evp_mac_table.sha256_hmac_template) {
+        evp_mac_table.ctx_free_fn(evp_mac_table.sha256_hmac_template);
+        evp_mac_table.sha256_hmac_template = NULL;
+    }
+    evp_mac_table.free_fn(evp_mac_table.hmac);
+    evp_mac_table.hmac = NULL;
+}
+
+static void s_evp_mac_clean_up(void) {
+    g_aws_openssl_evp_mac_table = NULL;
+
+    if (evp_mac_table.sha256_hmac_template) {
+        evp_mac_table.ctx_free_fn(evp_mac_table.sha256_hmac_template);
+        evp_mac_table.sha256_hmac_template = NULL;
+    }
+
+    if (evp_mac_table.hmac) {
+        evp_mac_table.free_fn(evp_mac_table.hmac);
+        evp_mac_table.hmac = NULL;
+    }
+}
+
 static int s_resolve_libcrypto(void) {
     if (s_libcrypto_version != AWS_LIBCRYPTO_NONE) {
         return s_libcrypto_version;
@@ -161,9 +305,17 @@ static int s_resolve_libcrypto(void) {
 void aws_cal_platform_init(struct aws_allocator *allocator) {
     int version = s_resolve_libcrypto();
     AWS_FATAL_ASSERT(version != AWS_LIBCRYPTO_NONE && "libcrypto could not be resolved");
+    s_evp_md_init();
+    s_evp_mac_init();
+    aws_libcrypto_ecc_set_backend(
+        s_libcrypto_has_providers ? AWS_LIBCRYPTO_ECC_BACKEND_EVP_PKEY : AWS_LIBCRYPTO_ECC_BACKEND_EC_KEY);
+    aws_libcrypto_ecc_init();
 }
 
 void aws_cal_platform_clean_up(void) {
+    aws_libcrypto_ecc_clean_up();
+    s_evp_mac_clean_up();
+    s_evp_md_clean_up();
 }
 #if !defined(__GNUC__) || (__GNUC__ >= 4 && __GNUC_MINOR__ > 1)
 #    pragma GCC diagnostic pop
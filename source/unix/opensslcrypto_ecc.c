@@ -6,17 +6,44 @@
 
 #include <aws/cal/cal.h>
 #include <aws/cal/private/der.h>
+#include <aws/cal/private/opensslcrypto_ecc.h>
 
 #include <openssl/bn.h>
 #include <openssl/ec.h>
+#include <openssl/ecdh.h>
 #include <openssl/ecdsa.h>
+#include <openssl/evp.h>
 #include <openssl/obj_mac.h>
 
 struct libcrypto_ecc_key {
     struct aws_ecc_key_pair key_pair;
     EC_KEY *ec_key;
+    /* the public point is not yet converted to pub_x and pub_y, see aws_ecc_key_pair_materialize_public_key() */
+    bool public_key_deferred;
+
+    /*
+     * EVP_PKEY backend only, all EVP_PKEY_CTX *. The templates are built on the first sign or verify, so importing a
+     * key that is never used costs nothing extra, and have been through EVP_PKEY_sign_init()/EVP_PKEY_verify_init()
+     * once: the provider side key is exported and the operation is set up. Every sign or verify works on a duplicate,
+     * which keeps a shared key usable from any number of threads; the most recently used duplicate is parked in the
+     * cache slot, so a key that is only used by one thread at a time never allocates a context after the first call.
+     */
+    struct aws_atomic_var sign_template;
+    struct aws_atomic_var verify_template;
+    struct aws_atomic_var cached_sign_ctx;
+    struct aws_atomic_var cached_verify_ctx;
 };
 
+static enum aws_libcrypto_ecc_backend s_ecc_backend = AWS_LIBCRYPTO_ECC_BACKEND_EC_KEY;
+
+void aws_libcrypto_ecc_set_backend(enum aws_libcrypto_ecc_backend backend) {
+    s_ecc_backend = backend;
+}
+
+enum aws_libcrypto_ecc_backend aws_libcrypto_ecc_get_backend(void) {
+    return s_ecc_backend;
+}
+
 static int s_curve_name_to_nid(enum aws_ecc_curve_name curve_name) {
     switch (curve_name) {
         case AWS_CAL_ECDSA_P256:
@@ -29,15 +56,78 @@ static int s_curve_name_to_nid(enum aws_ecc_curve_name curve_name) {
     return -1;
 }
 
+/*
+ * The curve groups are built once by aws_cal_library_init(), with the generator multiples precomputed. Keys get their
+ * group from these through EC_KEY_set_group(), which copies the curve parameters and takes a reference on the shared
+ * precomputation, instead of EC_KEY_new_by_curve_name() rebuilding the group from its curve data for every key.
+ * The shared groups are never modified after init.
+ */
+static EC_GROUP *s_curve_groups[AWS_CAL_ECDSA_P384 + 1];
+
+void aws_libcrypto_ecc_init(void) {
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_curve_groups); ++i) {
+        EC_GROUP *group = EC_GROUP_new_by_curve_name(s_curve_name_to_nid((enum aws_ecc_curve_name)i));
+
+        /* if precomputation fails the group still works, just with on-the-fly generator multiples */
+        if (group) {
+            EC_GROUP_precompute_mult(group, NULL);
+        }
+        s_curve_groups[i] = group;
+    }
+}
+
+void aws_libcrypto_ecc_clean_up(void) {
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_curve_groups); ++i) {
+        EC_GROUP_free(s_curve_groups[i]);
+        s_curve_groups[i] = NULL;
+    }
+}
+
+/* Raises AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM for a curve without a group, AWS_ERROR_INVALID_STATE otherwise. */
+static EC_KEY *s_ec_key_new(enum aws_ecc_curve_name curve_name) {
+    if ((size_t)curve_name >= AWS_ARRAY_SIZE(s_curve_groups)) {
+        aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+        return NULL;
+    }
+
+    const EC_GROUP *group = s_curve_groups[curve_name];
+    EC_KEY *ec_key = NULL;
+
+    if (group) {
+        ec_key = EC_KEY_new();
+        if (ec_key && EC_KEY_set_group(ec_key, group) != 1) {
+            EC_KEY_free(ec_key);
+            ec_key = NULL;
+        }
+    } else {
+        /* the library hasn't been initialized, or building the group failed there */
+        ec_key = EC_KEY_new_by_curve_name(s_curve_name_to_nid(curve_name));
+    }
+
+    if (!ec_key) {
+        aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    return ec_key;
+}
+
+static void s_evp_pkey_clean_up(struct libcrypto_ecc_key *key_impl) {
+    EVP_PKEY_CTX_free(aws_atomic_exchange_ptr(&key_impl->cached_sign_ctx, NULL));
+    EVP_PKEY_CTX_free(aws_atomic_exchange_ptr(&key_impl->cached_verify_ctx, NULL));
+    EVP_PKEY_CTX_free(aws_atomic_exchange_ptr(&key_impl->sign_template, NULL));
+    EVP_PKEY_CTX_free(aws_atomic_exchange_ptr(&key_impl->verify_template, NULL));
+}
+
 static void s_key_pair_destroy(struct aws_ecc_key_pair *key_pair) {
 
     if (key_pair) {
-        aws_byte_buf_clean_up(&key_pair->pub_x);
-        aws_byte_buf_clean_up(&key_pair->pub_y);
+        /* pub_x, pub_y and priv_d live in the same block as the key pair */
         aws_byte_buf_clean_up_secure(&key_pair->priv_d);
 
         struct libcrypto_ecc_key *key_impl = key_pair->impl;
 
+        s_evp_pkey_clean_up(key_impl);
+
         if (key_impl->ec_key) {
             EC_KEY_free(key_impl->ec_key);
         }
@@ -75,12 +165,140 @@ static int s_verify_payload(
                : aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
 }
 
+static EVP_PKEY_CTX *s_new_operation_template(EC_KEY *ec_key, int (*operation_init_fn)(EVP_PKEY_CTX *)) {
+    EVP_PKEY *pkey = EVP_PKEY_new();
+    if (!pkey || EVP_PKEY_set1_EC_KEY(pkey, ec_key) != 1) {
+        EVP_PKEY_free(pkey);
+        return NULL;
+    }
+
+    /* the context holds its own reference on pkey */
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new(pkey, NULL);
+    EVP_PKEY_free(pkey);
+
+    if (ctx && operation_init_fn(ctx) != 1) {
+        EVP_PKEY_CTX_free(ctx);
+        return NULL;
+    }
+
+    return ctx;
+}
+
+static EVP_PKEY_CTX *s_get_template(
+    struct libcrypto_ecc_key *key_impl,
+    struct aws_atomic_var *template_slot,
+    int (*operation_init_fn)(EVP_PKEY_CTX *)) {
+    EVP_PKEY_CTX *ctx_template = aws_atomic_load_ptr(template_slot);
+
+    if (ctx_template) {
+        return ctx_template;
+    }
+
+    ctx_template = s_new_operation_template(key_impl->ec_key, operation_init_fn);
+    if (!ctx_template) {
+        return NULL;
+    }
+
+    /* lost a race with another thread building the same template, use theirs */
+    void *expected = NULL;
+    if (!aws_atomic_compare_exchange_ptr(template_slot, &expected, ctx_template)) {
+        EVP_PKEY_CTX_free(ctx_template);
+        return expected;
+    }
+
+    return ctx_template;
+}
+
+static EVP_PKEY_CTX *s_acquire_ctx(struct aws_atomic_var *cache_slot, EVP_PKEY_CTX *ctx_template) {
+    EVP_PKEY_CTX *ctx = aws_atomic_exchange_ptr(cache_slot, NULL);
+
+    if (ctx) {
+        return ctx;
+    }
+
+    return EVP_PKEY_CTX_dup(ctx_template);
+}
+
+static void s_release_ctx(struct aws_atomic_var *cache_slot, EVP_PKEY_CTX *ctx) {
+    void *expected = NULL;
+
+    /* another thread already parked one, don't hold more than one idle context per key */
+    if (!aws_atomic_compare_exchange_ptr(cache_slot, &expected, ctx)) {
+        EVP_PKEY_CTX_free(ctx);
+    }
+}
+
+static int s_evp_pkey_sign_payload(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *hash,
+    struct aws_byte_buf *signature_output) {
+    struct libcrypto_ecc_key *libcrypto_key_pair = key_pair->impl;
+
+    /* without a private key this fails either way, let the EC_KEY path report it */
+    if (!EC_KEY_get0_private_key(libcrypto_key_pair->ec_key)) {
+        return s_sign_payload(key_pair, hash, signature_output);
+    }
+
+    EVP_PKEY_CTX *ctx_template =
+        s_get_template(libcrypto_key_pair, &libcrypto_key_pair->sign_template, EVP_PKEY_sign_init);
+    EVP_PKEY_CTX *ctx = ctx_template ? s_acquire_ctx(&libcrypto_key_pair->cached_sign_ctx, ctx_template) : NULL;
+    if (!ctx) {
+        return s_sign_payload(key_pair, hash, signature_output);
+    }
+
+    size_t signature_size = signature_output->capacity - signature_output->len;
+    if (EVP_PKEY_sign(
+            ctx, signature_output->buffer + signature_output->len, &signature_size, hash->ptr, hash->len) != 1) {
+        EVP_PKEY_CTX_free(ctx);
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    signature_output->len += signature_size;
+    s_release_ctx(&libcrypto_key_pair->cached_sign_ctx, ctx);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_evp_pkey_verify_payload(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_byte_cursor *hash,
+    const struct aws_byte_cursor *signature) {
+    struct libcrypto_ecc_key *libcrypto_key_pair = key_pair->impl;
+
+    if (!EC_KEY_get0_public_key(libcrypto_key_pair->ec_key)) {
+        return s_verify_payload(key_pair, hash, signature);
+    }
+
+    EVP_PKEY_CTX *ctx_template =
+        s_get_template(libcrypto_key_pair, &libcrypto_key_pair->verify_template, EVP_PKEY_verify_init);
+    EVP_PKEY_CTX *ctx = ctx_template ? s_acquire_ctx(&libcrypto_key_pair->cached_verify_ctx, ctx_template) : NULL;
+    if (!ctx) {
+        return s_verify_payload(key_pair, hash, signature);
+    }
+
+    int ret_val = EVP_PKEY_verify(ctx, signature->ptr, signature->len, hash->ptr, hash->len);
+    s_release_ctx(&libcrypto_key_pair->cached_verify_ctx, ctx);
+
+    return ret_val == 1 ? AWS_OP_SUCCESS : aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+}
+
 static size_t s_signature_length(const struct aws_ecc_key_pair *key_pair) {
     struct libcrypto_ecc_key *libcrypto_key_pair = key_pair->impl;
 
     return ECDSA_size(libcrypto_key_pair->ec_key);
 }
 
+/* Sets one of the key pair's coordinate buffers to num, left padded to the full coordinate size. */
+static void s_write_coordinate(struct aws_byte_buf *coordinate, const BIGNUM *num) {
+    size_t num_size = BN_num_bytes(num);
+    AWS_FATAL_ASSERT(num_size <= coordinate->capacity);
+
+    size_t padding = coordinate->capacity - num_size;
+    memset(coordinate->buffer, 0, padding);
+    BN_bn2bin(num, coordinate->buffer + padding);
+    coordinate->len = coordinate->capacity;
+}
+
 static int s_fill_in_public_key_info(
     struct libcrypto_ecc_key *libcrypto_key_pair,
     const EC_GROUP *group,
@@ -95,22 +313,8 @@ static int s_fill_in_public_key_info(
         goto clean_up;
     }
 
-    size_t x_coor_size = BN_num_bytes(big_num_x);
-    size_t y_coor_size = BN_num_bytes(big_num_y);
-
-    if (aws_byte_buf_init(&libcrypto_key_pair->key_pair.pub_x, libcrypto_key_pair->key_pair.allocator, x_coor_size)) {
-        goto clean_up;
-    }
-
-    if (aws_byte_buf_init(&libcrypto_key_pair->key_pair.pub_y, libcrypto_key_pair->key_pair.allocator, y_coor_size)) {
-        goto clean_up;
-    }
-
-    BN_bn2bin(big_num_x, libcrypto_key_pair->key_pair.pub_x.buffer);
-    BN_bn2bin(big_num_y, libcrypto_key_pair->key_pair.pub_y.buffer);
-
-    libcrypto_key_pair->key_pair.pub_x.len = x_coor_size;
-    libcrypto_key_pair->key_pair.pub_y.len = y_coor_size;
+    s_write_coordinate(&libcrypto_key_pair->key_pair.pub_x, big_num_x);
+    s_write_coordinate(&libcrypto_key_pair->key_pair.pub_y, big_num_y);
 
     ret_val = AWS_OP_SUCCESS;
 
@@ -124,7 +328,7 @@ clean_up:
 static int s_derive_public_key(struct aws_ecc_key_pair *key_pair) {
     struct libcrypto_ecc_key *libcrypto_key_pair = key_pair->impl;
 
-    if (!libcrypto_key_pair->key_pair.priv_d.buffer) {
+    if (!libcrypto_key_pair->key_pair.priv_d.len) {
         return aws_raise_error(AWS_ERROR_INVALID_STATE);
     }
 
@@ -133,6 +337,16 @@ static int s_derive_public_key(struct aws_ecc_key_pair *key_pair) {
         return AWS_OP_SUCCESS;
     }
 
+    const EC_POINT *public_key = EC_KEY_get0_public_key(libcrypto_key_pair->ec_key);
+    if (public_key) {
+        /* generated with its coordinates deferred */
+        if (s_fill_in_public_key_info(libcrypto_key_pair, EC_KEY_get0_group(libcrypto_key_pair->ec_key), public_key)) {
+            return AWS_OP_ERR;
+        }
+        libcrypto_key_pair->public_key_deferred = false;
+        return AWS_OP_SUCCESS;
+    }
+
     BIGNUM *priv_key_num =
         BN_bin2bn(libcrypto_key_pair->key_pair.priv_d.buffer, libcrypto_key_pair->key_pair.priv_d.len, NULL);
 
@@ -142,159 +356,274 @@ static int s_derive_public_key(struct aws_ecc_key_pair *key_pair) {
     EC_POINT_mul(group, point, priv_key_num, NULL, NULL, NULL);
     BN_free(priv_key_num);
 
-    EC_KEY_set_public_key(libcrypto_key_pair->ec_key, point);
-    int ret_val = s_fill_in_public_key_info(libcrypto_key_pair, group, point);
+    int ret_val = AWS_OP_ERR;
+    if (EC_KEY_set_public_key(libcrypto_key_pair->ec_key, point) != 1) {
+        aws_raise_error(AWS_ERROR_INVALID_STATE);
+    } else {
+        ret_val = s_fill_in_public_key_info(libcrypto_key_pair, group, point);
+    }
     EC_POINT_free(point);
+
+    /*
+     * A sign template built before this has the provider side copy of the key without its public half, which signing
+     * doesn't need, and verification only builds its template once there is a public key. So the templates are left
+     * alone: another thread may be duplicating one right now.
+     */
     return ret_val;
 }
 
-static struct aws_ecc_key_pair_vtable vtable = {
+static int s_materialize_public_key(struct aws_ecc_key_pair *key_pair) {
+    struct libcrypto_ecc_key *libcrypto_key_pair = key_pair->impl;
+    return libcrypto_key_pair->public_key_deferred ? s_derive_public_key(key_pair) : AWS_OP_SUCCESS;
+}
+
+static struct libcrypto_ecc_key *s_key_impl_new(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name);
+
+/*
+ * A replica gets an EC_KEY of its own on the shared group, and its own EVP_PKEY_CTX templates on first use, so
+ * replicas on different threads share no libcrypto state that is written while signing.
+ */
+static struct aws_ecc_key_pair *s_replicate(const struct aws_ecc_key_pair *key_pair, struct aws_allocator *allocator) {
+    struct libcrypto_ecc_key *key_impl = key_pair->impl;
+
+    struct libcrypto_ecc_key *replica = s_key_impl_new(allocator, key_pair->curve_name);
+    if (!replica) {
+        return NULL;
+    }
+
+    /* same backend as the key pair, whatever the current one is */
+    replica->key_pair.vtable = key_pair->vtable;
+
+    const BIGNUM *private_key = EC_KEY_get0_private_key(key_impl->ec_key);
+    const EC_POINT *public_key = EC_KEY_get0_public_key(key_impl->ec_key);
+    if ((private_key && EC_KEY_set_private_key(replica->ec_key, private_key) != 1) ||
+        (public_key && EC_KEY_set_public_key(replica->ec_key, public_key) != 1)) {
+        aws_raise_error(AWS_ERROR_INVALID_STATE);
+        s_key_pair_destroy(&replica->key_pair);
+        return NULL;
+    }
+
+    aws_ecc_key_pair_copy_coordinates(&replica->key_pair, key_pair);
+    replica->public_key_deferred = key_impl->public_key_deferred;
+
+    return &replica->key_pair;
+}
+
+/* peer is taken by its coordinates whatever its provider, the same way verification tables are built */
+static int s_derive_shared_secret(
+    const struct aws_ecc_key_pair *key_pair,
+    const struct aws_ecc_key_pair *peer,
+    struct aws_byte_buf *shared_secret) {
+    struct libcrypto_ecc_key *key_impl = key_pair->impl;
+
+    if (!EC_KEY_get0_private_key(key_impl->ec_key)) {
+        return aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+    }
+
+    int ret_val = AWS_OP_ERR;
+    size_t secret_size = aws_ecc_key_coordinate_byte_size_from_curve_name(key_pair->curve_name);
+    BIGNUM *peer_x_num = BN_bin2bn(peer->pub_x.buffer, peer->pub_x.len, NULL);
+    BIGNUM *peer_y_num = BN_bin2bn(peer->pub_y.buffer, peer->pub_y.len, NULL);
+
+    const EC_GROUP *group = EC_KEY_get0_group(key_impl->ec_key);
+    EC_POINT *peer_point = EC_POINT_new(group);
+
+    if (!peer_x_num || !peer_y_num || !peer_point ||
+        EC_POINT_set_affine_coordinates_GFp(group, peer_point, peer_x_num, peer_y_num, NULL) != 1) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        goto clean_up;
+    }
+
+    /* without a KDF the secret is x of the shared point, left padded to the field size */
+    if (ECDH_compute_key(shared_secret->buffer + shared_secret->len, secret_size, peer_point, key_impl->ec_key, NULL) !=
+        (int)secret_size) {
+        aws_raise_error(AWS_ERROR_INVALID_STATE);
+        goto clean_up;
+    }
+
+    shared_secret->len += secret_size;
+    ret_val = AWS_OP_SUCCESS;
+
+clean_up:
+    EC_POINT_free(peer_point);
+    BN_free(peer_x_num);
+    BN_free(peer_y_num);
+
+    return ret_val;
+}
+
+static struct aws_ecc_key_pair_vtable s_ec_key_vtable = {
     .sign_message = s_sign_payload,
     .verify_signature = s_verify_payload,
     .derive_pub_key = s_derive_public_key,
     .signature_length = s_signature_length,
     .destroy = s_key_pair_destroy,
+    .materialize_public_key = s_materialize_public_key,
+    .replicate = s_replicate,
+    .derive_shared_secret = s_derive_shared_secret,
 };
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key(
+static struct aws_ecc_key_pair_vtable s_evp_pkey_vtable = {
+    .sign_message = s_evp_pkey_sign_payload,
+    .verify_signature = s_evp_pkey_verify_payload,
+    .derive_pub_key = s_derive_public_key,
+    .signature_length = s_signature_length,
+    .destroy = s_key_pair_destroy,
+    .materialize_public_key = s_materialize_public_key,
+    .replicate = s_replicate,
+    .derive_shared_secret = s_derive_shared_secret,
+};
+
+static struct aws_ecc_key_pair_vtable *s_backend_vtable(void) {
+    return s_ecc_backend == AWS_LIBCRYPTO_ECC_BACKEND_EVP_PKEY ? &s_evp_pkey_vtable : &s_ec_key_vtable;
+}
+
+static struct libcrypto_ecc_key *s_key_impl_new(
     struct aws_allocator *allocator,
-    enum aws_ecc_curve_name curve_name,
-    const struct aws_byte_cursor *priv_key) {
+    enum aws_ecc_curve_name curve_name) {
+    struct libcrypto_ecc_key *key_impl = (struct libcrypto_ecc_key *)aws_ecc_key_pair_new_with_storage(
+        allocator, curve_name, sizeof(struct libcrypto_ecc_key), s_backend_vtable());
 
-    size_t key_length = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
-    if (priv_key->len != key_length) {
-        aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
+    if (!key_impl) {
         return NULL;
     }
 
-    struct libcrypto_ecc_key *key_impl = aws_mem_calloc(allocator, 1, sizeof(struct libcrypto_ecc_key));
-
-    key_impl->ec_key = EC_KEY_new_by_curve_name(s_curve_name_to_nid(curve_name));
-    key_impl->key_pair.curve_name = curve_name;
-    key_impl->key_pair.allocator = allocator;
-    key_impl->key_pair.vtable = &vtable;
-    key_impl->key_pair.impl = key_impl;
-    aws_atomic_init_int(&key_impl->key_pair.ref_count, 1);
-    aws_byte_buf_init_copy_from_cursor(&key_impl->key_pair.priv_d, allocator, *priv_key);
-
-    BIGNUM *priv_key_num = BN_bin2bn(key_impl->key_pair.priv_d.buffer, key_impl->key_pair.priv_d.len, NULL);
-    if (!EC_KEY_set_private_key(key_impl->ec_key, priv_key_num)) {
-        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
-        BN_free(priv_key_num);
+    key_impl->ec_key = s_ec_key_new(curve_name);
+    if (!key_impl->ec_key) {
         s_key_pair_destroy(&key_impl->key_pair);
         return NULL;
     }
-    BN_free(priv_key_num);
-    return &key_impl->key_pair;
+
+    return key_impl;
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random(
-    struct aws_allocator *allocator,
-    enum aws_ecc_curve_name curve_name) {
-    struct libcrypto_ecc_key *key_impl = aws_mem_calloc(allocator, 1, sizeof(struct libcrypto_ecc_key));
+static int s_set_private_key(struct libcrypto_ecc_key *key_impl, const struct aws_byte_cursor *priv_key) {
+    if (aws_ecc_key_pair_write_coordinate(&key_impl->key_pair.priv_d, *priv_key)) {
+        return AWS_OP_ERR;
+    }
+
+    BIGNUM *priv_key_num = BN_bin2bn(key_impl->key_pair.priv_d.buffer, key_impl->key_pair.priv_d.len, NULL);
+    int ret_val = EC_KEY_set_private_key(key_impl->ec_key, priv_key_num);
+    BN_free(priv_key_num);
 
-    key_impl->ec_key = EC_KEY_new_by_curve_name(s_curve_name_to_nid(curve_name));
-    key_impl->key_pair.curve_name = curve_name;
-    key_impl->key_pair.allocator = allocator;
-    key_impl->key_pair.vtable = &vtable;
-    key_impl->key_pair.impl = key_impl;
-    aws_atomic_init_int(&key_impl->key_pair.ref_count, 1);
+    return ret_val == 1 ? AWS_OP_SUCCESS : aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+}
 
-    if (EC_KEY_generate_key(key_impl->ec_key) != 1) {
-        goto error;
+static int s_set_public_key(
+    struct libcrypto_ecc_key *key_impl,
+    const struct aws_byte_cursor *public_key_x,
+    const struct aws_byte_cursor *public_key_y) {
+    if (aws_ecc_key_pair_write_coordinate(&key_impl->key_pair.pub_x, *public_key_x) ||
+        aws_ecc_key_pair_write_coordinate(&key_impl->key_pair.pub_y, *public_key_y)) {
+        return AWS_OP_ERR;
     }
 
-    const EC_POINT *pub_key_point = EC_KEY_get0_public_key(key_impl->ec_key);
+    int ret_val = AWS_OP_ERR;
+    BIGNUM *pub_x_num = BN_bin2bn(public_key_x->ptr, public_key_x->len, NULL);
+    BIGNUM *pub_y_num = BN_bin2bn(public_key_y->ptr, public_key_y->len, NULL);
+
     const EC_GROUP *group = EC_KEY_get0_group(key_impl->ec_key);
+    EC_POINT *point = EC_POINT_new(group);
 
-    const BIGNUM *private_key_num = EC_KEY_get0_private_key(key_impl->ec_key);
-    size_t priv_key_size = BN_num_bytes(private_key_num);
-    if (aws_byte_buf_init(&key_impl->key_pair.priv_d, allocator, priv_key_size)) {
-        goto error;
+    if (!pub_x_num || !pub_y_num || !point ||
+        EC_POINT_set_affine_coordinates_GFp(group, point, pub_x_num, pub_y_num, NULL) != 1 ||
+        EC_KEY_set_public_key(key_impl->ec_key, point) != 1) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        goto clean_up;
     }
 
-    BN_bn2bin(private_key_num, key_impl->key_pair.priv_d.buffer);
-    key_impl->key_pair.priv_d.len = priv_key_size;
+    ret_val = AWS_OP_SUCCESS;
 
-    if (!s_fill_in_public_key_info(key_impl, group, pub_key_point)) {
-        return &key_impl->key_pair;
-    }
+clean_up:
+    EC_POINT_free(point);
+    BN_free(pub_x_num);
+    BN_free(pub_y_num);
 
-error:
-    s_key_pair_destroy(&key_impl->key_pair);
-    return NULL;
+    return ret_val;
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key_impl(
     struct aws_allocator *allocator,
     enum aws_ecc_curve_name curve_name,
-    const struct aws_byte_cursor *public_key_x,
-    const struct aws_byte_cursor *public_key_y) {
-    struct libcrypto_ecc_key *key_impl = aws_mem_calloc(allocator, 1, sizeof(struct libcrypto_ecc_key));
-    BIGNUM *pub_x_num = NULL;
-    BIGNUM *pub_y_num = NULL;
-    EC_POINT *point = NULL;
+    const struct aws_byte_cursor *priv_key) {
 
-    if (!key_impl) {
+    size_t key_length = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+    if (priv_key->len != key_length) {
+        aws_raise_error(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM);
         return NULL;
     }
 
-    key_impl->ec_key = EC_KEY_new_by_curve_name(s_curve_name_to_nid(curve_name));
-    key_impl->key_pair.curve_name = curve_name;
-    key_impl->key_pair.allocator = allocator;
-    key_impl->key_pair.vtable = &vtable;
-    key_impl->key_pair.impl = key_impl;
-    aws_atomic_init_int(&key_impl->key_pair.ref_count, 1);
-
-    if (aws_byte_buf_init_copy_from_cursor(&key_impl->key_pair.pub_x, allocator, *public_key_x)) {
-        s_key_pair_destroy(&key_impl->key_pair);
+    struct libcrypto_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+    if (!key_impl) {
         return NULL;
     }
 
-    if (aws_byte_buf_init_copy_from_cursor(&key_impl->key_pair.pub_y, allocator, *public_key_y)) {
+    if (s_set_private_key(key_impl, priv_key)) {
         s_key_pair_destroy(&key_impl->key_pair);
         return NULL;
     }
 
-    pub_x_num = BN_bin2bn(public_key_x->ptr, public_key_x->len, NULL);
-    pub_y_num = BN_bin2bn(public_key_y->ptr, public_key_y->len, NULL);
-
-    const EC_GROUP *group = EC_KEY_get0_group(key_impl->ec_key);
-    point = EC_POINT_new(group);
+    return &key_impl->key_pair;
+}
 
-    if (EC_POINT_set_affine_coordinates_GFp(group, point, pub_x_num, pub_y_num, NULL) != 1) {
-        goto error;
+static struct aws_ecc_key_pair *s_generate_random(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    bool defer_public_key) {
+    struct libcrypto_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+    if (!key_impl) {
+        return NULL;
     }
 
-    if (EC_KEY_set_public_key(key_impl->ec_key, point) != 1) {
+    if (EC_KEY_generate_key(key_impl->ec_key) != 1) {
         goto error;
     }
 
-    EC_POINT_free(point);
-    BN_free(pub_x_num);
-    BN_free(pub_y_num);
+    /* keys with leading zero bytes are still exported at full size, other providers import nothing shorter */
+    s_write_coordinate(&key_impl->key_pair.priv_d, EC_KEY_get0_private_key(key_impl->ec_key));
 
-    return &key_impl->key_pair;
+    /* EC_KEY_generate_key() computed the point already, what can wait is its conversion to coordinates */
+    key_impl->public_key_deferred = defer_public_key;
+    if (defer_public_key || !s_derive_public_key(&key_impl->key_pair)) {
+        return &key_impl->key_pair;
+    }
 
 error:
-    if (point) {
-        EC_POINT_free(point);
-    }
+    s_key_pair_destroy(&key_impl->key_pair);
+    return NULL;
+}
 
-    if (pub_x_num) {
-        BN_free(pub_x_num);
-    }
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name) {
+    return s_generate_random(allocator, curve_name, false);
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_deferred_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name) {
+    return s_generate_random(allocator, curve_name, true);
+}
 
-    if (pub_y_num) {
-        BN_free(pub_y_num);
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const struct aws_byte_cursor *public_key_x,
+    const struct aws_byte_cursor *public_key_y) {
+    struct libcrypto_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+    if (!key_impl) {
+        return NULL;
     }
 
-    s_key_pair_destroy(&key_impl->key_pair);
+    if (s_set_public_key(key_impl, public_key_x, public_key_y)) {
+        s_key_pair_destroy(&key_impl->key_pair);
+        return NULL;
+    }
 
-    return NULL;
+    return &key_impl->key_pair;
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1_impl(
     struct aws_allocator *allocator,
     const struct aws_byte_cursor *encoded_keys) {
 
@@ -315,48 +644,27 @@ struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1(
     }
 
     if (priv_d.ptr) {
-        struct libcrypto_ecc_key *key_impl = aws_mem_calloc(allocator, 1, sizeof(struct libcrypto_ecc_key));
-        key_impl->key_pair.curve_name = curve_name;
-        /* as awkward as it seems, there's not a great way to manually set the public key, so let openssl just parse
-         * the der document manually now that we know what parts are what. */
-        if (!d2i_ECPrivateKey(&key_impl->ec_key, (const unsigned char **)&encoded_keys->ptr, encoded_keys->len)) {
-            aws_mem_release(allocator, key_impl);
-            aws_raise_error(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT);
+        /* build the key from the decoded components so it gets the shared curve group, d2i_ECPrivateKey() would
+         * construct a new one from the encoded parameters. */
+        struct libcrypto_ecc_key *key_impl = s_key_impl_new(allocator, curve_name);
+        if (!key_impl) {
             goto error;
         }
-
-        key_impl->key_pair.allocator = allocator;
-        key_impl->key_pair.vtable = &vtable;
-        key_impl->key_pair.impl = key_impl;
-        aws_atomic_init_int(&key_impl->key_pair.ref_count, 1);
         key = &key_impl->key_pair;
 
-        struct aws_byte_buf temp_buf;
-        AWS_ZERO_STRUCT(temp_buf);
-
-        if (pub_x.ptr) {
-            temp_buf = aws_byte_buf_from_array(pub_x.ptr, pub_x.len);
-            if (aws_byte_buf_init_copy(&key->pub_x, allocator, &temp_buf)) {
-                goto error;
-            }
-        }
-
-        if (pub_y.ptr) {
-            temp_buf = aws_byte_buf_from_array(pub_y.ptr, pub_y.len);
-            if (aws_byte_buf_init_copy(&key->pub_y, allocator, &temp_buf)) {
-                goto error;
-            }
+        if (s_set_private_key(key_impl, &priv_d)) {
+            goto error;
         }
 
-        if (priv_d.ptr) {
-            temp_buf = aws_byte_buf_from_array(priv_d.ptr, priv_d.len);
-            if (aws_byte_buf_init_copy(&key->priv_d, allocator, &temp_buf)) {
+        if (pub_x.ptr) {
+            if (s_set_public_key(key_impl, &pub_x, &pub_y)) {
                 goto error;
             }
+        } else if (s_derive_public_key(key)) {
+            goto error;
         }
-
     } else {
-        key = aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &pub_x, &pub_y);
+        key = aws_ecc_key_pair_new_from_public_key_impl(allocator, curve_name, &pub_x, &pub_y);
 
         if (!key) {
             goto error;
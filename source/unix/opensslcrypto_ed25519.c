@@ -0,0 +1,166 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/private/ed25519.h>
+
+#include <aws/cal/cal.h>
+#include <aws/cal/private/ed25519_native.h>
+
+#include <openssl/evp.h>
+
+/* EVP_PKEY_ED25519 and the raw key functions arrived in OpenSSL 1.1.1; older libcrypto has no platform provider */
+#ifdef EVP_PKEY_ED25519
+
+struct libcrypto_ed25519_key {
+    struct aws_ed25519_key_pair key_pair;
+    /* read only once built, so every thread signs and verifies with it through its own EVP_MD_CTX */
+    EVP_PKEY *pkey;
+};
+
+static void s_key_pair_destroy(struct aws_ed25519_key_pair *key_pair) {
+    struct libcrypto_ed25519_key *key_impl = key_pair->impl;
+    EVP_PKEY_free(key_impl->pkey);
+    aws_mem_release(key_pair->allocator, key_impl);
+}
+
+static int s_sign_message(
+    const struct aws_ed25519_key_pair *key_pair,
+    struct aws_byte_cursor message,
+    struct aws_byte_buf *signature) {
+    struct libcrypto_ed25519_key *key_impl = key_pair->impl;
+
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (!ctx) {
+        return aws_raise_error(AWS_ERROR_OOM);
+    }
+
+    int ret_val = AWS_OP_ERR;
+    size_t signature_len = AWS_ED25519_SIGNATURE_LEN;
+    if (EVP_DigestSignInit(ctx, NULL, NULL, NULL, key_impl->pkey) != 1 ||
+        EVP_DigestSign(ctx, signature->buffer + signature->len, &signature_len, message.ptr, message.len) != 1) {
+        aws_raise_error(AWS_ERROR_INVALID_STATE);
+        goto done;
+    }
+
+    signature->len += signature_len;
+    ret_val = AWS_OP_SUCCESS;
+
+done:
+    EVP_MD_CTX_free(ctx);
+    return ret_val;
+}
+
+static int s_verify_signature(
+    const struct aws_ed25519_key_pair *key_pair,
+    struct aws_byte_cursor message,
+    struct aws_byte_cursor signature) {
+    struct libcrypto_ed25519_key *key_impl = key_pair->impl;
+
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (!ctx) {
+        return aws_raise_error(AWS_ERROR_OOM);
+    }
+
+    int ret_val = aws_raise_error(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED);
+    if (EVP_DigestVerifyInit(ctx, NULL, NULL, NULL, key_impl->pkey) == 1 &&
+        EVP_DigestVerify(ctx, signature.ptr, signature.len, message.ptr, message.len) == 1) {
+        ret_val = AWS_OP_SUCCESS;
+    }
+
+    EVP_MD_CTX_free(ctx);
+    return ret_val;
+}
+
+static struct aws_ed25519_key_pair_vtable s_key_pair_vtable = {
+    .destroy = s_key_pair_destroy,
+    .sign_message = s_sign_message,
+    .verify_signature = s_verify_signature,
+};
+
+static struct libcrypto_ed25519_key *s_key_impl_new(struct aws_allocator *allocator) {
+    struct libcrypto_ed25519_key *key_impl = aws_mem_calloc(allocator, 1, sizeof(struct libcrypto_ed25519_key));
+    if (!key_impl) {
+        return NULL;
+    }
+
+    aws_ed25519_key_pair_init(&key_impl->key_pair, allocator, &s_key_pair_vtable, key_impl);
+    return key_impl;
+}
+
+bool aws_ed25519_platform_is_supported(void) {
+    return true;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_private_key_impl(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor private_key) {
+    struct libcrypto_ed25519_key *key_impl = s_key_impl_new(allocator);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    size_t public_key_len = AWS_ED25519_PUBLIC_KEY_LEN;
+    key_impl->pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, private_key.ptr, private_key.len);
+    if (!key_impl->pkey ||
+        EVP_PKEY_get_raw_public_key(key_impl->pkey, key_impl->key_pair.public_key, &public_key_len) != 1) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        s_key_pair_destroy(&key_impl->key_pair);
+        return NULL;
+    }
+
+    memcpy(key_impl->key_pair.private_key, private_key.ptr, AWS_ED25519_PRIVATE_KEY_LEN);
+    key_impl->key_pair.has_private_key = true;
+    return &key_impl->key_pair;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_public_key_impl(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor public_key) {
+    /* libcrypto takes any 32 bytes and only fails once it verifies, so check the point is on the curve here */
+    struct aws_ed25519_native_key decoded;
+    if (aws_ed25519_native_key_set_public_key(&decoded, public_key)) {
+        return NULL;
+    }
+
+    struct libcrypto_ed25519_key *key_impl = s_key_impl_new(allocator);
+    if (!key_impl) {
+        return NULL;
+    }
+
+    key_impl->pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, NULL, public_key.ptr, public_key.len);
+    if (!key_impl->pkey) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        s_key_pair_destroy(&key_impl->key_pair);
+        return NULL;
+    }
+
+    memcpy(key_impl->key_pair.public_key, public_key.ptr, AWS_ED25519_PUBLIC_KEY_LEN);
+    return &key_impl->key_pair;
+}
+
+#else
+
+bool aws_ed25519_platform_is_supported(void) {
+    return false;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_private_key_impl(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor private_key) {
+    (void)allocator;
+    (void)private_key;
+    aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    return NULL;
+}
+
+struct aws_ed25519_key_pair *aws_ed25519_key_pair_new_from_public_key_impl(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor public_key) {
+    (void)allocator;
+    (void)public_key;
+    aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+    return NULL;
+}
+
+#endif /* EVP_PKEY_ED25519 */
@@ -61,7 +61,7 @@ struct aws_hash *aws_md5_default_new(struct aws_allocator *allocator) {
         return NULL;
     }
 
-    if (!g_aws_openssl_evp_md_ctx_table->init_ex_fn(ctx, EVP_md5(), NULL)) {
+    if (!g_aws_openssl_evp_md_ctx_table->init_ex_fn(ctx, g_aws_openssl_evp_md_ctx_table->md5, NULL)) {
         s_destroy(hash);
         aws_raise_error(AWS_ERROR_UNKNOWN);
         return NULL;
@@ -90,7 +90,7 @@ struct aws_hash *aws_sha256_default_new(struct aws_allocator *allocator) {
         return NULL;
     }
 
-    if (!g_aws_openssl_evp_md_ctx_table->init_ex_fn(ctx, EVP_sha256(), NULL)) {
+    if (!g_aws_openssl_evp_md_ctx_table->init_ex_fn(ctx, g_aws_openssl_evp_md_ctx_table->sha256, NULL)) {
         s_destroy(hash);
         aws_raise_error(AWS_ERROR_UNKNOWN);
         return NULL;
@@ -2,8 +2,10 @@
  * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
  * SPDX-License-Identifier: Apache-2.0.
  */
+#include <aws/cal/cal.h>
 #include <aws/cal/hmac.h>
 #include <aws/cal/private/opensslcrypto_common.h>
+#include <aws/cal/private/opensslcrypto_hmac.h>
 
 #include <openssl/evp.h>
 #include <openssl/hmac.h>
@@ -33,21 +35,9 @@ static void s_destroy(struct aws_hmac *hmac) {
     aws_mem_release(hmac->allocator, hmac);
 }
 
-/*
-typedef struct hmac_ctx_st {
-    const EVP_MD *md;
-    EVP_MD_CTX md_ctx;
-    EVP_MD_CTX i_ctx;
-    EVP_MD_CTX o_ctx;
-    unsigned int key_length;
-    unsigned char key[HMAC_MAX_MD_CBLOCK];
-} HMAC_CTX;
-
-*/
-
-#define SIZEOF_OPENSSL_HMAC_CTX 300 /* <= 288 on 64 bit systems with openssl 1.0.* */
-
-struct aws_hmac *aws_sha256_hmac_default_new(struct aws_allocator *allocator, const struct aws_byte_cursor *secret) {
+struct aws_hmac *aws_sha256_hmac_libcrypto_legacy_new(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *secret) {
     AWS_ASSERT(secret->ptr);
 
     struct aws_hmac *hmac = aws_mem_acquire(allocator, sizeof(struct aws_hmac));
@@ -68,12 +58,16 @@ struct aws_hmac *aws_sha256_hmac_default_new(struct aws_allocator *allocator, co
         return NULL;
     }
 
-    g_aws_openssl_hmac_ctx_table->init_fn(ctx);
+    /* only present, and only needed, before OpenSSL 1.1 */
+    if (g_aws_openssl_hmac_ctx_table->init_fn) {
+        g_aws_openssl_hmac_ctx_table->init_fn(ctx);
+    }
 
     hmac->impl = ctx;
     hmac->good = true;
 
-    if (!g_aws_openssl_hmac_ctx_table->init_ex_fn(ctx, secret->ptr, (int)secret->len, EVP_sha256(), NULL)) {
+    if (!g_aws_openssl_hmac_ctx_table->init_ex_fn(
+            ctx, secret->ptr, (int)secret->len, g_aws_openssl_evp_md_ctx_table->sha256, NULL)) {
         s_destroy(hmac);
         aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
         return NULL;
@@ -120,3 +114,124 @@ static int s_finalize(struct aws_hmac *hmac, struct aws_byte_buf *output) {
     hmac->good = false;
     return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
 }
+
+/*
+ * OpenSSL 3 EVP_MAC backend. Each instance is a duplicate of the template context created at init, which already
+ * holds the fetched HMAC implementation and the SHA256 digest, so creating one involves no algorithm lookup.
+ */
+static void s_evp_mac_destroy(struct aws_hmac *hmac);
+static int s_evp_mac_update(struct aws_hmac *hmac, const struct aws_byte_cursor *to_hmac);
+static int s_evp_mac_finalize(struct aws_hmac *hmac, struct aws_byte_buf *output);
+
+static struct aws_hmac_vtable s_sha256_hmac_evp_mac_vtable = {
+    .destroy = s_evp_mac_destroy,
+    .update = s_evp_mac_update,
+    .finalize = s_evp_mac_finalize,
+    .alg_name = "SHA256 HMAC",
+    .provider = "OpenSSL 3 EVP_MAC",
+};
+
+static void s_evp_mac_destroy(struct aws_hmac *hmac) {
+    if (hmac == NULL) {
+        return;
+    }
+
+    struct evp_mac_ctx_st *ctx = hmac->impl;
+    if (ctx != NULL) {
+        g_aws_openssl_evp_mac_table->ctx_free_fn(ctx);
+    }
+
+    aws_mem_release(hmac->allocator, hmac);
+}
+
+struct aws_hmac *aws_sha256_hmac_libcrypto_evp_mac_new(
+    struct aws_allocator *allocator,
+    const struct aws_byte_cursor *secret) {
+    AWS_ASSERT(secret->ptr);
+
+    if (!g_aws_openssl_evp_mac_table) {
+        aws_raise_error(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM);
+        return NULL;
+    }
+
+    struct aws_hmac *hmac = aws_mem_acquire(allocator, sizeof(struct aws_hmac));
+
+    if (!hmac) {
+        return NULL;
+    }
+
+    hmac->allocator = allocator;
+    hmac->vtable = &s_sha256_hmac_evp_mac_vtable;
+    hmac->digest_size = AWS_SHA256_HMAC_LEN;
+
+    struct evp_mac_ctx_st *ctx =
+        g_aws_openssl_evp_mac_table->ctx_dup_fn(g_aws_openssl_evp_mac_table->sha256_hmac_template);
+
+    if (!ctx) {
+        aws_raise_error(AWS_ERROR_OOM);
+        aws_mem_release(allocator, hmac);
+        return NULL;
+    }
+
+    hmac->impl = ctx;
+    hmac->good = true;
+
+    /* a NULL key means "keep the previous key" to EVP_MAC_init, so an empty secret still needs a valid pointer */
+    static const unsigned char s_empty_key[1] = {0};
+    const unsigned char *key = secret->len ? secret->ptr : s_empty_key;
+
+    if (!g_aws_openssl_evp_mac_table->init_fn(ctx, key, secret->len, NULL)) {
+        s_evp_mac_destroy(hmac);
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    return hmac;
+}
+
+static int s_evp_mac_update(struct aws_hmac *hmac, const struct aws_byte_cursor *to_hmac) {
+    if (!hmac->good) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    struct evp_mac_ctx_st *ctx = hmac->impl;
+
+    if (AWS_LIKELY(g_aws_openssl_evp_mac_table->update_fn(ctx, to_hmac->ptr, to_hmac->len))) {
+        return AWS_OP_SUCCESS;
+    }
+
+    hmac->good = false;
+    return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+}
+
+static int s_evp_mac_finalize(struct aws_hmac *hmac, struct aws_byte_buf *output) {
+    if (!hmac->good) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    struct evp_mac_ctx_st *ctx = hmac->impl;
+
+    size_t buffer_len = output->capacity - output->len;
+
+    if (buffer_len < hmac->digest_size) {
+        return aws_raise_error(AWS_ERROR_SHORT_BUFFER);
+    }
+
+    size_t written = 0;
+    if (AWS_LIKELY(g_aws_openssl_evp_mac_table->final_fn(ctx, output->buffer + output->len, &written, buffer_len))) {
+        hmac->good = false;
+        output->len += written;
+        return AWS_OP_SUCCESS;
+    }
+
+    hmac->good = false;
+    return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+}
+
+struct aws_hmac *aws_sha256_hmac_default_new(struct aws_allocator *allocator, const struct aws_byte_cursor *secret) {
+    if (g_aws_openssl_evp_mac_table) {
+        return aws_sha256_hmac_libcrypto_evp_mac_new(allocator, secret);
+    }
+
+    return aws_sha256_hmac_libcrypto_legacy_new(allocator, secret);
+}
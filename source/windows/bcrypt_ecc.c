@@ -275,11 +275,7 @@ static struct aws_ecc_key_pair *s_alloc_pair_and_init_buffers(
         return NULL;
     }
 
-    key_impl->key_pair.allocator = allocator;
-    key_impl->key_pair.curve_name = curve_name;
-    key_impl->key_pair.impl = key_impl;
-    key_impl->key_pair.vtable = &s_vtable;
-    aws_atomic_init_int(&key_impl->key_pair.ref_count, 1);
+    aws_ecc_key_pair_init(&key_impl->key_pair, allocator, curve_name, &s_vtable, key_impl);
 
     size_t s_key_coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
 
@@ -356,7 +352,7 @@ error:
     return NULL;
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key_impl(
     struct aws_allocator *allocator,
     enum aws_ecc_curve_name curve_name,
     const struct aws_byte_cursor *priv_key) {
@@ -366,7 +362,7 @@ struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_private_key(
     return s_alloc_pair_and_init_buffers(allocator, curve_name, empty, empty, *priv_key);
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key_impl(
     struct aws_allocator *allocator,
     enum aws_ecc_curve_name curve_name,
     const struct aws_byte_cursor *public_key_x,
@@ -377,7 +373,7 @@ struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_public_key(
     return s_alloc_pair_and_init_buffers(allocator, curve_name, *public_key_x, *public_key_y, empty);
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_impl(
     struct aws_allocator *allocator,
     enum aws_ecc_curve_name curve_name) {
     aws_thread_call_once(&s_ecdsa_thread_once, s_load_alg_handle, NULL);
@@ -388,11 +384,7 @@ struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random(
         return NULL;
     }
 
-    key_impl->key_pair.allocator = allocator;
-    key_impl->key_pair.curve_name = curve_name;
-    key_impl->key_pair.impl = key_impl;
-    key_impl->key_pair.vtable = &s_vtable;
-    aws_atomic_init_int(&key_impl->key_pair.ref_count, 1);
+    aws_ecc_key_pair_init(&key_impl->key_pair, allocator, curve_name, &s_vtable, key_impl);
 
     size_t key_coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
 
@@ -446,7 +438,14 @@ error:
     return NULL;
 }
 
-struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1(
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_generate_random_deferred_impl(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name) {
+    /* the public key is exported together with the private key, nothing to defer */
+    return aws_ecc_key_pair_new_generate_random_impl(allocator, curve_name);
+}
+
+struct aws_ecc_key_pair *aws_ecc_key_pair_new_from_asn1_impl(
     struct aws_allocator *allocator,
     const struct aws_byte_cursor *encoded_keys) {
     struct aws_der_decoder *decoder = aws_der_decoder_new(allocator, *encoded_keys);
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <aws/cal/cal.h>
 #include <aws/cal/private/der.h>
 
 #include <aws/testing/aws_test_harness.h>
@@ -505,3 +506,117 @@ static int s_der_decode_key_pair(struct aws_allocator *allocator, void *ctx) {
 }
 
 AWS_TEST_CASE(der_decode_key_pair, s_der_decode_key_pair)
+
+/* RFC 6979 A.2.5, P-256 and SHA-256 of "sample" */
+static uint8_t s_ecdsa_der_signature[] = {
+    0x30, 0x46, 0x02, 0x21, 0x00, 0xef, 0xd4, 0x8b, 0x2a, 0xac, 0xb6, 0xa8, 0xfd, 0x11, 0x40, 0xdd, 0x9c, 0xd4,
+    0x5e, 0x81, 0xd6, 0x9d, 0x2c, 0x87, 0x7b, 0x56, 0xaa, 0xf9, 0x91, 0xc3, 0x4d, 0x0e, 0xa8, 0x4e, 0xaf, 0x37,
+    0x16, 0x02, 0x21, 0x00, 0xf7, 0xcb, 0x1c, 0x94, 0x2d, 0x65, 0x7c, 0x41, 0xd4, 0x36, 0xc7, 0xa1, 0xb6, 0xe2,
+    0x9f, 0x65, 0xf3, 0xe9, 0x00, 0xdb, 0xb9, 0xaf, 0xf4, 0x06, 0x4d, 0xc4, 0xab, 0x2f, 0x84, 0x3a, 0xcd, 0xa8,
+};
+
+static int s_der_ecdsa_signature_conversion(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    /* the same signature, and r = 1, s = 0x80, which need padding one way and a sign byte the other */
+    uint8_t raw_small[64] = {0};
+    raw_small[31] = 0x01;
+    raw_small[63] = 0x80;
+    uint8_t der_small[] = {0x30, 0x07, 0x02, 0x01, 0x01, 0x02, 0x02, 0x00, 0x80};
+
+    struct aws_byte_cursor der_inputs[] = {
+        aws_byte_cursor_from_array(s_ecdsa_der_signature, sizeof(s_ecdsa_der_signature)),
+        aws_byte_cursor_from_array(der_small, sizeof(der_small)),
+    };
+
+    uint8_t raw_storage[AWS_ARRAY_SIZE(der_inputs)][64];
+    struct aws_byte_buf raw[AWS_ARRAY_SIZE(der_inputs)];
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(der_inputs); ++i) {
+        raw[i] = aws_byte_buf_from_empty_array(raw_storage[i], sizeof(raw_storage[i]));
+    }
+
+    ASSERT_SUCCESS(aws_der_ecdsa_signatures_to_raw(der_inputs, AWS_ARRAY_SIZE(der_inputs), 32, raw));
+    ASSERT_BIN_ARRAYS_EQUALS(s_ecdsa_der_signature + 5, 32, raw[0].buffer, 32);
+    ASSERT_BIN_ARRAYS_EQUALS(s_ecdsa_der_signature + 40, 32, raw[0].buffer + 32, 32);
+    ASSERT_BIN_ARRAYS_EQUALS(raw_small, sizeof(raw_small), raw[1].buffer, raw[1].len);
+
+    struct aws_byte_cursor raw_inputs[AWS_ARRAY_SIZE(der_inputs)];
+    uint8_t der_storage[AWS_ARRAY_SIZE(der_inputs)][72];
+    struct aws_byte_buf der[AWS_ARRAY_SIZE(der_inputs)];
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(der_inputs); ++i) {
+        raw_inputs[i] = aws_byte_cursor_from_buf(&raw[i]);
+        der[i] = aws_byte_buf_from_empty_array(der_storage[i], sizeof(der_storage[i]));
+    }
+
+    ASSERT_UINT_EQUALS(72, aws_der_ecdsa_signature_max_length(32));
+    ASSERT_SUCCESS(aws_der_ecdsa_signatures_from_raw(raw_inputs, AWS_ARRAY_SIZE(raw_inputs), 32, der));
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(der_inputs); ++i) {
+        ASSERT_BIN_ARRAYS_EQUALS(der_inputs[i].ptr, der_inputs[i].len, der[i].buffer, der[i].len);
+    }
+
+    /* outputs are checked before anything is converted */
+    raw[0].len = 0;
+    raw[1].len = 1;
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_der_ecdsa_signatures_to_raw(der_inputs, 2, 32, raw));
+    ASSERT_UINT_EQUALS(0, raw[0].len);
+
+    der[0].len = 0;
+    der[1].len = 1;
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_der_ecdsa_signatures_from_raw(raw_inputs, 2, 32, der));
+    ASSERT_UINT_EQUALS(0, der[0].len);
+
+    der[1].len = 0;
+    raw_inputs[1].len = 63;
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_der_ecdsa_signatures_from_raw(raw_inputs, 2, 32, der));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_der_ecdsa_signatures_to_raw(der_inputs, 1, 0, raw));
+
+    /* values too big for the curve */
+    raw[0].len = 0;
+    ASSERT_ERROR(AWS_ERROR_CAL_MALFORMED_ASN1_ENCOUNTERED, aws_der_ecdsa_signatures_to_raw(der_inputs, 1, 31, raw));
+
+    /* strict DER only: a redundant leading zero, a negative value, trailing data and a long form short length */
+    uint8_t redundant_zero[] = {0x30, 0x07, 0x02, 0x02, 0x00, 0x01, 0x02, 0x01, 0x02};
+    uint8_t negative[] = {0x30, 0x06, 0x02, 0x01, 0x81, 0x02, 0x01, 0x01};
+    uint8_t trailing[] = {0x30, 0x06, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01, 0x00};
+    uint8_t long_form[] = {0x30, 0x81, 0x06, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01};
+    struct aws_byte_cursor malformed[] = {
+        aws_byte_cursor_from_array(redundant_zero, sizeof(redundant_zero)),
+        aws_byte_cursor_from_array(negative, sizeof(negative)),
+        aws_byte_cursor_from_array(trailing, sizeof(trailing)),
+        aws_byte_cursor_from_array(long_form, sizeof(long_form)),
+        aws_byte_cursor_from_array(s_ecdsa_der_signature, sizeof(s_ecdsa_der_signature) - 1),
+    };
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(malformed); ++i) {
+        struct aws_byte_cursor r;
+        struct aws_byte_cursor s;
+        ASSERT_ERROR(AWS_ERROR_CAL_MALFORMED_ASN1_ENCOUNTERED, aws_der_ecdsa_signature_parse(malformed[i], &r, &s));
+        raw[0].len = 0;
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_MALFORMED_ASN1_ENCOUNTERED, aws_der_ecdsa_signatures_to_raw(&malformed[i], 1, 32, raw));
+    }
+
+    /* scalars as large as P-521's need the long form SEQUENCE length */
+    uint8_t raw_large[2 * AWS_DER_ECDSA_MAX_ELEMENT_SIZE];
+    memset(raw_large, 0xff, sizeof(raw_large));
+    struct aws_byte_cursor raw_large_cur = aws_byte_cursor_from_array(raw_large, sizeof(raw_large));
+    uint8_t der_large[3 + 2 * (3 + AWS_DER_ECDSA_MAX_ELEMENT_SIZE)];
+    struct aws_byte_buf der_large_buf = aws_byte_buf_from_empty_array(der_large, sizeof(der_large));
+    ASSERT_UINT_EQUALS(sizeof(der_large), aws_der_ecdsa_signature_max_length(AWS_DER_ECDSA_MAX_ELEMENT_SIZE));
+    ASSERT_SUCCESS(
+        aws_der_ecdsa_signatures_from_raw(&raw_large_cur, 1, AWS_DER_ECDSA_MAX_ELEMENT_SIZE, &der_large_buf));
+    ASSERT_UINT_EQUALS(sizeof(der_large), der_large_buf.len);
+    ASSERT_UINT_EQUALS(0x81, der_large[1]);
+
+    uint8_t raw_back[sizeof(raw_large)];
+    struct aws_byte_buf raw_back_buf = aws_byte_buf_from_empty_array(raw_back, sizeof(raw_back));
+    struct aws_byte_cursor der_large_cur = aws_byte_cursor_from_buf(&der_large_buf);
+    ASSERT_SUCCESS(
+        aws_der_ecdsa_signatures_to_raw(&der_large_cur, 1, AWS_DER_ECDSA_MAX_ELEMENT_SIZE, &raw_back_buf));
+    ASSERT_BIN_ARRAYS_EQUALS(raw_large, sizeof(raw_large), raw_back_buf.buffer, raw_back_buf.len);
+
+    return 0;
+}
+
+AWS_TEST_CASE(der_ecdsa_signature_conversion, s_der_ecdsa_signature_conversion)
@@ -5,9 +5,13 @@
 #include <aws/cal/cal.h>
 #include <aws/cal/ecc.h>
 #include <aws/cal/hash.h>
+#include <aws/cal/private/ec_native.h>
+#include <aws/cal/private/ecc.h>
 #include <aws/common/byte_buf.h>
 #include <aws/common/encoding.h>
+#include <aws/common/math.h>
 #include <aws/common/string.h>
+#include <aws/common/thread.h>
 #include <aws/testing/aws_test_harness.h>
 
 static int s_test_key_derivation(
@@ -832,6 +836,62 @@ static int s_ecc_key_pair_private_ref_count_test(struct aws_allocator *allocator
 
 AWS_TEST_CASE(ecc_key_pair_private_ref_count_test, s_ecc_key_pair_private_ref_count_test)
 
+/* a provider the way an AWS_BYO_CRYPTO build would write one: its key struct comes from wherever it likes */
+struct s_custom_ecc_key_pair {
+    struct aws_ecc_key_pair key_pair;
+    bool destroyed;
+};
+
+static void s_custom_ecc_key_pair_destroy(struct aws_ecc_key_pair *key_pair) {
+    struct s_custom_ecc_key_pair *custom = key_pair->impl;
+    custom->destroyed = true;
+}
+
+static struct aws_ecc_key_pair_vtable s_custom_ecc_key_pair_vtable = {
+    .destroy = s_custom_ecc_key_pair_destroy,
+};
+
+static int s_ecc_key_pair_custom_provider_init_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    struct aws_ecc_key_pair *generated = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256);
+    ASSERT_NOT_NULL(generated);
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(generated, &pub_x, &pub_y);
+
+    /* not zeroed, like a provider's stack or pool allocated key struct */
+    struct s_custom_ecc_key_pair custom;
+    memset(&custom, 0xa5, sizeof(custom));
+    aws_ecc_key_pair_init(&custom.key_pair, allocator, AWS_CAL_ECDSA_P256, &s_custom_ecc_key_pair_vtable, &custom);
+    custom.destroyed = false;
+
+    ASSERT_PTR_EQUALS(allocator, custom.key_pair.allocator);
+    ASSERT_PTR_EQUALS(&custom, custom.key_pair.impl);
+    ASSERT_NULL(aws_atomic_load_ptr(&custom.key_pair.verification_table));
+
+    custom.key_pair.pub_x = aws_byte_buf_from_array(pub_x.ptr, pub_x.len);
+    custom.key_pair.pub_y = aws_byte_buf_from_array(pub_y.ptr, pub_y.len);
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(&custom.key_pair));
+    ASSERT_NOT_NULL(aws_atomic_load_ptr(&custom.key_pair.verification_table));
+
+    /* the last release hands the table back and then calls the provider's destroy */
+    aws_ecc_key_pair_acquire(&custom.key_pair);
+    aws_ecc_key_pair_release(&custom.key_pair);
+    ASSERT_FALSE(custom.destroyed);
+    aws_ecc_key_pair_release(&custom.key_pair);
+    ASSERT_TRUE(custom.destroyed);
+
+    aws_ecc_key_pair_release(generated);
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_key_pair_custom_provider_init, s_ecc_key_pair_custom_provider_init_fn)
+
 /*
  Message, signature, and key values for a correct signature that contains a coordinate that is < 32 bytes long in the
  der encoding.  This was an issue on windows where we have to unpack the coordinates and pass them to BCrypt and
@@ -911,3 +971,2386 @@ static int s_ecdsa_p256_test_small_coordinate_verification(struct aws_allocator
     return AWS_OP_SUCCESS;
 }
 AWS_TEST_CASE(ecdsa_p256_test_small_coordinate_verification, s_ecdsa_p256_test_small_coordinate_verification);
+
+static int s_ecc_key_pair_outlives_library_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    struct aws_ecc_key_pair *signing_key = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P384);
+    ASSERT_NOT_NULL(signing_key);
+
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(signing_key, &pub_x, &pub_y);
+
+    /* many keys on the same curve share the curve setup built at init */
+    struct aws_ecc_key_pair *verifying_keys[8];
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(verifying_keys); ++i) {
+        verifying_keys[i] = aws_ecc_key_pair_new_from_public_key(allocator, AWS_CAL_ECDSA_P384, &pub_x, &pub_y);
+        ASSERT_NOT_NULL(verifying_keys[i]);
+    }
+
+    aws_cal_library_clean_up();
+
+    /* keys created while the library was initialized stay usable after clean up */
+    uint8_t hash[AWS_SHA256_LEN];
+    memset(hash, 0xa5, sizeof(hash));
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_array(hash, sizeof(hash));
+
+    struct aws_byte_buf signature_buf;
+    ASSERT_SUCCESS(aws_byte_buf_init(&signature_buf, allocator, aws_ecc_key_pair_signature_length(signing_key)));
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(signing_key, &hash_cur, &signature_buf));
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(verifying_keys); ++i) {
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(verifying_keys[i], &hash_cur, &signature_cur));
+        aws_ecc_key_pair_release(verifying_keys[i]);
+    }
+
+    aws_byte_buf_clean_up(&signature_buf);
+    aws_ecc_key_pair_release(signing_key);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_key_pair_outlives_library, s_ecc_key_pair_outlives_library_fn)
+
+static int s_test_prepared_verification(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *signing_key = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(signing_key);
+
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(signing_key, &pub_x, &pub_y);
+
+    struct aws_ecc_key_pair *plain_key = aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &pub_x, &pub_y);
+    ASSERT_NOT_NULL(plain_key);
+    struct aws_ecc_key_pair *prepared_key = aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &pub_x, &pub_y);
+    ASSERT_NOT_NULL(prepared_key);
+
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(prepared_key));
+    /* preparing again is a no-op */
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(prepared_key));
+
+    struct aws_byte_buf signature_buf;
+    ASSERT_SUCCESS(aws_byte_buf_init(&signature_buf, allocator, aws_ecc_key_pair_signature_length(signing_key)));
+
+    /* digests shorter than, equal to and longer than the curve's order */
+    uint8_t hash[64];
+    size_t hash_lengths[] = {20, 32, 48, 64};
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(hash_lengths); ++i) {
+        memset(hash, (int)(0x11 * (i + 1)), sizeof(hash));
+        struct aws_byte_cursor hash_cur = aws_byte_cursor_from_array(hash, hash_lengths[i]);
+
+        signature_buf.len = 0;
+        ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(signing_key, &hash_cur, &signature_buf));
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(plain_key, &hash_cur, &signature_cur));
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(prepared_key, &hash_cur, &signature_cur));
+
+        /* wrong digest */
+        hash[0] ^= 0x01;
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(plain_key, &hash_cur, &signature_cur));
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(prepared_key, &hash_cur, &signature_cur));
+        hash[0] ^= 0x01;
+
+        /* wrong s */
+        signature_buf.buffer[signature_buf.len - 1] ^= 0x01;
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(plain_key, &hash_cur, &signature_cur));
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(prepared_key, &hash_cur, &signature_cur));
+        signature_buf.buffer[signature_buf.len - 1] ^= 0x01;
+
+        /* truncated DER */
+        struct aws_byte_cursor truncated = aws_byte_cursor_from_array(signature_buf.buffer, signature_buf.len - 1);
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(prepared_key, &hash_cur, &truncated));
+
+        /* trailing garbage after the SEQUENCE */
+        uint8_t padded[256];
+        memcpy(padded, signature_buf.buffer, signature_buf.len);
+        padded[signature_buf.len] = 0;
+        struct aws_byte_cursor padded_cur = aws_byte_cursor_from_array(padded, signature_buf.len + 1);
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(prepared_key, &hash_cur, &padded_cur));
+    }
+
+    aws_byte_buf_clean_up(&signature_buf);
+    aws_ecc_key_pair_release(prepared_key);
+    aws_ecc_key_pair_release(plain_key);
+    aws_ecc_key_pair_release(signing_key);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecdsa_test_prepared_verification_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    ASSERT_SUCCESS(s_test_prepared_verification(allocator, AWS_CAL_ECDSA_P256));
+    ASSERT_SUCCESS(s_test_prepared_verification(allocator, AWS_CAL_ECDSA_P384));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_test_prepared_verification, s_ecdsa_test_prepared_verification_fn)
+
+static int s_ecdsa_p256_test_small_coordinate_prepared_verification_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    struct aws_ecc_key_pair *key = aws_ecc_key_new_from_hex_coordinates(
+        allocator, AWS_CAL_ECDSA_P256, aws_byte_cursor_from_string(s_pub_x), aws_byte_cursor_from_string(s_pub_y));
+    ASSERT_NOT_NULL(key);
+
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(key));
+    ASSERT_SUCCESS(s_validate_message_signature(
+        allocator, key, aws_byte_cursor_from_string(s_hex_message), aws_byte_cursor_from_string(s_signature_value)));
+
+    aws_ecc_key_pair_release(key);
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(
+    ecdsa_p256_test_small_coordinate_prepared_verification,
+    s_ecdsa_p256_test_small_coordinate_prepared_verification_fn)
+
+typedef int(s_test_fn)(struct aws_allocator *allocator, void *ctx);
+
+/* The P-256 tests above, with key pairs from the native provider. */
+static int s_ecdsa_p256_native_provider_fn(struct aws_allocator *allocator, void *ctx) {
+    s_test_fn *tests[] = {
+        s_ecdsa_p256_test_pub_key_derivation_fn,
+        s_ecdsa_p256_test_known_signing_value_fn,
+        s_ecdsa_test_invalid_signature_fn,
+        s_ecdsa_p256_test_key_gen_fn,
+        s_ecdsa_p256_test_key_gen_export_fn,
+        s_ecdsa_p256_test_import_asn1_key_pair_fn,
+        s_ecdsa_test_import_asn1_key_pair_public_only_fn,
+        s_ecdsa_test_import_asn1_key_pair_invalid_fails_fn,
+        s_ecdsa_test_signature_format_fn,
+        s_ecc_key_pair_random_ref_count_test,
+        s_ecc_key_pair_public_ref_count_test,
+        s_ecc_key_pair_asn1_ref_count_test,
+        s_ecc_key_pair_private_ref_count_test,
+        s_ecdsa_p256_test_small_coordinate_verification,
+        s_ecdsa_p256_test_small_coordinate_prepared_verification_fn,
+    };
+
+    enum aws_ecc_provider default_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P256);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_NATIVE));
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(tests); ++i) {
+        ASSERT_SUCCESS(tests[i](allocator, ctx));
+    }
+
+    /* curves the native provider doesn't implement are rejected */
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM,
+        aws_ecc_set_provider((enum aws_ecc_curve_name)(AWS_CAL_ECDSA_P384 + 1), AWS_ECC_PROVIDER_NATIVE));
+    ASSERT_INT_EQUALS(AWS_ECC_PROVIDER_NATIVE, aws_ecc_get_provider(AWS_CAL_ECDSA_P256));
+
+    if (default_provider != AWS_ECC_PROVIDER_NATIVE) {
+        ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, default_provider));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_p256_native_provider, s_ecdsa_p256_native_provider_fn)
+
+/* The P-384 tests above, with key pairs from the native provider. */
+static int s_ecdsa_p384_native_provider_fn(struct aws_allocator *allocator, void *ctx) {
+    s_test_fn *tests[] = {
+        s_ecdsa_p384_test_pub_key_derivation_fn,
+        s_ecdsa_p384_test_known_signing_value_fn,
+        s_ecdsa_p384_test_key_gen_fn,
+        s_ecdsa_p384_test_key_gen_export_fn,
+        s_ecdsa_p384_test_import_asn1_key_pair_fn,
+        s_ecdsa_test_prepared_verification_fn,
+    };
+
+    enum aws_ecc_provider default_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P384);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P384, AWS_ECC_PROVIDER_NATIVE));
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(tests); ++i) {
+        ASSERT_SUCCESS(tests[i](allocator, ctx));
+    }
+
+    ASSERT_INT_EQUALS(AWS_ECC_PROVIDER_NATIVE, aws_ecc_get_provider(AWS_CAL_ECDSA_P384));
+
+    if (default_provider != AWS_ECC_PROVIDER_NATIVE) {
+        ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P384, default_provider));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_p384_native_provider, s_ecdsa_p384_native_provider_fn)
+
+/* The generator tables the engine uses, whether linked in from the build or built at runtime, are the real ones. */
+static int s_ec_native_generator_tables_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    enum aws_ecc_curve_name curves[] = {AWS_CAL_ECDSA_P256, AWS_CAL_ECDSA_P384};
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(curves); ++i) {
+        size_t length = aws_ec_native_generator_table_length(curves[i]);
+        ASSERT_TRUE(length > 0);
+
+        uint64_t *expected = aws_mem_calloc(allocator, length, sizeof(uint64_t));
+        ASSERT_NOT_NULL(expected);
+        ASSERT_SUCCESS(aws_ec_native_build_generator_table(curves[i], expected));
+
+        const struct aws_ec_native_table *table = aws_ec_native_generator_table(curves[i]);
+        ASSERT_NOT_NULL(table);
+        ASSERT_PTR_EQUALS(aws_ec_native_curve_get(curves[i]), table->curve);
+        ASSERT_UINT_EQUALS(length, table->windows * AWS_EC_NATIVE_WINDOW_ENTRIES * 2 * table->curve->limbs);
+        ASSERT_BIN_ARRAYS_EQUALS(expected, length * sizeof(uint64_t), table->points, length * sizeof(uint64_t));
+
+        aws_mem_release(allocator, expected);
+    }
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ec_native_generator_tables, s_ec_native_generator_tables_fn)
+
+static int s_ecdsa_p256_native_invalid_keys_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    enum aws_ecc_provider default_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P256);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_NATIVE));
+
+    /* the private scalar has to be in [1, n - 1] */
+    uint8_t zero[32];
+    AWS_ZERO_ARRAY(zero);
+    struct aws_byte_cursor private_key = aws_byte_cursor_from_array(zero, sizeof(zero));
+    ASSERT_NULL(aws_ecc_key_pair_new_from_private_key(allocator, AWS_CAL_ECDSA_P256, &private_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    uint8_t order[] = {
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51,
+    };
+    private_key = aws_byte_cursor_from_array(order, sizeof(order));
+    ASSERT_NULL(aws_ecc_key_pair_new_from_private_key(allocator, AWS_CAL_ECDSA_P256, &private_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    private_key = aws_byte_cursor_from_array(order, sizeof(order) - 1);
+    ASSERT_NULL(aws_ecc_key_pair_new_from_private_key(allocator, AWS_CAL_ECDSA_P256, &private_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM, aws_last_error());
+
+    /* n - 1 is the largest valid scalar */
+    order[31] -= 1;
+    private_key = aws_byte_cursor_from_array(order, sizeof(order));
+    struct aws_ecc_key_pair *key_pair =
+        aws_ecc_key_pair_new_from_private_key(allocator, AWS_CAL_ECDSA_P256, &private_key);
+    ASSERT_NOT_NULL(key_pair);
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_public_key(key_pair));
+    aws_ecc_key_pair_release(key_pair);
+
+    /* public points have to be on the curve */
+    key_pair = aws_ecc_key_new_from_hex_coordinates(
+        allocator, AWS_CAL_ECDSA_P256, aws_byte_cursor_from_string(s_pub_x), aws_byte_cursor_from_string(s_pub_x));
+    ASSERT_NULL(key_pair);
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    if (default_provider != AWS_ECC_PROVIDER_NATIVE) {
+        ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, default_provider));
+    }
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_p256_native_invalid_keys, s_ecdsa_p256_native_invalid_keys_fn)
+
+#ifndef AWS_BYO_CRYPTO
+/* Signs with one provider, verifies with the other, on the same key material. */
+static int s_test_provider_pair(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    enum aws_ecc_provider signer_provider,
+    enum aws_ecc_provider verifier_provider) {
+
+    ASSERT_SUCCESS(aws_ecc_set_provider(curve_name, signer_provider));
+    struct aws_ecc_key_pair *generated_key = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(generated_key);
+
+    struct aws_byte_cursor priv_d;
+    aws_ecc_key_pair_get_private_key(generated_key, &priv_d);
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(generated_key, &pub_x, &pub_y);
+
+    /* a key imported from the other provider's private key derives the same public key */
+    ASSERT_SUCCESS(aws_ecc_set_provider(curve_name, verifier_provider));
+    struct aws_ecc_key_pair *imported_key = aws_ecc_key_pair_new_from_private_key(allocator, curve_name, &priv_d);
+    ASSERT_NOT_NULL(imported_key);
+
+    if (!aws_ecc_key_pair_derive_public_key(imported_key)) {
+        struct aws_byte_cursor derived_x;
+        struct aws_byte_cursor derived_y;
+        aws_ecc_key_pair_get_public_key(imported_key, &derived_x, &derived_y);
+        ASSERT_BIN_ARRAYS_EQUALS(pub_x.ptr, pub_x.len, derived_x.ptr, derived_x.len);
+        ASSERT_BIN_ARRAYS_EQUALS(pub_y.ptr, pub_y.len, derived_y.ptr, derived_y.len);
+    }
+
+    struct aws_ecc_key_pair *verifying_key =
+        aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &pub_x, &pub_y);
+    ASSERT_NOT_NULL(verifying_key);
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_cursor message = aws_byte_cursor_from_c_str("ecc provider cross check");
+    struct aws_byte_buf hash_value = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    ASSERT_SUCCESS(aws_sha256_compute(allocator, &message, &hash_value, 0));
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_value);
+
+    struct aws_byte_buf signature_buf;
+    ASSERT_SUCCESS(aws_byte_buf_init(&signature_buf, allocator, aws_ecc_key_pair_signature_length(generated_key)));
+
+    for (size_t i = 0; i < 8; ++i) {
+        signature_buf.len = 0;
+        ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(generated_key, &hash_cur, &signature_buf));
+
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(verifying_key, &hash_cur, &signature_cur));
+
+        hash[i] ^= 0x01;
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(verifying_key, &hash_cur, &signature_cur));
+        hash[i] ^= 0x01;
+    }
+
+    aws_byte_buf_clean_up(&signature_buf);
+    aws_ecc_key_pair_release(verifying_key);
+    aws_ecc_key_pair_release(imported_key);
+    aws_ecc_key_pair_release(generated_key);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_native_platform_cross_check(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    aws_cal_library_init(allocator);
+
+    enum aws_ecc_provider default_provider = aws_ecc_get_provider(curve_name);
+
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_SUCCESS(s_test_provider_pair(allocator, curve_name, AWS_ECC_PROVIDER_NATIVE, AWS_ECC_PROVIDER_PLATFORM));
+        ASSERT_SUCCESS(s_test_provider_pair(allocator, curve_name, AWS_ECC_PROVIDER_PLATFORM, AWS_ECC_PROVIDER_NATIVE));
+    }
+
+    ASSERT_SUCCESS(aws_ecc_set_provider(curve_name, default_provider));
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecdsa_p256_native_platform_cross_check_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    return s_test_native_platform_cross_check(allocator, AWS_CAL_ECDSA_P256);
+}
+
+AWS_TEST_CASE(ecdsa_p256_native_platform_cross_check, s_ecdsa_p256_native_platform_cross_check_fn)
+
+static int s_ecdsa_p384_native_platform_cross_check_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+    return s_test_native_platform_cross_check(allocator, AWS_CAL_ECDSA_P384);
+}
+
+AWS_TEST_CASE(ecdsa_p384_native_platform_cross_check, s_ecdsa_p384_native_platform_cross_check_fn)
+#endif /* AWS_BYO_CRYPTO */
+
+#define VERIFY_BATCH_SIZE 370
+#define VERIFY_BATCH_KEYS 4
+
+static int s_ecdsa_verify_batch_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    /*
+     * key 0 has enough P-256 signatures and key 1 enough P-384 ones to get a table for the batch, key 2 brings its
+     * own table and key 3 is public only.
+     */
+    struct aws_ecc_key_pair *signers[VERIFY_BATCH_KEYS] = {
+        aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256),
+        aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P384),
+        aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256),
+        aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256),
+    };
+    struct aws_ecc_key_pair *verifiers[VERIFY_BATCH_KEYS];
+    for (size_t i = 0; i < VERIFY_BATCH_KEYS; ++i) {
+        ASSERT_NOT_NULL(signers[i]);
+        verifiers[i] = signers[i];
+    }
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(signers[2]));
+
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(signers[3], &pub_x, &pub_y);
+    verifiers[3] = aws_ecc_key_pair_new_from_public_key(allocator, AWS_CAL_ECDSA_P256, &pub_x, &pub_y);
+    ASSERT_NOT_NULL(verifiers[3]);
+
+    size_t max_signature_length = aws_ecc_key_pair_signature_length(signers[1]);
+    uint8_t *hashes = aws_mem_calloc(allocator, VERIFY_BATCH_SIZE, AWS_SHA256_LEN);
+    uint8_t *signature_storage = aws_mem_calloc(allocator, VERIFY_BATCH_SIZE, max_signature_length);
+    struct aws_ecc_key_pair **keys = aws_mem_calloc(allocator, VERIFY_BATCH_SIZE, sizeof(struct aws_ecc_key_pair *));
+    struct aws_byte_cursor *messages = aws_mem_calloc(allocator, VERIFY_BATCH_SIZE, sizeof(struct aws_byte_cursor));
+    struct aws_byte_cursor *signatures = aws_mem_calloc(allocator, VERIFY_BATCH_SIZE, sizeof(struct aws_byte_cursor));
+    int *results = aws_mem_calloc(allocator, VERIFY_BATCH_SIZE, sizeof(int));
+    ASSERT_NOT_NULL(hashes);
+    ASSERT_NOT_NULL(signature_storage);
+    ASSERT_NOT_NULL(keys);
+    ASSERT_NOT_NULL(messages);
+    ASSERT_NOT_NULL(signatures);
+    ASSERT_NOT_NULL(results);
+
+    for (size_t i = 0; i < VERIFY_BATCH_SIZE; ++i) {
+        size_t key_index = i % 10 < 7 ? 0 : i % 10 - 6;
+        keys[i] = verifiers[key_index];
+
+        uint8_t *hash = hashes + i * AWS_SHA256_LEN;
+        for (size_t j = 0; j < AWS_SHA256_LEN; ++j) {
+            hash[j] = (uint8_t)(i * 31 + j);
+        }
+        messages[i] = aws_byte_cursor_from_array(hash, AWS_SHA256_LEN);
+
+        struct aws_byte_buf signature =
+            aws_byte_buf_from_empty_array(signature_storage + i * max_signature_length, max_signature_length);
+        ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(signers[key_index], &messages[i], &signature));
+        signatures[i] = aws_byte_cursor_from_buf(&signature);
+    }
+
+    ASSERT_SUCCESS(aws_ecc_verify_batch(allocator, keys, messages, signatures, 0, NULL, results));
+
+    /* the same workers serve every batch below */
+    struct aws_ecc_verify_workers *workers[] = {
+        NULL,
+        aws_ecc_verify_workers_new(allocator, 1),
+        aws_ecc_verify_workers_new(allocator, 3),
+        aws_ecc_verify_workers_new(allocator, 0),
+    };
+    for (size_t t = 1; t < AWS_ARRAY_SIZE(workers); ++t) {
+        ASSERT_NOT_NULL(workers[t]);
+    }
+
+    for (size_t t = 0; t < AWS_ARRAY_SIZE(workers); ++t) {
+        memset(results, 0xff, VERIFY_BATCH_SIZE * sizeof(int));
+        ASSERT_SUCCESS(
+            aws_ecc_verify_batch(allocator, keys, messages, signatures, VERIFY_BATCH_SIZE, workers[t], results));
+        for (size_t i = 0; i < VERIFY_BATCH_SIZE; ++i) {
+            ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, results[i]);
+        }
+    }
+
+    /* every 13th message no longer matches its signature, and one signature is cut short */
+    for (size_t i = 0; i < VERIFY_BATCH_SIZE; i += 13) {
+        hashes[i * AWS_SHA256_LEN] ^= 0x01;
+    }
+    signatures[100].len = 3;
+
+    for (size_t t = 0; t < AWS_ARRAY_SIZE(workers); ++t) {
+        memset(results, 0xff, VERIFY_BATCH_SIZE * sizeof(int));
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_verify_batch(allocator, keys, messages, signatures, VERIFY_BATCH_SIZE, workers[t], results));
+        for (size_t i = 0; i < VERIFY_BATCH_SIZE; ++i) {
+            if (i % 13 == 0) {
+                ASSERT_INT_EQUALS(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED, results[i]);
+            } else if (i == 100) {
+                ASSERT_TRUE(results[i] != AWS_ERROR_SUCCESS);
+            } else {
+                ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, results[i]);
+            }
+        }
+    }
+
+    for (size_t t = 0; t < AWS_ARRAY_SIZE(workers); ++t) {
+        aws_ecc_verify_workers_destroy(workers[t]);
+    }
+
+    aws_mem_release(allocator, results);
+    aws_mem_release(allocator, signatures);
+    aws_mem_release(allocator, messages);
+    aws_mem_release(allocator, keys);
+    aws_mem_release(allocator, signature_storage);
+    aws_mem_release(allocator, hashes);
+
+    aws_ecc_key_pair_release(verifiers[3]);
+    for (size_t i = 0; i < VERIFY_BATCH_KEYS; ++i) {
+        aws_ecc_key_pair_release(signers[i]);
+    }
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_verify_batch, s_ecdsa_verify_batch_fn)
+
+/* more than two of the native provider's blocks of 32 */
+#define SIGN_BATCH_SIZE 70
+
+static int s_test_sign_batch(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(key_pair);
+
+    size_t signature_length = aws_ecc_key_pair_signature_length(key_pair);
+    uint8_t hashes[SIGN_BATCH_SIZE][AWS_SHA256_LEN];
+    struct aws_byte_cursor messages[SIGN_BATCH_SIZE];
+    struct aws_byte_buf signatures[SIGN_BATCH_SIZE];
+
+    for (size_t i = 0; i < SIGN_BATCH_SIZE; ++i) {
+        for (size_t j = 0; j < AWS_SHA256_LEN; ++j) {
+            hashes[i][j] = (uint8_t)(i * 7 + j);
+        }
+        messages[i] = aws_byte_cursor_from_array(hashes[i], AWS_SHA256_LEN);
+        ASSERT_SUCCESS(aws_byte_buf_init(&signatures[i], allocator, signature_length));
+    }
+
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message_batch(key_pair, messages, 0, signatures));
+
+    /* one buffer too small fails the batch before anything is signed */
+    signatures[40].capacity = signature_length - 1;
+    ASSERT_ERROR(
+        AWS_ERROR_SHORT_BUFFER, aws_ecc_key_pair_sign_message_batch(key_pair, messages, SIGN_BATCH_SIZE, signatures));
+    signatures[40].capacity = signature_length;
+    for (size_t i = 0; i < SIGN_BATCH_SIZE; ++i) {
+        ASSERT_UINT_EQUALS(0, signatures[i].len);
+    }
+
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message_batch(key_pair, messages, SIGN_BATCH_SIZE, signatures));
+
+    for (size_t i = 0; i < SIGN_BATCH_SIZE; ++i) {
+        struct aws_byte_cursor signature = aws_byte_cursor_from_buf(&signatures[i]);
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(key_pair, &messages[i], &signature));
+
+        /* each signature only verifies its own message */
+        size_t other = (i + 1) % SIGN_BATCH_SIZE;
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(key_pair, &messages[other], &signature));
+    }
+
+    for (size_t i = 0; i < SIGN_BATCH_SIZE; ++i) {
+        aws_byte_buf_clean_up(&signatures[i]);
+    }
+    aws_ecc_key_pair_release(key_pair);
+
+    return AWS_OP_SUCCESS;
+}
+
+typedef int(s_curve_test_fn)(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name);
+
+/* Runs fn on each curve under every provider in the build, then puts the curve's default provider back. */
+static int s_for_each_curve_and_provider(struct aws_allocator *allocator, s_curve_test_fn *fn) {
+    enum aws_ecc_curve_name curves[] = {AWS_CAL_ECDSA_P256, AWS_CAL_ECDSA_P384};
+    enum aws_ecc_provider providers[] = {
+        AWS_ECC_PROVIDER_NATIVE,
+#ifndef AWS_BYO_CRYPTO
+        AWS_ECC_PROVIDER_PLATFORM,
+#endif
+    };
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(curves); ++i) {
+        enum aws_ecc_provider default_provider = aws_ecc_get_provider(curves[i]);
+        for (size_t j = 0; j < AWS_ARRAY_SIZE(providers); ++j) {
+            ASSERT_SUCCESS(aws_ecc_set_provider(curves[i], providers[j]));
+            ASSERT_SUCCESS(fn(allocator, curves[i]));
+        }
+        ASSERT_SUCCESS(aws_ecc_set_provider(curves[i], default_provider));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecdsa_sign_batch_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    /* the native provider's shared inversions, and one signature at a time for everything else */
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_sign_batch));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_sign_batch, s_ecdsa_sign_batch_fn)
+
+#define NONCE_POOL_THREAD_COUNT 4
+#define NONCE_POOL_SIGNATURES 25
+
+struct nonce_pool_thread_data {
+    struct aws_ecc_key_pair *key_pair;
+    struct aws_byte_cursor hash;
+    struct aws_atomic_var failures;
+};
+
+static void s_nonce_pool_thread_fn(void *arg) {
+    struct nonce_pool_thread_data *data = arg;
+
+    uint8_t signature[AWS_EC_NATIVE_MAX_LIMBS * 16 + 8];
+    for (size_t i = 0; i < NONCE_POOL_SIGNATURES; ++i) {
+        struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+        if (aws_ecc_key_pair_sign_message(data->key_pair, &data->hash, &signature_buf)) {
+            aws_atomic_fetch_add(&data->failures, 1);
+            continue;
+        }
+
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+        if (aws_ecc_key_pair_verify_signature(data->key_pair, &data->hash, &signature_cur)) {
+            aws_atomic_fetch_add(&data->failures, 1);
+        }
+    }
+}
+
+static int s_ecdsa_native_nonce_pool_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_cursor message = aws_byte_cursor_from_c_str("nonces made ahead of time");
+    struct aws_byte_buf hash_value = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    ASSERT_SUCCESS(aws_sha256_compute(allocator, &message, &hash_value, 0));
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_value);
+
+    /* nonces from a pool make valid signatures */
+    struct aws_ec_native_key key;
+    ASSERT_SUCCESS(aws_ec_native_key_init(&key, AWS_CAL_ECDSA_P256));
+    ASSERT_SUCCESS(aws_ec_native_key_generate(&key));
+
+    struct aws_ec_native_nonce_pool *pool = aws_ec_native_nonce_pool_new(allocator, AWS_CAL_ECDSA_P256, 4, 1);
+    ASSERT_NOT_NULL(pool);
+
+    struct aws_ec_native_nonce nonce;
+    for (size_t i = 0; i < 8; ++i) {
+        /* the worker fills the pool in the background */
+        size_t attempts = 0;
+        while (!aws_ec_native_nonce_pool_take(pool, &nonce)) {
+            ASSERT_TRUE(++attempts < 5000);
+            aws_thread_current_sleep(1000000);
+        }
+
+        uint8_t signature[AWS_EC_NATIVE_MAX_LIMBS * 16 + 8];
+        struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+        ASSERT_SUCCESS(
+            aws_ec_native_sign_with_nonce(&key, &nonce, &hash_cur, AWS_EC_NATIVE_SIGNATURE_DER, &signature_buf));
+
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+        ASSERT_SUCCESS(aws_ec_native_key_verify(&key, &hash_cur, AWS_EC_NATIVE_SIGNATURE_DER, &signature_cur));
+    }
+
+    aws_ec_native_nonce_pool_destroy(pool);
+    aws_ec_native_key_clean_up(&key);
+
+    ASSERT_NULL(aws_ec_native_nonce_pool_new(allocator, AWS_CAL_ECDSA_P256, 4, 4));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    /* and through the key pair API, from several threads at once */
+    enum aws_ecc_provider default_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P256);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_NATIVE));
+
+    struct nonce_pool_thread_data data = {
+        .key_pair = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256),
+        .hash = hash_cur,
+    };
+    ASSERT_NOT_NULL(data.key_pair);
+    aws_atomic_init_int(&data.failures, 0);
+
+    struct aws_ecc_nonce_pool_options options = {
+        .depth = 16,
+        .refill_threshold = 4,
+    };
+    ASSERT_SUCCESS(aws_ecc_key_pair_enable_nonce_pool(data.key_pair, &options));
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_ecc_key_pair_enable_nonce_pool(data.key_pair, &options));
+
+    struct aws_thread threads[NONCE_POOL_THREAD_COUNT];
+    for (size_t i = 0; i < NONCE_POOL_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_nonce_pool_thread_fn, &data, NULL));
+    }
+
+    for (size_t i = 0; i < NONCE_POOL_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+
+    ASSERT_UINT_EQUALS(0, aws_atomic_load_int(&data.failures));
+
+    /* public only key pairs can't sign */
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(data.key_pair, &pub_x, &pub_y);
+    struct aws_ecc_key_pair *public_key =
+        aws_ecc_key_pair_new_from_public_key(allocator, AWS_CAL_ECDSA_P256, &pub_x, &pub_y);
+    ASSERT_NOT_NULL(public_key);
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT, aws_ecc_key_pair_enable_nonce_pool(public_key, &options));
+    aws_ecc_key_pair_release(public_key);
+
+    /* the worker is still running when the key pair goes away */
+    aws_ecc_key_pair_release(data.key_pair);
+
+#ifndef AWS_BYO_CRYPTO
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_PLATFORM));
+    struct aws_ecc_key_pair *platform_key = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256);
+    ASSERT_NOT_NULL(platform_key);
+    ASSERT_ERROR(AWS_ERROR_UNSUPPORTED_OPERATION, aws_ecc_key_pair_enable_nonce_pool(platform_key, &options));
+    aws_ecc_key_pair_release(platform_key);
+#endif
+
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, default_provider));
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_native_nonce_pool, s_ecdsa_native_nonce_pool_fn)
+
+/*
+ * Signs message and checks the signature is expected, both on its own and in a batch, and that it verifies. Signing
+ * deterministically makes the same signature every time.
+ */
+static int s_test_deterministic_signature(
+    struct aws_allocator *allocator,
+    struct aws_ecc_key_pair *key_pair,
+    const char *message,
+    struct aws_byte_cursor expected) {
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_cursor message_cur = aws_byte_cursor_from_c_str(message);
+    struct aws_byte_buf hash_value = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    ASSERT_SUCCESS(aws_sha256_compute(allocator, &message_cur, &hash_value, 0));
+    struct aws_byte_cursor hashes[3];
+    struct aws_byte_buf signatures[AWS_ARRAY_SIZE(hashes)];
+
+    size_t signature_length = aws_ecc_key_pair_signature_length(key_pair);
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(hashes); ++i) {
+        hashes[i] = aws_byte_cursor_from_buf(&hash_value);
+        ASSERT_SUCCESS(aws_byte_buf_init(&signatures[i], allocator, signature_length));
+    }
+
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(key_pair, &hashes[0], &signatures[0]));
+    ASSERT_BIN_ARRAYS_EQUALS(expected.ptr, expected.len, signatures[0].buffer, signatures[0].len);
+
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signatures[0]);
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(key_pair, &hashes[0], &signature_cur));
+
+    signatures[0].len = 0;
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message_batch(key_pair, hashes, AWS_ARRAY_SIZE(hashes), signatures));
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(hashes); ++i) {
+        ASSERT_BIN_ARRAYS_EQUALS(expected.ptr, expected.len, signatures[i].buffer, signatures[i].len);
+        aws_byte_buf_clean_up(&signatures[i]);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecdsa_native_deterministic_signing_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    /* RFC 6979 A.2.5 and A.2.6: the keys, and their SHA-256 signatures of "sample" and "test" */
+    uint8_t p256_d[] = {
+        0xc9, 0xaf, 0xa9, 0xd8, 0x45, 0xba, 0x75, 0x16, 0x6b, 0x5c, 0x21, 0x57, 0x67, 0xb1, 0xd6, 0x93,
+        0x4e, 0x50, 0xc3, 0xdb, 0x36, 0xe8, 0x9b, 0x12, 0x7b, 0x8a, 0x62, 0x2b, 0x12, 0x0f, 0x67, 0x21,
+    };
+
+    uint8_t p256_sample[] = {
+        0x30, 0x46, 0x02, 0x21, 0x00, 0xef, 0xd4, 0x8b, 0x2a, 0xac, 0xb6, 0xa8, 0xfd, 0x11, 0x40, 0xdd,
+        0x9c, 0xd4, 0x5e, 0x81, 0xd6, 0x9d, 0x2c, 0x87, 0x7b, 0x56, 0xaa, 0xf9, 0x91, 0xc3, 0x4d, 0x0e,
+        0xa8, 0x4e, 0xaf, 0x37, 0x16, 0x02, 0x21, 0x00, 0xf7, 0xcb, 0x1c, 0x94, 0x2d, 0x65, 0x7c, 0x41,
+        0xd4, 0x36, 0xc7, 0xa1, 0xb6, 0xe2, 0x9f, 0x65, 0xf3, 0xe9, 0x00, 0xdb, 0xb9, 0xaf, 0xf4, 0x06,
+        0x4d, 0xc4, 0xab, 0x2f, 0x84, 0x3a, 0xcd, 0xa8,
+    };
+
+    uint8_t p256_test[] = {
+        0x30, 0x45, 0x02, 0x21, 0x00, 0xf1, 0xab, 0xb0, 0x23, 0x51, 0x83, 0x51, 0xcd, 0x71, 0xd8, 0x81,
+        0x56, 0x7b, 0x1e, 0xa6, 0x63, 0xed, 0x3e, 0xfc, 0xf6, 0xc5, 0x13, 0x2b, 0x35, 0x4f, 0x28, 0xd3,
+        0xb0, 0xb7, 0xd3, 0x83, 0x67, 0x02, 0x20, 0x01, 0x9f, 0x41, 0x13, 0x74, 0x2a, 0x2b, 0x14, 0xbd,
+        0x25, 0x92, 0x6b, 0x49, 0xc6, 0x49, 0x15, 0x5f, 0x26, 0x7e, 0x60, 0xd3, 0x81, 0x4b, 0x4c, 0x0c,
+        0xc8, 0x42, 0x50, 0xe4, 0x6f, 0x00, 0x83,
+    };
+
+    uint8_t p384_d[] = {
+        0x6b, 0x9d, 0x3d, 0xad, 0x2e, 0x1b, 0x8c, 0x1c, 0x05, 0xb1, 0x98, 0x75, 0xb6, 0x65, 0x9f, 0x4d,
+        0xe2, 0x3c, 0x3b, 0x66, 0x7b, 0xf2, 0x97, 0xba, 0x9a, 0xa4, 0x77, 0x40, 0x78, 0x71, 0x37, 0xd8,
+        0x96, 0xd5, 0x72, 0x4e, 0x4c, 0x70, 0xa8, 0x25, 0xf8, 0x72, 0xc9, 0xea, 0x60, 0xd2, 0xed, 0xf5,
+    };
+
+    uint8_t p384_sample[] = {
+        0x30, 0x65, 0x02, 0x30, 0x21, 0xb1, 0x3d, 0x1e, 0x01, 0x3c, 0x7f, 0xa1, 0x39, 0x2d, 0x03, 0xc5,
+        0xf9, 0x9a, 0xf8, 0xb3, 0x0c, 0x57, 0x0c, 0x6f, 0x98, 0xd4, 0xea, 0x8e, 0x35, 0x4b, 0x63, 0xa2,
+        0x1d, 0x3d, 0xaa, 0x33, 0xbd, 0xe1, 0xe8, 0x88, 0xe6, 0x33, 0x55, 0xd9, 0x2f, 0xa2, 0xb3, 0xc3,
+        0x6d, 0x8f, 0xb2, 0xcd, 0x02, 0x31, 0x00, 0xf3, 0xaa, 0x44, 0x3f, 0xb1, 0x07, 0x74, 0x5b, 0xf4,
+        0xbd, 0x77, 0xcb, 0x38, 0x91, 0x67, 0x46, 0x32, 0x06, 0x8a, 0x10, 0xca, 0x67, 0xe3, 0xd4, 0x5d,
+        0xb2, 0x26, 0x6f, 0xa7, 0xd1, 0xfe, 0xeb, 0xef, 0xdc, 0x63, 0xec, 0xcd, 0x1a, 0xc4, 0x2e, 0xc0,
+        0xcb, 0x86, 0x68, 0xa4, 0xfa, 0x0a, 0xb0,
+    };
+
+    uint8_t p384_test[] = {
+        0x30, 0x64, 0x02, 0x30, 0x6d, 0x6d, 0xef, 0xac, 0x9a, 0xb6, 0x4d, 0xab, 0xaf, 0xe3, 0x6c, 0x6b,
+        0xf5, 0x10, 0x35, 0x2a, 0x4c, 0xc2, 0x70, 0x01, 0x26, 0x36, 0x38, 0xe5, 0xb1, 0x6d, 0x9b, 0xb5,
+        0x1d, 0x45, 0x15, 0x59, 0xf9, 0x18, 0xee, 0xda, 0xf2, 0x29, 0x3b, 0xe5, 0xb4, 0x75, 0xcc, 0x8f,
+        0x01, 0x88, 0x63, 0x6b, 0x02, 0x30, 0x2d, 0x46, 0xf3, 0xbe, 0xcb, 0xcc, 0x52, 0x3d, 0x5f, 0x1a,
+        0x12, 0x56, 0xbf, 0x0c, 0x9b, 0x02, 0x4d, 0x87, 0x9b, 0xa9, 0xe8, 0x38, 0x14, 0x4c, 0x8b, 0xa6,
+        0xba, 0xeb, 0x4b, 0x53, 0xb4, 0x7d, 0x51, 0xab, 0x37, 0x3f, 0x98, 0x45, 0xc0, 0x51, 0x4e, 0xef,
+        0xb1, 0x40, 0x24, 0x78, 0x72, 0x65,
+    };
+
+    enum aws_ecc_provider default_p256_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P256);
+    enum aws_ecc_provider default_p384_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P384);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_NATIVE));
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P384, AWS_ECC_PROVIDER_NATIVE));
+
+    struct aws_byte_cursor p256_private_key = aws_byte_cursor_from_array(p256_d, sizeof(p256_d));
+    struct aws_ecc_key_pair *p256_key =
+        aws_ecc_key_pair_new_from_private_key(allocator, AWS_CAL_ECDSA_P256, &p256_private_key);
+    ASSERT_NOT_NULL(p256_key);
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_public_key(p256_key));
+
+    /* a nonce pool doesn't get in the way */
+    struct aws_ecc_nonce_pool_options options = {
+        .depth = 4,
+        .refill_threshold = 1,
+    };
+    ASSERT_SUCCESS(aws_ecc_key_pair_enable_nonce_pool(p256_key, &options));
+    ASSERT_SUCCESS(aws_ecc_key_pair_set_deterministic_signing(p256_key, true));
+
+    ASSERT_SUCCESS(s_test_deterministic_signature(
+        allocator, p256_key, "sample", aws_byte_cursor_from_array(p256_sample, sizeof(p256_sample))));
+    ASSERT_SUCCESS(s_test_deterministic_signature(
+        allocator, p256_key, "test", aws_byte_cursor_from_array(p256_test, sizeof(p256_test))));
+
+    struct aws_byte_cursor p384_private_key = aws_byte_cursor_from_array(p384_d, sizeof(p384_d));
+    struct aws_ecc_key_pair *p384_key =
+        aws_ecc_key_pair_new_from_private_key(allocator, AWS_CAL_ECDSA_P384, &p384_private_key);
+    ASSERT_NOT_NULL(p384_key);
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_public_key(p384_key));
+    ASSERT_SUCCESS(aws_ecc_key_pair_set_deterministic_signing(p384_key, true));
+
+    ASSERT_SUCCESS(s_test_deterministic_signature(
+        allocator, p384_key, "sample", aws_byte_cursor_from_array(p384_sample, sizeof(p384_sample))));
+    ASSERT_SUCCESS(s_test_deterministic_signature(
+        allocator, p384_key, "test", aws_byte_cursor_from_array(p384_test, sizeof(p384_test))));
+
+    /* back to random nonces */
+    ASSERT_SUCCESS(aws_ecc_key_pair_set_deterministic_signing(p256_key, false));
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_cursor message = aws_byte_cursor_from_c_str("sample");
+    struct aws_byte_buf hash_value = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    ASSERT_SUCCESS(aws_sha256_compute(allocator, &message, &hash_value, 0));
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_value);
+
+    uint8_t signature[AWS_EC_NATIVE_MAX_LIMBS * 16 + 8];
+    struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(p256_key, &hash_cur, &signature_buf));
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(p256_key, &hash_cur, &signature_cur));
+    ASSERT_FALSE(
+        signature_buf.len == sizeof(p256_sample) && memcmp(signature, p256_sample, sizeof(p256_sample)) == 0);
+
+    /* public only key pairs can't sign */
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(p256_key, &pub_x, &pub_y);
+    struct aws_ecc_key_pair *public_key =
+        aws_ecc_key_pair_new_from_public_key(allocator, AWS_CAL_ECDSA_P256, &pub_x, &pub_y);
+    ASSERT_NOT_NULL(public_key);
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT, aws_ecc_key_pair_set_deterministic_signing(public_key, true));
+    aws_ecc_key_pair_release(public_key);
+
+    aws_ecc_key_pair_release(p384_key);
+    aws_ecc_key_pair_release(p256_key);
+
+#ifndef AWS_BYO_CRYPTO
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_PLATFORM));
+    struct aws_ecc_key_pair *platform_key = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256);
+    ASSERT_NOT_NULL(platform_key);
+    ASSERT_ERROR(AWS_ERROR_UNSUPPORTED_OPERATION, aws_ecc_key_pair_set_deterministic_signing(platform_key, true));
+    aws_ecc_key_pair_release(platform_key);
+#endif
+
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, default_p256_provider));
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P384, default_p384_provider));
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_native_deterministic_signing, s_ecdsa_native_deterministic_signing_fn)
+
+/*
+ * Signs a hash in both forms with a fresh key from the current provider, and checks each form verifies, converts to
+ * the other and verifies there too, including through a prepared verification table.
+ */
+static int s_test_raw_signatures(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(key_pair);
+
+    uint8_t hash[AWS_SHA256_LEN];
+    memset(hash, 0xa5, sizeof(hash));
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_array(hash, sizeof(hash));
+
+    size_t raw_length = aws_ecc_raw_signature_length(curve_name);
+    ASSERT_UINT_EQUALS(2 * aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name), raw_length);
+
+    struct aws_byte_buf raw;
+    ASSERT_SUCCESS(aws_byte_buf_init(&raw, allocator, raw_length));
+    struct aws_byte_buf der;
+    ASSERT_SUCCESS(aws_byte_buf_init(&der, allocator, aws_ecc_key_pair_signature_length(key_pair)));
+
+    /* raw signing appends exactly raw_length bytes and refuses anything shorter */
+    raw.len = 1;
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_ecc_key_pair_sign_message_raw(key_pair, &hash_cur, &raw));
+    raw.len = 0;
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message_raw(key_pair, &hash_cur, &raw));
+    ASSERT_UINT_EQUALS(raw_length, raw.len);
+
+    struct aws_byte_cursor raw_cur = aws_byte_cursor_from_buf(&raw);
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature_raw(key_pair, &hash_cur, &raw_cur));
+
+    ASSERT_SUCCESS(aws_ecc_signatures_raw_to_der(curve_name, &raw_cur, 1, &der));
+    struct aws_byte_cursor der_cur = aws_byte_cursor_from_buf(&der);
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(key_pair, &hash_cur, &der_cur));
+
+    /* and the other way round */
+    der.len = 0;
+    raw.len = 0;
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &der));
+    der_cur = aws_byte_cursor_from_buf(&der);
+    ASSERT_SUCCESS(aws_ecc_signatures_der_to_raw(curve_name, &der_cur, 1, &raw));
+    raw_cur = aws_byte_cursor_from_buf(&raw);
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature_raw(key_pair, &hash_cur, &raw_cur));
+
+    /* a wrong length or a flipped bit is just a bad signature */
+    struct aws_byte_cursor short_cur = raw_cur;
+    short_cur.len -= 1;
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+        aws_ecc_key_pair_verify_signature_raw(key_pair, &hash_cur, &short_cur));
+    raw.buffer[raw.len - 1] ^= 0x01;
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+        aws_ecc_key_pair_verify_signature_raw(key_pair, &hash_cur, &raw_cur));
+    raw.buffer[raw.len - 1] ^= 0x01;
+
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(key_pair));
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature_raw(key_pair, &hash_cur, &raw_cur));
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+        aws_ecc_key_pair_verify_signature_raw(key_pair, &hash_cur, &short_cur));
+
+    aws_byte_buf_clean_up(&der);
+    aws_byte_buf_clean_up(&raw);
+    aws_ecc_key_pair_release(key_pair);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecdsa_raw_signatures_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_raw_signatures));
+
+    /* the native engine's own raw output is the RFC 6979 signature's r || s */
+    uint8_t p256_d[] = {
+        0xc9, 0xaf, 0xa9, 0xd8, 0x45, 0xba, 0x75, 0x16, 0x6b, 0x5c, 0x21, 0x57, 0x67, 0xb1, 0xd6, 0x93,
+        0x4e, 0x50, 0xc3, 0xdb, 0x36, 0xe8, 0x9b, 0x12, 0x7b, 0x8a, 0x62, 0x2b, 0x12, 0x0f, 0x67, 0x21,
+    };
+
+    uint8_t p256_sample_raw[] = {
+        0xef, 0xd4, 0x8b, 0x2a, 0xac, 0xb6, 0xa8, 0xfd, 0x11, 0x40, 0xdd, 0x9c, 0xd4, 0x5e, 0x81, 0xd6,
+        0x9d, 0x2c, 0x87, 0x7b, 0x56, 0xaa, 0xf9, 0x91, 0xc3, 0x4d, 0x0e, 0xa8, 0x4e, 0xaf, 0x37, 0x16,
+        0xf7, 0xcb, 0x1c, 0x94, 0x2d, 0x65, 0x7c, 0x41, 0xd4, 0x36, 0xc7, 0xa1, 0xb6, 0xe2, 0x9f, 0x65,
+        0xf3, 0xe9, 0x00, 0xdb, 0xb9, 0xaf, 0xf4, 0x06, 0x4d, 0xc4, 0xab, 0x2f, 0x84, 0x3a, 0xcd, 0xa8,
+    };
+
+    enum aws_ecc_provider default_p256_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P256);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_NATIVE));
+    struct aws_byte_cursor private_key = aws_byte_cursor_from_array(p256_d, sizeof(p256_d));
+    struct aws_ecc_key_pair *key_pair =
+        aws_ecc_key_pair_new_from_private_key(allocator, AWS_CAL_ECDSA_P256, &private_key);
+    ASSERT_NOT_NULL(key_pair);
+    ASSERT_SUCCESS(aws_ecc_key_pair_set_deterministic_signing(key_pair, true));
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_cursor message = aws_byte_cursor_from_c_str("sample");
+    struct aws_byte_buf hash_value = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    ASSERT_SUCCESS(aws_sha256_compute(allocator, &message, &hash_value, 0));
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_value);
+
+    uint8_t signature[sizeof(p256_sample_raw)];
+    struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message_raw(key_pair, &hash_cur, &signature_buf));
+    ASSERT_BIN_ARRAYS_EQUALS(p256_sample_raw, sizeof(p256_sample_raw), signature_buf.buffer, signature_buf.len);
+
+    aws_ecc_key_pair_release(key_pair);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, default_p256_provider));
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_raw_signatures, s_ecdsa_raw_signatures_fn)
+
+/* Feeds message to a signer or verifier in uneven chunks that straddle SHA-256 block boundaries. */
+static int s_stream_update(void *stream, bool signer, struct aws_byte_cursor message) {
+    size_t chunk_sizes[] = {1, 63, 64, 65, 7, 128};
+    size_t i = 0;
+
+    while (message.len) {
+        size_t chunk_size = aws_min_size(chunk_sizes[i++ % AWS_ARRAY_SIZE(chunk_sizes)], message.len);
+        struct aws_byte_cursor chunk = aws_byte_cursor_advance(&message, chunk_size);
+        ASSERT_SUCCESS(signer ? aws_ecc_signer_update(stream, &chunk) : aws_ecc_verifier_update(stream, &chunk));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Streams a message through a signer and a verifier made from a fresh key of the current provider, and checks they
+ * agree with signing and verifying the message's SHA-256 digest directly, for several messages in a row.
+ */
+static int s_test_streaming_signatures(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(key_pair);
+
+    struct aws_ecc_signer *signer = aws_ecc_signer_new(allocator, key_pair);
+    ASSERT_NOT_NULL(signer);
+    struct aws_ecc_verifier *verifier = aws_ecc_verifier_new(allocator, key_pair);
+    ASSERT_NOT_NULL(verifier);
+    /* the streams keep the key alive */
+    aws_ecc_key_pair_release(key_pair);
+
+    uint8_t message[1000];
+    for (size_t i = 0; i < sizeof(message); ++i) {
+        message[i] = (uint8_t)(i * 7);
+    }
+
+    struct aws_byte_buf signature;
+    ASSERT_SUCCESS(aws_byte_buf_init(&signature, allocator, aws_ecc_key_pair_signature_length(key_pair)));
+
+    /* an empty message, then lengths on and around block boundaries */
+    size_t lengths[] = {0, 55, 56, 64, sizeof(message)};
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(lengths); ++i) {
+        struct aws_byte_cursor message_cur = aws_byte_cursor_from_array(message, lengths[i]);
+
+        uint8_t hash[AWS_SHA256_LEN];
+        struct aws_byte_buf hash_buf = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+        ASSERT_SUCCESS(aws_sha256_compute(allocator, &message_cur, &hash_buf, 0));
+        struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_buf);
+
+        signature.len = 0;
+        ASSERT_SUCCESS(s_stream_update(signer, true, message_cur));
+        ASSERT_SUCCESS(aws_ecc_signer_finalize(signer, &signature));
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature);
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(key_pair, &hash_cur, &signature_cur));
+
+        ASSERT_SUCCESS(s_stream_update(verifier, false, message_cur));
+        ASSERT_SUCCESS(aws_ecc_verifier_finalize(verifier, &signature_cur));
+
+        signature.len = 0;
+        ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature));
+        signature_cur = aws_byte_cursor_from_buf(&signature);
+        ASSERT_SUCCESS(s_stream_update(verifier, false, message_cur));
+        ASSERT_SUCCESS(aws_ecc_verifier_finalize(verifier, &signature_cur));
+
+        /* raw signatures, and a message one byte short of the signed one */
+        signature.len = 0;
+        ASSERT_SUCCESS(s_stream_update(signer, true, message_cur));
+        ASSERT_SUCCESS(aws_ecc_signer_finalize_raw(signer, &signature));
+        ASSERT_UINT_EQUALS(aws_ecc_raw_signature_length(curve_name), signature.len);
+        signature_cur = aws_byte_cursor_from_buf(&signature);
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature_raw(key_pair, &hash_cur, &signature_cur));
+
+        ASSERT_SUCCESS(s_stream_update(verifier, false, message_cur));
+        ASSERT_SUCCESS(aws_ecc_verifier_finalize_raw(verifier, &signature_cur));
+
+        if (message_cur.len) {
+            message_cur.len -= 1;
+            ASSERT_SUCCESS(s_stream_update(verifier, false, message_cur));
+            ASSERT_ERROR(
+                AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED, aws_ecc_verifier_finalize_raw(verifier, &signature_cur));
+        }
+    }
+
+    aws_byte_buf_clean_up(&signature);
+    aws_ecc_verifier_destroy(verifier);
+    aws_ecc_signer_destroy(signer);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecdsa_streaming_signatures_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_streaming_signatures));
+
+    /* RFC 6979 A.2.5: streaming "sample" in pieces signs the same as signing its digest */
+    uint8_t p256_d[] = {
+        0xc9, 0xaf, 0xa9, 0xd8, 0x45, 0xba, 0x75, 0x16, 0x6b, 0x5c, 0x21, 0x57, 0x67, 0xb1, 0xd6, 0x93,
+        0x4e, 0x50, 0xc3, 0xdb, 0x36, 0xe8, 0x9b, 0x12, 0x7b, 0x8a, 0x62, 0x2b, 0x12, 0x0f, 0x67, 0x21,
+    };
+
+    uint8_t p256_sample_raw[] = {
+        0xef, 0xd4, 0x8b, 0x2a, 0xac, 0xb6, 0xa8, 0xfd, 0x11, 0x40, 0xdd, 0x9c, 0xd4, 0x5e, 0x81, 0xd6,
+        0x9d, 0x2c, 0x87, 0x7b, 0x56, 0xaa, 0xf9, 0x91, 0xc3, 0x4d, 0x0e, 0xa8, 0x4e, 0xaf, 0x37, 0x16,
+        0xf7, 0xcb, 0x1c, 0x94, 0x2d, 0x65, 0x7c, 0x41, 0xd4, 0x36, 0xc7, 0xa1, 0xb6, 0xe2, 0x9f, 0x65,
+        0xf3, 0xe9, 0x00, 0xdb, 0xb9, 0xaf, 0xf4, 0x06, 0x4d, 0xc4, 0xab, 0x2f, 0x84, 0x3a, 0xcd, 0xa8,
+    };
+
+    enum aws_ecc_provider default_p256_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P256);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_NATIVE));
+    struct aws_byte_cursor private_key = aws_byte_cursor_from_array(p256_d, sizeof(p256_d));
+    struct aws_ecc_key_pair *key_pair =
+        aws_ecc_key_pair_new_from_private_key(allocator, AWS_CAL_ECDSA_P256, &private_key);
+    ASSERT_NOT_NULL(key_pair);
+    ASSERT_SUCCESS(aws_ecc_key_pair_set_deterministic_signing(key_pair, true));
+
+    struct aws_ecc_signer *signer = aws_ecc_signer_new(allocator, key_pair);
+    ASSERT_NOT_NULL(signer);
+    struct aws_byte_cursor parts[] = {aws_byte_cursor_from_c_str("sam"), aws_byte_cursor_from_c_str("ple")};
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(parts); ++i) {
+        ASSERT_SUCCESS(aws_ecc_signer_update(signer, &parts[i]));
+    }
+
+    uint8_t signature[sizeof(p256_sample_raw)];
+    struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+    ASSERT_SUCCESS(aws_ecc_signer_finalize_raw(signer, &signature_buf));
+    ASSERT_BIN_ARRAYS_EQUALS(p256_sample_raw, sizeof(p256_sample_raw), signature_buf.buffer, signature_buf.len);
+
+    aws_ecc_signer_destroy(signer);
+    aws_ecc_key_pair_release(key_pair);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, default_p256_provider));
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_streaming_signatures, s_ecdsa_streaming_signatures_fn)
+
+/*
+ * Key pairs keep their coordinates in fixed, full size storage: short and zero padded encodings import, everything
+ * comes back out at the curve's coordinate size, and encodings with significant bytes beyond it are rejected.
+ */
+static int s_test_coordinate_storage(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+
+    /* a key whose private scalar or public x starts with a zero byte, found by trying */
+    struct aws_ecc_key_pair *key_pair = NULL;
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    struct aws_byte_cursor priv_d;
+    for (size_t i = 0; i < 1000000; ++i) {
+        key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+        ASSERT_NOT_NULL(key_pair);
+        aws_ecc_key_pair_get_public_key(key_pair, &pub_x, &pub_y);
+        aws_ecc_key_pair_get_private_key(key_pair, &priv_d);
+        ASSERT_UINT_EQUALS(coordinate_size, pub_x.len);
+        ASSERT_UINT_EQUALS(coordinate_size, pub_y.len);
+        ASSERT_UINT_EQUALS(coordinate_size, priv_d.len);
+        if (pub_x.ptr[0] == 0 || priv_d.ptr[0] == 0) {
+            break;
+        }
+        aws_ecc_key_pair_release(key_pair);
+        key_pair = NULL;
+    }
+    ASSERT_NOT_NULL(key_pair);
+
+    uint8_t padded[AWS_EC_NATIVE_MAX_LIMBS * 8 + 1] = {0};
+    struct aws_byte_cursor variants[3][2] = {
+        {pub_x, pub_y},
+        {pub_x, pub_y},
+        {pub_x, pub_y},
+    };
+    /* strip the zero bytes, or add one more */
+    while (variants[0][0].len && variants[0][0].ptr[0] == 0) {
+        aws_byte_cursor_advance(&variants[0][0], 1);
+    }
+    memcpy(padded + 1, pub_x.ptr, pub_x.len);
+    variants[1][0] = aws_byte_cursor_from_array(padded, pub_x.len + 1);
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(variants); ++i) {
+        struct aws_ecc_key_pair *public_key =
+            aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &variants[i][0], &variants[i][1]);
+        ASSERT_NOT_NULL(public_key);
+
+        struct aws_byte_cursor x;
+        struct aws_byte_cursor y;
+        aws_ecc_key_pair_get_public_key(public_key, &x, &y);
+        ASSERT_BIN_ARRAYS_EQUALS(pub_x.ptr, pub_x.len, x.ptr, x.len);
+        ASSERT_BIN_ARRAYS_EQUALS(pub_y.ptr, pub_y.len, y.ptr, y.len);
+
+        uint8_t hash[AWS_SHA256_LEN] = {1};
+        struct aws_byte_cursor hash_cur = aws_byte_cursor_from_array(hash, sizeof(hash));
+        struct aws_byte_buf signature;
+        ASSERT_SUCCESS(aws_byte_buf_init(&signature, allocator, aws_ecc_key_pair_signature_length(key_pair)));
+        ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature));
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature);
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(public_key, &hash_cur, &signature_cur));
+        aws_byte_buf_clean_up(&signature);
+
+        aws_ecc_key_pair_release(public_key);
+    }
+
+    /* a significant byte beyond the coordinate size */
+    padded[0] = 0x01;
+    ASSERT_NULL(aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &variants[1][0], &pub_y));
+
+    aws_ecc_key_pair_release(key_pair);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecc_key_pair_coordinate_storage_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_coordinate_storage));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_key_pair_coordinate_storage, s_ecc_key_pair_coordinate_storage_fn)
+
+static int s_test_deferred_public_key(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+
+    /* the usual constructors write the coordinates right away */
+    struct aws_ecc_key_pair *generated = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(generated);
+    ASSERT_UINT_EQUALS(coordinate_size, generated->pub_x.len);
+    ASSERT_UINT_EQUALS(coordinate_size, generated->pub_y.len);
+    aws_ecc_key_pair_release(generated);
+
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random_deferred(allocator, curve_name);
+    ASSERT_NOT_NULL(key_pair);
+    ASSERT_UINT_EQUALS(0, key_pair->pub_x.len);
+    ASSERT_UINT_EQUALS(coordinate_size, key_pair->priv_d.len);
+
+    /* signing doesn't need the coordinates */
+    uint8_t hash[AWS_SHA256_LEN] = {7};
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_array(hash, sizeof(hash));
+    struct aws_byte_buf signature;
+    ASSERT_SUCCESS(aws_byte_buf_init(&signature, allocator, aws_ecc_key_pair_signature_length(key_pair)));
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature));
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature);
+
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(key_pair, &pub_x, &pub_y);
+    ASSERT_UINT_EQUALS(0, pub_x.len);
+    ASSERT_UINT_EQUALS(0, pub_y.len);
+    ASSERT_ERROR(AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT, aws_ecc_key_pair_prepare_for_verification(key_pair));
+
+    ASSERT_SUCCESS(aws_ecc_key_pair_materialize_public_key(key_pair));
+    ASSERT_SUCCESS(aws_ecc_key_pair_materialize_public_key(key_pair));
+    aws_ecc_key_pair_get_public_key(key_pair, &pub_x, &pub_y);
+    ASSERT_UINT_EQUALS(coordinate_size, pub_x.len);
+    ASSERT_UINT_EQUALS(coordinate_size, pub_y.len);
+
+    /* the coordinates are the ones the private key derives to */
+    struct aws_byte_cursor priv_d;
+    aws_ecc_key_pair_get_private_key(key_pair, &priv_d);
+    struct aws_ecc_key_pair *derived = aws_ecc_key_pair_new_from_private_key(allocator, curve_name, &priv_d);
+    ASSERT_NOT_NULL(derived);
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_public_key(derived));
+    ASSERT_BIN_ARRAYS_EQUALS(derived->pub_x.buffer, derived->pub_x.len, pub_x.ptr, pub_x.len);
+    ASSERT_BIN_ARRAYS_EQUALS(derived->pub_y.buffer, derived->pub_y.len, pub_y.ptr, pub_y.len);
+    aws_ecc_key_pair_release(derived);
+
+    struct aws_ecc_key_pair *public_key = aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &pub_x, &pub_y);
+    ASSERT_NOT_NULL(public_key);
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(public_key, &hash_cur, &signature_cur));
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(key_pair, &hash_cur, &signature_cur));
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(key_pair));
+    aws_ecc_key_pair_release(public_key);
+    aws_ecc_key_pair_release(key_pair);
+
+    /* deriving writes the deferred coordinates too */
+    key_pair = aws_ecc_key_pair_new_generate_random_deferred(allocator, curve_name);
+    ASSERT_NOT_NULL(key_pair);
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_public_key(key_pair));
+    ASSERT_UINT_EQUALS(coordinate_size, key_pair->pub_x.len);
+    ASSERT_UINT_EQUALS(coordinate_size, key_pair->pub_y.len);
+    ASSERT_SUCCESS(aws_ecc_key_pair_materialize_public_key(key_pair));
+    aws_ecc_key_pair_release(key_pair);
+
+    aws_byte_buf_clean_up(&signature);
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecc_key_pair_deferred_public_key_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_deferred_public_key));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_key_pair_deferred_public_key, s_ecc_key_pair_deferred_public_key_fn)
+
+#define KEY_POOL_THREAD_COUNT 4
+#define KEY_POOL_TAKES 16
+
+struct key_pool_thread_data {
+    struct aws_ecc_key_pool *pool;
+    struct aws_ecc_key_pair *key_pairs[KEY_POOL_THREAD_COUNT * KEY_POOL_TAKES];
+    struct aws_atomic_var next;
+};
+
+static void s_key_pool_thread_fn(void *arg) {
+    struct key_pool_thread_data *data = arg;
+    for (size_t i = 0; i < KEY_POOL_TAKES; ++i) {
+        data->key_pairs[aws_atomic_fetch_add(&data->next, 1)] = aws_ecc_key_pool_take(data->pool);
+    }
+}
+
+/* Checks key_pair's public key is the one its private key derives to. */
+static int s_check_pooled_key_pair(struct aws_allocator *allocator, struct aws_ecc_key_pair *key_pair) {
+    struct aws_byte_cursor priv_d;
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_private_key(key_pair, &priv_d);
+    aws_ecc_key_pair_get_public_key(key_pair, &pub_x, &pub_y);
+
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(key_pair->curve_name);
+    ASSERT_UINT_EQUALS(coordinate_size, priv_d.len);
+    ASSERT_UINT_EQUALS(coordinate_size, pub_x.len);
+    ASSERT_UINT_EQUALS(coordinate_size, pub_y.len);
+
+    struct aws_ecc_key_pair *derived = aws_ecc_key_pair_new_from_private_key(allocator, key_pair->curve_name, &priv_d);
+    ASSERT_NOT_NULL(derived);
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_public_key(derived));
+
+    struct aws_byte_cursor derived_x;
+    struct aws_byte_cursor derived_y;
+    aws_ecc_key_pair_get_public_key(derived, &derived_x, &derived_y);
+    ASSERT_BIN_ARRAYS_EQUALS(derived_x.ptr, derived_x.len, pub_x.ptr, pub_x.len);
+    ASSERT_BIN_ARRAYS_EQUALS(derived_y.ptr, derived_y.len, pub_y.ptr, pub_y.len);
+    aws_ecc_key_pair_release(derived);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_key_pool(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pool_options options = {
+        .depth = 8,
+        .refill_threshold = 2,
+    };
+    struct aws_ecc_key_pool *pool = aws_ecc_key_pool_new(allocator, curve_name, &options);
+    ASSERT_NOT_NULL(pool);
+
+    /* the worker fills the pool in the background, an empty pool makes the key pair on the spot */
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pool_take(pool);
+    ASSERT_NOT_NULL(key_pair);
+    ASSERT_SUCCESS(s_check_pooled_key_pair(allocator, key_pair));
+    aws_ecc_key_pair_release(key_pair);
+
+    /* more takers than the pool holds, so some key pairs are made on the spot */
+    struct key_pool_thread_data data = {.pool = pool};
+    aws_atomic_init_int(&data.next, 0);
+
+    struct aws_thread threads[KEY_POOL_THREAD_COUNT];
+    for (size_t i = 0; i < KEY_POOL_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_key_pool_thread_fn, &data, NULL));
+    }
+
+    for (size_t i = 0; i < KEY_POOL_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+
+    /* every key pair is valid and handed out once */
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(data.key_pairs); ++i) {
+        ASSERT_NOT_NULL(data.key_pairs[i]);
+        ASSERT_SUCCESS(s_check_pooled_key_pair(allocator, data.key_pairs[i]));
+        for (size_t j = 0; j < i; ++j) {
+            ASSERT_FALSE(aws_byte_buf_eq(&data.key_pairs[i]->priv_d, &data.key_pairs[j]->priv_d));
+        }
+    }
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(data.key_pairs); ++i) {
+        aws_ecc_key_pair_release(data.key_pairs[i]);
+    }
+
+    /* the worker is still refilling when the pool goes away */
+    aws_ecc_key_pool_destroy(pool);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecc_key_pool_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    struct aws_ecc_key_pool_options options = {
+        .depth = 4,
+        .refill_threshold = 4,
+    };
+    ASSERT_NULL(aws_ecc_key_pool_new(allocator, AWS_CAL_ECDSA_P256, &options));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+    options.depth = 0;
+    options.refill_threshold = 0;
+    ASSERT_NULL(aws_ecc_key_pool_new(allocator, AWS_CAL_ECDSA_P256, &options));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_key_pool));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_key_pool, s_ecc_key_pool_fn)
+
+#define KEY_POOL_CHURN_TAKES 1024
+
+struct key_pool_churn_data {
+    struct aws_ecc_key_pool *pool;
+    struct aws_atomic_var failures;
+};
+
+static void s_key_pool_churn_thread_fn(void *arg) {
+    struct key_pool_churn_data *data = arg;
+    for (size_t i = 0; i < KEY_POOL_CHURN_TAKES; ++i) {
+        struct aws_ecc_key_pair *key_pair = aws_ecc_key_pool_take(data->pool);
+        if (!key_pair) {
+            aws_atomic_fetch_add(&data->failures, 1);
+        }
+        aws_ecc_key_pair_release(key_pair);
+    }
+}
+
+/*
+ * With a power of two depth the ring has no spare slot, so the worker refills right behind takers that have claimed
+ * a slot but not yet given it back. Keep it refilling after every take while several threads take at once.
+ */
+static int s_ecc_key_pool_power_of_two_depth_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    enum aws_ecc_provider default_provider = aws_ecc_get_provider(AWS_CAL_ECDSA_P256);
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, AWS_ECC_PROVIDER_NATIVE));
+
+    size_t depths[] = {1, 2, 4, 8};
+    for (size_t d = 0; d < AWS_ARRAY_SIZE(depths); ++d) {
+        struct aws_ecc_key_pool_options options = {
+            .depth = depths[d],
+            .refill_threshold = depths[d] - 1,
+        };
+        struct key_pool_churn_data data = {
+            .pool = aws_ecc_key_pool_new(allocator, AWS_CAL_ECDSA_P256, &options),
+        };
+        ASSERT_NOT_NULL(data.pool);
+        aws_atomic_init_int(&data.failures, 0);
+
+        struct aws_thread threads[KEY_POOL_THREAD_COUNT];
+        for (size_t i = 0; i < KEY_POOL_THREAD_COUNT; ++i) {
+            ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+            ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_key_pool_churn_thread_fn, &data, NULL));
+        }
+
+        for (size_t i = 0; i < KEY_POOL_THREAD_COUNT; ++i) {
+            ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+            aws_thread_clean_up(&threads[i]);
+        }
+
+        ASSERT_UINT_EQUALS(0, aws_atomic_load_int(&data.failures));
+        aws_ecc_key_pool_destroy(data.pool);
+    }
+
+    ASSERT_SUCCESS(aws_ecc_set_provider(AWS_CAL_ECDSA_P256, default_provider));
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_key_pool_power_of_two_depth, s_ecc_key_pool_power_of_two_depth_fn)
+
+#define REPLICA_THREAD_COUNT 4
+#define REPLICA_ITERATIONS 20
+
+struct replica_thread_data {
+    struct aws_allocator *allocator;
+    struct aws_ecc_key_pair *key_pair;
+    struct aws_byte_cursor hash;
+    struct aws_atomic_var failures;
+};
+
+/* Each thread signs and verifies with a replica of its own, checking the shared key pair accepts its signatures. */
+static void s_replica_thread_fn(void *arg) {
+    struct replica_thread_data *data = arg;
+
+    struct aws_ecc_key_pair *replica = aws_ecc_key_pair_new_replica(data->allocator, data->key_pair);
+    if (!replica) {
+        aws_atomic_fetch_add(&data->failures, 1);
+        return;
+    }
+
+    for (size_t i = 0; i < REPLICA_ITERATIONS; ++i) {
+        uint8_t signature[256];
+        struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+        if (aws_ecc_key_pair_sign_message(replica, &data->hash, &signature_buf)) {
+            aws_atomic_fetch_add(&data->failures, 1);
+            continue;
+        }
+
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+        if (aws_ecc_key_pair_verify_signature(replica, &data->hash, &signature_cur) ||
+            aws_ecc_key_pair_verify_signature(data->key_pair, &data->hash, &signature_cur)) {
+            aws_atomic_fetch_add(&data->failures, 1);
+        }
+    }
+
+    aws_ecc_key_pair_release(replica);
+}
+
+static int s_test_key_pair_replicas(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(key_pair);
+    bool deterministic = aws_ecc_key_pair_set_deterministic_signing(key_pair, true) == AWS_OP_SUCCESS;
+
+    struct aws_ecc_key_pair *replica = aws_ecc_key_pair_new_replica(allocator, key_pair);
+    ASSERT_NOT_NULL(replica);
+    ASSERT_TRUE(replica != key_pair || !key_pair->vtable->replicate);
+    ASSERT_TRUE(aws_byte_buf_eq(&key_pair->priv_d, &replica->priv_d));
+    ASSERT_TRUE(aws_byte_buf_eq(&key_pair->pub_x, &replica->pub_x));
+    ASSERT_TRUE(aws_byte_buf_eq(&key_pair->pub_y, &replica->pub_y));
+
+    /* either one verifies the other's signatures, and deterministic ones match */
+    uint8_t hash[AWS_SHA256_LEN] = {9};
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_array(hash, sizeof(hash));
+    uint8_t signature[256];
+    uint8_t replica_signature[256];
+    struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+    struct aws_byte_buf replica_signature_buf =
+        aws_byte_buf_from_empty_array(replica_signature, sizeof(replica_signature));
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature_buf));
+    ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(replica, &hash_cur, &replica_signature_buf));
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+    struct aws_byte_cursor replica_signature_cur = aws_byte_cursor_from_buf(&replica_signature_buf);
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(replica, &hash_cur, &signature_cur));
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(key_pair, &hash_cur, &replica_signature_cur));
+    if (deterministic) {
+        ASSERT_TRUE(aws_byte_cursor_eq(&signature_cur, &replica_signature_cur));
+    }
+    aws_ecc_key_pair_release(replica);
+
+    /* replicas made after preparing the key pair share its table */
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(key_pair));
+    replica = aws_ecc_key_pair_new_replica(allocator, key_pair);
+    ASSERT_NOT_NULL(replica);
+    ASSERT_PTR_EQUALS(
+        aws_atomic_load_ptr(&key_pair->verification_table), aws_atomic_load_ptr(&replica->verification_table));
+
+    /* and outlive it */
+    aws_ecc_key_pair_release(key_pair);
+    ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(replica, &hash_cur, &signature_cur));
+
+    struct replica_thread_data data = {
+        .allocator = allocator,
+        .key_pair = replica,
+        .hash = hash_cur,
+    };
+    aws_atomic_init_int(&data.failures, 0);
+
+    struct aws_thread threads[REPLICA_THREAD_COUNT];
+    for (size_t i = 0; i < REPLICA_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_replica_thread_fn, &data, NULL));
+    }
+
+    for (size_t i = 0; i < REPLICA_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+
+    ASSERT_UINT_EQUALS(0, aws_atomic_load_int(&data.failures));
+    aws_ecc_key_pair_release(replica);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecc_key_pair_replicas_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_key_pair_replicas));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_key_pair_replicas, s_ecc_key_pair_replicas_fn)
+
+#define KEY_SLOT_THREAD_COUNT 4
+#define KEY_SLOT_ROTATIONS 10
+
+struct key_slot_thread_data {
+    struct aws_ecc_key_slot *slot;
+    struct aws_byte_cursor hash;
+    struct aws_atomic_var done;
+    struct aws_atomic_var reads;
+    struct aws_atomic_var failures;
+};
+
+/* Signs and verifies with whatever key pair is current until the rotations are over. */
+static void s_key_slot_thread_fn(void *arg) {
+    struct key_slot_thread_data *data = arg;
+
+    struct aws_ecc_key_slot_reader *reader = aws_ecc_key_slot_reader_new(data->slot);
+    if (!reader) {
+        aws_atomic_fetch_add(&data->failures, 1);
+        return;
+    }
+
+    while (!aws_atomic_load_int(&data->done)) {
+        struct aws_ecc_key_pair *key_pair = aws_ecc_key_slot_read_begin(reader);
+
+        uint8_t signature[256];
+        struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+        if (aws_ecc_key_pair_sign_message(key_pair, &data->hash, &signature_buf)) {
+            aws_atomic_fetch_add(&data->failures, 1);
+        } else {
+            struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+            if (aws_ecc_key_pair_verify_signature(key_pair, &data->hash, &signature_cur)) {
+                aws_atomic_fetch_add(&data->failures, 1);
+            }
+        }
+
+        aws_ecc_key_slot_read_end(reader);
+        aws_atomic_fetch_add(&data->reads, 1);
+    }
+
+    aws_ecc_key_slot_reader_destroy(reader);
+}
+
+static int s_ecc_key_slot_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    struct aws_ecc_key_pair *first = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256);
+    struct aws_ecc_key_pair *second = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256);
+    ASSERT_NOT_NULL(first);
+    ASSERT_NOT_NULL(second);
+
+    struct aws_ecc_key_slot *slot = aws_ecc_key_slot_new(allocator, first);
+    ASSERT_NOT_NULL(slot);
+    ASSERT_UINT_EQUALS(2, aws_atomic_load_int(&first->ref_count));
+
+    struct aws_ecc_key_slot_reader *reader = aws_ecc_key_slot_reader_new(slot);
+    ASSERT_NOT_NULL(reader);
+
+    /* a reader inside a read keeps the key pair it got, without a reference of its own */
+    ASSERT_PTR_EQUALS(first, aws_ecc_key_slot_read_begin(reader));
+    ASSERT_UINT_EQUALS(2, aws_atomic_load_int(&first->ref_count));
+    ASSERT_SUCCESS(aws_ecc_key_slot_publish(slot, second));
+    ASSERT_UINT_EQUALS(2, aws_atomic_load_int(&first->ref_count));
+    ASSERT_UINT_EQUALS(2, aws_atomic_load_int(&second->ref_count));
+    aws_ecc_key_slot_reclaim(slot);
+    ASSERT_UINT_EQUALS(2, aws_atomic_load_int(&first->ref_count));
+
+    /* until it leaves */
+    aws_ecc_key_slot_read_end(reader);
+    aws_ecc_key_slot_reclaim(slot);
+    ASSERT_UINT_EQUALS(1, aws_atomic_load_int(&first->ref_count));
+
+    ASSERT_PTR_EQUALS(second, aws_ecc_key_slot_read_begin(reader));
+    aws_ecc_key_slot_read_end(reader);
+
+    /* with nobody reading, the old key pair goes straight away */
+    ASSERT_SUCCESS(aws_ecc_key_slot_publish(slot, first));
+    ASSERT_UINT_EQUALS(2, aws_atomic_load_int(&first->ref_count));
+    ASSERT_UINT_EQUALS(1, aws_atomic_load_int(&second->ref_count));
+
+    /* destroying the last reader inside the grace period lets go too */
+    aws_ecc_key_slot_read_begin(reader);
+    ASSERT_SUCCESS(aws_ecc_key_slot_publish(slot, NULL));
+    ASSERT_UINT_EQUALS(2, aws_atomic_load_int(&first->ref_count));
+    aws_ecc_key_slot_read_end(reader);
+    ASSERT_NULL(aws_ecc_key_slot_read_begin(reader));
+    aws_ecc_key_slot_read_end(reader);
+    aws_ecc_key_slot_reader_destroy(reader);
+    ASSERT_UINT_EQUALS(1, aws_atomic_load_int(&first->ref_count));
+
+    /* rotations under load */
+    ASSERT_SUCCESS(aws_ecc_key_slot_publish(slot, first));
+
+    uint8_t hash[AWS_SHA256_LEN] = {3};
+    struct key_slot_thread_data data = {
+        .slot = slot,
+        .hash = aws_byte_cursor_from_array(hash, sizeof(hash)),
+    };
+    aws_atomic_init_int(&data.done, 0);
+    aws_atomic_init_int(&data.reads, 0);
+    aws_atomic_init_int(&data.failures, 0);
+
+    struct aws_thread threads[KEY_SLOT_THREAD_COUNT];
+    for (size_t i = 0; i < KEY_SLOT_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_key_slot_thread_fn, &data, NULL));
+    }
+
+    for (size_t i = 0; i < KEY_SLOT_ROTATIONS; ++i) {
+        struct aws_ecc_key_pair *next = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256);
+        ASSERT_NOT_NULL(next);
+        ASSERT_SUCCESS(aws_ecc_key_slot_publish(slot, next));
+        aws_ecc_key_pair_release(next);
+
+        /* let the readers get some reads in on each key pair */
+        size_t reads = aws_atomic_load_int(&data.reads);
+        while (aws_atomic_load_int(&data.reads) < reads + KEY_SLOT_THREAD_COUNT) {
+            aws_thread_current_sleep(100000);
+        }
+    }
+
+    aws_atomic_store_int(&data.done, 1);
+    for (size_t i = 0; i < KEY_SLOT_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+
+    ASSERT_UINT_EQUALS(0, aws_atomic_load_int(&data.failures));
+    ASSERT_UINT_EQUALS(1, aws_atomic_load_int(&first->ref_count));
+
+    aws_ecc_key_slot_destroy(slot);
+    aws_ecc_key_pair_release(first);
+    aws_ecc_key_pair_release(second);
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_key_slot, s_ecc_key_slot_fn)
+
+/* NIST CAVS ECC CDH primitive test vectors, COUNT = 0: peer's public key, our private key and the expected Z */
+static int s_test_shared_secret_known_answer(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *peer_x_hex,
+    const char *peer_y_hex,
+    const char *private_key_hex,
+    const char *expected_hex) {
+    uint8_t peer_x[AWS_EC_NATIVE_MAX_LIMBS * 8] = {0};
+    uint8_t peer_y[AWS_EC_NATIVE_MAX_LIMBS * 8] = {0};
+    uint8_t private_key[AWS_EC_NATIVE_MAX_LIMBS * 8] = {0};
+    uint8_t expected[AWS_EC_NATIVE_MAX_LIMBS * 8] = {0};
+    struct aws_byte_buf peer_x_buf = aws_byte_buf_from_empty_array(peer_x, sizeof(peer_x));
+    struct aws_byte_buf peer_y_buf = aws_byte_buf_from_empty_array(peer_y, sizeof(peer_y));
+    struct aws_byte_buf private_key_buf = aws_byte_buf_from_empty_array(private_key, sizeof(private_key));
+    struct aws_byte_buf expected_buf = aws_byte_buf_from_empty_array(expected, sizeof(expected));
+    struct aws_byte_cursor peer_x_hex_cur = aws_byte_cursor_from_c_str(peer_x_hex);
+    struct aws_byte_cursor peer_y_hex_cur = aws_byte_cursor_from_c_str(peer_y_hex);
+    struct aws_byte_cursor private_key_hex_cur = aws_byte_cursor_from_c_str(private_key_hex);
+    struct aws_byte_cursor expected_hex_cur = aws_byte_cursor_from_c_str(expected_hex);
+    ASSERT_SUCCESS(aws_hex_decode(&peer_x_hex_cur, &peer_x_buf));
+    ASSERT_SUCCESS(aws_hex_decode(&peer_y_hex_cur, &peer_y_buf));
+    ASSERT_SUCCESS(aws_hex_decode(&private_key_hex_cur, &private_key_buf));
+    ASSERT_SUCCESS(aws_hex_decode(&expected_hex_cur, &expected_buf));
+
+    struct aws_byte_cursor peer_x_cur = aws_byte_cursor_from_buf(&peer_x_buf);
+    struct aws_byte_cursor peer_y_cur = aws_byte_cursor_from_buf(&peer_y_buf);
+    struct aws_byte_cursor private_key_cur = aws_byte_cursor_from_buf(&private_key_buf);
+    struct aws_ecc_key_pair *peer =
+        aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &peer_x_cur, &peer_y_cur);
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_from_private_key(allocator, curve_name, &private_key_cur);
+    ASSERT_NOT_NULL(peer);
+    ASSERT_NOT_NULL(key_pair);
+
+    uint8_t secret[AWS_EC_NATIVE_MAX_LIMBS * 8];
+    struct aws_byte_buf secret_buf = aws_byte_buf_from_empty_array(secret, sizeof(secret));
+    if (aws_ecc_key_pair_derive_shared_secret(key_pair, peer, &secret_buf)) {
+        /* the platform providers other than libcrypto don't do ECDH */
+        ASSERT_INT_EQUALS(AWS_ERROR_UNSUPPORTED_OPERATION, aws_last_error());
+        goto done;
+    }
+    ASSERT_BIN_ARRAYS_EQUALS(expected_buf.buffer, expected_buf.len, secret_buf.buffer, secret_buf.len);
+
+    /* a peer with a verification table gets the same secret */
+    ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(peer));
+    secret_buf.len = 0;
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_shared_secret(key_pair, peer, &secret_buf));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_buf.buffer, expected_buf.len, secret_buf.buffer, secret_buf.len);
+
+done:
+    aws_ecc_key_pair_release(peer);
+    aws_ecc_key_pair_release(key_pair);
+
+    return AWS_OP_SUCCESS;
+}
+
+#define SHARED_SECRET_BATCH_SIZE 40
+
+static int s_test_shared_secret(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    size_t secret_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+
+    struct aws_ecc_key_pair *alice = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    struct aws_ecc_key_pair *bob = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(alice);
+    ASSERT_NOT_NULL(bob);
+
+    uint8_t alice_secret[AWS_EC_NATIVE_MAX_LIMBS * 8];
+    uint8_t bob_secret[AWS_EC_NATIVE_MAX_LIMBS * 8];
+    struct aws_byte_buf alice_secret_buf = aws_byte_buf_from_empty_array(alice_secret, sizeof(alice_secret));
+    struct aws_byte_buf bob_secret_buf = aws_byte_buf_from_empty_array(bob_secret, sizeof(bob_secret));
+    if (aws_ecc_key_pair_derive_shared_secret(alice, bob, &alice_secret_buf)) {
+        ASSERT_INT_EQUALS(AWS_ERROR_UNSUPPORTED_OPERATION, aws_last_error());
+        aws_ecc_key_pair_release(alice);
+        aws_ecc_key_pair_release(bob);
+        return AWS_OP_SUCCESS;
+    }
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_shared_secret(bob, alice, &bob_secret_buf));
+    ASSERT_UINT_EQUALS(secret_size, alice_secret_buf.len);
+    ASSERT_TRUE(aws_byte_buf_eq(&alice_secret_buf, &bob_secret_buf));
+
+    /* bob's public key alone, from either provider, gives alice the same secret */
+    struct aws_byte_cursor bob_x;
+    struct aws_byte_cursor bob_y;
+    aws_ecc_key_pair_get_public_key(bob, &bob_x, &bob_y);
+    struct aws_ecc_key_pair *bob_public[] = {
+        aws_ecc_key_pair_new_native_from_public_key(allocator, curve_name, &bob_x, &bob_y),
+#ifndef AWS_BYO_CRYPTO
+        aws_ecc_key_pair_new_from_public_key_impl(allocator, curve_name, &bob_x, &bob_y),
+#endif
+    };
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(bob_public); ++i) {
+        ASSERT_NOT_NULL(bob_public[i]);
+        bob_secret_buf.len = 0;
+        ASSERT_SUCCESS(aws_ecc_key_pair_derive_shared_secret(alice, bob_public[i], &bob_secret_buf));
+        ASSERT_TRUE(aws_byte_buf_eq(&alice_secret_buf, &bob_secret_buf));
+
+        /* which can't derive anything itself */
+        bob_secret_buf.len = 0;
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT,
+            aws_ecc_key_pair_derive_shared_secret(bob_public[i], alice, &bob_secret_buf));
+        aws_ecc_key_pair_release(bob_public[i]);
+    }
+
+    /* misuse is caught before anything is derived */
+    uint8_t short_secret[8];
+    struct aws_byte_buf short_secret_buf = aws_byte_buf_from_empty_array(short_secret, sizeof(short_secret));
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_ecc_key_pair_derive_shared_secret(alice, bob, &short_secret_buf));
+
+    enum aws_ecc_curve_name other_curve_name =
+        curve_name == AWS_CAL_ECDSA_P256 ? AWS_CAL_ECDSA_P384 : AWS_CAL_ECDSA_P256;
+    struct aws_ecc_key_pair *other_curve = aws_ecc_key_pair_new_generate_random(allocator, other_curve_name);
+    ASSERT_NOT_NULL(other_curve);
+    bob_secret_buf.len = 0;
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT, aws_ecc_key_pair_derive_shared_secret(alice, other_curve, &bob_secret_buf));
+    aws_ecc_key_pair_release(other_curve);
+
+    /* a batch over more than one block, some peers with tables, matches deriving one at a time */
+    struct aws_ecc_key_pair *peers[SHARED_SECRET_BATCH_SIZE];
+    struct aws_byte_buf secrets[SHARED_SECRET_BATCH_SIZE];
+    for (size_t i = 0; i < SHARED_SECRET_BATCH_SIZE; ++i) {
+        peers[i] = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+        ASSERT_NOT_NULL(peers[i]);
+        if (i % 3 == 0) {
+            ASSERT_SUCCESS(aws_ecc_key_pair_prepare_for_verification(peers[i]));
+        }
+        ASSERT_SUCCESS(aws_byte_buf_init(&secrets[i], allocator, secret_size));
+    }
+
+    ASSERT_SUCCESS(aws_ecc_key_pair_derive_shared_secret_batch(
+        alice, (const struct aws_ecc_key_pair *const *)peers, SHARED_SECRET_BATCH_SIZE, secrets));
+
+    for (size_t i = 0; i < SHARED_SECRET_BATCH_SIZE; ++i) {
+        alice_secret_buf.len = 0;
+        bob_secret_buf.len = 0;
+        ASSERT_SUCCESS(aws_ecc_key_pair_derive_shared_secret(alice, peers[i], &alice_secret_buf));
+        ASSERT_SUCCESS(aws_ecc_key_pair_derive_shared_secret(peers[i], alice, &bob_secret_buf));
+        ASSERT_TRUE(aws_byte_buf_eq(&alice_secret_buf, &secrets[i]));
+        ASSERT_TRUE(aws_byte_buf_eq(&bob_secret_buf, &secrets[i]));
+    }
+
+    /* a full buffer anywhere fails the whole batch up front */
+    for (size_t i = 0; i < SHARED_SECRET_BATCH_SIZE; ++i) {
+        secrets[i].len = i == SHARED_SECRET_BATCH_SIZE - 1 ? secret_size : 0;
+    }
+    ASSERT_ERROR(
+        AWS_ERROR_SHORT_BUFFER,
+        aws_ecc_key_pair_derive_shared_secret_batch(
+            alice, (const struct aws_ecc_key_pair *const *)peers, SHARED_SECRET_BATCH_SIZE, secrets));
+    ASSERT_UINT_EQUALS(0, secrets[0].len);
+
+    for (size_t i = 0; i < SHARED_SECRET_BATCH_SIZE; ++i) {
+        aws_byte_buf_clean_up_secure(&secrets[i]);
+        aws_ecc_key_pair_release(peers[i]);
+    }
+
+    aws_ecc_key_pair_release(alice);
+    aws_ecc_key_pair_release(bob);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_shared_secret_on_curve(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    ASSERT_SUCCESS(s_test_shared_secret(allocator, curve_name));
+
+    if (curve_name == AWS_CAL_ECDSA_P256) {
+        ASSERT_SUCCESS(s_test_shared_secret_known_answer(
+            allocator,
+            curve_name,
+            "700c48f77f56584c5cc632ca65640db91b6bacce3a4df6b42ce7cc838833d287",
+            "db71e509e3fd9b060ddb20ba5c51dcc5948d46fbf640dfe0441782cab85fa4ac",
+            "7d7dc5f71eb29ddaf80d6214632eeae03d9058af1fb6d22ed80badb62bc1a534",
+            "46fc62106420ff012e54a434fbdd2d25ccc5852060561e68040dd7778997bd7b"));
+    } else {
+        ASSERT_SUCCESS(s_test_shared_secret_known_answer(
+            allocator,
+            curve_name,
+            "a7c76b970c3b5fe8b05d2838ae04ab47697b9eaf52e764592efda27fe7513272"
+            "734466b400091adbf2d68c58e0c50066",
+            "ac68f19f2e1cb879aed43a9969b91a0839c4c38a49749b661efedf243451915e"
+            "d0905a32b060992b468c64766fc8437a",
+            "3cc3122a68f0d95027ad38c067916ba0eb8c38894d22e1b15618b6818a661774"
+            "ad463b205da88cf699ab4d43c9cf98a1",
+            "5f9d29dc5e31a163060356213669c8ce132e22f57c9a04f40ba7fcead493b457"
+            "e5621e766c40a2e3d4d6a04b25e533f1"));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecdh_shared_secret_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_shared_secret_on_curve));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdh_shared_secret, s_ecdh_shared_secret_fn)
+
+static int s_test_sec1_generator(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    const char *gx_hex,
+    const char *gy_hex) {
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+
+    uint8_t gx[AWS_EC_NATIVE_MAX_LIMBS * 8] = {0};
+    uint8_t gy[AWS_EC_NATIVE_MAX_LIMBS * 8] = {0};
+    struct aws_byte_buf gx_buf = aws_byte_buf_from_empty_array(gx, sizeof(gx));
+    struct aws_byte_buf gy_buf = aws_byte_buf_from_empty_array(gy, sizeof(gy));
+    struct aws_byte_cursor gx_hex_cur = aws_byte_cursor_from_c_str(gx_hex);
+    struct aws_byte_cursor gy_hex_cur = aws_byte_cursor_from_c_str(gy_hex);
+    ASSERT_SUCCESS(aws_hex_decode(&gx_hex_cur, &gx_buf));
+    ASSERT_SUCCESS(aws_hex_decode(&gy_hex_cur, &gy_buf));
+
+    /* the generator's y is odd on both curves, so 0x03 || x decompresses to it */
+    uint8_t encoded[1 + AWS_EC_NATIVE_MAX_LIMBS * 8];
+    encoded[0] = 0x03;
+    memcpy(encoded + 1, gx, coordinate_size);
+    struct aws_byte_cursor encoded_cur = aws_byte_cursor_from_array(encoded, 1 + coordinate_size);
+    struct aws_ecc_key_pair *generator = aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur);
+    ASSERT_NOT_NULL(generator);
+
+    struct aws_byte_cursor x;
+    struct aws_byte_cursor y;
+    aws_ecc_key_pair_get_public_key(generator, &x, &y);
+    ASSERT_BIN_ARRAYS_EQUALS(gx, coordinate_size, x.ptr, x.len);
+    ASSERT_BIN_ARRAYS_EQUALS(gy, coordinate_size, y.ptr, y.len);
+    aws_ecc_key_pair_release(generator);
+
+    /* and 0x02 || x to its negation, the other point with that x */
+    encoded[0] = 0x02;
+    generator = aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur);
+    ASSERT_NOT_NULL(generator);
+    aws_ecc_key_pair_get_public_key(generator, &x, &y);
+    ASSERT_BIN_ARRAYS_EQUALS(gx, coordinate_size, x.ptr, x.len);
+    ASSERT_UINT_EQUALS(0, y.ptr[y.len - 1] & 1);
+    ASSERT_FALSE(aws_byte_cursor_eq(&y, &(struct aws_byte_cursor){.ptr = gy, .len = coordinate_size}));
+    aws_ecc_key_pair_release(generator);
+
+    return AWS_OP_SUCCESS;
+}
+
+#define SEC1_ROUND_TRIP_KEYS 16
+
+static int s_test_sec1_public_key(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    size_t coordinate_size = aws_ecc_key_coordinate_byte_size_from_curve_name(curve_name);
+    bool formats[] = {true, false};
+
+    uint8_t encoded[1 + 2 * AWS_EC_NATIVE_MAX_LIMBS * 8];
+    struct aws_byte_buf encoded_buf = aws_byte_buf_from_empty_array(encoded, sizeof(encoded));
+
+    for (size_t i = 0; i < SEC1_ROUND_TRIP_KEYS; ++i) {
+        struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+        ASSERT_NOT_NULL(key_pair);
+        struct aws_byte_cursor x;
+        struct aws_byte_cursor y;
+        aws_ecc_key_pair_get_public_key(key_pair, &x, &y);
+
+        for (size_t j = 0; j < AWS_ARRAY_SIZE(formats); ++j) {
+            bool compressed = formats[j];
+            encoded_buf.len = 0;
+            ASSERT_SUCCESS(aws_ecc_key_pair_write_sec1_public_key(key_pair, compressed, &encoded_buf));
+            ASSERT_UINT_EQUALS(aws_ecc_sec1_public_key_length(curve_name, compressed), encoded_buf.len);
+            ASSERT_UINT_EQUALS(compressed ? 0x02 | (y.ptr[y.len - 1] & 1) : 0x04, encoded[0]);
+
+            struct aws_byte_cursor encoded_cur = aws_byte_cursor_from_buf(&encoded_buf);
+            struct aws_ecc_key_pair *decoded =
+                aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur);
+            ASSERT_NOT_NULL(decoded);
+            struct aws_byte_cursor decoded_x;
+            struct aws_byte_cursor decoded_y;
+            aws_ecc_key_pair_get_public_key(decoded, &decoded_x, &decoded_y);
+            ASSERT_BIN_ARRAYS_EQUALS(x.ptr, x.len, decoded_x.ptr, decoded_x.len);
+            ASSERT_BIN_ARRAYS_EQUALS(y.ptr, y.len, decoded_y.ptr, decoded_y.len);
+            aws_ecc_key_pair_release(decoded);
+        }
+
+        aws_ecc_key_pair_release(key_pair);
+    }
+
+    /* an uncompressed point with y changed is not on the curve */
+    struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(key_pair);
+    encoded_buf.len = 0;
+    ASSERT_SUCCESS(aws_ecc_key_pair_write_sec1_public_key(key_pair, false, &encoded_buf));
+    encoded[encoded_buf.len - 1] ^= 1;
+    struct aws_byte_cursor encoded_cur = aws_byte_cursor_from_buf(&encoded_buf);
+    ASSERT_NULL(aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur));
+
+    /* neither is one whose compressed form has the wrong length or prefix */
+    encoded_buf.len = 0;
+    ASSERT_SUCCESS(aws_ecc_key_pair_write_sec1_public_key(key_pair, true, &encoded_buf));
+    encoded_cur = aws_byte_cursor_from_array(encoded, encoded_buf.len - 1);
+    ASSERT_NULL(aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+    encoded[0] = 0x05;
+    encoded_cur = aws_byte_cursor_from_buf(&encoded_buf);
+    ASSERT_NULL(aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    /* x = 1 has no point on either curve: x^3 - 3x + b is not a square */
+    memset(encoded, 0, sizeof(encoded));
+    encoded[0] = 0x02;
+    encoded[coordinate_size] = 1;
+    encoded_cur = aws_byte_cursor_from_array(encoded, 1 + coordinate_size);
+    ASSERT_NULL(aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    /* nor does an x that is not reduced */
+    memset(encoded + 1, 0xff, coordinate_size);
+    ASSERT_NULL(aws_ecc_key_pair_new_from_sec1_public_key(allocator, curve_name, &encoded_cur));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    /* writing needs room for the whole encoding */
+    uint8_t short_encoded[8];
+    struct aws_byte_buf short_encoded_buf = aws_byte_buf_from_empty_array(short_encoded, sizeof(short_encoded));
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_ecc_key_pair_write_sec1_public_key(key_pair, true, &short_encoded_buf));
+    aws_ecc_key_pair_release(key_pair);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_sec1_public_key_on_curve(struct aws_allocator *allocator, enum aws_ecc_curve_name curve_name) {
+    ASSERT_SUCCESS(s_test_sec1_public_key(allocator, curve_name));
+
+    if (curve_name == AWS_CAL_ECDSA_P256) {
+        ASSERT_SUCCESS(s_test_sec1_generator(
+            allocator,
+            curve_name,
+            "6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296",
+            "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5"));
+    } else {
+        ASSERT_SUCCESS(s_test_sec1_generator(
+            allocator,
+            curve_name,
+            "aa87ca22be8b05378eb1c71ef320ad746e1d3b628ba79b9859f741e082542a38"
+            "5502f25dbf55296c3a545e3872760ab7",
+            "3617de4a96262c6f5d9e98bf9292dc29f8f41dbd289a147ce9da3113b5f0b8c0"
+            "0a60b1ce1d7e819d7a431d7c90ea0e5f"));
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecc_sec1_public_key_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    ASSERT_UINT_EQUALS(33, aws_ecc_sec1_public_key_length(AWS_CAL_ECDSA_P256, true));
+    ASSERT_UINT_EQUALS(65, aws_ecc_sec1_public_key_length(AWS_CAL_ECDSA_P256, false));
+    ASSERT_UINT_EQUALS(49, aws_ecc_sec1_public_key_length(AWS_CAL_ECDSA_P384, true));
+    ASSERT_UINT_EQUALS(97, aws_ecc_sec1_public_key_length(AWS_CAL_ECDSA_P384, false));
+
+    ASSERT_SUCCESS(s_for_each_curve_and_provider(allocator, s_test_sec1_public_key_on_curve));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecc_sec1_public_key, s_ecc_sec1_public_key_fn)
+
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(AWS_BYO_CRYPTO)
+#    include <aws/cal/private/opensslcrypto_ecc.h>
+
+static int s_test_libcrypto_backend_pair(
+    struct aws_allocator *allocator,
+    enum aws_ecc_curve_name curve_name,
+    enum aws_libcrypto_ecc_backend signer_backend,
+    enum aws_libcrypto_ecc_backend verifier_backend) {
+
+    aws_libcrypto_ecc_set_backend(signer_backend);
+    struct aws_ecc_key_pair *signing_key = aws_ecc_key_pair_new_generate_random(allocator, curve_name);
+    ASSERT_NOT_NULL(signing_key);
+
+    struct aws_byte_cursor pub_x;
+    struct aws_byte_cursor pub_y;
+    aws_ecc_key_pair_get_public_key(signing_key, &pub_x, &pub_y);
+
+    aws_libcrypto_ecc_set_backend(verifier_backend);
+    struct aws_ecc_key_pair *verifying_key =
+        aws_ecc_key_pair_new_from_public_key(allocator, curve_name, &pub_x, &pub_y);
+    ASSERT_NOT_NULL(verifying_key);
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_cursor message = aws_byte_cursor_from_c_str("libcrypto ecc backend cross check");
+    struct aws_byte_buf hash_value = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    ASSERT_SUCCESS(aws_sha256_compute(allocator, &message, &hash_value, 0));
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_value);
+
+    struct aws_byte_buf signature_buf;
+    ASSERT_SUCCESS(aws_byte_buf_init(&signature_buf, allocator, aws_ecc_key_pair_signature_length(signing_key)));
+
+    /* the second round goes through the context parked by the first one */
+    for (size_t i = 0; i < 2; ++i) {
+        signature_buf.len = 0;
+        ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(signing_key, &hash_cur, &signature_buf));
+
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(verifying_key, &hash_cur, &signature_cur));
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(signing_key, &hash_cur, &signature_cur));
+
+        hash[0] ^= 0x01;
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ecc_key_pair_verify_signature(verifying_key, &hash_cur, &signature_cur));
+        hash[0] ^= 0x01;
+    }
+
+    aws_byte_buf_clean_up(&signature_buf);
+    aws_ecc_key_pair_release(verifying_key);
+    aws_ecc_key_pair_release(signing_key);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ecdsa_libcrypto_backends_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    enum aws_libcrypto_ecc_backend default_backend = aws_libcrypto_ecc_get_backend();
+    enum aws_libcrypto_ecc_backend backends[] = {
+        AWS_LIBCRYPTO_ECC_BACKEND_EC_KEY,
+        AWS_LIBCRYPTO_ECC_BACKEND_EVP_PKEY,
+    };
+    enum aws_ecc_curve_name curves[] = {AWS_CAL_ECDSA_P256, AWS_CAL_ECDSA_P384};
+
+    for (size_t curve = 0; curve < AWS_ARRAY_SIZE(curves); ++curve) {
+        for (size_t signer = 0; signer < AWS_ARRAY_SIZE(backends); ++signer) {
+            for (size_t verifier = 0; verifier < AWS_ARRAY_SIZE(backends); ++verifier) {
+                ASSERT_SUCCESS(
+                    s_test_libcrypto_backend_pair(allocator, curves[curve], backends[signer], backends[verifier]));
+            }
+        }
+    }
+
+    aws_libcrypto_ecc_set_backend(default_backend);
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_libcrypto_backends, s_ecdsa_libcrypto_backends_fn)
+
+static int s_ecdsa_libcrypto_evp_pkey_derive_after_sign_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    enum aws_libcrypto_ecc_backend default_backend = aws_libcrypto_ecc_get_backend();
+    aws_libcrypto_ecc_set_backend(AWS_LIBCRYPTO_ECC_BACKEND_EVP_PKEY);
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_cursor message = aws_byte_cursor_from_c_str("sign, derive, sign again");
+    struct aws_byte_buf hash_value = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    ASSERT_SUCCESS(aws_sha256_compute(allocator, &message, &hash_value, 0));
+    struct aws_byte_cursor hash_cur = aws_byte_cursor_from_buf(&hash_value);
+
+    enum aws_ecc_curve_name curves[] = {AWS_CAL_ECDSA_P256, AWS_CAL_ECDSA_P384};
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(curves); ++i) {
+        struct aws_ecc_key_pair *generated = aws_ecc_key_pair_new_generate_random(allocator, curves[i]);
+        ASSERT_NOT_NULL(generated);
+        struct aws_byte_cursor priv_d;
+        aws_ecc_key_pair_get_private_key(generated, &priv_d);
+
+        struct aws_ecc_key_pair *key_pair = aws_ecc_key_pair_new_from_private_key(allocator, curves[i], &priv_d);
+        ASSERT_NOT_NULL(key_pair);
+
+        struct aws_byte_buf signature_buf;
+        ASSERT_SUCCESS(aws_byte_buf_init(&signature_buf, allocator, aws_ecc_key_pair_signature_length(key_pair)));
+
+        /* the sign template is built here, from a key without its public half */
+        ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature_buf));
+        ASSERT_SUCCESS(aws_ecc_key_pair_derive_public_key(key_pair));
+
+        /* and still signs once the public key is there */
+        signature_buf.len = 0;
+        ASSERT_SUCCESS(aws_ecc_key_pair_sign_message(key_pair, &hash_cur, &signature_buf));
+        struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(key_pair, &hash_cur, &signature_cur));
+        ASSERT_SUCCESS(aws_ecc_key_pair_verify_signature(generated, &hash_cur, &signature_cur));
+
+        aws_byte_buf_clean_up(&signature_buf);
+        aws_ecc_key_pair_release(key_pair);
+        aws_ecc_key_pair_release(generated);
+    }
+
+    aws_libcrypto_ecc_set_backend(default_backend);
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_libcrypto_evp_pkey_derive_after_sign, s_ecdsa_libcrypto_evp_pkey_derive_after_sign_fn)
+
+#    define SHARED_KEY_THREAD_COUNT 4
+#    define SHARED_KEY_ITERATIONS 16
+
+struct shared_key_thread_data {
+    struct aws_ecc_key_pair *key_pair;
+    struct aws_byte_cursor hash;
+    struct aws_atomic_var failures;
+};
+
+static int s_sign_and_verify(const struct aws_ecc_key_pair *key_pair, const struct aws_byte_cursor *hash) {
+    uint8_t signature[256];
+    AWS_ZERO_ARRAY(signature);
+    struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+
+    if (aws_ecc_key_pair_sign_message(key_pair, hash, &signature_buf)) {
+        return AWS_OP_ERR;
+    }
+
+    struct aws_byte_cursor signature_cur = aws_byte_cursor_from_buf(&signature_buf);
+    return aws_ecc_key_pair_verify_signature(key_pair, hash, &signature_cur);
+}
+
+static void s_shared_key_thread_fn(void *arg) {
+    struct shared_key_thread_data *data = arg;
+
+    for (size_t i = 0; i < SHARED_KEY_ITERATIONS; ++i) {
+        if (s_sign_and_verify(data->key_pair, &data->hash)) {
+            aws_atomic_fetch_add(&data->failures, 1);
+        }
+    }
+}
+
+static int s_ecdsa_libcrypto_evp_pkey_shared_key_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    enum aws_libcrypto_ecc_backend default_backend = aws_libcrypto_ecc_get_backend();
+    aws_libcrypto_ecc_set_backend(AWS_LIBCRYPTO_ECC_BACKEND_EVP_PKEY);
+
+    uint8_t hash[AWS_SHA256_LEN];
+    struct aws_byte_cursor message = aws_byte_cursor_from_c_str("one key, many threads");
+    struct aws_byte_buf hash_value = aws_byte_buf_from_empty_array(hash, sizeof(hash));
+    ASSERT_SUCCESS(aws_sha256_compute(allocator, &message, &hash_value, 0));
+
+    struct shared_key_thread_data data = {
+        .key_pair = aws_ecc_key_pair_new_generate_random(allocator, AWS_CAL_ECDSA_P256),
+        .hash = aws_byte_cursor_from_buf(&hash_value),
+    };
+    ASSERT_NOT_NULL(data.key_pair);
+    aws_atomic_init_int(&data.failures, 0);
+
+    struct aws_thread threads[SHARED_KEY_THREAD_COUNT];
+    for (size_t i = 0; i < SHARED_KEY_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_init(&threads[i], allocator));
+        ASSERT_SUCCESS(aws_thread_launch(&threads[i], s_shared_key_thread_fn, &data, NULL));
+    }
+
+    for (size_t i = 0; i < SHARED_KEY_THREAD_COUNT; ++i) {
+        ASSERT_SUCCESS(aws_thread_join(&threads[i]));
+        aws_thread_clean_up(&threads[i]);
+    }
+
+    ASSERT_UINT_EQUALS(0, aws_atomic_load_int(&data.failures));
+
+    aws_ecc_key_pair_release(data.key_pair);
+    aws_libcrypto_ecc_set_backend(default_backend);
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ecdsa_libcrypto_evp_pkey_shared_key, s_ecdsa_libcrypto_evp_pkey_shared_key_fn)
+#endif
@@ -0,0 +1,378 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/cal.h>
+#include <aws/cal/ed25519.h>
+#include <aws/common/byte_buf.h>
+#include <aws/common/encoding.h>
+#include <aws/testing/aws_test_harness.h>
+
+static enum aws_ecc_provider s_providers[] = {
+    AWS_ECC_PROVIDER_NATIVE,
+    AWS_ECC_PROVIDER_PLATFORM,
+};
+
+/* decodes hex into buf's storage, which must be big enough */
+static struct aws_byte_cursor s_from_hex(struct aws_byte_buf *buf, const char *hex) {
+    struct aws_byte_cursor hex_cursor = aws_byte_cursor_from_c_str(hex);
+    buf->len = 0;
+    AWS_FATAL_ASSERT(aws_hex_decode(&hex_cursor, buf) == AWS_OP_SUCCESS);
+    return aws_byte_cursor_from_buf(buf);
+}
+
+struct ed25519_vector {
+    const char *private_key;
+    const char *public_key;
+    const char *message;
+    const char *signature;
+};
+
+/* RFC 8032 section 7.1, TEST 1 to TEST 3 */
+static const struct ed25519_vector s_rfc8032_vectors[] = {
+    {
+        .private_key = "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+        .public_key = "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+        .message = "",
+        .signature = "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b4"
+                     "6bd25bf5f0595bbe24655141438e7a100b",
+    },
+    {
+        .private_key = "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+        .public_key = "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+        .message = "72",
+        .signature = "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d"
+                     "8c387b2eaeb4302aeeb00d291612bb0c00",
+    },
+    {
+        .private_key = "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+        .public_key = "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+        .message = "af82",
+        .signature = "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6"
+                     "594a7c15e9716ed28dc027beceea1ec40a",
+    },
+};
+
+static int s_test_rfc8032_vector(struct aws_allocator *allocator, const struct ed25519_vector *vector) {
+    uint8_t private_key_storage[32] = {0};
+    uint8_t public_key_storage[32] = {0};
+    uint8_t message_storage[16] = {0};
+    uint8_t signature_storage[64] = {0};
+    struct aws_byte_buf private_key_buf = aws_byte_buf_from_empty_array(private_key_storage, 32);
+    struct aws_byte_buf public_key_buf = aws_byte_buf_from_empty_array(public_key_storage, 32);
+    struct aws_byte_buf message_buf = aws_byte_buf_from_empty_array(message_storage, 16);
+    struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature_storage, 64);
+
+    struct aws_byte_cursor private_key = s_from_hex(&private_key_buf, vector->private_key);
+    struct aws_byte_cursor expected_public_key = s_from_hex(&public_key_buf, vector->public_key);
+    struct aws_byte_cursor message = s_from_hex(&message_buf, vector->message);
+    struct aws_byte_cursor expected_signature = s_from_hex(&signature_buf, vector->signature);
+
+    struct aws_ed25519_key_pair *key_pair = aws_ed25519_key_pair_new_from_private_key(allocator, &private_key);
+    ASSERT_NOT_NULL(key_pair);
+
+    struct aws_byte_cursor public_key;
+    aws_ed25519_key_pair_get_public_key(key_pair, &public_key);
+    ASSERT_BIN_ARRAYS_EQUALS(expected_public_key.ptr, expected_public_key.len, public_key.ptr, public_key.len);
+
+    struct aws_byte_cursor key_pair_private_key;
+    aws_ed25519_key_pair_get_private_key(key_pair, &key_pair_private_key);
+    ASSERT_BIN_ARRAYS_EQUALS(private_key.ptr, private_key.len, key_pair_private_key.ptr, key_pair_private_key.len);
+
+    uint8_t signature[AWS_ED25519_SIGNATURE_LEN];
+    struct aws_byte_buf signature_out = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+    ASSERT_SUCCESS(aws_ed25519_key_pair_sign_message(key_pair, &message, &signature_out));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_signature.ptr, expected_signature.len, signature_out.buffer, signature_out.len);
+    ASSERT_SUCCESS(aws_ed25519_key_pair_verify_signature(key_pair, &message, &expected_signature));
+
+    struct aws_ed25519_key_pair *verifier = aws_ed25519_key_pair_new_from_public_key(allocator, &expected_public_key);
+    ASSERT_NOT_NULL(verifier);
+    ASSERT_SUCCESS(aws_ed25519_key_pair_verify_signature(verifier, &message, &expected_signature));
+
+    struct aws_byte_cursor verifier_private_key;
+    aws_ed25519_key_pair_get_private_key(verifier, &verifier_private_key);
+    ASSERT_UINT_EQUALS(0, verifier_private_key.len);
+
+    aws_ed25519_key_pair_release(verifier);
+    aws_ed25519_key_pair_release(key_pair);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ed25519_rfc8032_vectors_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    enum aws_ecc_provider default_provider = aws_ed25519_get_provider();
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_providers); ++i) {
+        if (aws_ed25519_set_provider(s_providers[i])) {
+            /* no Ed25519 on this platform */
+            ASSERT_INT_EQUALS(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM, aws_last_error());
+            continue;
+        }
+
+        for (size_t j = 0; j < AWS_ARRAY_SIZE(s_rfc8032_vectors); ++j) {
+            ASSERT_SUCCESS(s_test_rfc8032_vector(allocator, &s_rfc8032_vectors[j]));
+        }
+    }
+    ASSERT_SUCCESS(aws_ed25519_set_provider(default_provider));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ed25519_rfc8032_vectors, s_ed25519_rfc8032_vectors_fn)
+
+/* adds the group order L to the S half of a signature, which keeps [S]B the same */
+static void s_add_group_order(uint8_t *signature) {
+    static const uint8_t group_order[32] = {
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+    };
+
+    unsigned carry = 0;
+    for (size_t i = 0; i < 32; ++i) {
+        carry += signature[32 + i] + group_order[i];
+        signature[32 + i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+}
+
+static int s_test_sign_verify(struct aws_allocator *allocator) {
+    struct aws_ed25519_key_pair *key_pair = aws_ed25519_key_pair_new_generate_random(allocator);
+    ASSERT_NOT_NULL(key_pair);
+
+    struct aws_byte_cursor public_key;
+    aws_ed25519_key_pair_get_public_key(key_pair, &public_key);
+    struct aws_ed25519_key_pair *verifier = aws_ed25519_key_pair_new_from_public_key(allocator, &public_key);
+    ASSERT_NOT_NULL(verifier);
+
+    uint8_t message_storage[300];
+    for (size_t i = 0; i < sizeof(message_storage); ++i) {
+        message_storage[i] = (uint8_t)(i * 7);
+    }
+    struct aws_byte_cursor message = aws_byte_cursor_from_array(message_storage, sizeof(message_storage));
+
+    uint8_t signature[AWS_ED25519_SIGNATURE_LEN + 1];
+    struct aws_byte_buf signature_buf = aws_byte_buf_from_empty_array(signature, AWS_ED25519_SIGNATURE_LEN);
+    ASSERT_SUCCESS(aws_ed25519_key_pair_sign_message(key_pair, &message, &signature_buf));
+    ASSERT_UINT_EQUALS(AWS_ED25519_SIGNATURE_LEN, signature_buf.len);
+
+    /* a full buffer is too short */
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_ed25519_key_pair_sign_message(key_pair, &message, &signature_buf));
+
+    struct aws_byte_cursor signature_cursor = aws_byte_cursor_from_array(signature, AWS_ED25519_SIGNATURE_LEN);
+    ASSERT_SUCCESS(aws_ed25519_key_pair_verify_signature(key_pair, &message, &signature_cursor));
+    ASSERT_SUCCESS(aws_ed25519_key_pair_verify_signature(verifier, &message, &signature_cursor));
+
+    /* a public key alone can't sign */
+    struct aws_byte_buf verifier_signature_buf = aws_byte_buf_from_empty_array(signature, sizeof(signature));
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_MISSING_REQUIRED_KEY_COMPONENT,
+        aws_ed25519_key_pair_sign_message(verifier, &message, &verifier_signature_buf));
+
+    /* the other provider signs the same way, and accepts this provider's signatures */
+    enum aws_ecc_provider provider = aws_ed25519_get_provider();
+    enum aws_ecc_provider other_provider =
+        provider == AWS_ECC_PROVIDER_NATIVE ? AWS_ECC_PROVIDER_PLATFORM : AWS_ECC_PROVIDER_NATIVE;
+    if (aws_ed25519_set_provider(other_provider) == AWS_OP_SUCCESS) {
+        struct aws_byte_cursor private_key;
+        aws_ed25519_key_pair_get_private_key(key_pair, &private_key);
+        struct aws_ed25519_key_pair *other = aws_ed25519_key_pair_new_from_private_key(allocator, &private_key);
+        ASSERT_NOT_NULL(other);
+
+        uint8_t other_signature[AWS_ED25519_SIGNATURE_LEN];
+        struct aws_byte_buf other_signature_buf =
+            aws_byte_buf_from_empty_array(other_signature, sizeof(other_signature));
+        ASSERT_SUCCESS(aws_ed25519_key_pair_sign_message(other, &message, &other_signature_buf));
+        ASSERT_BIN_ARRAYS_EQUALS(signature, AWS_ED25519_SIGNATURE_LEN, other_signature, sizeof(other_signature));
+        ASSERT_SUCCESS(aws_ed25519_key_pair_verify_signature(other, &message, &signature_cursor));
+
+        aws_ed25519_key_pair_release(other);
+        ASSERT_SUCCESS(aws_ed25519_set_provider(provider));
+    }
+
+    /* any change to the message or the signature, a wrong length, or a non-canonical S fails */
+    message_storage[100] ^= 1;
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+        aws_ed25519_key_pair_verify_signature(verifier, &message, &signature_cursor));
+    message_storage[100] ^= 1;
+
+    for (size_t i = 0; i < AWS_ED25519_SIGNATURE_LEN; i += 9) {
+        signature[i] ^= 0x10;
+        ASSERT_ERROR(
+            AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+            aws_ed25519_key_pair_verify_signature(verifier, &message, &signature_cursor));
+        signature[i] ^= 0x10;
+    }
+
+    struct aws_byte_cursor short_signature = aws_byte_cursor_from_array(signature, AWS_ED25519_SIGNATURE_LEN - 1);
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+        aws_ed25519_key_pair_verify_signature(verifier, &message, &short_signature));
+    struct aws_byte_cursor long_signature = aws_byte_cursor_from_array(signature, AWS_ED25519_SIGNATURE_LEN + 1);
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+        aws_ed25519_key_pair_verify_signature(verifier, &message, &long_signature));
+
+    uint8_t malleated[AWS_ED25519_SIGNATURE_LEN];
+    memcpy(malleated, signature, sizeof(malleated));
+    s_add_group_order(malleated);
+    struct aws_byte_cursor malleated_cursor = aws_byte_cursor_from_array(malleated, sizeof(malleated));
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+        aws_ed25519_key_pair_verify_signature(verifier, &message, &malleated_cursor));
+
+    ASSERT_SUCCESS(aws_ed25519_key_pair_verify_signature(verifier, &message, &signature_cursor));
+
+    aws_ed25519_key_pair_release(verifier);
+    aws_ed25519_key_pair_release(key_pair);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_test_bad_keys(struct aws_allocator *allocator) {
+    uint8_t key[AWS_ED25519_PUBLIC_KEY_LEN + 1] = {0};
+
+    struct aws_byte_cursor short_key = aws_byte_cursor_from_array(key, AWS_ED25519_PUBLIC_KEY_LEN - 1);
+    ASSERT_NULL(aws_ed25519_key_pair_new_from_public_key(allocator, &short_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM, aws_last_error());
+    ASSERT_NULL(aws_ed25519_key_pair_new_from_private_key(allocator, &short_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM, aws_last_error());
+
+    struct aws_byte_cursor long_key = aws_byte_cursor_from_array(key, AWS_ED25519_PUBLIC_KEY_LEN + 1);
+    ASSERT_NULL(aws_ed25519_key_pair_new_from_public_key(allocator, &long_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_CAL_INVALID_KEY_LENGTH_FOR_ALGORITHM, aws_last_error());
+
+    struct aws_byte_cursor public_key = aws_byte_cursor_from_array(key, AWS_ED25519_PUBLIC_KEY_LEN);
+
+    /* y = 2 has no x: (y^2 - 1) / (d y^2 + 1) is not a square */
+    key[0] = 2;
+    ASSERT_NULL(aws_ed25519_key_pair_new_from_public_key(allocator, &public_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    /* y = p + 1 is y = 1 encoded non-canonically */
+    memset(key, 0xff, AWS_ED25519_PUBLIC_KEY_LEN);
+    key[0] = 0xee;
+    key[31] = 0x7f;
+    ASSERT_NULL(aws_ed25519_key_pair_new_from_public_key(allocator, &public_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    /* y = 1 is the identity, x = 0, which can't have the sign bit set */
+    memset(key, 0, AWS_ED25519_PUBLIC_KEY_LEN);
+    key[0] = 1;
+    key[31] = 0x80;
+    ASSERT_NULL(aws_ed25519_key_pair_new_from_public_key(allocator, &public_key));
+    ASSERT_INT_EQUALS(AWS_ERROR_INVALID_ARGUMENT, aws_last_error());
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_ed25519_sign_verify_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    enum aws_ecc_provider default_provider = aws_ed25519_get_provider();
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_providers); ++i) {
+        if (aws_ed25519_set_provider(s_providers[i])) {
+            ASSERT_INT_EQUALS(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM, aws_last_error());
+            continue;
+        }
+
+        for (size_t j = 0; j < 8; ++j) {
+            ASSERT_SUCCESS(s_test_sign_verify(allocator));
+        }
+        ASSERT_SUCCESS(s_test_bad_keys(allocator));
+    }
+    ASSERT_SUCCESS(aws_ed25519_set_provider(default_provider));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ed25519_sign_verify, s_ed25519_sign_verify_fn)
+
+/* more than one block of the batch, so the blocks are checked independently */
+#define BATCH_SIZE 100
+#define BATCH_KEYS 4
+
+static int s_ed25519_verify_batch_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    /* keys from both providers where there are two, each signing many of the messages */
+    enum aws_ecc_provider default_provider = aws_ed25519_get_provider();
+    struct aws_ed25519_key_pair *key_pairs[BATCH_KEYS];
+    for (size_t i = 0; i < BATCH_KEYS; ++i) {
+        if (aws_ed25519_set_provider(s_providers[i % AWS_ARRAY_SIZE(s_providers)])) {
+            ASSERT_SUCCESS(aws_ed25519_set_provider(AWS_ECC_PROVIDER_NATIVE));
+        }
+        key_pairs[i] = aws_ed25519_key_pair_new_generate_random(allocator);
+        ASSERT_NOT_NULL(key_pairs[i]);
+    }
+    ASSERT_SUCCESS(aws_ed25519_set_provider(default_provider));
+
+    struct aws_ed25519_key_pair *keys[BATCH_SIZE];
+    uint8_t message_storage[BATCH_SIZE][20];
+    uint8_t signature_storage[BATCH_SIZE][AWS_ED25519_SIGNATURE_LEN];
+    struct aws_byte_cursor messages[BATCH_SIZE];
+    struct aws_byte_cursor signatures[BATCH_SIZE];
+    int results[BATCH_SIZE];
+
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        /* runs of the same key, and keys coming back later */
+        keys[i] = key_pairs[(i / 3) % BATCH_KEYS];
+        memset(message_storage[i], (int)i, sizeof(message_storage[i]));
+        messages[i] = aws_byte_cursor_from_array(message_storage[i], (i * 7) % sizeof(message_storage[i]));
+
+        struct aws_byte_buf signature_buf =
+            aws_byte_buf_from_empty_array(signature_storage[i], sizeof(signature_storage[i]));
+        ASSERT_SUCCESS(aws_ed25519_key_pair_sign_message(keys[i], &messages[i], &signature_buf));
+        signatures[i] = aws_byte_cursor_from_buf(&signature_buf);
+    }
+
+    memset(results, 0xff, sizeof(results));
+    ASSERT_SUCCESS(aws_ed25519_verify_batch(allocator, keys, messages, signatures, BATCH_SIZE, results));
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        ASSERT_INT_EQUALS(AWS_ERROR_SUCCESS, results[i]);
+    }
+
+    /* a batch of one, and an empty one */
+    ASSERT_SUCCESS(aws_ed25519_verify_batch(allocator, keys, messages, signatures, 1, results));
+    ASSERT_SUCCESS(aws_ed25519_verify_batch(allocator, keys, messages, signatures, 0, results));
+
+    /* a signature for another message, a bad R, a malleated S and a short signature are each found */
+    size_t swapped = 5;
+    size_t bad_r = 42;
+    size_t malleated = 70;
+    size_t truncated = 99;
+    messages[swapped] = messages[swapped + 1];
+    signature_storage[bad_r][3] ^= 0x40;
+    s_add_group_order(signature_storage[malleated]);
+    signatures[truncated].len -= 1;
+
+    memset(results, 0xff, sizeof(results));
+    ASSERT_ERROR(
+        AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED,
+        aws_ed25519_verify_batch(allocator, keys, messages, signatures, BATCH_SIZE, results));
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        bool bad = i == swapped || i == bad_r || i == malleated || i == truncated;
+        ASSERT_INT_EQUALS(bad ? AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED : AWS_ERROR_SUCCESS, results[i]);
+    }
+
+    for (size_t i = 0; i < BATCH_KEYS; ++i) {
+        aws_ed25519_key_pair_release(key_pairs[i]);
+    }
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(ed25519_verify_batch, s_ed25519_verify_batch_fn)
@@ -0,0 +1,159 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include <aws/cal/kdf.h>
+#include <aws/common/byte_buf.h>
+#include <aws/testing/aws_test_harness.h>
+
+/*
+ * RFC 5869 Appendix A test vectors for HKDF-SHA256
+ * https://tools.ietf.org/html/rfc5869#appendix-A
+ */
+
+static int s_hkdf_sha256_rfc5869_test_case_1_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint8_t ikm[] = {
+        0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+        0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+    };
+    uint8_t salt[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c};
+    uint8_t info[] = {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9};
+
+    struct aws_byte_cursor ikm_cur = aws_byte_cursor_from_array(ikm, sizeof(ikm));
+    struct aws_byte_cursor salt_cur = aws_byte_cursor_from_array(salt, sizeof(salt));
+    struct aws_byte_cursor info_cur = aws_byte_cursor_from_array(info, sizeof(info));
+
+    uint8_t expected_prk[] = {
+        0x07, 0x77, 0x09, 0x36, 0x2c, 0x2e, 0x32, 0xdf, 0x0d, 0xdc, 0x3f, 0x0d, 0xc4, 0x7b, 0xba, 0x63,
+        0x90, 0xb6, 0xc7, 0x3b, 0xb5, 0x0f, 0x9c, 0x31, 0x22, 0xec, 0x84, 0x4a, 0xd7, 0xc2, 0xb3, 0xe5,
+    };
+    uint8_t expected_okm[] = {
+        0x3c, 0xb2, 0x5f, 0x25, 0xfa, 0xac, 0xd5, 0x7a, 0x90, 0x43, 0x4f, 0x64, 0xd0, 0x36, 0x2f, 0x2a,
+        0x2d, 0x2d, 0x0a, 0x90, 0xcf, 0x1a, 0x5a, 0x4c, 0x5d, 0xb0, 0x2d, 0x56, 0xec, 0xc4, 0xc5, 0xbf,
+        0x34, 0x00, 0x72, 0x08, 0xd5, 0xb8, 0x87, 0x18, 0x58, 0x65,
+    };
+
+    uint8_t prk[32];
+    struct aws_byte_buf prk_buf = aws_byte_buf_from_empty_array(prk, sizeof(prk));
+    ASSERT_SUCCESS(aws_hkdf_sha256_extract(&salt_cur, &ikm_cur, &prk_buf));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_prk, sizeof(expected_prk), prk_buf.buffer, prk_buf.len);
+
+    uint8_t okm[sizeof(expected_okm)];
+    struct aws_byte_buf okm_buf = aws_byte_buf_from_empty_array(okm, sizeof(okm));
+    struct aws_byte_cursor prk_cur = aws_byte_cursor_from_buf(&prk_buf);
+    ASSERT_SUCCESS(aws_hkdf_sha256_expand(&prk_cur, &info_cur, &okm_buf, sizeof(expected_okm)));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_okm, sizeof(expected_okm), okm_buf.buffer, okm_buf.len);
+
+    okm_buf.len = 0;
+    ASSERT_SUCCESS(aws_hkdf_sha256_derive(&salt_cur, &ikm_cur, &info_cur, &okm_buf, sizeof(expected_okm)));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_okm, sizeof(expected_okm), okm_buf.buffer, okm_buf.len);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(hkdf_sha256_rfc5869_test_case_1, s_hkdf_sha256_rfc5869_test_case_1_fn)
+
+static int s_hkdf_sha256_rfc5869_test_case_3_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint8_t ikm[] = {
+        0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+        0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+    };
+    struct aws_byte_cursor ikm_cur = aws_byte_cursor_from_array(ikm, sizeof(ikm));
+    struct aws_byte_cursor empty_cur = aws_byte_cursor_from_array(NULL, 0);
+
+    uint8_t expected_okm[] = {
+        0x8d, 0xa4, 0xe7, 0x75, 0xa5, 0x63, 0xc1, 0x8f, 0x71, 0x5f, 0x80, 0x2a, 0x06, 0x3c, 0x5a, 0x31,
+        0xb8, 0xa1, 0x1f, 0x5c, 0x5e, 0xe1, 0x87, 0x9e, 0xc3, 0x45, 0x4e, 0x5f, 0x3c, 0x73, 0x8d, 0x2d,
+        0x9d, 0x20, 0x13, 0x95, 0xfa, 0xa4, 0xb6, 0x1a, 0x96, 0xc8,
+    };
+
+    uint8_t okm[sizeof(expected_okm)];
+    struct aws_byte_buf okm_buf = aws_byte_buf_from_empty_array(okm, sizeof(okm));
+    ASSERT_SUCCESS(aws_hkdf_sha256_derive(&empty_cur, &ikm_cur, &empty_cur, &okm_buf, sizeof(expected_okm)));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_okm, sizeof(expected_okm), okm_buf.buffer, okm_buf.len);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(hkdf_sha256_rfc5869_test_case_3, s_hkdf_sha256_rfc5869_test_case_3_fn)
+
+static int s_hkdf_sha256_invalid_length_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    uint8_t prk[32] = {0};
+    struct aws_byte_cursor prk_cur = aws_byte_cursor_from_array(prk, sizeof(prk));
+    struct aws_byte_cursor info_cur = aws_byte_cursor_from_c_str("info");
+
+    struct aws_byte_buf output;
+    ASSERT_SUCCESS(aws_byte_buf_init(&output, allocator, AWS_HKDF_SHA256_MAX_OUTPUT_LEN + 1));
+
+    ASSERT_ERROR(
+        AWS_ERROR_INVALID_ARGUMENT,
+        aws_hkdf_sha256_expand(&prk_cur, &info_cur, &output, AWS_HKDF_SHA256_MAX_OUTPUT_LEN + 1));
+    ASSERT_UINT_EQUALS(0, output.len);
+
+    ASSERT_SUCCESS(aws_hkdf_sha256_expand(&prk_cur, &info_cur, &output, AWS_HKDF_SHA256_MAX_OUTPUT_LEN));
+    ASSERT_UINT_EQUALS(AWS_HKDF_SHA256_MAX_OUTPUT_LEN, output.len);
+
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_hkdf_sha256_expand(&prk_cur, &info_cur, &output, 2));
+
+    aws_byte_buf_clean_up(&output);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(hkdf_sha256_invalid_length, s_hkdf_sha256_invalid_length_fn)
+
+/*
+ * SP 800-108 counter mode vectors, cross-checked against OpenSSL's KBKDF (mac HMAC, digest SHA256).
+ */
+static int s_sp800_108_counter_kdf_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint8_t key[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+    };
+    struct aws_byte_cursor key_cur = aws_byte_cursor_from_array(key, sizeof(key));
+    struct aws_byte_cursor label_cur = aws_byte_cursor_from_c_str("label");
+    struct aws_byte_cursor context_cur = aws_byte_cursor_from_c_str("context");
+
+    uint8_t expected_short[] = {
+        0xb5, 0xb9, 0x30, 0x26, 0x55, 0xfb, 0x93, 0x69, 0x72, 0xe8, 0x9f, 0xc9, 0x70, 0x6f, 0xc6, 0xd7,
+    };
+    uint8_t expected_long[] = {
+        0x79, 0x3c, 0x8c, 0x63, 0x22, 0x23, 0x4b, 0x76, 0x06, 0x1b, 0xb6, 0xbe, 0x85, 0x8d, 0x89, 0x9c,
+        0xf6, 0xc2, 0xcf, 0x3a, 0x2c, 0xf0, 0x75, 0xf2, 0x2b, 0xed, 0x2b, 0x8a, 0x17, 0xd1, 0x0f, 0xf1,
+        0xcd, 0x9a, 0x6c, 0xdf, 0xd6, 0xc0, 0xf4, 0xbc, 0xae, 0xa6, 0xf6, 0x70, 0x0b, 0x4d, 0xec, 0xc8,
+        0xcb, 0x28, 0xa0, 0x19, 0x96, 0x8a, 0x85, 0x9f, 0x4e, 0x2d, 0x4e, 0xc8, 0xc6, 0x86, 0xdb, 0xd5,
+        0xa3, 0x3e, 0x69, 0x43, 0x41, 0x3e, 0x3d, 0xb9, 0xb6, 0xc0, 0x4a, 0x28, 0x02, 0x2f, 0x93, 0x6e,
+    };
+
+    uint8_t output[sizeof(expected_long)];
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output, sizeof(output));
+
+    ASSERT_SUCCESS(aws_sp800_108_counter_kdf_hmac_sha256(
+        &key_cur, &label_cur, &context_cur, &output_buf, sizeof(expected_short)));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_short, sizeof(expected_short), output_buf.buffer, output_buf.len);
+
+    output_buf.len = 0;
+    ASSERT_SUCCESS(
+        aws_sp800_108_counter_kdf_hmac_sha256(&key_cur, &label_cur, &context_cur, &output_buf, sizeof(expected_long)));
+    ASSERT_BIN_ARRAYS_EQUALS(expected_long, sizeof(expected_long), output_buf.buffer, output_buf.len);
+
+    output_buf.len = 1;
+    ASSERT_ERROR(
+        AWS_ERROR_SHORT_BUFFER,
+        aws_sp800_108_counter_kdf_hmac_sha256(&key_cur, &label_cur, &context_cur, &output_buf, sizeof(expected_long)));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sp800_108_counter_kdf, s_sp800_108_counter_kdf_fn)
@@ -29,6 +29,8 @@ static int s_sha256_hmac_rfc4231_test_case_1_fn(struct aws_allocator *allocator,
     };
     struct aws_byte_cursor expected_buf = aws_byte_cursor_from_array(expected, sizeof(expected));
 
+    ASSERT_SUCCESS(
+        s_verify_hmac_test_case(allocator, &input, &secret_buf, &expected_buf, aws_sha256_hmac_native_new));
     return s_verify_hmac_test_case(allocator, &input, &secret_buf, &expected_buf, aws_sha256_hmac_new);
 }
 
@@ -52,6 +54,8 @@ static int s_sha256_hmac_rfc4231_test_case_2_fn(struct aws_allocator *allocator,
     };
     struct aws_byte_cursor expected_buf = aws_byte_cursor_from_array(expected, sizeof(expected));
 
+    ASSERT_SUCCESS(
+        s_verify_hmac_test_case(allocator, &input, &secret_buf, &expected_buf, aws_sha256_hmac_native_new));
     return s_verify_hmac_test_case(allocator, &input, &secret_buf, &expected_buf, aws_sha256_hmac_new);
 }
 
@@ -80,6 +84,8 @@ static int s_sha256_hmac_rfc4231_test_case_3_fn(struct aws_allocator *allocator,
     };
     struct aws_byte_cursor expected_buf = aws_byte_cursor_from_array(expected, sizeof(expected));
 
+    ASSERT_SUCCESS(
+        s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_native_new));
     return s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_new);
 }
 
@@ -108,6 +114,8 @@ static int s_sha256_hmac_rfc4231_test_case_4_fn(struct aws_allocator *allocator,
     };
     struct aws_byte_cursor expected_buf = aws_byte_cursor_from_array(expected, sizeof(expected));
 
+    ASSERT_SUCCESS(
+        s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_native_new));
     return s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_new);
 }
 
@@ -144,6 +152,8 @@ static int s_sha256_hmac_rfc4231_test_case_5_fn(struct aws_allocator *allocator,
     };
     struct aws_byte_cursor expected_buf = aws_byte_cursor_from_array(expected, sizeof(expected));
 
+    ASSERT_SUCCESS(
+        s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_native_new));
     return s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_new);
 }
 
@@ -173,6 +183,8 @@ static int s_sha256_hmac_rfc4231_test_case_6_fn(struct aws_allocator *allocator,
     };
     struct aws_byte_cursor expected_buf = aws_byte_cursor_from_array(expected, sizeof(expected));
 
+    ASSERT_SUCCESS(
+        s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_native_new));
     return s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_new);
 }
 
@@ -204,6 +216,8 @@ static int s_sha256_hmac_rfc4231_test_case_7_fn(struct aws_allocator *allocator,
     };
     struct aws_byte_cursor expected_buf = aws_byte_cursor_from_array(expected, sizeof(expected));
 
+    ASSERT_SUCCESS(
+        s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_native_new));
     return s_verify_hmac_test_case(allocator, &input_buf, &secret_buf, &expected_buf, aws_sha256_hmac_new);
 }
 
@@ -326,3 +340,277 @@ static int s_sha256_hmac_test_invalid_state_fn(struct aws_allocator *allocator,
 }
 
 AWS_TEST_CASE(sha256_hmac_test_invalid_state, s_sha256_hmac_test_invalid_state_fn)
+
+#define BATCH_MESSAGE_COUNT 37
+
+static int s_verify_batch_against_oneshot(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor *secrets,
+    size_t secret_count,
+    size_t truncate_to) {
+
+    uint8_t message_storage[BATCH_MESSAGE_COUNT * 7];
+    for (size_t i = 0; i < sizeof(message_storage); ++i) {
+        message_storage[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    /* lengths straddle every padding case: empty, one and two tail blocks, and multiple full blocks */
+    struct aws_byte_cursor messages[BATCH_MESSAGE_COUNT];
+    for (size_t i = 0; i < BATCH_MESSAGE_COUNT; ++i) {
+        messages[i] = aws_byte_cursor_from_array(message_storage + i, i * 6);
+    }
+
+    uint8_t batch_storage[BATCH_MESSAGE_COUNT][AWS_SHA256_HMAC_LEN];
+    struct aws_byte_buf batch_outputs[BATCH_MESSAGE_COUNT];
+    for (size_t i = 0; i < BATCH_MESSAGE_COUNT; ++i) {
+        batch_outputs[i] = aws_byte_buf_from_empty_array(batch_storage[i], sizeof(batch_storage[i]));
+    }
+
+    ASSERT_SUCCESS(aws_sha256_hmac_compute_batch(
+        secrets, secret_count, messages, batch_outputs, BATCH_MESSAGE_COUNT, truncate_to));
+
+    for (size_t i = 0; i < BATCH_MESSAGE_COUNT; ++i) {
+        uint8_t expected[AWS_SHA256_HMAC_LEN];
+        struct aws_byte_buf expected_buf = aws_byte_buf_from_empty_array(expected, sizeof(expected));
+        struct aws_byte_cursor *secret = secret_count == 1 ? &secrets[0] : &secrets[i];
+        ASSERT_SUCCESS(aws_sha256_hmac_compute(allocator, secret, &messages[i], &expected_buf, truncate_to));
+        ASSERT_BIN_ARRAYS_EQUALS(expected_buf.buffer, expected_buf.len, batch_outputs[i].buffer, batch_outputs[i].len);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_sha256_hmac_batch_shared_secret_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    struct aws_byte_cursor secret = aws_byte_cursor_from_c_str("batch shared secret");
+    ASSERT_SUCCESS(s_verify_batch_against_oneshot(allocator, &secret, 1, 0));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_hmac_batch_shared_secret, s_sha256_hmac_batch_shared_secret_fn)
+
+static int s_sha256_hmac_batch_per_message_secrets_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    uint8_t secret_storage[BATCH_MESSAGE_COUNT * 4];
+    for (size_t i = 0; i < sizeof(secret_storage); ++i) {
+        secret_storage[i] = (uint8_t)(i * 13 + 1);
+    }
+
+    /* includes empty and longer than block size secrets, and runs of messages sharing one secret */
+    struct aws_byte_cursor secrets[BATCH_MESSAGE_COUNT];
+    for (size_t i = 0; i < BATCH_MESSAGE_COUNT; ++i) {
+        size_t secret_idx = i % 3 == 2 ? i - 1 : i;
+        secrets[i] = aws_byte_cursor_from_array(secret_storage + secret_idx, secret_idx * 3);
+    }
+
+    ASSERT_SUCCESS(s_verify_batch_against_oneshot(allocator, secrets, BATCH_MESSAGE_COUNT, 0));
+    ASSERT_SUCCESS(s_verify_batch_against_oneshot(allocator, secrets, BATCH_MESSAGE_COUNT, 16));
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_hmac_batch_per_message_secrets, s_sha256_hmac_batch_per_message_secrets_fn)
+
+static int s_sha256_hmac_batch_empty_secrets_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    /* {NULL, 0} looks just like a lane that has not built a key yet */
+    struct aws_byte_cursor secrets[BATCH_MESSAGE_COUNT];
+    struct aws_byte_cursor messages[BATCH_MESSAGE_COUNT];
+    uint8_t batch_storage[BATCH_MESSAGE_COUNT][AWS_SHA256_HMAC_LEN];
+    struct aws_byte_buf batch_outputs[BATCH_MESSAGE_COUNT];
+    for (size_t i = 0; i < BATCH_MESSAGE_COUNT; ++i) {
+        secrets[i] = aws_byte_cursor_from_array(NULL, 0);
+        messages[i] = aws_byte_cursor_from_c_str("the quick brown fox");
+        batch_outputs[i] = aws_byte_buf_from_empty_array(batch_storage[i], sizeof(batch_storage[i]));
+    }
+
+    ASSERT_SUCCESS(aws_sha256_hmac_compute_batch(
+        secrets, BATCH_MESSAGE_COUNT, messages, batch_outputs, BATCH_MESSAGE_COUNT, 0));
+
+    /* libcrypto wants a non-NULL pointer even for an empty key */
+    uint8_t unused = 0;
+    struct aws_byte_cursor empty_secret = aws_byte_cursor_from_array(&unused, 0);
+    uint8_t expected[AWS_SHA256_HMAC_LEN];
+    struct aws_byte_buf expected_buf = aws_byte_buf_from_empty_array(expected, sizeof(expected));
+    ASSERT_SUCCESS(aws_sha256_hmac_compute(allocator, &empty_secret, &messages[0], &expected_buf, 0));
+
+    for (size_t i = 0; i < BATCH_MESSAGE_COUNT; ++i) {
+        ASSERT_BIN_ARRAYS_EQUALS(expected_buf.buffer, expected_buf.len, batch_outputs[i].buffer, batch_outputs[i].len);
+    }
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_hmac_batch_empty_secrets, s_sha256_hmac_batch_empty_secrets_fn)
+
+static int s_sha256_hmac_batch_invalid_args_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    struct aws_byte_cursor secrets[2] = {
+        aws_byte_cursor_from_c_str("secret one"),
+        aws_byte_cursor_from_c_str("secret two"),
+    };
+    struct aws_byte_cursor messages[3] = {
+        aws_byte_cursor_from_c_str("one"),
+        aws_byte_cursor_from_c_str("two"),
+        aws_byte_cursor_from_c_str("three"),
+    };
+
+    uint8_t storage[3][AWS_SHA256_HMAC_LEN];
+    struct aws_byte_buf outputs[3];
+    for (size_t i = 0; i < 3; ++i) {
+        outputs[i] = aws_byte_buf_from_empty_array(storage[i], sizeof(storage[i]));
+    }
+
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_sha256_hmac_compute_batch(secrets, 2, messages, outputs, 3, 0));
+
+    outputs[2].capacity = AWS_SHA256_HMAC_LEN - 1;
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_sha256_hmac_compute_batch(secrets, 1, messages, outputs, 3, 0));
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_UINT_EQUALS(0, outputs[i].len);
+    }
+
+    ASSERT_SUCCESS(aws_sha256_hmac_compute_batch(secrets, 1, messages, outputs, 3, AWS_SHA256_HMAC_LEN - 1));
+    ASSERT_UINT_EQUALS(AWS_SHA256_HMAC_LEN - 1, outputs[2].len);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_hmac_batch_invalid_args, s_sha256_hmac_batch_invalid_args_fn)
+
+static int s_sha256_hmac_verify_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    uint8_t secret[] = {
+        0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+        0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+    };
+    struct aws_byte_cursor secret_buf = aws_byte_cursor_from_array(secret, sizeof(secret));
+    struct aws_byte_cursor input = aws_byte_cursor_from_c_str("Hi There");
+    uint8_t expected[] = {
+        0xb0, 0x34, 0x4c, 0x61, 0xd8, 0xdb, 0x38, 0x53, 0x5c, 0xa8, 0xaf, 0xce, 0xaf, 0x0b, 0xf1, 0x2b,
+        0x88, 0x1d, 0xc2, 0x00, 0xc9, 0x83, 0x3d, 0xa7, 0x26, 0xe9, 0x37, 0x6c, 0x2e, 0x32, 0xcf, 0xf7,
+    };
+
+    struct aws_byte_cursor full = aws_byte_cursor_from_array(expected, sizeof(expected));
+    struct aws_byte_cursor truncated = aws_byte_cursor_from_array(expected, 16);
+    struct aws_byte_cursor empty = aws_byte_cursor_from_array(expected, 0);
+
+    struct aws_hmac *hmac = aws_sha256_hmac_new(allocator, &secret_buf);
+    ASSERT_NOT_NULL(hmac);
+    ASSERT_SUCCESS(aws_hmac_update(hmac, &input));
+    ASSERT_SUCCESS(aws_hmac_verify(hmac, &full));
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_hmac_verify(hmac, &full));
+    aws_hmac_destroy(hmac);
+
+    hmac = aws_sha256_hmac_new(allocator, &secret_buf);
+    ASSERT_NOT_NULL(hmac);
+    ASSERT_SUCCESS(aws_hmac_update(hmac, &input));
+    ASSERT_SUCCESS(aws_hmac_verify(hmac, &truncated));
+    aws_hmac_destroy(hmac);
+
+    hmac = aws_sha256_hmac_new(allocator, &secret_buf);
+    ASSERT_NOT_NULL(hmac);
+    ASSERT_SUCCESS(aws_hmac_update(hmac, &input));
+    ASSERT_ERROR(AWS_ERROR_INVALID_ARGUMENT, aws_hmac_verify(hmac, &empty));
+    expected[sizeof(expected) - 1] ^= 0x01;
+    ASSERT_ERROR(AWS_ERROR_CAL_SIGNATURE_VALIDATION_FAILED, aws_hmac_verify(hmac, &full));
+    aws_hmac_destroy(hmac);
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_hmac_verify, s_sha256_hmac_verify_fn)
+
+static int s_sha256_hmac_native_test_invalid_state_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_byte_cursor secret_buf = aws_byte_cursor_from_c_str("native secret");
+    struct aws_byte_cursor input_buf = aws_byte_cursor_from_c_str("native input");
+
+    uint8_t output[AWS_SHA256_HMAC_LEN] = {0};
+    struct aws_byte_buf output_buf = aws_byte_buf_from_array(output, sizeof(output) - 1);
+    output_buf.len = 0;
+
+    struct aws_hmac *hmac = aws_sha256_hmac_native_new(allocator, &secret_buf);
+    ASSERT_NOT_NULL(hmac);
+    ASSERT_SUCCESS(aws_hmac_update(hmac, &input_buf));
+    ASSERT_ERROR(AWS_ERROR_SHORT_BUFFER, aws_hmac_finalize(hmac, &output_buf, 0));
+
+    output_buf.capacity = sizeof(output);
+    ASSERT_SUCCESS(aws_hmac_finalize(hmac, &output_buf, 0));
+    ASSERT_UINT_EQUALS(AWS_SHA256_HMAC_LEN, output_buf.len);
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_hmac_update(hmac, &input_buf));
+    ASSERT_ERROR(AWS_ERROR_INVALID_STATE, aws_hmac_finalize(hmac, &output_buf, 0));
+
+    aws_hmac_destroy(hmac);
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_hmac_native_test_invalid_state, s_sha256_hmac_native_test_invalid_state_fn)
+
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(AWS_BYO_CRYPTO)
+#    include <aws/cal/private/opensslcrypto_hmac.h>
+
+static int s_sha256_hmac_libcrypto_backends_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    aws_cal_library_init(allocator);
+
+    uint8_t secret[] = {
+        0x4a,
+        0x65,
+        0x66,
+        0x65,
+    };
+    struct aws_byte_cursor secret_buf = aws_byte_cursor_from_array(secret, sizeof(secret));
+
+    struct aws_byte_cursor input = aws_byte_cursor_from_c_str("what do ya want for nothing?");
+    uint8_t expected[] = {
+        0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xc7,
+        0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43,
+    };
+    struct aws_byte_cursor expected_buf = aws_byte_cursor_from_array(expected, sizeof(expected));
+
+    ASSERT_SUCCESS(
+        s_verify_hmac_test_case(allocator, &input, &secret_buf, &expected_buf, aws_sha256_hmac_libcrypto_legacy_new));
+
+    /* EVP_MAC is only there with OpenSSL 3 */
+    aws_cal_library_init(allocator);
+    struct aws_hmac *evp_mac_hmac = aws_sha256_hmac_libcrypto_evp_mac_new(allocator, &secret_buf);
+    if (evp_mac_hmac) {
+        aws_hmac_destroy(evp_mac_hmac);
+        ASSERT_SUCCESS(s_verify_hmac_test_case(
+            allocator, &input, &secret_buf, &expected_buf, aws_sha256_hmac_libcrypto_evp_mac_new));
+    } else {
+        ASSERT_INT_EQUALS(AWS_ERROR_CAL_UNSUPPORTED_ALGORITHM, aws_last_error());
+        aws_cal_library_clean_up();
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_hmac_libcrypto_backends, s_sha256_hmac_libcrypto_backends_fn)
+#endif
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 #include <aws/cal/hash.h>
+#include <aws/cal/private/sha256.h>
 #include <aws/common/byte_buf.h>
 #include <aws/testing/aws_test_harness.h>
 
@@ -270,3 +271,195 @@ static int s_sha256_test_invalid_state_fn(struct aws_allocator *allocator, void
 }
 
 AWS_TEST_CASE(sha256_test_invalid_state, s_sha256_test_invalid_state_fn)
+
+static int s_sha256_compress_kernels_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    /* library init picks the kernel aws_sha256_compress() dispatches to */
+    aws_cal_library_init(allocator);
+
+    /* "abc", padded to one block, checks the portable kernel on its own */
+    uint8_t abc_block[AWS_SHA256_BLOCK_LEN] = {'a', 'b', 'c', 0x80};
+    abc_block[AWS_SHA256_BLOCK_LEN - 1] = 0x18;
+    uint32_t abc_expected[8] = {
+        0xba7816bf,
+        0x8f01cfea,
+        0x414140de,
+        0x5dae2223,
+        0xb00361a3,
+        0x96177a9c,
+        0xb410ff61,
+        0xf20015ad,
+    };
+    uint32_t iv[8] = {
+        0x6a09e667,
+        0xbb67ae85,
+        0x3c6ef372,
+        0xa54ff53a,
+        0x510e527f,
+        0x9b05688c,
+        0x1f83d9ab,
+        0x5be0cd19,
+    };
+    uint32_t state[8];
+    memcpy(state, iv, sizeof(state));
+    aws_sha256_compress_portable(state, abc_block, 1);
+    ASSERT_BIN_ARRAYS_EQUALS(abc_expected, sizeof(abc_expected), state, sizeof(state));
+
+    /* whatever kernel the CPU gets (SHA extensions on most x86) must agree with the portable one */
+    uint8_t blocks[9 * AWS_SHA256_BLOCK_LEN];
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < sizeof(blocks); ++i) {
+        seed = seed * 1103515245 + 12345;
+        blocks[i] = (uint8_t)(seed >> 16);
+    }
+
+    for (size_t block_count = 1; block_count <= 9; ++block_count) {
+        uint32_t portable_state[8];
+        uint32_t dispatched_state[8];
+        for (size_t i = 0; i < 8; ++i) {
+            portable_state[i] = iv[i] ^ (uint32_t)(block_count * 0x9e3779b9);
+        }
+        memcpy(dispatched_state, portable_state, sizeof(dispatched_state));
+
+        aws_sha256_compress_portable(portable_state, blocks, block_count);
+        aws_sha256_compress(dispatched_state, blocks, block_count);
+        ASSERT_BIN_ARRAYS_EQUALS(
+            portable_state, sizeof(portable_state), dispatched_state, sizeof(dispatched_state));
+    }
+
+    aws_cal_library_clean_up();
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_compress_kernels, s_sha256_compress_kernels_fn)
+
+static int s_digest_equals_test_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint8_t digest[AWS_SHA256_LEN + 3];
+    for (size_t i = 0; i < sizeof(digest); ++i) {
+        digest[i] = (uint8_t)(i * 7 + 3);
+    }
+    uint8_t copy[sizeof(digest)];
+    memcpy(copy, digest, sizeof(digest));
+
+    /* odd length so both the word loop and the byte tail are covered */
+    struct aws_byte_cursor digest_cur = aws_byte_cursor_from_array(digest, sizeof(digest));
+    struct aws_byte_cursor copy_cur = aws_byte_cursor_from_array(copy, sizeof(copy));
+    ASSERT_TRUE(aws_cal_digest_equals(&digest_cur, &copy_cur));
+
+    for (size_t i = 0; i < sizeof(copy); ++i) {
+        copy[i] ^= 0x80;
+        ASSERT_FALSE(aws_cal_digest_equals(&digest_cur, &copy_cur));
+        copy[i] ^= 0x80;
+    }
+
+    struct aws_byte_cursor shorter = aws_byte_cursor_from_array(copy, sizeof(copy) - 1);
+    ASSERT_FALSE(aws_cal_digest_equals(&digest_cur, &shorter));
+
+    struct aws_byte_cursor empty = aws_byte_cursor_from_array(NULL, 0);
+    ASSERT_TRUE(aws_cal_digest_equals(&empty, &empty));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(digest_equals_test, s_digest_equals_test_fn)
+
+static int s_digest_equals_batch_test_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)allocator;
+    (void)ctx;
+
+    uint8_t digests[4][AWS_SHA256_LEN];
+    uint8_t expected[4][AWS_SHA256_LEN];
+    struct aws_byte_cursor digest_curs[4];
+    struct aws_byte_cursor expected_curs[4];
+    for (size_t i = 0; i < 4; ++i) {
+        memset(digests[i], (int)i, sizeof(digests[i]));
+        memset(expected[i], (int)i, sizeof(expected[i]));
+        digest_curs[i] = aws_byte_cursor_from_array(digests[i], sizeof(digests[i]));
+        expected_curs[i] = aws_byte_cursor_from_array(expected[i], sizeof(expected[i]));
+    }
+
+    bool results[4] = {false, false, false, false};
+    ASSERT_TRUE(aws_cal_digest_equals_batch(digest_curs, expected_curs, 4, results));
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(results[i]);
+    }
+
+    expected[2][AWS_SHA256_LEN - 1] ^= 0x01;
+    ASSERT_FALSE(aws_cal_digest_equals_batch(digest_curs, expected_curs, 4, results));
+    ASSERT_TRUE(results[0]);
+    ASSERT_TRUE(results[1]);
+    ASSERT_FALSE(results[2]);
+    ASSERT_TRUE(results[3]);
+
+    ASSERT_FALSE(aws_cal_digest_equals_batch(digest_curs, expected_curs, 4, NULL));
+    ASSERT_TRUE(aws_cal_digest_equals_batch(digest_curs, expected_curs, 2, NULL));
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(digest_equals_batch_test, s_digest_equals_batch_test_fn)
+
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(AWS_BYO_CRYPTO)
+#    include <aws/cal/private/opensslcrypto_common.h>
+
+static int s_libcrypto_fetched_digests_fn(struct aws_allocator *allocator, void *ctx) {
+    (void)ctx;
+
+    struct aws_byte_cursor input = aws_byte_cursor_from_c_str("abc");
+    uint8_t sha256_expected[] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+    };
+    uint8_t md5_expected[] = {
+        0x90, 0x01, 0x50, 0x98, 0x3c, 0xd2, 0x4f, 0xb0, 0xd6, 0x96, 0x3f, 0x7d, 0x28, 0xe1, 0x7f, 0x72,
+    };
+
+    /* the digests are fetched at every init and freed at every clean up */
+    for (size_t round = 0; round < 3; ++round) {
+        aws_cal_library_init(allocator);
+
+        struct openssl_evp_md_ctx_table *table = g_aws_openssl_evp_md_ctx_table;
+        ASSERT_NOT_NULL(table);
+        ASSERT_NOT_NULL(table->sha256);
+        ASSERT_NOT_NULL(table->md5);
+
+        /* OpenSSL 3 hands out fetched digests; everything else keeps the static ones */
+        if (table->md_fetch_fn) {
+            ASSERT_TRUE(table->sha256 != EVP_sha256());
+        } else {
+            ASSERT_TRUE(table->sha256 == EVP_sha256());
+            ASSERT_TRUE(table->md5 == EVP_md5());
+        }
+
+        const EVP_MD *sha256 = table->sha256;
+        const EVP_MD *md5 = table->md5;
+        for (size_t i = 0; i < 4; ++i) {
+            uint8_t output[AWS_SHA256_LEN] = {0};
+            struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output, sizeof(output));
+            ASSERT_SUCCESS(aws_sha256_compute(allocator, &input, &output_buf, 0));
+            ASSERT_BIN_ARRAYS_EQUALS(sha256_expected, sizeof(sha256_expected), output_buf.buffer, output_buf.len);
+
+            output_buf.len = 0;
+            ASSERT_SUCCESS(aws_md5_compute(allocator, &input, &output_buf, 0));
+            ASSERT_BIN_ARRAYS_EQUALS(md5_expected, sizeof(md5_expected), output_buf.buffer, output_buf.len);
+        }
+
+        /* hashing never fetches again */
+        ASSERT_TRUE(table->sha256 == sha256);
+        ASSERT_TRUE(table->md5 == md5);
+
+        aws_cal_library_clean_up();
+        ASSERT_NULL(table->sha256);
+        ASSERT_NULL(table->md5);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+AWS_TEST_CASE(sha256_libcrypto_fetched_digests, s_libcrypto_fetched_digests_fn)
+#endif